@@ -34,6 +34,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcCpuLib.h>
 #include <Library/OcDevicePathLib.h>
 #include <Library/OcStorageLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
@@ -119,22 +120,49 @@ OcMain (
   EFI_STATUS                Status;
   OC_PRIVILEGE_CONTEXT      *Privilege;
 
+  OcTraceBegin ("Init");
+
   DEBUG ((DEBUG_INFO, "OC: OcMiscEarlyInit...\n"));
+  OcTraceBegin ("EarlyInit");
   Status = OcMiscEarlyInit (
     Storage,
     &mOpenCoreConfiguration,
     mOpenCoreVaultKey
     );
+  OcTraceEnd ("EarlyInit");
 
   if (EFI_ERROR (Status)) {
+    OcTraceEnd ("Init");
     return;
   }
 
+  //
+  // Storage caching is only possible once configuration is loaded.
+  //
+  if (mOpenCoreConfiguration.Misc.Security.StorageCache) {
+    OcStorageEnableContentCache (
+      Storage,
+      OC_STORAGE_CONTENT_CACHE_FILE_MAX,
+      OC_STORAGE_CONTENT_CACHE_TOTAL_MAX
+      );
+  }
+
+  if (mOpenCoreConfiguration.Misc.Security.VaultPreload) {
+    OcTraceBegin ("VaultPreload");
+    OcStoragePreloadVaultFiles (Storage);
+    OcTraceEnd ("VaultPreload");
+  }
+
+  OcTraceBegin ("CpuScan");
   OcCpuScanProcessor (&mOpenCoreCpuInfo);
+  OcTraceEnd ("CpuScan");
 
   DEBUG ((DEBUG_INFO, "OC: OcLoadNvramSupport...\n"));
+  OcTraceBegin ("Nvram");
   OcLoadNvramSupport (Storage, &mOpenCoreConfiguration);
+  OcTraceEnd ("Nvram");
   DEBUG ((DEBUG_INFO, "OC: OcMiscMiddleInit...\n"));
+  OcTraceBegin ("MiddleInit");
   OcMiscMiddleInit (
     Storage,
     &mOpenCoreConfiguration,
@@ -143,22 +171,37 @@ OcMain (
     mStorageHandle,
     mOpenCoreConfiguration.Booter.Quirks.ForceBooterSignature ? mOpenCoreBooterHash : NULL
     );
+  OcTraceEnd ("MiddleInit");
   DEBUG ((DEBUG_INFO, "OC: OcLoadUefiSupport...\n"));
+  OcTraceBegin ("Uefi");
   OcLoadUefiSupport (Storage, &mOpenCoreConfiguration, &mOpenCoreCpuInfo, mOpenCoreBooterHash);
+  OcTraceEnd ("Uefi");
   DEBUG_CODE_BEGIN ();
   DEBUG ((DEBUG_INFO, "OC: OcMiscLoadSystemReport...\n"));
+  OcTraceBegin ("SystemReport");
   OcMiscLoadSystemReport (&mOpenCoreConfiguration, mStorageHandle);
+  OcTraceEnd ("SystemReport");
   DEBUG_CODE_END ();
   DEBUG ((DEBUG_INFO, "OC: OcLoadAcpiSupport...\n"));
+  OcTraceBegin ("Acpi");
   OcLoadAcpiSupport (&mOpenCoreStorage, &mOpenCoreConfiguration);
+  OcTraceEnd ("Acpi");
   DEBUG ((DEBUG_INFO, "OC: OcLoadPlatformSupport...\n"));
+  OcTraceBegin ("Platform");
   OcLoadPlatformSupport (&mOpenCoreConfiguration, &mOpenCoreCpuInfo);
+  OcTraceEnd ("Platform");
   DEBUG ((DEBUG_INFO, "OC: OcLoadDevPropsSupport...\n"));
+  OcTraceBegin ("DevProps");
   OcLoadDevPropsSupport (&mOpenCoreConfiguration);
+  OcTraceEnd ("DevProps");
   DEBUG ((DEBUG_INFO, "OC: OcMiscLateInit...\n"));
+  OcTraceBegin ("LateInit");
   OcMiscLateInit (Storage, &mOpenCoreConfiguration);
+  OcTraceEnd ("LateInit");
   DEBUG ((DEBUG_INFO, "OC: OcLoadKernelSupport...\n"));
+  OcTraceBegin ("KernelSupport");
   OcLoadKernelSupport (&mOpenCoreStorage, &mOpenCoreConfiguration, &mOpenCoreCpuInfo);
+  OcTraceEnd ("KernelSupport");
 
   if (mOpenCoreConfiguration.Misc.Security.EnablePassword) {
     mOpenCorePrivilege.CurrentLevel = OcPrivilegeUnauthorized;
@@ -171,6 +214,9 @@ OcMain (
     Privilege = NULL;
   }
 
+  OcTraceEnd ("Init");
+  OcTraceSave ();
+
   DEBUG ((DEBUG_INFO, "OC: All green, starting boot management...\n"));
 
   OcMiscBoot (
@@ -232,6 +278,7 @@ OcBootstrap (
   CopyMem (mStoragePath, LoadPath, StoragePathSize);
   SetDevicePathEndNode ((UINT8 *) mStoragePath + StoragePathSize);
 
+  OcTraceBegin ("Storage");
   Status = OcStorageInitFromFs (
     &mOpenCoreStorage,
     FileSystem,
@@ -240,6 +287,7 @@ OcBootstrap (
     mStorageRoot,
     mOpenCoreVaultKey
     );
+  OcTraceEnd ("Storage");
 
   if (!EFI_ERROR (Status)) {
     OcMain (&mOpenCoreStorage, LoadPath);
@@ -79,6 +79,16 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 //
 #define OC_RTC_BLACKLIST_VARIABLE_NAME       L"rtc-blacklist"
 
+//
+// Variable used to report boot phase timing, see OC_TRACE_HEADER.
+//
+#define OC_TRACE_VARIABLE_NAME               L"opencore-trace"
+
+//
+// Variable used to store boot entries found by the picker for the next boot.
+//
+#define OC_SCAN_CACHE_VARIABLE_NAME          L"opencore-scan-cache"
+
 //
 // Boot prefix used instead of normal Boot in OC_VENDOR_VARIABLE_GUID
 //
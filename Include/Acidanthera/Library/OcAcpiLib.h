@@ -53,6 +53,80 @@ typedef struct {
   CHAR8   Name[OC_ACPI_NAME_SIZE+1];
 } OC_ACPI_REGION;
 
+//
+// ACPI namespace object declared in table AML.
+//
+typedef struct {
+  //
+  // Object body offset from table start.
+  //
+  UINT32  Offset;
+  //
+  // Object body length.
+  //
+  UINT32  Length;
+  //
+  // Offset of the last object path segment from table start.
+  //
+  UINT32  NameOffset;
+  //
+  // Index of the first object path segment in namespace segment list.
+  //
+  UINT32  Path;
+  //
+  // Number of object path segments.
+  //
+  UINT32  Depth;
+} OC_ACPI_NAMESPACE_OBJECT;
+
+//
+// ACPI namespace index of a single table.
+//
+typedef struct {
+  //
+  // Declared objects in table order.
+  //
+  OC_ACPI_NAMESPACE_OBJECT  *Objects;
+  //
+  // Number of objects.
+  //
+  UINT32                    NumberOfObjects;
+  //
+  // Number of allocated object slots.
+  //
+  UINT32                    AllocatedObjects;
+  //
+  // Object path segments, 4 name characters each.
+  //
+  UINT32                    *Segments;
+  //
+  // Number of segments.
+  //
+  UINT32                    NumberOfSegments;
+  //
+  // Number of allocated segment slots.
+  //
+  UINT32                    AllocatedSegments;
+} OC_ACPI_NAMESPACE;
+
+//
+// ACPI table state kept between patches.
+//
+typedef struct {
+  //
+  // Patched table.
+  //
+  EFI_ACPI_COMMON_HEADER  *Table;
+  //
+  // Table namespace index or NULL when not built.
+  //
+  OC_ACPI_NAMESPACE       *Namespace;
+  //
+  // Table was modified and needs checksum refresh.
+  //
+  BOOLEAN                 Modified;
+} OC_ACPI_PATCHED_TABLE;
+
 //
 // Main ACPI context describing current tableset worked on.
 //
@@ -101,12 +175,32 @@ typedef struct {
   // Number of allocated region slots.
   //
   UINT32                                         AllocatedRegions;
+  //
+  // Tables touched by patches since last AcpiFlushPatches.
+  //
+  OC_ACPI_PATCHED_TABLE                          *PatchedTables;
+  //
+  // Number of patched tables.
+  //
+  UINT32                                         NumberOfPatchedTables;
+  //
+  // Number of allocated patched table slots.
+  //
+  UINT32                                         AllocatedPatchedTables;
 } OC_ACPI_CONTEXT;
 
 //
 // ACPI patch structure.
 //
 typedef struct {
+  //
+  // Namespace path to search in, e.g. \_SB.PCI0.LPCB, or NULL for entire table.
+  //
+  CONST CHAR8  *Base;
+  //
+  // Number of Base path occurrences to skip.
+  //
+  UINT32       BaseSkip;
   //
   // Find bytes.
   //
@@ -228,7 +322,7 @@ AcpiNormalizeHeaders (
   );
 
 /**
-  Patch ACPI tables.
+  Patch ACPI tables. Table checksums are refreshed by AcpiFlushPatches.
 
   @param[in,out] Context     ACPI library context.
   @param[in]     Patch       ACPI patch.
@@ -239,6 +333,74 @@ AcpiApplyPatch (
   IN     OC_ACPI_PATCH    *Patch
   );
 
+/**
+  Refresh checksums of tables modified by AcpiApplyPatch
+  and free namespace indices built for patching.
+  Called automatically when the tableset changes.
+
+  @param[in,out] Context     ACPI library context.
+**/
+VOID
+AcpiFlushPatches (
+  IN OUT OC_ACPI_CONTEXT  *Context
+  );
+
+/**
+  Build namespace index of Scope, Device, Processor, PowerResource,
+  ThermalZone, Method, and Name declarations in DSDT or SSDT.
+  Objects declared within conditional blocks are not indexed.
+
+  @param[in]  Table      ACPI table.
+  @param[out] Namespace  Namespace index, free with AcpiFreeNamespace.
+
+  @return EFI_SUCCESS on success.
+**/
+EFI_STATUS
+AcpiBuildNamespace (
+  IN  CONST EFI_ACPI_DESCRIPTION_HEADER  *Table,
+  OUT OC_ACPI_NAMESPACE                  *Namespace
+  );
+
+/**
+  Free namespace index.
+
+  @param[in,out] Namespace  Namespace index.
+**/
+VOID
+AcpiFreeNamespace (
+  IN OUT OC_ACPI_NAMESPACE  *Namespace
+  );
+
+/**
+  Find namespace object declaration by path.
+
+  @param[in] Namespace  Namespace index.
+  @param[in] Path       Absolute object path, e.g. \_SB.PCI0 or _SB_.PCI0.
+  @param[in] Skip       Number of path occurrences to skip.
+
+  @return object declaration or NULL.
+**/
+CONST OC_ACPI_NAMESPACE_OBJECT *
+AcpiFindNamespaceObject (
+  IN CONST OC_ACPI_NAMESPACE  *Namespace,
+  IN CONST CHAR8              *Path,
+  IN UINT32                   Skip
+  );
+
+/**
+  Check that object names in namespace index still match table contents.
+
+  @param[in] Namespace  Namespace index.
+  @param[in] Table      ACPI table the index was built for.
+
+  @return TRUE when the index is up to date.
+**/
+BOOLEAN
+AcpiNamespaceIsValid (
+  IN CONST OC_ACPI_NAMESPACE            *Namespace,
+  IN CONST EFI_ACPI_DESCRIPTION_HEADER  *Table
+  );
+
 /**
   Try to load ACPI regions.
 
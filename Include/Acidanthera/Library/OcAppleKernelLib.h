@@ -245,6 +245,12 @@ typedef struct {
   //
   CHAR8                    *PrelinkedInfo;
   //
+  // Unmodified copy of prelinkedkernel PRELINK_INFO_SECTION, from which
+  // unchanged parts of XML_DOCUMENT are exported verbatim.
+  // Freed upon context destruction.
+  //
+  CHAR8                    *PrelinkedInfoSource;
+  //
   // Parsed instance of PlistInfo. New entries are added here.
   //
   XML_DOCUMENT             *PrelinkedInfoDocument;
@@ -269,9 +275,31 @@ typedef struct {
   // Currently allocated pooled buffers. PooledBuffersAllocCount >= PooledBuffersCount.
   //
   UINT32                   PooledBuffersAllocCount;
+  //
+  // Current scratch arena chunk for allocations living as long as the context,
+  // like prelinked info copies and kext identifiers. Chunks are pooled buffers.
+  //
+  UINT8                    *ScratchArena;
+  //
+  // Size of the current scratch arena chunk.
+  //
+  UINT32                   ScratchArenaSize;
+  //
+  // Used bytes of the current scratch arena chunk.
+  //
+  UINT32                   ScratchArenaUsed;
+  //
+  // Total size of all scratch arena chunks.
+  //
+  UINT32                   ScratchArenaTotal;
   VOID                     *LinkBuffer;
   UINT32                   LinkBufferSize;
   //
+  // Parent vtables resolved in dependencies during linking.
+  // Shared across injected kexts and allocated on first use.
+  //
+  VOID                     *VtableCache;
+  //
   // Used for caching all prelinked kexts.
   // I.e. this contains kernel, injected kexts, and kexts used as dependencies.
   //
@@ -431,6 +459,11 @@ typedef struct {
   // Flag to indicate if above list is valid. List is built during the first read from SLE.
   //
   BOOLEAN               BuiltInKextsValid;
+  //
+  // Flag to indicate if built-in kext list matches a persisted index,
+  // either loaded from it or already saved to it.
+  //
+  BOOLEAN               BuiltInKextsIndexed;
 } CACHELESS_CONTEXT;
 
 //
@@ -475,8 +508,8 @@ typedef struct {
   //
   UINT32                    MkextInfoOffset;
   //
-  // Copy of mkext plist used for XML_DOCUMENT.
-  // Freed upon context destruction.
+  // Copy of mkext plist used for XML_DOCUMENT, followed by its unmodified
+  // copy for export. Freed upon context destruction.
   //
   UINT8                    *MkextInfo;
   //
@@ -491,6 +524,19 @@ typedef struct {
   // List of cached kexts, used for patching and blocking.
   //
   LIST_ENTRY               CachedKexts;
+  //
+  // Adler-32 of the original mkext data starting from Version field
+  // and excluding v2 plist, updated on in-place changes.
+  //
+  UINT32                   MkextChecksum;
+  //
+  // Size of the data covered by MkextChecksum.
+  //
+  UINT32                   MkextChecksumSize;
+  //
+  // Adler-32 of the header part covered by MkextChecksum at creation.
+  //
+  UINT32                   MkextHeaderChecksum;
 } MKEXT_CONTEXT;
 
 //
@@ -1166,6 +1212,45 @@ CachelessContextFree (
   IN OUT CACHELESS_CONTEXT    *Context
   );
 
+/**
+  Load built-in kext list from a persisted index, skipping the scan
+  of Extensions directory. The index is only accepted when it was built for
+  the same kernel version and Extensions directory modification time.
+  Indexed Info.plist and binary modification times and sizes are checked
+  by CachelessContextHookBuiltin only for the kexts it actually uses,
+  falling back to a full scan when any of them changed.
+  Must be called before the first CachelessContextHookBuiltin call.
+
+  @param[in,out] Context         Cacheless context.
+  @param[in]     Index           Index previously returned by CachelessContextExportIndex.
+  @param[in]     IndexSize       Index size.
+
+  @return  EFI_SUCCESS on success.
+**/
+EFI_STATUS
+CachelessContextLoadIndex (
+  IN OUT CACHELESS_CONTEXT    *Context,
+  IN     CONST VOID           *Index,
+  IN     UINT32               IndexSize
+  );
+
+/**
+  Export built-in kext list as an index to be persisted for the following
+  boots. Only valid once the list is built by CachelessContextHookBuiltin.
+
+  @param[in]     Context         Cacheless context.
+  @param[out]    Index           Index allocated from pool.
+  @param[out]    IndexSize       Index size.
+
+  @return  EFI_SUCCESS on success.
+**/
+EFI_STATUS
+CachelessContextExportIndex (
+  IN     CACHELESS_CONTEXT    *Context,
+     OUT VOID                 **Index,
+     OUT UINT32               *IndexSize
+  );
+
 /**
   Add kext to cacheless context to be injected later on.
 
@@ -1296,6 +1381,8 @@ CachelessContextHookBuiltin (
   Decompress mkext buffer while reserving space for injected kexts later on.
   Specifying zero for OutBufferSize will calculate the size of the
   buffer required for the decompressed mkext in OutMkextSize.
+  Entries are decompressed directly to their final location and
+  checksummed as they are written.
 
   @param[in]     Buffer               Mkext buffer.
   @param[in]     BufferSize           Mkext buffer size.
@@ -1339,7 +1426,8 @@ MkextCheckCpuType (
   Note that MkextAllocSize never changes, and is to be estimated.
 
   Mkext buffers cannot contain any compression, and should be run
-  through MkextDecompress first.
+  through MkextDecompress first. Mkext checksum is expected to be valid,
+  as it is only updated for the changed parts afterwards.
 
   @param[in,out] Context            Mkext context.
   @param[in,out] Mkext              Decompressed Mkext buffer.
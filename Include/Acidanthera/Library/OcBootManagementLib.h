@@ -31,6 +31,11 @@
 **/
 typedef struct OC_PICKER_CONTEXT_ OC_PICKER_CONTEXT;
 
+/**
+  Persistent boot entry scan cache state.
+**/
+typedef struct OC_SCAN_CACHE_ OC_SCAN_CACHE;
+
 /**
   Default strings for use in the interfaces.
 **/
@@ -252,6 +257,14 @@ struct OC_BOOT_FILESYSTEM_ {
   // Contains recovery on the filesystem.
   //
   BOOLEAN              HasSelfRecovery;
+  //
+  // Boot entries are restored from scan cache and await revalidation.
+  //
+  BOOLEAN              FromScanCache;
+  //
+  // Boot entries do not depend on BootOrder and can be stored in scan cache.
+  //
+  BOOLEAN              ScanCacheable;
 };
 
 /**
@@ -282,6 +295,28 @@ typedef struct OC_BOOT_CONTEXT_ {
   // Picker context for externally configured parameters.
   //
   OC_PICKER_CONTEXT           *PickerContext;
+  //
+  // Scan cache state, NULL when scan cache is not used.
+  //
+  OC_SCAN_CACHE               *ScanCacheState;
+  //
+  // Boot entry count on scanned filesystems, which are shown in the picker.
+  // Equals BootEntryCount once scanning is complete.
+  //
+  UINTN                       VisibleEntryCount;
+  //
+  // Next filesystem to scan, NULL once scanning is complete.
+  // Boot entries of the filesystems before it are visible.
+  //
+  LIST_ENTRY                  *PendingFileSystem;
+  //
+  // Filesystem for custom entries, inserted once scanning is complete.
+  //
+  OC_BOOT_FILESYSTEM          *PendingCustomFileSystem;
+  //
+  // Index of custom entry already created from BootOrder, MAX_UINT32 if none.
+  //
+  UINT32                      DefaultCustomIndex;
 } OC_BOOT_CONTEXT;
 
 /**
@@ -593,6 +628,26 @@ VOID
   IN  UINT32             File  OPTIONAL
   );
 
+/**
+  Scan next filesystem left pending by boot entry scanning.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *OC_SCAN_NEXT_FILE_SYSTEM) (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+     OUT OC_BOOT_FILESYSTEM  **FileSystem
+  );
+
+/**
+  Revalidate boot entries restored from scan cache.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *OC_REVALIDATE_BOOT_ENTRIES) (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+     OUT BOOLEAN          *Changed
+  );
+
 /**
   Picker behaviour action.
 **/
@@ -716,6 +771,10 @@ struct OC_PICKER_CONTEXT_ {
   //
   BOOLEAN                    HideAuxiliary;
   //
+  // Restore picker boot entries from the previous boot and revalidate them afterwards.
+  //
+  BOOLEAN                    ScanCache;
+  //
   // Enable audio assistant during picker playback.
   //
   BOOLEAN                    PickerAudioAssist;
@@ -752,6 +811,14 @@ struct OC_PICKER_CONTEXT_ {
   //
   OC_TOGGLE_VOICE_OVER       ToggleVoiceOver;
   //
+  // Scan next pending filesystem function.
+  //
+  OC_SCAN_NEXT_FILE_SYSTEM   ScanNextFileSystem;
+  //
+  // Revalidate boot entries restored from scan cache function.
+  //
+  OC_REVALIDATE_BOOT_ENTRIES RevalidateBootEntries;
+  //
   // Recovery initiator if present.
   //
   EFI_DEVICE_PATH_PROTOCOL   *RecoveryInitiator;
@@ -837,6 +904,9 @@ OcGetBootEntryIcon (
 
 /**
   Scan system for boot entries.
+  When the picker is to be shown, scanning stops once the default entry
+  is visible, and the remaining filesystems are left pending for
+  OcScanNextFileSystem. Filesystems on slow devices are scanned last.
 
   @param[in]  Context  Picker context.
 
@@ -847,6 +917,63 @@ OcScanForBootEntries (
   IN  OC_PICKER_CONTEXT  *Context
   );
 
+/**
+  Scan next filesystem left pending by OcScanForBootEntries.
+  Boot entries of the scanned filesystem become visible and are appended
+  to the end of the list returned by OcEnumerateEntries.
+  Custom entries are scanned last.
+
+  @param[in,out]  BootContext  Boot context from OcScanForBootEntries.
+  @param[out]     FileSystem   Scanned filesystem.
+
+  @retval EFI_SUCCESS    One filesystem was scanned.
+  @retval EFI_NOT_FOUND  Scanning is complete.
+**/
+EFI_STATUS
+EFIAPI
+OcScanNextFileSystem (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+     OUT OC_BOOT_FILESYSTEM  **FileSystem
+  );
+
+/**
+  Revalidate boot entries restored from scan cache on the next pending
+  filesystem. Changed entries replace the cached ones, which are preserved
+  until the boot context is freed, and the boot menu must be reloaded.
+  Scan cache is updated once all filesystems are revalidated or any
+  of them changed.
+
+  @param[in,out]  BootContext  Boot context from OcScanForBootEntries.
+  @param[out]     Changed      Set to TRUE when boot entries changed.
+
+  @retval EFI_SUCCESS    One filesystem was revalidated.
+  @retval EFI_NOT_READY  Filesystems are still pending scanning.
+  @retval EFI_NOT_FOUND  No filesystems await revalidation.
+**/
+EFI_STATUS
+EFIAPI
+OcRevalidateBootEntries (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+     OUT BOOLEAN          *Changed
+  );
+
+/**
+  Ensure that the chosen boot entry may be booted. Entries restored from
+  scan cache are revalidated synchronously on their filesystem first.
+
+  @param[in,out]  BootContext  Boot context from OcScanForBootEntries.
+  @param[in]      BootEntry    Chosen boot entry.
+
+  @retval EFI_SUCCESS    Boot entry is valid.
+  @retval EFI_NOT_FOUND  Boot entry is stale and the boot menu must be reloaded.
+**/
+EFI_STATUS
+EFIAPI
+OcRevalidateChosenEntry (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+  IN     OC_BOOT_ENTRY    *BootEntry
+  );
+
 /**
   Scan system for first entry to boot.
   This is likely to return an incomplete list and can even give NULL,
@@ -862,7 +989,8 @@ OcScanForDefaultBootEntry (
   );
 
 /**
-  Perform boot entry enumeration.
+  Perform boot entry enumeration. Only VisibleEntryCount entries
+  on already scanned filesystems are enumerated.
 
   @param[in]  BootContext    Boot context.
 
@@ -154,4 +154,46 @@ Adler32 (
   IN UINT32       BufferLen
   );
 
+/**
+  Updates Adler32 checksum with more data.
+  SIMD implementation is used when supported by the CPU.
+  @param[in]   Adler          Current checksum, 1 for empty data.
+  @param[in]   Buffer         Source buffer.
+  @param[in]   BufferLen      Source buffer size.
+  @return  Updated checksum.
+**/
+UINT32
+Adler32Update (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
+/**
+  Calculates CRC32 checksum with the polynomial used by zlib, PNG and GPT.
+  @param[in]   Buffer         Source buffer.
+  @param[in]   BufferLen      Source buffer size.
+  @return  Checksum.
+**/
+UINT32
+Crc32 (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
+/**
+  Updates CRC32 checksum with more data.
+  SIMD implementation is used when supported by the CPU.
+  @param[in]   Crc            Current checksum, 0 for empty data.
+  @param[in]   Buffer         Source buffer.
+  @param[in]   BufferLen      Source buffer size.
+  @return  Updated checksum.
+**/
+UINT32
+Crc32Update (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
 #endif // OC_COMPRESSION_LIB_H
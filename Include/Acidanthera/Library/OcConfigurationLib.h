@@ -56,6 +56,8 @@
 /// ACPI patches.
 ///
 #define OC_ACPI_PATCH_ENTRY_FIELDS(_, __) \
+  _(OC_STRING                   , Base             ,     , OC_STRING_CONSTR ("", _, __), OC_DESTR (OC_STRING) ) \
+  _(UINT32                      , BaseSkip         ,     , 0                           , ()                   ) \
   _(UINT32                      , Count            ,     , 0                           , ()                   ) \
   _(BOOLEAN                     , Enabled          ,     , FALSE                       , ()                   ) \
   _(OC_STRING                   , Comment          ,     , OC_STRING_CONSTR ("", _, __), OC_DESTR (OC_STRING) ) \
@@ -299,6 +301,7 @@
 /// KernelSpace operation scheme.
 ///
 #define OC_KERNEL_SCHEME_FIELDS(_, __) \
+  _(BOOLEAN                     , CachelessIndex   ,     , FALSE  , ()) \
   _(OC_STRING                   , KernelArch       ,     , OC_STRING_CONSTR ("Auto", _, __), OC_DESTR (OC_STRING)) \
   _(OC_STRING                   , KernelCache      ,     , OC_STRING_CONSTR ("Auto", _, __), OC_DESTR (OC_STRING)) \
   _(BOOLEAN                     , FuzzyMatch       ,     , FALSE  , ())
@@ -335,6 +338,7 @@
   _(BOOLEAN                     , PickerAudioAssist           ,     , FALSE                               , ())                   \
   _(BOOLEAN                     , HideAuxiliary               ,     , FALSE                               , ())                   \
   _(BOOLEAN                     , PollAppleHotKeys            ,     , FALSE                               , ())                   \
+  _(BOOLEAN                     , ScanCache                   ,     , FALSE                               , ())                   \
   _(BOOLEAN                     , ShowPicker                  ,     , FALSE                               , ())
   OC_DECLARE (OC_MISC_BOOT)
 
@@ -344,6 +348,7 @@
   _(UINT32                      , Target                      ,     , 0            , ()) \
   _(BOOLEAN                     , AppleDebug                  ,     , FALSE        , ()) \
   _(BOOLEAN                     , ApplePanic                  ,     , FALSE        , ()) \
+  _(BOOLEAN                     , BootTrace                   ,     , FALSE        , ()) \
   _(BOOLEAN                     , DisableWatchDog             ,     , FALSE        , ()) \
   _(BOOLEAN                     , SerialInit                  ,     , FALSE        , ()) \
   _(BOOLEAN                     , SysReport                   ,     , FALSE        , ())
@@ -378,7 +383,10 @@ typedef enum {
   _(OC_DATA                     , PasswordSalt                ,      , OC_EDATA_CONSTR (_, __) , OC_DESTR (OC_DATA)) \
   _(OC_STRING                   , SecureBootModel             ,      , OC_STRING_CONSTR ("Default", _, __), OC_DESTR (OC_STRING) ) \
   _(UINT64                      , ApECID                      ,      , 0                       , ()) \
-  _(UINT64                      , HaltLevel                   ,      , 0x80000000              , ())
+  _(UINT64                      , HaltLevel                   ,      , 0x80000000              , ()) \
+  _(BOOLEAN                     , VaultPrefetch               ,      , FALSE                   , ()) \
+  _(BOOLEAN                     , VaultPreload                ,      , FALSE                   , ()) \
+  _(BOOLEAN                     , StorageCache                ,      , FALSE                   , ())
   OC_DECLARE (OC_MISC_SECURITY)
 
 #define OC_MISC_TOOLS_ENTRY_FIELDS(_, __) \
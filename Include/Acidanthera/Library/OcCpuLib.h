@@ -215,4 +215,24 @@ OcGetTSCFrequency (
   VOID
   );
 
+/**
+  SIMD instruction set extensions reported by OcCpuGetSimdFeatures.
+**/
+#define OC_CPU_SIMD_SSE2       BIT0
+#define OC_CPU_SIMD_SSSE3      BIT1
+#define OC_CPU_SIMD_PCLMULQDQ  BIT2
+#define OC_CPU_SIMD_AVX2       BIT3
+
+/**
+  Obtain SIMD instruction set extensions usable on the current CPU.
+  AVX2 is only reported when the OS (firmware) enabled YMM state in XCR0.
+  The result is cached after the first call.
+
+  @retval OC_CPU_SIMD_* bitmask.
+**/
+UINT32
+OcCpuGetSimdFeatures (
+  VOID
+  );
+
 #endif // OC_CPU_LIB_H_
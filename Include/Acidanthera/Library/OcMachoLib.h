@@ -43,6 +43,12 @@ typedef struct {
   MACH_NLIST_ANY        *IndirectSymbolTable;
   MACH_RELOCATION_INFO  *LocalRelocations;
   MACH_RELOCATION_INFO  *ExternRelocations;
+  //
+  // Symbol name hash index, see MachoInitializeSymbolIndex.
+  //
+  UINT32                *SymbolIndex;
+  UINT32                SymbolIndexMask;
+  BOOLEAN               SymbolIndexBuilt;
 
   BOOLEAN               Is32Bit;
 } OC_MACHO_CONTEXT;
@@ -624,6 +630,7 @@ MachoSymbolIsLocalDefined64 (
 
 /**
   Retrieves a locally defined symbol by its name.
+  The symbol name hash index is used when it has been built.
 
   @param[in] Context  Context of the Mach-O.
   @param[in] Name     Name of the symbol to locate.
@@ -706,6 +713,53 @@ MachoGetSymbolByIndex64 (
   IN     UINT32            Index
   );
 
+/**
+  Builds the symbol name hash index of the Mach-O unless already attempted.
+  The index is used by MachoGetSymbolByName and
+  MachoGetLocalDefinedSymbolByName, and must be released with
+  MachoFreeSymbolIndex by the owner of Context.  Copies of Context made
+  after this call share the index and must not free it.
+
+  The index refers to symbols by their position, thus it must be freed
+  before the symbol table is modified or Context is reinitialized.
+
+  @param[in,out] Context  Context of the Mach-O.
+
+  @retval TRUE  The index is available.
+
+**/
+BOOLEAN
+MachoInitializeSymbolIndex (
+  IN OUT OC_MACHO_CONTEXT  *Context
+  );
+
+/**
+  Releases the symbol name hash index of the Mach-O if any.
+
+  @param[in,out] Context  Context of the Mach-O.
+
+**/
+VOID
+MachoFreeSymbolIndex (
+  IN OUT OC_MACHO_CONTEXT  *Context
+  );
+
+/**
+  Retrieves the first symbol with the given name in symbol table order.
+  The symbol name hash index is built on first use.
+
+  @param[in,out] Context  Context of the Mach-O.
+  @param[in]     Name     Name of the symbol to locate.
+
+  @retval NULL  NULL is returned on failure.
+
+**/
+MACH_NLIST_ANY *
+MachoGetSymbolByName (
+  IN OUT OC_MACHO_CONTEXT  *Context,
+  IN     CONST CHAR8       *Name
+  );
+
 /**
   Retrieves a Symbol's name.
 
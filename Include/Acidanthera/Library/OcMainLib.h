@@ -54,6 +54,8 @@
 
 #define OPEN_CORE_LOG_PREFIX_PATH  L"opencore"
 
+#define OPEN_CORE_SLE_INDEX_PATH   L"opencore-sle.bin"
+
 #define OPEN_CORE_NVRAM_PATH       L"nvram.plist"
 
 #define OPEN_CORE_ACPI_PATH        L"ACPI\\"
@@ -0,0 +1,69 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_PARALLEL_LIB_H
+#define OC_PARALLEL_LIB_H
+
+#include <Uefi.h>
+
+/**
+  Parallel job callback.
+
+  Jobs may be executed on application processors and therefore must be
+  pure computation over memory prepared in advance by the caller:
+  - No boot services, protocols, or memory allocation.
+  - No DEBUG output (the logger is not MP-safe).
+  - No writes to memory shared with other jobs without atomics.
+  - Safe to run again, as jobs interrupted by AP timeout are rerun on the BSP.
+
+  @param[in]      Index    Job index in [0, JobCount).
+  @param[in,out]  Context  Caller context shared by all jobs.
+**/
+typedef
+VOID
+(EFIAPI *OC_PARALLEL_JOB) (
+  IN     UINTN  Index,
+  IN OUT VOID   *Context
+  );
+
+/**
+  Get the number of processors available for running parallel jobs.
+  Must be called from the BSP.
+
+  @return  Number of processors, at least 1.
+**/
+UINTN
+OcParallelGetWorkerCount (
+  VOID
+  );
+
+/**
+  Execute JobCount jobs, distributing them over all enabled application
+  processors via EFI_MP_SERVICES_PROTOCOL. Jobs are split into per-processor
+  queues, and processors which finish early steal work from the others.
+  When MP services are unavailable jobs are run sequentially on the BSP.
+  Returns only after every job completed. Must be called from the BSP.
+
+  @param[in]      Job       Job callback.
+  @param[in,out]  Context   Caller context passed to every job.
+  @param[in]      JobCount  Number of jobs to run.
+**/
+VOID
+OcParallelRun (
+  IN     OC_PARALLEL_JOB  Job,
+  IN OUT VOID             *Context,
+  IN     UINTN            JobCount
+  );
+
+#endif // OC_PARALLEL_LIB_H
@@ -191,6 +191,58 @@ PeCoffLoadImage (
   IN     UINT32                 DestinationSize
   );
 
+/**
+  Check whether the Image can be loaded in place, i.e. within its raw file
+  buffer without a separate destination. This requires the raw file buffer
+  to be allocated from page memory, the Image Sections to reside at their
+  RVAs in the raw file, and the buffer to be large enough to hold the Image.
+
+  @param[in]  Context     The context describing the Image. Must have been
+                          initialised by PeCoffInitializeContext().
+  @param[in]  BufferSize  The size, in bytes, of the memory allocated for
+                          Context->FileBuffer.
+
+  @retval TRUE   The Image can be loaded in place.
+  @retval FALSE  The Image must be loaded with a separate destination.
+**/
+BOOLEAN
+PeCoffCanLoadInPlace (
+  IN CONST PE_COFF_IMAGE_CONTEXT  *Context,
+  IN UINT32                       BufferSize
+  );
+
+/**
+  Load the Image into the destination memory space and relocate it to the
+  destination address. When HashUpdate is not NULL, the Image is also hashed
+  using the Authenticode algorithm, and every raw file chunk is loaded right
+  after hashing it, so that the raw file is only swept once.
+
+  If Destination is Context->FileBuffer, the Image is loaded in place and
+  the raw file buffer is modified. In this case PeCoffCanLoadInPlace() must
+  have returned TRUE, and the raw file is hashed before it is modified.
+
+  @param[in]     Context          The context describing the Image. Must have
+                                  been initialised by PeCoffInitializeContext().
+  @param[out]    Destination      The Image destination memory. Must be
+                                  allocated from page memory. Refer to
+                                  PeCoffLoadImage() for size requirements.
+  @param[in]     DestinationSize  The size, in bytes, of Destination.
+  @param[in]     HashUpdate       The data hashing function, optional.
+  @param[in,out] HashContext      The context of the current hash, optional.
+
+  @retval RETURN_SUCCESS  The Image was loaded and relocated successfully.
+  @retval other           The Image could not be hashed, loaded, or relocated
+                          successfully.
+**/
+RETURN_STATUS
+PeCoffLoadRelocateImage (
+  IN OUT PE_COFF_IMAGE_CONTEXT  *Context,
+  OUT    VOID                   *Destination,
+  IN     UINT32                 DestinationSize,
+  IN     PE_COFF_HASH_UPDATE    HashUpdate OPTIONAL,
+  IN OUT VOID                   *HashContext OPTIONAL
+  );
+
 /**
   Discards optional Image Sections to disguise sensitive data.
 
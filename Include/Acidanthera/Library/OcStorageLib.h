@@ -56,6 +56,78 @@
   _(OC_STORAGE_VAULT_FILES      , Files    ,     , OC_CONSTR (OC_STORAGE_VAULT_FILES, _, __) , OC_DESTR (OC_STORAGE_VAULT_FILES))
   OC_DECLARE (OC_STORAGE_VAULT)
 
+/**
+  Number of storage file cache buckets.
+**/
+#define OC_STORAGE_CACHE_BUCKETS 64
+
+/**
+  Default verified file content cache limits.
+**/
+#define OC_STORAGE_CONTENT_CACHE_FILE_MAX  SIZE_256KB
+#define OC_STORAGE_CONTENT_CACHE_TOTAL_MAX SIZE_4MB
+
+/**
+  Storage file cache entry, describes a single path.
+**/
+typedef struct OC_STORAGE_CACHE_ENTRY_ OC_STORAGE_CACHE_ENTRY;
+struct OC_STORAGE_CACHE_ENTRY_ {
+  ///
+  /// Next entry in the bucket.
+  ///
+  OC_STORAGE_CACHE_ENTRY           *Next;
+  ///
+  /// Path hash.
+  ///
+  UINT32                           Hash;
+  ///
+  /// File path relative to storage root, follows the entry.
+  ///
+  CHAR16                           *Path;
+  ///
+  /// File opened by the last existence check and not read yet, owned by entry.
+  ///
+  EFI_FILE_PROTOCOL                *File;
+  ///
+  /// Verified file contents with double null termination, owned by entry.
+  ///
+  UINT8                            *Data;
+  ///
+  /// File size without null termination, valid with Data.
+  ///
+  UINT32                           Size;
+  ///
+  /// File is known to be missing.
+  ///
+  BOOLEAN                          Missing;
+  ///
+  /// Number of file opens avoided.
+  ///
+  UINT32                           OpensSaved;
+  ///
+  /// Number of bytes not read and hashed again.
+  ///
+  UINT64                           BytesSaved;
+};
+
+/**
+  Storage file read and verified in advance.
+**/
+typedef struct {
+  ///
+  /// Vault digest of the file, identifies the file.
+  ///
+  CONST UINT8                      *Digest;
+  ///
+  /// File contents with double null termination, NULL once handed over.
+  ///
+  UINT8                            *Buffer;
+  ///
+  /// File size without null termination.
+  ///
+  UINT32                           Size;
+} OC_STORAGE_PREFETCHED_FILE;
+
 /**
   Storage abstraction context
 **/
@@ -100,6 +172,39 @@ typedef struct {
   /// Vault status.
   ///
   BOOLEAN                          HasVault;
+  ///
+  /// Vault file lookup table with open addressing, owned by context.
+  /// Each slot contains vault file index plus one, or 0 when empty.
+  ///
+  UINT32                           *VaultIndex;
+  ///
+  /// Vault file lookup table size minus one, power of two minus one.
+  ///
+  UINT32                           VaultIndexMask;
+  ///
+  /// Files read and verified in advance, owned by context.
+  ///
+  OC_STORAGE_PREFETCHED_FILE       *Prefetched;
+  ///
+  /// Number of prefetched files.
+  ///
+  UINT32                           PrefetchedCount;
+  ///
+  /// File cache hashed by path, owned by context.
+  ///
+  OC_STORAGE_CACHE_ENTRY           *Cache[OC_STORAGE_CACHE_BUCKETS];
+  ///
+  /// Cache entry holding an open file, at most one to not exhaust handles.
+  ///
+  OC_STORAGE_CACHE_ENTRY           *OpenEntry;
+  ///
+  /// Maximum size of a single file in content cache, 0 when disabled.
+  ///
+  UINT32                           ContentCacheFileMax;
+  ///
+  /// Remaining content cache size.
+  ///
+  UINT32                           ContentCacheFree;
 } OC_STORAGE_CONTEXT;
 
 /**
@@ -134,13 +239,45 @@ OcStorageFree (
   IN OUT OC_STORAGE_CONTEXT            *Context
   );
 
+/**
+  Enable caching of verified file contents. Subsequent reads of cached
+  files return a copy without reading and hashing them again.
+  Content cache is disabled by default.
+
+  @param[in,out]  Context       Storage context.
+  @param[in]      FileSizeMax   Maximum size of a single file to cache.
+  @param[in]      TotalSizeMax  Maximum size of all cached files.
+**/
+VOID
+OcStorageEnableContentCache (
+  IN OUT OC_STORAGE_CONTEXT            *Context,
+  IN     UINT32                        FileSizeMax,
+  IN     UINT32                        TotalSizeMax
+  );
+
+/**
+  Read all vault files fitting into the content cache in vault order,
+  verify their digests while reading, and keep the verified contents
+  in the content cache. Subsequent reads of these files return a copy
+  without reading and hashing them again. Files failing verification
+  are not cached, so that the following read reports the error as usual.
+  Does nothing when storage has no vault or content cache is disabled.
+
+  @param[in,out]  Context       Storage context.
+**/
+VOID
+OcStoragePreloadVaultFiles (
+  IN OUT OC_STORAGE_CONTEXT            *Context
+  );
+
 /**
   Check whether file exists.
+  Results are cached, and the file opened is reused by the following read.
 
   @param[in]  Context      Storage context.
   @param[in]  FilePath     The full path to the file on the device.
 
-  @retval TRUE if file is present in vault or ondisk.
+  @retval TRUE if file is present in vault, or ondisk when there is no vault.
 **/
 BOOLEAN
 OcStorageExistsFileUnicode (
@@ -148,6 +285,48 @@ OcStorageExistsFileUnicode (
   IN  CONST CHAR16                     *FilePath
   );
 
+/**
+  Read multiple vault files from storage in advance. Vault digests of all
+  files are verified at once on every available processor, and subsequent
+  OcStorageReadFileUnicode calls hand over the verified contents without
+  reading or hashing them again. Files failing verification are dropped,
+  so that the following read reports the error as usual. Previously
+  prefetched files which were not read yet are released.
+  Does nothing when storage has no vault.
+
+  @param[in]  Context      Storage context.
+  @param[in]  FilePaths    Full paths to the files on the device.
+  @param[in]  FileCount    Number of files.
+**/
+VOID
+OcStoragePrefetchFilesUnicode (
+  IN  OC_STORAGE_CONTEXT               *Context,
+  IN  CHAR16                           **FilePaths,
+  IN  UINT32                           FileCount
+  );
+
+/**
+  Read multiple vault files from storage in advance like
+  OcStoragePrefetchFilesUnicode, building full paths from ASCII names.
+  Each path is Directory followed by the file name, and by the sub path
+  separated with a backslash when SubPaths are provided. Entries with
+  NULL or empty names are skipped, and slashes are converted to UEFI ones.
+
+  @param[in]  Context      Storage context.
+  @param[in]  Directory    Directory prefix with trailing backslash.
+  @param[in]  FileNames    File names relative to Directory.
+  @param[in]  SubPaths     File paths relative to FileNames, optional.
+  @param[in]  FileCount    Number of files.
+**/
+VOID
+OcStoragePrefetchFilesAscii (
+  IN  OC_STORAGE_CONTEXT               *Context,
+  IN  CONST CHAR16                     *Directory,
+  IN  CONST CHAR8                      **FileNames,
+  IN  CONST CHAR8                      **SubPaths   OPTIONAL,
+  IN  UINT32                           FileCount
+  );
+
 /**
   Read file from storage with implicit double (2 byte) null termination.
   Null termination does not affect the returned file size.
@@ -168,8 +347,29 @@ OcStorageReadFileUnicode (
   OUT UINT32                           *FileSize OPTIONAL
   );
 
+/**
+  Write file to storage file system relative to its root, creating
+  or replacing it. Cached existence and contents of the file are dropped
+  when it is within storage, so that subsequent accesses see the new file.
+
+  @param[in,out]  Context      Storage context.
+  @param[in]      FilePath     The full path to the file on the file system.
+  @param[in]      Buffer       File contents.
+  @param[in]      Size         File size.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+OcStorageWriteRootFileUnicode (
+  IN OUT OC_STORAGE_CONTEXT            *Context,
+  IN     CONST CHAR16                  *FilePath,
+  IN     CONST VOID                    *Buffer,
+  IN     UINT32                        Size
+  );
+
 /**
   Get information about the storage file when possible.
+  File cache statistics for the path are reported in the log.
 
   @param[in]  Context         Storage context.
   @param[in]  FilePath        The full path to the file on the device.
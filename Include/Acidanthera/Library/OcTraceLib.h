@@ -0,0 +1,162 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_TRACE_LIB_H
+#define OC_TRACE_LIB_H
+
+#include <Uefi.h>
+
+//
+// Boot trace record signature and version.
+//
+#define OC_TRACE_SIGNATURE  SIGNATURE_32 ('O', 'c', 'T', 'r')
+#define OC_TRACE_VERSION    1
+
+//
+// Maximum phase name size including the terminator, longer names are truncated.
+//
+#define OC_TRACE_NAME_SIZE  16
+
+//
+// Maximum number of distinct phases in the record.
+//
+#define OC_TRACE_MAX_NODES  96
+
+//
+// Maximum phase nesting level.
+//
+#define OC_TRACE_MAX_DEPTH  16
+
+#pragma pack(push, 1)
+
+/**
+  Boot trace record header, followed by NodeCount OC_TRACE_NODE entries.
+  The record is exported as opencore-trace variable.
+**/
+typedef struct {
+  ///
+  /// OC_TRACE_SIGNATURE.
+  ///
+  UINT32  Signature;
+  ///
+  /// OC_TRACE_VERSION.
+  ///
+  UINT16  Version;
+  ///
+  /// Number of nodes following the header.
+  ///
+  UINT16  NodeCount;
+  ///
+  /// Number of phases not recorded due to node or depth limits.
+  ///
+  UINT32  Dropped;
+  ///
+  /// Reserved, zero.
+  ///
+  UINT32  Reserved;
+  ///
+  /// Timestamp counter frequency in Hz, 0 when unknown.
+  ///
+  UINT64  Frequency;
+  ///
+  /// Timestamp of trace creation.
+  ///
+  UINT64  Start;
+} OC_TRACE_HEADER;
+
+/**
+  Boot trace node. Every node accumulates all runs of a phase with
+  the same name within the same parent phase.
+**/
+typedef struct {
+  ///
+  /// Phase name, null-terminated.
+  ///
+  CHAR8   Name[OC_TRACE_NAME_SIZE];
+  ///
+  /// Parent node index plus one, 0 for top-level phases.
+  ///
+  UINT16  Parent;
+  ///
+  /// Number of completed runs.
+  ///
+  UINT16  Count;
+  ///
+  /// Reserved, zero.
+  ///
+  UINT32  Reserved;
+  ///
+  /// Timestamp of the first run start.
+  ///
+  UINT64  First;
+  ///
+  /// Total timestamp ticks spent in completed runs.
+  ///
+  UINT64  Total;
+} OC_TRACE_NODE;
+
+#pragma pack(pop)
+
+/**
+  Configure boot tracing. Until configured, phases are only recorded within
+  the calling image. Enabling shares the record with other images, which
+  continue it, and allows exporting it. Disabling drops the record and turns
+  further calls in this image into no-ops.
+
+  @param[in]  Enable  Enable boot tracing.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+OcTraceConfigure (
+  IN BOOLEAN  Enable
+  );
+
+/**
+  Mark the beginning of a boot phase. Phases may be nested, and
+  a phase started within another phase is recorded as its child.
+  Tracing state is shared between all images using this library once enabled.
+
+  @param[in]  Name  Phase name, truncated to OC_TRACE_NAME_SIZE - 1 characters.
+**/
+VOID
+OcTraceBegin (
+  IN CONST CHAR8  *Name
+  );
+
+/**
+  Mark the end of a boot phase. Phases nested into this one and not yet
+  ended are ended as well. Does nothing if the phase is not running,
+  so it is safe to end a phase more than once.
+
+  @param[in]  Name  Phase name passed to OcTraceBegin.
+**/
+VOID
+OcTraceEnd (
+  IN CONST CHAR8  *Name
+  );
+
+/**
+  Export the boot trace record as a volatile opencore-trace variable.
+  Phases still running only report previously completed runs.
+
+  @retval EFI_SUCCESS      on success.
+  @retval EFI_NOT_STARTED  when tracing is not enabled.
+**/
+EFI_STATUS
+OcTraceSave (
+  VOID
+  );
+
+#endif // OC_TRACE_LIB_H
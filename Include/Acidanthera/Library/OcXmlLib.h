@@ -134,6 +134,22 @@ XmlDocumentParse (
   BOOLEAN  WithRefs
   );
 
+//
+// Provides an unmodified copy of the parsed buffer. Export then copies nodes,
+// which were not changed since parsing, verbatim from it instead of serialising
+// them, so that the cost scales with the amount of changes.
+//
+// @param Document  XML_DOCUMENT to update.
+// @param Source    Copy of the buffer passed to XmlDocumentParse made before
+//                  parsing, must stay valid while the document is exported.
+//                  NULL disables verbatim copying.
+//
+VOID
+XmlDocumentSetSource (
+  XML_DOCUMENT  *Document,
+  CONST CHAR8   *Source
+  );
+
 //
 // Exports parsed document into the buffer.
 //
@@ -152,6 +168,47 @@ XmlDocumentExport (
   BOOLEAN       PrependPlistInfo
   );
 
+//
+// Calculates exported document size without exporting it.
+//
+// @param Document          XML_DOCUMENT to export
+// @param Length            Resulting length of the export without trailing \0
+// @param Skip              N root levels before exporting, normally 0.
+// @param PrependPlistInfo  Prepend XML plist doc info to exported document.
+//
+// @return TRUE on success, FALSE when the size does not fit UINT32.
+//
+BOOLEAN
+XmlDocumentExportSize (
+  XML_DOCUMENT  *Document,
+  UINT32        *Length,
+  UINT32        Skip,
+  BOOLEAN       PrependPlistInfo
+  );
+
+//
+// Exports parsed document into caller-provided buffer, normally
+// sized with XmlDocumentExportSize.
+//
+// @param Document          XML_DOCUMENT to export
+// @param Buffer            Destination buffer.
+// @param BufferSize        Destination buffer size including room for trailing \0.
+// @param Length            Resulting length of the buffer without trailing \0 (optional)
+// @param Skip              N root levels before exporting, normally 0.
+// @param PrependPlistInfo  Prepend XML plist doc info to exported document.
+//
+// @return TRUE on success, FALSE when the buffer is too small.
+//
+BOOLEAN
+XmlDocumentExportToBuffer (
+  XML_DOCUMENT  *Document,
+  CHAR8         *Buffer,
+  UINT32        BufferSize,
+  UINT32        *Length,
+  UINT32        Skip,
+  BOOLEAN       PrependPlistInfo
+  );
+
 //
 // Frees all resources associated with the document. All XML_NODE
 // references obtained through the document will be invalidated.
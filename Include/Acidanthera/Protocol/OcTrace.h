@@ -0,0 +1,60 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_TRACE_PROTOCOL_H
+#define OC_TRACE_PROTOCOL_H
+
+#include <Library/OcTraceLib.h>
+
+#define OC_TRACE_PROTOCOL_REVISION  1
+
+//
+// OC_TRACE_PROTOCOL_GUID
+// 6E58CEEE-DB0D-45CA-BAD4-A959E26F2F2B
+//
+#define OC_TRACE_PROTOCOL_GUID  \
+  { 0x6E58CEEE, 0xDB0D, 0x45CA, \
+    { 0xBA, 0xD4, 0xA9, 0x59, 0xE2, 0x6F, 0x2F, 0x2B } }
+
+/**
+  Boot trace state shared by OcTraceLib instances of different images,
+  installed by the first image starting a phase. Not meant to be used directly.
+**/
+typedef struct {
+  ///
+  /// OC_TRACE_PROTOCOL_REVISION.
+  ///
+  UINT32           Revision;
+  ///
+  /// Number of running phases.
+  ///
+  UINT32           Depth;
+  ///
+  /// Node indices of running phases.
+  ///
+  UINT16           Stack[OC_TRACE_MAX_DEPTH];
+  ///
+  /// Start timestamps of running phases.
+  ///
+  UINT64           StackStart[OC_TRACE_MAX_DEPTH];
+  ///
+  /// Exported record, Nodes must follow Header.
+  ///
+  OC_TRACE_HEADER  Header;
+  OC_TRACE_NODE    Nodes[OC_TRACE_MAX_NODES];
+} OC_TRACE_PROTOCOL;
+
+extern EFI_GUID gOcTraceProtocolGuid;
+
+#endif // OC_TRACE_PROTOCOL_H
@@ -0,0 +1,749 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/OcDebugLogLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#include <IndustryStandard/AcpiAml.h>
+#include <IndustryStandard/Acpi.h>
+
+#include <Library/OcAcpiLib.h>
+
+//
+// Maximum supported namespace path depth.
+//
+#define ACPI_NAMESPACE_MAX_DEPTH  32
+
+//
+// Maximum supported term list nesting.
+//
+#define ACPI_NAMESPACE_MAX_NESTING  32
+
+typedef struct {
+  //
+  // Table data.
+  //
+  CONST UINT8        *Data;
+  //
+  // Namespace index being built.
+  //
+  OC_ACPI_NAMESPACE  *Namespace;
+  //
+  // Current scope path.
+  //
+  UINT32             Scope[ACPI_NAMESPACE_MAX_DEPTH];
+  //
+  // Current scope depth.
+  //
+  UINT32             ScopeDepth;
+  //
+  // Current term list nesting.
+  //
+  UINT32             Nesting;
+} ACPI_NAMESPACE_WALKER;
+
+STATIC
+BOOLEAN
+AcpiIsNameChar (
+  IN UINT8    Char,
+  IN BOOLEAN  Lead
+  )
+{
+  return (Char >= 'A' && Char <= 'Z')
+    || Char == '_'
+    || (!Lead && Char >= '0' && Char <= '9');
+}
+
+/**
+  Read AML PkgLength.
+
+  @param[in]  Data    Table data.
+  @param[in]  Offset  PkgLength offset.
+  @param[in]  End     Enclosing object end offset.
+  @param[out] PkgEnd  Package end offset.
+  @param[out] Next    Offset following PkgLength.
+
+  @return TRUE when package fits enclosing object.
+**/
+STATIC
+BOOLEAN
+AcpiReadPkgLength (
+  IN  CONST UINT8  *Data,
+  IN  UINT32       Offset,
+  IN  UINT32       End,
+  OUT UINT32       *PkgEnd,
+  OUT UINT32       *Next
+  )
+{
+  UINT32  Length;
+  UINT32  Count;
+  UINT32  Index;
+
+  if (Offset >= End) {
+    return FALSE;
+  }
+
+  Count = Data[Offset] >> 6U;
+  if (Offset + Count >= End) {
+    return FALSE;
+  }
+
+  if (Count == 0) {
+    Length = Data[Offset] & 0x3FU;
+  } else {
+    Length = Data[Offset] & 0x0FU;
+    for (Index = 0; Index < Count; ++Index) {
+      Length |= (UINT32) Data[Offset + 1 + Index] << (4U + 8U * Index);
+    }
+  }
+
+  *Next = Offset + 1 + Count;
+  if (Length < 1 + Count || Length > End - Offset) {
+    return FALSE;
+  }
+
+  *PkgEnd = Offset + Length;
+  return TRUE;
+}
+
+/**
+  Read AML NameString and resolve it against current scope.
+
+  @param[in]  Walker      Namespace walker.
+  @param[in]  Offset      NameString offset.
+  @param[in]  End         Enclosing object end offset.
+  @param[out] Path        Resolved path, at least ACPI_NAMESPACE_MAX_DEPTH segments.
+  @param[out] Depth       Resolved path depth.
+  @param[out] NameOffset  Offset of the last segment.
+  @param[out] Next        Offset following NameString.
+
+  @return TRUE on valid name.
+**/
+STATIC
+BOOLEAN
+AcpiReadNameString (
+  IN  ACPI_NAMESPACE_WALKER  *Walker,
+  IN  UINT32                 Offset,
+  IN  UINT32                 End,
+  OUT UINT32                 *Path,
+  OUT UINT32                 *Depth,
+  OUT UINT32                 *NameOffset,
+  OUT UINT32                 *Next
+  )
+{
+  CONST UINT8  *Data;
+  UINT32       Count;
+  UINT32       Index;
+
+  Data        = Walker->Data;
+  *NameOffset = Offset;
+
+  if (Offset >= End) {
+    return FALSE;
+  }
+
+  if (Data[Offset] == AML_ROOT_CHAR) {
+    *Depth = 0;
+    ++Offset;
+  } else {
+    *Depth = Walker->ScopeDepth;
+    CopyMem (Path, Walker->Scope, Walker->ScopeDepth * sizeof (Path[0]));
+    while (Offset < End && Data[Offset] == AML_PARENT_PREFIX_CHAR) {
+      if (*Depth == 0) {
+        return FALSE;
+      }
+      --(*Depth);
+      ++Offset;
+    }
+  }
+
+  if (Offset >= End) {
+    return FALSE;
+  }
+
+  //
+  // NullName is not used in declarations and references we need.
+  //
+  if (Data[Offset] == AML_ZERO_OP) {
+    return FALSE;
+  }
+
+  if (Data[Offset] == AML_DUAL_NAME_PREFIX) {
+    Count = 2;
+    ++Offset;
+  } else if (Data[Offset] == AML_MULTI_NAME_PREFIX) {
+    if (Offset + 1 >= End) {
+      return FALSE;
+    }
+    Count   = Data[Offset + 1];
+    Offset += 2;
+  } else {
+    Count = 1;
+  }
+
+  if (Count == 0
+    || Count > ACPI_NAMESPACE_MAX_DEPTH - *Depth
+    || Count * OC_ACPI_NAME_SIZE > End - Offset) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < Count; ++Index) {
+    if (!AcpiIsNameChar (Data[Offset], TRUE)
+      || !AcpiIsNameChar (Data[Offset + 1], FALSE)
+      || !AcpiIsNameChar (Data[Offset + 2], FALSE)
+      || !AcpiIsNameChar (Data[Offset + 3], FALSE)) {
+      return FALSE;
+    }
+
+    *NameOffset = Offset;
+    CopyMem (&Path[*Depth], &Data[Offset], sizeof (Path[0]));
+    ++(*Depth);
+    Offset += OC_ACPI_NAME_SIZE;
+  }
+
+  *Next = Offset;
+  return TRUE;
+}
+
+/**
+  Skip AML DataRefObject, only constant data and references are supported.
+
+  @param[in]  Walker  Namespace walker.
+  @param[in]  Offset  Object offset.
+  @param[in]  End     Enclosing object end offset.
+  @param[out] Next    Offset following the object.
+
+  @return TRUE on valid object.
+**/
+STATIC
+BOOLEAN
+AcpiSkipDataObject (
+  IN  ACPI_NAMESPACE_WALKER  *Walker,
+  IN  UINT32                 Offset,
+  IN  UINT32                 End,
+  OUT UINT32                 *Next
+  )
+{
+  CONST UINT8  *Data;
+  UINT32       Size;
+  UINT32       PkgEnd;
+  UINT32       Path[ACPI_NAMESPACE_MAX_DEPTH];
+  UINT32       Depth;
+  UINT32       NameOffset;
+
+  Data = Walker->Data;
+
+  if (Offset >= End) {
+    return FALSE;
+  }
+
+  switch (Data[Offset]) {
+    case AML_ZERO_OP:
+    case AML_ONE_OP:
+    case AML_ONES_OP:
+      Size = 1;
+      break;
+    case AML_BYTE_PREFIX:
+      Size = 1 + sizeof (UINT8);
+      break;
+    case AML_WORD_PREFIX:
+      Size = 1 + sizeof (UINT16);
+      break;
+    case AML_DWORD_PREFIX:
+      Size = 1 + sizeof (UINT32);
+      break;
+    case AML_QWORD_PREFIX:
+      Size = 1 + sizeof (UINT64);
+      break;
+    case AML_STRING_PREFIX:
+      for (Size = 1; Offset + Size < End && Data[Offset + Size] != '\0'; ++Size) {
+      }
+      ++Size;
+      break;
+    case AML_BUFFER_OP:
+    case AML_PACKAGE_OP:
+    case AML_VAR_PACKAGE_OP:
+      if (!AcpiReadPkgLength (Data, Offset + 1, End, &PkgEnd, Next)) {
+        return FALSE;
+      }
+      *Next = PkgEnd;
+      return TRUE;
+    case AML_EXT_OP:
+      if (Offset + 1 >= End || Data[Offset + 1] != AML_EXT_REVISION_OP) {
+        return FALSE;
+      }
+      Size = 2;
+      break;
+    default:
+      return AcpiReadNameString (Walker, Offset, End, Path, &Depth, &NameOffset, Next);
+  }
+
+  if (Size > End - Offset) {
+    return FALSE;
+  }
+
+  *Next = Offset + Size;
+  return TRUE;
+}
+
+STATIC
+EFI_STATUS
+AcpiAddNamespaceObject (
+  IN OUT ACPI_NAMESPACE_WALKER  *Walker,
+  IN     CONST UINT32           *Path,
+  IN     UINT32                 Depth,
+  IN     UINT32                 NameOffset,
+  IN     UINT32                 Offset,
+  IN     UINT32                 End
+  )
+{
+  OC_ACPI_NAMESPACE         *Namespace;
+  OC_ACPI_NAMESPACE_OBJECT  *Object;
+  VOID                      *NewBuffer;
+  UINT32                    NewCount;
+
+  Namespace = Walker->Namespace;
+
+  //
+  // Reopening root scope declares nothing.
+  //
+  if (Depth == 0) {
+    return EFI_SUCCESS;
+  }
+
+  if (Namespace->NumberOfObjects == Namespace->AllocatedObjects) {
+    NewCount  = Namespace->AllocatedObjects * 2 + 64;
+    NewBuffer = ReallocatePool (
+      Namespace->AllocatedObjects * sizeof (Namespace->Objects[0]),
+      NewCount * sizeof (Namespace->Objects[0]),
+      Namespace->Objects
+      );
+    if (NewBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Namespace->Objects          = NewBuffer;
+    Namespace->AllocatedObjects = NewCount;
+  }
+
+  if (Depth > Namespace->AllocatedSegments - Namespace->NumberOfSegments) {
+    NewCount  = Namespace->AllocatedSegments * 2 + 256;
+    NewBuffer = ReallocatePool (
+      Namespace->AllocatedSegments * sizeof (Namespace->Segments[0]),
+      NewCount * sizeof (Namespace->Segments[0]),
+      Namespace->Segments
+      );
+    if (NewBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Namespace->Segments          = NewBuffer;
+    Namespace->AllocatedSegments = NewCount;
+  }
+
+  Object             = &Namespace->Objects[Namespace->NumberOfObjects];
+  Object->Offset     = Offset;
+  Object->Length     = End - Offset;
+  Object->NameOffset = NameOffset;
+  Object->Path       = Namespace->NumberOfSegments;
+  Object->Depth      = Depth;
+
+  CopyMem (&Namespace->Segments[Object->Path], Path, Depth * sizeof (Path[0]));
+  Namespace->NumberOfSegments += Depth;
+  ++Namespace->NumberOfObjects;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Walk AML TermList and index namespace declarations within it.
+  Parsing stops at the first unsupported term, and the enclosing
+  object continues after the end of this list.
+
+  @param[in,out] Walker  Namespace walker.
+  @param[in]     Offset  TermList offset.
+  @param[in]     End     TermList end offset.
+
+  @return EFI_SUCCESS unless memory allocation failure.
+**/
+STATIC
+EFI_STATUS
+AcpiWalkTermList (
+  IN OUT ACPI_NAMESPACE_WALKER  *Walker,
+  IN     UINT32                 Offset,
+  IN     UINT32                 End
+  )
+{
+  EFI_STATUS   Status;
+  CONST UINT8  *Data;
+  UINT32       Path[ACPI_NAMESPACE_MAX_DEPTH];
+  UINT32       Depth;
+  UINT32       NameOffset;
+  UINT32       PkgEnd;
+  UINT32       Next;
+  UINT32       Extra;
+  UINT32       SavedScope[ACPI_NAMESPACE_MAX_DEPTH];
+  UINT32       SavedDepth;
+
+  Data = Walker->Data;
+
+  if (Walker->Nesting == ACPI_NAMESPACE_MAX_NESTING) {
+    return EFI_SUCCESS;
+  }
+
+  ++Walker->Nesting;
+
+  Status = EFI_SUCCESS;
+
+  while (Offset < End && !EFI_ERROR (Status)) {
+    switch (Data[Offset]) {
+      case AML_SCOPE_OP:
+      case AML_METHOD_OP:
+        if (!AcpiReadPkgLength (Data, Offset + 1, End, &PkgEnd, &Next)
+          || !AcpiReadNameString (Walker, Next, PkgEnd, Path, &Depth, &NameOffset, &Next)) {
+          Offset = End;
+          break;
+        }
+
+        if (Data[Offset] == AML_SCOPE_OP) {
+          Status = AcpiAddNamespaceObject (Walker, Path, Depth, NameOffset, Next, PkgEnd);
+          if (!EFI_ERROR (Status)) {
+            CopyMem (SavedScope, Walker->Scope, sizeof (SavedScope));
+            SavedDepth = Walker->ScopeDepth;
+            CopyMem (Walker->Scope, Path, Depth * sizeof (Path[0]));
+            Walker->ScopeDepth = Depth;
+            Status = AcpiWalkTermList (Walker, Next, PkgEnd);
+            CopyMem (Walker->Scope, SavedScope, sizeof (SavedScope));
+            Walker->ScopeDepth = SavedDepth;
+          }
+        } else if (Next < PkgEnd) {
+          //
+          // Skip MethodFlags, method body is not walked.
+          //
+          Status = AcpiAddNamespaceObject (Walker, Path, Depth, NameOffset, Next + 1, PkgEnd);
+        }
+
+        Offset = PkgEnd;
+        break;
+
+      case AML_NAME_OP:
+        if (!AcpiReadNameString (Walker, Offset + 1, End, Path, &Depth, &NameOffset, &Next)
+          || !AcpiSkipDataObject (Walker, Next, End, &PkgEnd)) {
+          Offset = End;
+          break;
+        }
+
+        Status = AcpiAddNamespaceObject (Walker, Path, Depth, NameOffset, Next, PkgEnd);
+        Offset = PkgEnd;
+        break;
+
+      case AML_ALIAS_OP:
+        if (!AcpiReadNameString (Walker, Offset + 1, End, Path, &Depth, &NameOffset, &Next)
+          || !AcpiReadNameString (Walker, Next, End, Path, &Depth, &NameOffset, &Offset)) {
+          Offset = End;
+        }
+        break;
+
+      case AML_EXTERNAL_OP:
+        if (!AcpiReadNameString (Walker, Offset + 1, End, Path, &Depth, &NameOffset, &Next)
+          || End - Next < 2) {
+          Offset = End;
+          break;
+        }
+
+        //
+        // Skip ObjectType and ArgumentCount.
+        //
+        Offset = Next + 2;
+        break;
+
+      case AML_IF_OP:
+      case AML_ELSE_OP:
+      case AML_WHILE_OP:
+        //
+        // Conditional blocks are skipped as a whole, as their predicates are not parsed.
+        //
+        if (!AcpiReadPkgLength (Data, Offset + 1, End, &PkgEnd, &Next)) {
+          Offset = End;
+          break;
+        }
+
+        Offset = PkgEnd;
+        break;
+
+      case AML_EXT_OP:
+        if (Offset + 1 >= End) {
+          Offset = End;
+          break;
+        }
+
+        switch (Data[Offset + 1]) {
+          case AML_EXT_DEVICE_OP:
+          case AML_EXT_PROCESSOR_OP:
+          case AML_EXT_POWER_RES_OP:
+          case AML_EXT_THERMAL_ZONE_OP:
+            if (!AcpiReadPkgLength (Data, Offset + 2, End, &PkgEnd, &Next)
+              || !AcpiReadNameString (Walker, Next, PkgEnd, Path, &Depth, &NameOffset, &Next)) {
+              Offset = End;
+              break;
+            }
+
+            //
+            // Processor has ProcID, PblkAddr, and PblkLen.
+            // PowerResource has SystemLevel and ResourceOrder.
+            //
+            if (Data[Offset + 1] == AML_EXT_PROCESSOR_OP) {
+              Extra = sizeof (UINT8) + sizeof (UINT32) + sizeof (UINT8);
+            } else if (Data[Offset + 1] == AML_EXT_POWER_RES_OP) {
+              Extra = sizeof (UINT8) + sizeof (UINT16);
+            } else {
+              Extra = 0;
+            }
+
+            if (Extra > PkgEnd - Next) {
+              Offset = End;
+              break;
+            }
+
+            Next  += Extra;
+            Status = AcpiAddNamespaceObject (Walker, Path, Depth, NameOffset, Next, PkgEnd);
+            if (!EFI_ERROR (Status)) {
+              CopyMem (SavedScope, Walker->Scope, sizeof (SavedScope));
+              SavedDepth = Walker->ScopeDepth;
+              CopyMem (Walker->Scope, Path, Depth * sizeof (Path[0]));
+              Walker->ScopeDepth = Depth;
+              Status = AcpiWalkTermList (Walker, Next, PkgEnd);
+              CopyMem (Walker->Scope, SavedScope, sizeof (SavedScope));
+              Walker->ScopeDepth = SavedDepth;
+            }
+
+            Offset = PkgEnd;
+            break;
+
+          case AML_EXT_FIELD_OP:
+          case AML_EXT_INDEX_FIELD_OP:
+          case AML_EXT_BANK_FIELD_OP:
+            if (!AcpiReadPkgLength (Data, Offset + 2, End, &PkgEnd, &Next)) {
+              Offset = End;
+              break;
+            }
+
+            Offset = PkgEnd;
+            break;
+
+          case AML_EXT_REGION_OP:
+            //
+            // RegionSpace is followed by RegionOffset and RegionLen,
+            // which are expected to be constants or references.
+            //
+            if (!AcpiReadNameString (Walker, Offset + 2, End, Path, &Depth, &NameOffset, &Next)
+              || Next >= End
+              || !AcpiSkipDataObject (Walker, Next + 1, End, &Next)
+              || !AcpiSkipDataObject (Walker, Next, End, &Offset)) {
+              Offset = End;
+            }
+            break;
+
+          case AML_EXT_MUTEX_OP:
+            if (!AcpiReadNameString (Walker, Offset + 2, End, Path, &Depth, &NameOffset, &Next)
+              || Next >= End) {
+              Offset = End;
+              break;
+            }
+
+            //
+            // Skip SyncFlags.
+            //
+            Offset = Next + 1;
+            break;
+
+          case AML_EXT_EVENT_OP:
+            if (!AcpiReadNameString (Walker, Offset + 2, End, Path, &Depth, &NameOffset, &Offset)) {
+              Offset = End;
+            }
+            break;
+
+          default:
+            Offset = End;
+            break;
+        }
+        break;
+
+      default:
+        //
+        // Other terms are not supported.
+        //
+        Offset = End;
+        break;
+    }
+  }
+
+  --Walker->Nesting;
+
+  return Status;
+}
+
+EFI_STATUS
+AcpiBuildNamespace (
+  IN  CONST EFI_ACPI_DESCRIPTION_HEADER  *Table,
+  OUT OC_ACPI_NAMESPACE                  *Namespace
+  )
+{
+  EFI_STATUS             Status;
+  ACPI_NAMESPACE_WALKER  *Walker;
+
+  ZeroMem (Namespace, sizeof (*Namespace));
+
+  if (Table->Length < sizeof (EFI_ACPI_DESCRIPTION_HEADER)
+    || (Table->Signature != EFI_ACPI_6_2_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE
+      && Table->Signature != EFI_ACPI_6_2_SECONDARY_SYSTEM_DESCRIPTION_TABLE_SIGNATURE)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Walker = AllocateZeroPool (sizeof (*Walker));
+  if (Walker == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Walker->Data      = (CONST UINT8 *) Table;
+  Walker->Namespace = Namespace;
+
+  Status = AcpiWalkTermList (Walker, sizeof (EFI_ACPI_DESCRIPTION_HEADER), Table->Length);
+
+  FreePool (Walker);
+
+  if (EFI_ERROR (Status)) {
+    AcpiFreeNamespace (Namespace);
+  }
+
+  return Status;
+}
+
+VOID
+AcpiFreeNamespace (
+  IN OUT OC_ACPI_NAMESPACE  *Namespace
+  )
+{
+  if (Namespace->Objects != NULL) {
+    FreePool (Namespace->Objects);
+  }
+
+  if (Namespace->Segments != NULL) {
+    FreePool (Namespace->Segments);
+  }
+
+  ZeroMem (Namespace, sizeof (*Namespace));
+}
+
+CONST OC_ACPI_NAMESPACE_OBJECT *
+AcpiFindNamespaceObject (
+  IN CONST OC_ACPI_NAMESPACE  *Namespace,
+  IN CONST CHAR8              *Path,
+  IN UINT32                   Skip
+  )
+{
+  UINT32  Segments[ACPI_NAMESPACE_MAX_DEPTH];
+  UINT32  Depth;
+  UINT32  Index;
+  CHAR8   *Segment;
+
+  //
+  // Parse path into segments padding them with underscores, e.g.
+  // \_SB.PCI0.EC becomes _SB_, PCI0, EC__.
+  //
+  if (*Path == '\\') {
+    ++Path;
+  }
+
+  Depth = 0;
+  while (*Path != '\0') {
+    if (Depth == ACPI_NAMESPACE_MAX_DEPTH) {
+      return NULL;
+    }
+
+    Segment = (CHAR8 *) &Segments[Depth];
+    for (Index = 0; Index < OC_ACPI_NAME_SIZE && *Path != '.' && *Path != '\0'; ++Index, ++Path) {
+      if (!AcpiIsNameChar ((UINT8) *Path, Index == 0)) {
+        return NULL;
+      }
+
+      Segment[Index] = *Path;
+    }
+
+    if (Index == 0 || (*Path != '.' && *Path != '\0')) {
+      return NULL;
+    }
+
+    while (Index < OC_ACPI_NAME_SIZE) {
+      Segment[Index++] = '_';
+    }
+
+    ++Depth;
+
+    if (*Path == '.') {
+      ++Path;
+      if (*Path == '\0') {
+        return NULL;
+      }
+    }
+  }
+
+  if (Depth == 0) {
+    return NULL;
+  }
+
+  for (Index = 0; Index < Namespace->NumberOfObjects; ++Index) {
+    if (Namespace->Objects[Index].Depth == Depth
+      && Namespace->Segments[Namespace->Objects[Index].Path + Depth - 1] == Segments[Depth - 1]
+      && CompareMem (
+        &Namespace->Segments[Namespace->Objects[Index].Path],
+        Segments,
+        Depth * sizeof (Segments[0])
+        ) == 0) {
+      if (Skip == 0) {
+        return &Namespace->Objects[Index];
+      }
+
+      --Skip;
+    }
+  }
+
+  return NULL;
+}
+
+BOOLEAN
+AcpiNamespaceIsValid (
+  IN CONST OC_ACPI_NAMESPACE            *Namespace,
+  IN CONST EFI_ACPI_DESCRIPTION_HEADER  *Table
+  )
+{
+  UINT32                          Index;
+  CONST OC_ACPI_NAMESPACE_OBJECT  *Object;
+
+  for (Index = 0; Index < Namespace->NumberOfObjects; ++Index) {
+    Object = &Namespace->Objects[Index];
+    if (CompareMem (
+      (CONST UINT8 *) Table + Object->NameOffset,
+      &Namespace->Segments[Object->Path + Object->Depth - 1],
+      OC_ACPI_NAME_SIZE
+      ) != 0) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
@@ -823,6 +823,8 @@ AcpiFreeContext (
   IN OUT OC_ACPI_CONTEXT  *Context
   )
 {
+  AcpiFlushPatches (Context);
+
   if (Context->Tables != NULL) {
     FreePool (Context->Tables);
     Context->Tables = NULL;
@@ -847,6 +849,8 @@ AcpiApplyContext (
   EFI_PHYSICAL_ADDRESS  Table;
   UINT32                TablePrintSignature;
 
+  AcpiFlushPatches (Context);
+
   XsdtSize = Context->Xsdt == NULL ? 0 : sizeof (*Context->Xsdt) + sizeof (Context->Xsdt->Tables[0]) * Context->NumberOfTables;
   RsdtSize = Context->Rsdt == NULL ? 0 : sizeof (*Context->Rsdt) + sizeof (Context->Rsdt->Tables[0]) * Context->NumberOfTables;
   Size     = ALIGN_VALUE (XsdtSize, sizeof (UINT64)) + ALIGN_VALUE (RsdtSize, sizeof (UINT64));
@@ -964,6 +968,8 @@ AcpiDeleteTable (
   Index = 0;
   Found = FALSE;
 
+  AcpiFlushPatches (Context);
+
   while (Index < Context->NumberOfTables) {
     if ((Signature == 0 || Context->Tables[Index]->Signature == Signature)
       && (Length == 0 || Context->Tables[Index]->Length == Length)) {
@@ -1039,6 +1045,8 @@ AcpiInsertTable (
     return EFI_INVALID_PARAMETER;
   }
 
+  AcpiFlushPatches (Context);
+
   ReplaceDsdt = Common->Signature == EFI_ACPI_6_2_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE;
 
   if (ReplaceDsdt && (Context->Dsdt == NULL || Context->Fadt == NULL)) {
@@ -1145,6 +1153,167 @@ AcpiNormalizeHeaders (
   }
 }
 
+/**
+  Get patching state for the table, allocating it if needed.
+
+  @param Context  ACPI library context.
+  @param Table    ACPI table.
+
+  @return table state or NULL on allocation failure.
+**/
+STATIC
+OC_ACPI_PATCHED_TABLE *
+AcpiGetPatchedTable (
+  IN OUT OC_ACPI_CONTEXT         *Context,
+  IN     EFI_ACPI_COMMON_HEADER  *Table
+  )
+{
+  UINT32                 Index;
+  OC_ACPI_PATCHED_TABLE  *NewTables;
+
+  for (Index = 0; Index < Context->NumberOfPatchedTables; ++Index) {
+    if (Context->PatchedTables[Index].Table == Table) {
+      return &Context->PatchedTables[Index];
+    }
+  }
+
+  if (Context->NumberOfPatchedTables == Context->AllocatedPatchedTables) {
+    NewTables = AllocatePool ((Context->AllocatedPatchedTables + 8) * sizeof (Context->PatchedTables[0]));
+    if (NewTables == NULL) {
+      return NULL;
+    }
+
+    if (Context->PatchedTables != NULL) {
+      CopyMem (NewTables, Context->PatchedTables, Context->NumberOfPatchedTables * sizeof (Context->PatchedTables[0]));
+      FreePool (Context->PatchedTables);
+    }
+
+    Context->PatchedTables = NewTables;
+    Context->AllocatedPatchedTables += 8;
+  }
+
+  Context->PatchedTables[Context->NumberOfPatchedTables].Table     = Table;
+  Context->PatchedTables[Context->NumberOfPatchedTables].Namespace = NULL;
+  Context->PatchedTables[Context->NumberOfPatchedTables].Modified  = FALSE;
+
+  return &Context->PatchedTables[Context->NumberOfPatchedTables++];
+}
+
+/**
+  Apply ACPI patch to a single writable table.
+
+  @param Context       ACPI library context.
+  @param Table         ACPI table.
+  @param Patch         ACPI patch.
+  @param SearchLength  Number of bytes searched.
+
+  @return number of replaced occurrences.
+**/
+STATIC
+UINT32
+AcpiApplyTablePatch (
+  IN OUT OC_ACPI_CONTEXT         *Context,
+  IN OUT EFI_ACPI_COMMON_HEADER  *Table,
+  IN     OC_ACPI_PATCH           *Patch,
+     OUT UINT32                  *SearchLength
+  )
+{
+  EFI_STATUS                      Status;
+  OC_ACPI_PATCHED_TABLE           *State;
+  CONST OC_ACPI_NAMESPACE_OBJECT  *Object;
+  UINT8                           *Data;
+  UINT32                          Length;
+  UINT32                          ReplaceCount;
+  UINT32                          TablePrintSignature;
+
+  State  = AcpiGetPatchedTable (Context, Table);
+  Data   = (UINT8 *) Table;
+  Length = Table->Length;
+
+  if (Patch->Base != NULL) {
+    //
+    // Namespace index is built once per table and reused by all patches.
+    //
+    Object = NULL;
+    if (State != NULL && State->Namespace == NULL
+      && Table->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+      State->Namespace = AllocatePool (sizeof (*State->Namespace));
+      if (State->Namespace != NULL) {
+        Status = AcpiBuildNamespace ((EFI_ACPI_DESCRIPTION_HEADER *) Table, State->Namespace);
+        if (EFI_ERROR (Status)) {
+          FreePool (State->Namespace);
+          State->Namespace = NULL;
+        } else {
+          TablePrintSignature = AcpiReadSignature (Table);
+          DEBUG ((
+            DEBUG_INFO,
+            "OCA: Indexed %u objects in %.4a (OEM %016Lx) of %u bytes\n",
+            State->Namespace->NumberOfObjects,
+            (CHAR8 *) &TablePrintSignature,
+            AcpiReadOemTableId (Table),
+            Table->Length
+            ));
+        }
+      }
+    }
+
+    if (State != NULL && State->Namespace != NULL) {
+      Object = AcpiFindNamespaceObject (State->Namespace, Patch->Base, Patch->BaseSkip);
+    }
+
+    if (Object == NULL) {
+      *SearchLength = 0;
+      return 0;
+    }
+
+    Data  += Object->Offset;
+    Length = Object->Length;
+  }
+
+  if (Patch->Limit > 0 && Patch->Limit < Length) {
+    Length = Patch->Limit;
+  }
+
+  *SearchLength = Length;
+
+  ReplaceCount = ApplyPatch (
+    Patch->Find,
+    Patch->Mask,
+    Patch->Size,
+    Patch->Replace,
+    Patch->ReplaceMask,
+    Data,
+    Length,
+    Patch->Count,
+    Patch->Skip
+    );
+
+  if (ReplaceCount == 0) {
+    return 0;
+  }
+
+  if (State == NULL) {
+    if (Table->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+      AcpiRefreshTableChecksum ((EFI_ACPI_DESCRIPTION_HEADER *) Table);
+    }
+    return ReplaceCount;
+  }
+
+  State->Modified = TRUE;
+
+  //
+  // Patches are size-preserving, so the index only goes stale when names get renamed.
+  //
+  if (State->Namespace != NULL
+    && !AcpiNamespaceIsValid (State->Namespace, (EFI_ACPI_DESCRIPTION_HEADER *) Table)) {
+    AcpiFreeNamespace (State->Namespace);
+    FreePool (State->Namespace);
+    State->Namespace = NULL;
+  }
+
+  return ReplaceCount;
+}
+
 EFI_STATUS
 AcpiApplyPatch (
   IN OUT OC_ACPI_CONTEXT  *Context,
@@ -1159,17 +1328,20 @@ AcpiApplyPatch (
   UINT32                  TablePrintSignature;
   EFI_ACPI_COMMON_HEADER  *NewTable;
 
-  DEBUG ((DEBUG_INFO, "OCA: Applying %u byte ACPI patch skip %u, count %u\n", Patch->Size, Patch->Skip, Patch->Count));
+  DEBUG ((
+    DEBUG_INFO,
+    "OCA: Applying %u byte ACPI patch skip %u, count %u, base %a skip %u\n",
+    Patch->Size,
+    Patch->Skip,
+    Patch->Count,
+    Patch->Base != NULL ? Patch->Base : "<none>",
+    Patch->BaseSkip
+    ));
 
   if (Context->Dsdt != NULL
     && (Patch->TableSignature == 0 || Patch->TableSignature == EFI_ACPI_6_2_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE)
     && (Patch->TableLength == 0 || Context->Dsdt->Length == Patch->TableLength)
     && (Patch->OemTableId == 0 || Context->Dsdt->OemTableId == Patch->OemTableId)) {
-    ReplaceLimit = Patch->Limit;
-    if (ReplaceLimit == 0) {
-      ReplaceLimit = Context->Dsdt->Length;
-    }
-
     if (!AcpiIsTableWritable ((EFI_ACPI_COMMON_HEADER *) Context->Dsdt)) {
       Status = AcpiAllocateCopyDsdt (Context, NULL);
       if (EFI_ERROR (Status)) {
@@ -1177,16 +1349,11 @@ AcpiApplyPatch (
       }
     }
 
-    ReplaceCount = ApplyPatch (
-      Patch->Find,
-      Patch->Mask,
-      Patch->Size,
-      Patch->Replace,
-      Patch->ReplaceMask,
-      (UINT8 *) Context->Dsdt,
-      ReplaceLimit,
-      Patch->Count,
-      Patch->Skip
+    ReplaceCount = AcpiApplyTablePatch (
+      Context,
+      (EFI_ACPI_COMMON_HEADER *) Context->Dsdt,
+      Patch,
+      &ReplaceLimit
       );
 
     DEBUG ((
@@ -1197,12 +1364,6 @@ AcpiApplyPatch (
       ReplaceCount,
       Patch->Count
       ));
-
-    if (ReplaceCount > 0) {
-      AcpiRefreshTableChecksum (Context->Dsdt);
-
-
-    }
   }
 
   for (Index = 0; Index < Context->NumberOfTables; ++Index) {
@@ -1219,11 +1380,6 @@ AcpiApplyPatch (
         continue;
       }
 
-      ReplaceLimit = Patch->Limit;
-      if (ReplaceLimit == 0) {
-        ReplaceLimit = Context->Tables[Index]->Length;
-      }
-
       if (!AcpiIsTableWritable (Context->Tables[Index])) {
         Status = AcpiAllocateCopyTable (Context->Tables[Index], 0, &NewTable);
         if (EFI_ERROR (Status)) {
@@ -1232,16 +1388,11 @@ AcpiApplyPatch (
         Context->Tables[Index] = NewTable;
       }
 
-      ReplaceCount = ApplyPatch (
-        Patch->Find,
-        Patch->Mask,
-        Patch->Size,
-        Patch->Replace,
-        Patch->ReplaceMask,
-        (UINT8 *) Context->Tables[Index],
-        ReplaceLimit,
-        Patch->Count,
-        Patch->Skip
+      ReplaceCount = AcpiApplyTablePatch (
+        Context,
+        Context->Tables[Index],
+        Patch,
+        &ReplaceLimit
         );
 
       TablePrintSignature = AcpiReadSignature (Context->Tables[Index]);
@@ -1258,16 +1409,45 @@ AcpiApplyPatch (
         ReplaceCount,
         Patch->Count
         ));
-
-      if (ReplaceCount > 0 && Context->Tables[Index]->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
-        AcpiRefreshTableChecksum ((EFI_ACPI_DESCRIPTION_HEADER *) Context->Tables[Index]);
-      }
     }
   }
 
   return EFI_SUCCESS;
 }
 
+VOID
+AcpiFlushPatches (
+  IN OUT OC_ACPI_CONTEXT  *Context
+  )
+{
+  UINT32                 Index;
+  OC_ACPI_PATCHED_TABLE  *State;
+
+  for (Index = 0; Index < Context->NumberOfPatchedTables; ++Index) {
+    State = &Context->PatchedTables[Index];
+
+    //
+    // Refresh checksum once per table regardless of the amount of patches applied.
+    //
+    if (State->Modified && State->Table->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+      AcpiRefreshTableChecksum ((EFI_ACPI_DESCRIPTION_HEADER *) State->Table);
+    }
+
+    if (State->Namespace != NULL) {
+      AcpiFreeNamespace (State->Namespace);
+      FreePool (State->Namespace);
+    }
+  }
+
+  if (Context->PatchedTables != NULL) {
+    FreePool (Context->PatchedTables);
+    Context->PatchedTables = NULL;
+  }
+
+  Context->NumberOfPatchedTables  = 0;
+  Context->AllocatedPatchedTables = 0;
+}
+
 EFI_STATUS
 AcpiLoadRegions (
   IN OUT OC_ACPI_CONTEXT  *Context
@@ -0,0 +1,126 @@
+/** @file
+  Copyright (C) 2020, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "OcApfsInternal.h"
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcCpuLib.h>
+
+UINT64
+InternalApfsFletcher64 (
+  IN CONST VOID  *Data,
+  IN UINTN       DataSize
+  )
+{
+  CONST UINT32  *Walker;
+  CONST UINT32  *WalkerEnd;
+  UINT64        Sum1;
+  UINT64        Sum2;
+  UINT32        Rem;
+#if APFS_HAS_SIMD
+  UINT32        Features;
+  UINTN         Count;
+#endif
+
+  //
+  // For APFS we have the following guarantees (checked outside).
+  // - DataSize is always divisible by 4 (UINT32), the only potential exceptions
+  //   are multiples of block sizes of 1 and 2, which we do not support and filter out.
+  // - DataSize is always between 0x1000-8 and 0x10000-8, i.e. within UINT16.
+  //
+  ASSERT (DataSize >= APFS_NX_MINIMUM_BLOCK_SIZE - sizeof (UINT64));
+  ASSERT (DataSize <= APFS_NX_MAXIMUM_BLOCK_SIZE - sizeof (UINT64));
+  ASSERT (DataSize % sizeof (UINT32) == 0);
+
+  Sum1 = 0;
+  Sum2 = 0;
+
+  Walker     = Data;
+  WalkerEnd  = Walker + DataSize / sizeof (UINT32);
+
+#if APFS_HAS_SIMD
+  //
+  // Kernels produce the same unreduced sums as the loop below, which
+  // then handles the remaining words.
+  //
+  Features = OcCpuGetSimdFeatures ();
+  Count    = DataSize / sizeof (UINT32);
+
+  if ((Features & OC_CPU_SIMD_AVX2) != 0) {
+    Count -= Count % APFS_FLETCHER64_AVX2_WORDS;
+    InternalApfsFletcher64Avx2 (Walker, Count, &Sum1, &Sum2);
+    Walker += Count;
+  } else if ((Features & OC_CPU_SIMD_SSE2) != 0) {
+    Count -= Count % APFS_FLETCHER64_SSE2_WORDS;
+    InternalApfsFletcher64Sse2 (Walker, Count, &Sum1, &Sum2);
+    Walker += Count;
+  }
+#endif
+
+  //
+  // Do usual Fletcher-64 rounds without modulo due to impossible overflow.
+  //
+  while (Walker < WalkerEnd) {
+    //
+    // Sum1 never overflows, because 0xFFFFFFFF * (0x10000-8) < MAX_UINT64.
+    // This is just a normal sum of data values.
+    //
+    Sum1 += *Walker;
+    //
+    // Sum2 never overflows, because 0xFFFFFFFF * (0x4000-1) * 0x1FFF < MAX_UINT64.
+    // This is just a normal arithmetical progression of sums.
+    //
+    Sum2 += Sum1;
+    ++Walker;
+  }
+
+  //
+  // Split Fletcher-64 halves.
+  // As per Chinese remainder theorem, perform the modulo now.
+  // No overflows also possible as seen from Sum1/Sum2 upper bounds above.
+  //
+
+  Sum2 += Sum1;
+  APFS_MOD_MAX_UINT32 (Sum2, &Rem);
+  Sum2  = ~Rem;
+
+  Sum1 += Sum2;
+  APFS_MOD_MAX_UINT32 (Sum1, &Rem);
+  Sum1  = ~Rem;
+
+  return (Sum1 << 32U) | Sum2;
+}
+
+BOOLEAN
+InternalApfsObjectChecksumVerify (
+  IN CONST APFS_OBJ_PHYS  *Block,
+  IN UINTN                DataSize
+  )
+{
+  UINT64  NewChecksum;
+
+  ASSERT (DataSize > sizeof (*Block));
+
+  NewChecksum = InternalApfsFletcher64 (
+    &Block->ObjectOid,
+    DataSize - sizeof (Block->Checksum)
+    );
+
+  if (NewChecksum == Block->Checksum) {
+    return TRUE;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCJS: Checksum mismatch for %Lx\n", Block->ObjectOid));
+  return FALSE;
+}
@@ -0,0 +1,134 @@
+/** @file
+  SIMD Fletcher-64 kernels.
+
+  Each kernel keeps per-lane running sums of words (A) and of A itself (B)
+  in 64-bit lanes. For L lanes and T iterations word i = L * t + l
+  contributes L * (T - t) - l times to the Fletcher-64 second sum, thus
+  Sum2 = L * Sum (B) - Sum (l * A), which needs only additions in the loop.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "OcApfsInternal.h"
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+
+#if APFS_HAS_SIMD
+
+//
+// Intrinsic headers are not usable in freestanding firmware builds with
+// all toolchains, thus use vector extensions directly.
+//
+typedef unsigned long long  V2DU __attribute__ ((vector_size (16)));
+typedef unsigned long long  V4DU __attribute__ ((vector_size (32)));
+
+#define APFS_SIMD_TARGET(x) __attribute__ ((target (x)))
+
+APFS_SIMD_TARGET ("sse2")
+VOID
+InternalApfsFletcher64Sse2 (
+  IN     CONST UINT32  *Data,
+  IN     UINTN         Count,
+  IN OUT UINT64        *Sum1,
+  IN OUT UINT64        *Sum2
+  )
+{
+  CONST V2DU  Mask = {MAX_UINT32, MAX_UINT32};
+  V2DU        Words;
+  V2DU        SumLo;
+  V2DU        SumHi;
+  V2DU        ProgLo;
+  V2DU        ProgHi;
+  UINT64      Total;
+
+  ASSERT (Count % APFS_FLETCHER64_SSE2_WORDS == 0);
+
+  //
+  // Previously summed words contribute once per every following word.
+  //
+  *Sum2 += *Sum1 * Count;
+
+  SumLo  = (V2DU) {0, 0};
+  SumHi  = (V2DU) {0, 0};
+  ProgLo = (V2DU) {0, 0};
+  ProgHi = (V2DU) {0, 0};
+
+  while (Count > 0) {
+    __builtin_memcpy (&Words, Data, sizeof (Words));
+
+    //
+    // Even words (lanes 0, 2) go to Lo, odd words (lanes 1, 3) go to Hi.
+    //
+    SumLo  += Words & Mask;
+    SumHi  += Words >> 32;
+    ProgLo += SumLo;
+    ProgHi += SumHi;
+
+    Data  += APFS_FLETCHER64_SSE2_WORDS;
+    Count -= APFS_FLETCHER64_SSE2_WORDS;
+  }
+
+  Total  = SumLo[0] + SumLo[1] + SumHi[0] + SumHi[1];
+  *Sum1 += Total;
+  *Sum2 += APFS_FLETCHER64_SSE2_WORDS * (ProgLo[0] + ProgLo[1] + ProgHi[0] + ProgHi[1])
+    - (2 * SumLo[1] + SumHi[0] + 3 * SumHi[1]);
+}
+
+APFS_SIMD_TARGET ("avx2")
+VOID
+InternalApfsFletcher64Avx2 (
+  IN     CONST UINT32  *Data,
+  IN     UINTN         Count,
+  IN OUT UINT64        *Sum1,
+  IN OUT UINT64        *Sum2
+  )
+{
+  CONST V4DU  Mask = {MAX_UINT32, MAX_UINT32, MAX_UINT32, MAX_UINT32};
+  V4DU        Words;
+  V4DU        SumLo;
+  V4DU        SumHi;
+  V4DU        ProgLo;
+  V4DU        ProgHi;
+  UINT64      Total;
+
+  ASSERT (Count % APFS_FLETCHER64_AVX2_WORDS == 0);
+
+  *Sum2 += *Sum1 * Count;
+
+  SumLo  = (V4DU) {0, 0, 0, 0};
+  SumHi  = (V4DU) {0, 0, 0, 0};
+  ProgLo = (V4DU) {0, 0, 0, 0};
+  ProgHi = (V4DU) {0, 0, 0, 0};
+
+  while (Count > 0) {
+    __builtin_memcpy (&Words, Data, sizeof (Words));
+
+    SumLo  += Words & Mask;
+    SumHi  += Words >> 32;
+    ProgLo += SumLo;
+    ProgHi += SumHi;
+
+    Data  += APFS_FLETCHER64_AVX2_WORDS;
+    Count -= APFS_FLETCHER64_AVX2_WORDS;
+  }
+
+  Total  = SumLo[0] + SumLo[1] + SumLo[2] + SumLo[3]
+    + SumHi[0] + SumHi[1] + SumHi[2] + SumHi[3];
+  *Sum1 += Total;
+  *Sum2 += APFS_FLETCHER64_AVX2_WORDS * (ProgLo[0] + ProgLo[1] + ProgLo[2] + ProgLo[3]
+    + ProgHi[0] + ProgHi[1] + ProgHi[2] + ProgHi[3])
+    - (2 * SumLo[1] + 4 * SumLo[2] + 6 * SumLo[3]
+    + SumHi[0] + 3 * SumHi[1] + 5 * SumHi[2] + 7 * SumHi[3]);
+}
+
+#endif // APFS_HAS_SIMD
@@ -40,6 +40,14 @@ STATIC BOOLEAN           mGlobalConnect;
 STATIC BOOLEAN           mDisconnectHandles;
 STATIC EFI_SYSTEM_TABLE  *mNullSystemTable;
 
+//
+// Versions of started APFS drivers. Containers bundling a driver of the same version
+// are connected to the running instance instead of loading one more copy.
+//
+STATIC UINT64            mApfsStartedVersions[APFS_MAX_STARTED_DRIVERS];
+STATIC UINT32            mApfsStartedDates[APFS_MAX_STARTED_DRIVERS];
+STATIC UINT32            mApfsStartedDriverCount;
+
 //
 // There seems to exist a driver with a very large version, which is treated by
 // apfs kernel extension to have 0 version. Follow suit.
@@ -80,11 +88,13 @@ ApfsCheckOpenCoreScanPolicy (
 }
 
 STATIC
-EFI_STATUS
-ApfsVerifyDriverVersion (
-  IN APFS_PRIVATE_DATA  *PrivateData,
-  IN VOID               *DriverBuffer,
-  IN UINT32             DriverSize
+VOID
+ApfsGetDriverVersion (
+  IN  APFS_PRIVATE_DATA  *PrivateData,
+  IN  VOID               *DriverBuffer,
+  IN  UINT32             DriverSize,
+  OUT UINT64             *Version,
+  OUT UINT32             *Date
   )
 {
   EFI_STATUS            Status;
@@ -92,7 +102,6 @@ ApfsVerifyDriverVersion (
   UINT64                RealVersion;
   UINT32                RealDate;
   UINTN                 Index;
-  BOOLEAN               HasLegitVersion;
 
   Status = PeCoffGetApfsDriverVersion (
     DriverBuffer,
@@ -156,6 +165,20 @@ ApfsVerifyDriverVersion (
     }
   }
 
+  *Version = RealVersion;
+  *Date    = RealDate;
+}
+
+STATIC
+EFI_STATUS
+ApfsVerifyDriverVersion (
+  IN APFS_PRIVATE_DATA  *PrivateData,
+  IN UINT64             RealVersion,
+  IN UINT32             RealDate
+  )
+{
+  BOOLEAN  HasLegitVersion;
+
   HasLegitVersion = (mApfsMinimalVersion == 0 || mApfsMinimalVersion <= RealVersion)
     && (mApfsMinimalDate == 0 || mApfsMinimalDate <= RealDate);
 
@@ -177,13 +200,32 @@ ApfsVerifyDriverVersion (
   return EFI_SECURITY_VIOLATION;
 }
 
+STATIC
+BOOLEAN
+ApfsIsDriverStarted (
+  IN UINT64  Version,
+  IN UINT32  Date
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < mApfsStartedDriverCount; ++Index) {
+    if (mApfsStartedVersions[Index] == Version && mApfsStartedDates[Index] == Date) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
 STATIC
 EFI_STATUS
 ApfsRegisterPartition (
-  IN  EFI_HANDLE             Handle,
-  IN  EFI_BLOCK_IO_PROTOCOL  *BlockIo,
-  IN  APFS_NX_SUPERBLOCK     *SuperBlock,
-  OUT APFS_PRIVATE_DATA      **PrivateDataPointer
+  IN  EFI_HANDLE              Handle,
+  IN  EFI_BLOCK_IO_PROTOCOL   *BlockIo,
+  IN  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2,
+  IN  APFS_NX_SUPERBLOCK      *SuperBlock,
+  OUT APFS_PRIVATE_DATA       **PrivateDataPointer
   )
 {
   EFI_STATUS           Status;
@@ -201,6 +243,7 @@ ApfsRegisterPartition (
   PrivateData->LocationInfo.ControllerHandle = Handle;
   CopyGuid (&PrivateData->LocationInfo.ContainerUuid, &SuperBlock->Uuid);
   PrivateData->BlockIo = BlockIo;
+  PrivateData->BlockIo2 = BlockIo2;
   PrivateData->ApfsBlockSize = SuperBlock->BlockSize;
   PrivateData->LbaMultiplier = PrivateData->ApfsBlockSize / PrivateData->BlockIo->Media->BlockSize;
   PrivateData->EfiJumpStart  = SuperBlock->EfiJumpStart;
@@ -231,10 +274,12 @@ ApfsRegisterPartition (
 
 STATIC
 EFI_STATUS
-ApfsStartDriver (
+ApfsLoadDriver (
   IN APFS_PRIVATE_DATA  *PrivateData,
   IN VOID               *DriverBuffer,
-  IN UINT32             DriverSize
+  IN UINT32             DriverSize,
+  IN UINT64             Version,
+  IN UINT32             Date
   )
 {
   EFI_STATUS                 Status;
@@ -261,8 +306,8 @@ ApfsStartDriver (
 
   Status = ApfsVerifyDriverVersion (
     PrivateData,
-    DriverBuffer,
-    DriverSize
+    Version,
+    Date
     );
   if (EFI_ERROR (Status)) {
     return Status;
@@ -352,6 +397,60 @@ ApfsStartDriver (
     return Status;
   }
 
+  if (mApfsStartedDriverCount < APFS_MAX_STARTED_DRIVERS) {
+    mApfsStartedVersions[mApfsStartedDriverCount] = Version;
+    mApfsStartedDates[mApfsStartedDriverCount]    = Date;
+    ++mApfsStartedDriverCount;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+ApfsStartDriver (
+  IN APFS_PRIVATE_DATA  *PrivateData,
+  IN VOID               *DriverBuffer,
+  IN UINT32             DriverSize
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      Version;
+  UINT32      Date;
+
+  ApfsGetDriverVersion (
+    PrivateData,
+    DriverBuffer,
+    DriverSize,
+    &Version,
+    &Date
+    );
+
+  //
+  // The started driver handles any container once connected, so there is
+  // no need to verify and load the same driver version once again.
+  //
+  if (ApfsIsDriverStarted (Version, Date)) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCJS: APFS driver %Lu/%u is already started for %g\n",
+      Version,
+      Date,
+      &PrivateData->LocationInfo.ContainerUuid
+      ));
+  } else {
+    Status = ApfsLoadDriver (
+      PrivateData,
+      DriverBuffer,
+      DriverSize,
+      Version,
+      Date
+      );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
   DEBUG ((
     DEBUG_INFO,
     "OCJS: Connecting %a%a APFS driver on handle %p\n",
@@ -390,56 +489,6 @@ ApfsStartDriver (
   return EFI_SUCCESS;
 }
 
-STATIC
-EFI_STATUS
-ApfsConnectDevice (
-  IN EFI_HANDLE             Handle,
-  IN EFI_BLOCK_IO_PROTOCOL  *BlockIo
-  )
-{
-  EFI_STATUS           Status;
-  APFS_NX_SUPERBLOCK   *SuperBlock;
-  APFS_PRIVATE_DATA    *PrivateData;
-  VOID                 *DriverBuffer;
-  UINT32               DriverSize;
-
-  //
-  // This may still be not APFS but some other file system.
-  //
-  Status = InternalApfsReadSuperBlock (BlockIo, &SuperBlock);
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
-
-  DEBUG ((DEBUG_INFO, "OCJS: Got APFS super block for %g\n", &SuperBlock->Uuid));
-
-  //
-  // We no longer need super block once we register ourselves.
-  //
-  Status = ApfsRegisterPartition (Handle, BlockIo, SuperBlock, &PrivateData);
-  FreePool (SuperBlock);
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
-
-  //
-  // We cannot load drivers if we have no fusion drive pair as they are not
-  // guaranteed to be located on each drive.
-  //
-  if (!PrivateData->CanLoadDriver) {
-    return EFI_NOT_READY;
-  }
-
-  Status = InternalApfsReadDriver (PrivateData, &DriverSize, &DriverBuffer);
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
-
-  Status = ApfsStartDriver (PrivateData, DriverBuffer, DriverSize);
-  FreePool (DriverBuffer);
-  return Status;
-}
-
 VOID
 OcApfsConfigure (
   IN UINT64   MinVersion,
@@ -475,10 +524,13 @@ OcApfsConfigure (
   mDisconnectHandles = DisconnectHandles;
 }
 
+STATIC
 EFI_STATUS
-OcApfsConnectHandle (
-  IN EFI_HANDLE  Handle,
-  IN BOOLEAN     VerifyPolicy
+ApfsCheckHandle (
+  IN  EFI_HANDLE              Handle,
+  IN  BOOLEAN                 VerifyPolicy,
+  OUT EFI_BLOCK_IO_PROTOCOL   **BlockIoPtr,
+  OUT EFI_BLOCK_IO2_PROTOCOL  **BlockIo2Ptr
   )
 {
   EFI_STATUS             Status;
@@ -502,7 +554,7 @@ OcApfsConnectHandle (
 
   //
   // Obtain Block I/O.
-  // We do not need to care about 2nd revision, as apfs.efi does not use it.
+  // apfs.efi does not use 2nd revision, but we use it for faster reads when present.
   //
   Status = gBS->HandleProtocol (
     Handle,
@@ -575,8 +627,123 @@ OcApfsConnectHandle (
     return EFI_UNSUPPORTED;
   }
 
+  Status = gBS->HandleProtocol (
+    Handle,
+    &gEfiBlockIo2ProtocolGuid,
+    (VOID **) BlockIo2Ptr
+    );
+  if (EFI_ERROR (Status)) {
+    *BlockIo2Ptr = NULL;
+  }
+
+  *BlockIoPtr = BlockIo;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+InternalApfsConnectHandles (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       HandleCount,
+  IN BOOLEAN     VerifyPolicy
+  )
+{
+  EFI_STATUS            Status;
+  APFS_CONNECT_CONTEXT  *Contexts;
+  APFS_CONNECT_CONTEXT  *Context;
+  UINTN                 Index;
+  VOID                  *TempProtocol;
+
+  Contexts = AllocateZeroPool (HandleCount * sizeof (*Contexts));
+  if (Contexts == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < HandleCount; ++Index) {
+    Context         = &Contexts[Index];
+    Context->Handle = Handles[Index];
+    Context->Status = ApfsCheckHandle (
+      Context->Handle,
+      VerifyPolicy,
+      &Context->BlockIo,
+      &Context->BlockIo2
+      );
+  }
+
   //
-  // This is possibly APFS, try connecting.
+  // This may still be not APFS but some other file system.
+  // Read super blocks from all devices at once to avoid waiting for each disk in turn.
   //
-  return ApfsConnectDevice (Handle, BlockIo);
+  InternalApfsReadSuperBlocks (Contexts, HandleCount);
+
+  for (Index = 0; Index < HandleCount; ++Index) {
+    Context = &Contexts[Index];
+    if (EFI_ERROR (Context->Status)) {
+      continue;
+    }
+
+    DEBUG ((DEBUG_INFO, "OCJS: Got APFS super block for %g\n", &Context->SuperBlock->Uuid));
+
+    //
+    // We no longer need super block once we register ourselves.
+    //
+    Context->Status = ApfsRegisterPartition (
+      Context->Handle,
+      Context->BlockIo,
+      Context->BlockIo2,
+      Context->SuperBlock,
+      &Context->PrivateData
+      );
+    FreePool (Context->SuperBlock);
+    Context->SuperBlock = NULL;
+
+    //
+    // We cannot load drivers if we have no fusion drive pair as they are not
+    // guaranteed to be located on each drive. The partition completing the pair
+    // loads the driver.
+    //
+    if (!EFI_ERROR (Context->Status) && !Context->PrivateData->CanLoadDriver) {
+      Context->Status = EFI_NOT_READY;
+    }
+  }
+
+  InternalApfsReadDrivers (Contexts, HandleCount);
+
+  Status = EFI_NOT_FOUND;
+
+  for (Index = 0; Index < HandleCount; ++Index) {
+    Context = &Contexts[Index];
+
+    if (!EFI_ERROR (Context->Status)) {
+      //
+      // Containers may get connected by the drivers started for the previous ones.
+      //
+      if (!EFI_ERROR (gBS->HandleProtocol (Context->Handle, &gEfiSimpleFileSystemProtocolGuid, &TempProtocol))) {
+        Context->Status = EFI_ALREADY_STARTED;
+      } else {
+        Context->Status = ApfsStartDriver (
+          Context->PrivateData,
+          Context->DriverBuffer,
+          Context->DriverSize
+          );
+      }
+
+      FreePool (Context->DriverBuffer);
+    }
+
+    if (!EFI_ERROR (Context->Status) || EFI_ERROR (Status)) {
+      Status = Context->Status;
+    }
+  }
+
+  FreePool (Contexts);
+  return Status;
+}
+
+EFI_STATUS
+OcApfsConnectHandle (
+  IN EFI_HANDLE  Handle,
+  IN BOOLEAN     VerifyPolicy
+  )
+{
+  return InternalApfsConnectHandles (&Handle, 1, VerifyPolicy);
 }
@@ -101,9 +101,10 @@ InternalApfsInitFusionData (
 
 EFI_BLOCK_IO_PROTOCOL *
 InternalApfsTranslateBlock (
-  IN  APFS_PRIVATE_DATA    *PrivateData,
-  IN  UINT64               Block,
-  OUT EFI_LBA              *Lba
+  IN  APFS_PRIVATE_DATA       *PrivateData,
+  IN  UINT64                  Block,
+  OUT EFI_LBA                 *Lba,
+  OUT EFI_BLOCK_IO2_PROTOCOL  **BlockIo2
   )
 {
   BOOLEAN  IsFusionMaster;
@@ -119,7 +120,8 @@ InternalApfsTranslateBlock (
   // For normal disks we just return as is.
   //
   if (!PrivateData->IsFusion) {
-    *Lba = Block * PrivateData->LbaMultiplier;
+    *Lba      = Block * PrivateData->LbaMultiplier;
+    *BlockIo2 = PrivateData->BlockIo2;
     return PrivateData->BlockIo;
   }
 
@@ -138,8 +140,10 @@ InternalApfsTranslateBlock (
   *Lba = Block * PrivateData->LbaMultiplier;
 
   if (IsFusionMaster == PrivateData->IsFusionMaster) {
+    *BlockIo2 = PrivateData->BlockIo2;
     return PrivateData->BlockIo;
   }
 
+  *BlockIo2 = PrivateData->FusionSibling->BlockIo2;
   return PrivateData->FusionSibling->BlockIo;
 }
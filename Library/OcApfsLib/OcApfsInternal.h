@@ -18,10 +18,16 @@
 #include <Uefi.h>
 #include <IndustryStandard/Apfs.h>
 #include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
 #include <Protocol/ApfsEfiBootRecordInfo.h>
 
 #define APFS_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('A', 'F', 'J', 'S')
 
+/**
+  Maximum number of distinct APFS driver versions remembered as started.
+**/
+#define APFS_MAX_STARTED_DRIVERS  8
+
 /**
   On Intel 64-bit we can use 128-bit multiplication instead of slow division:
   (x * (UINT128) 0x8000000080000001) >> 31.
@@ -33,6 +39,31 @@
   #define APFS_MOD_MAX_UINT32(Value, Result) do { DivU64x32Remainder ((Value), MAX_UINT32, (Result)); } while (0)
 #endif
 
+/**
+  Fletcher-64 SIMD kernels are written with GCC vector extensions,
+  which are supported by both GCC and clang. Other compilers use the
+  scalar implementation.
+**/
+#if (defined (__GNUC__) || defined (__clang__)) && (defined (MDE_CPU_IA32) || defined (MDE_CPU_X64))
+#define APFS_HAS_SIMD 1
+#else
+#define APFS_HAS_SIMD 0
+#endif
+
+/**
+  Fletcher-64 SIMD kernels consume this many 32-bit words per iteration.
+**/
+#define APFS_FLETCHER64_SSE2_WORDS  4
+#define APFS_FLETCHER64_AVX2_WORDS  8
+
+/**
+  Asynchronous block reads not completed within this time, in microseconds,
+  are aborted and retried synchronously. Completion is polled every
+  APFS_READ_POLL_INTERVAL microseconds.
+**/
+#define APFS_READ_TIMEOUT        5000000
+#define APFS_READ_POLL_INTERVAL  10
+
 typedef struct APFS_PRIVATE_DATA_ APFS_PRIVATE_DATA;
 
 /**
@@ -56,6 +87,10 @@ typedef struct APFS_PRIVATE_DATA_ {
   //
   EFI_BLOCK_IO_PROTOCOL               *BlockIo;
   //
+  // Block I/O 2 protocol, optional.
+  //
+  EFI_BLOCK_IO2_PROTOCOL              *BlockIo2;
+  //
   // APFS block size, a multiple of Block I/O block size.
   //
   UINT32                              ApfsBlockSize;
@@ -93,24 +128,205 @@ typedef struct APFS_PRIVATE_DATA_ {
   BOOLEAN                             IsFusionMaster;
 } APFS_PRIVATE_DATA;
 
+/**
+  Block read request, completed asynchronously when Block I/O 2 is available.
+**/
+typedef struct {
+  //
+  // Block I/O protocol.
+  //
+  EFI_BLOCK_IO_PROTOCOL               *BlockIo;
+  //
+  // Block I/O 2 protocol, optional.
+  //
+  EFI_BLOCK_IO2_PROTOCOL              *BlockIo2;
+  //
+  // Starting LBA.
+  //
+  EFI_LBA                             Lba;
+  //
+  // Read size, a multiple of Block I/O block size.
+  //
+  UINTN                               Size;
+  //
+  // Read buffer, requests without buffer are ignored.
+  //
+  VOID                                *Buffer;
+  //
+  // Block I/O 2 token for asynchronous reads.
+  //
+  EFI_BLOCK_IO2_TOKEN                 Token;
+  //
+  // Read status.
+  //
+  EFI_STATUS                          Status;
+} APFS_READ_REQUEST;
+
+/**
+  Connection state of a potential APFS container.
+**/
+typedef struct {
+  //
+  // Device handle.
+  //
+  EFI_HANDLE                          Handle;
+  //
+  // Block I/O protocol.
+  //
+  EFI_BLOCK_IO_PROTOCOL               *BlockIo;
+  //
+  // Block I/O 2 protocol, optional.
+  //
+  EFI_BLOCK_IO2_PROTOCOL              *BlockIo2;
+  //
+  // Verified super block until the partition is registered.
+  //
+  APFS_NX_SUPERBLOCK                  *SuperBlock;
+  //
+  // Registered partition private data.
+  //
+  APFS_PRIVATE_DATA                   *PrivateData;
+  //
+  // Bundled driver.
+  //
+  VOID                                *DriverBuffer;
+  //
+  // Bundled driver size.
+  //
+  UINT32                              DriverSize;
+  //
+  // Connection status, no further processing is done on error.
+  //
+  EFI_STATUS                          Status;
+} APFS_CONNECT_CONTEXT;
+
 /**
   List of discovered partitions.
 **/
 extern LIST_ENTRY  mApfsPrivateDataList;
 
-EFI_STATUS
-InternalApfsReadSuperBlock (
-  IN  EFI_BLOCK_IO_PROTOCOL  *BlockIo,
-  OUT APFS_NX_SUPERBLOCK     **SuperBlockPtr
+/**
+  Perform block reads. All reads are submitted before waiting for
+  any of them, so that reads from different disks overlap.
+  Reads not completed within APFS_READ_TIMEOUT are retried synchronously.
+
+  @param[in,out]  Requests  Read requests.
+  @param[in]      Count     Number of read requests.
+**/
+VOID
+InternalApfsReadBlocks (
+  IN OUT APFS_READ_REQUEST  *Requests,
+  IN     UINTN              Count
+  );
+
+/**
+  Read and verify super blocks of all containers without error status.
+  Containers without valid super block get error status.
+
+  @param[in,out]  Contexts  Container connection states.
+  @param[in]      Count     Number of containers.
+**/
+VOID
+InternalApfsReadSuperBlocks (
+  IN OUT APFS_CONNECT_CONTEXT  *Contexts,
+  IN     UINTN                 Count
   );
 
+/**
+  Read bundled drivers of all registered containers without error status.
+  Containers without valid driver get error status.
+
+  @param[in,out]  Contexts  Container connection states.
+  @param[in]      Count     Number of containers.
+**/
+VOID
+InternalApfsReadDrivers (
+  IN OUT APFS_CONNECT_CONTEXT  *Contexts,
+  IN     UINTN                 Count
+  );
+
+/**
+  Connect APFS driver to devices at handles.
+
+  @param[in] Handles       Device handles (APFS containers).
+  @param[in] HandleCount   Number of device handles.
+  @param[in] VerifyPolicy  Apply ScanPolicy rules.
+
+  @retval EFI_SUCCESS if at least one device was connected.
+**/
 EFI_STATUS
-InternalApfsReadDriver (
-  IN  APFS_PRIVATE_DATA    *PrivateData,
-  OUT UINT32               *DriverSize,
-  OUT VOID                 **DriverBuffer
+InternalApfsConnectHandles (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       HandleCount,
+  IN BOOLEAN     VerifyPolicy
   );
 
+/**
+  Calculate APFS Fletcher-64 checksum with the fastest available implementation.
+
+  @param[in]  Data      Data to checksum, normally object data after the checksum field.
+  @param[in]  DataSize  Data size, multiple of sizeof (UINT32) between
+                        APFS_NX_MINIMUM_BLOCK_SIZE - 8 and APFS_NX_MAXIMUM_BLOCK_SIZE - 8.
+
+  @return  Fletcher-64 checksum.
+**/
+UINT64
+InternalApfsFletcher64 (
+  IN CONST VOID  *Data,
+  IN UINTN       DataSize
+  );
+
+/**
+  Verify APFS object checksum.
+
+  @param[in]  Block     APFS object header.
+  @param[in]  DataSize  Object size including the header.
+
+  @retval TRUE when checksum is valid.
+**/
+BOOLEAN
+InternalApfsObjectChecksumVerify (
+  IN CONST APFS_OBJ_PHYS  *Block,
+  IN UINTN                DataSize
+  );
+
+#if APFS_HAS_SIMD
+
+/**
+  Fletcher-64 SSE2 kernel. Accumulates unreduced sums, i.e. Sum1 is the sum
+  of all words and Sum2 is the sum of all running Sum1 values.
+
+  @param[in]      Data   Words to checksum.
+  @param[in]      Count  Number of words, multiple of APFS_FLETCHER64_SSE2_WORDS.
+  @param[in,out]  Sum1   Running sum of words.
+  @param[in,out]  Sum2   Running sum of Sum1.
+**/
+VOID
+InternalApfsFletcher64Sse2 (
+  IN     CONST UINT32  *Data,
+  IN     UINTN         Count,
+  IN OUT UINT64        *Sum1,
+  IN OUT UINT64        *Sum2
+  );
+
+/**
+  Fletcher-64 AVX2 kernel, see InternalApfsFletcher64Sse2.
+
+  @param[in]      Data   Words to checksum.
+  @param[in]      Count  Number of words, multiple of APFS_FLETCHER64_AVX2_WORDS.
+  @param[in,out]  Sum1   Running sum of words.
+  @param[in,out]  Sum2   Running sum of Sum1.
+**/
+VOID
+InternalApfsFletcher64Avx2 (
+  IN     CONST UINT32  *Data,
+  IN     UINTN         Count,
+  IN OUT UINT64        *Sum1,
+  IN OUT UINT64        *Sum2
+  );
+
+#endif // APFS_HAS_SIMD
+
 VOID
 InternalApfsInitFusionData (
   IN  APFS_NX_SUPERBLOCK   *SuperBlock,
@@ -119,9 +335,10 @@ InternalApfsInitFusionData (
 
 EFI_BLOCK_IO_PROTOCOL *
 InternalApfsTranslateBlock (
-  IN  APFS_PRIVATE_DATA    *PrivateData,
-  IN  UINT64               Block,
-  OUT EFI_LBA              *Lba
+  IN  APFS_PRIVATE_DATA       *PrivateData,
+  IN  UINT64                  Block,
+  OUT EFI_LBA                 *Lba,
+  OUT EFI_BLOCK_IO2_PROTOCOL  **BlockIo2
   );
 
 #endif // OC_APFS_INTERNAL_H
@@ -20,169 +20,220 @@
 #include <Library/OcApfsLib.h>
 #include <Library/OcGuardLib.h>
 #include <Library/OcPeCoffLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 
-STATIC
-UINT64
-ApfsFletcher64 (
-  VOID    *Data,
-  UINTN   DataSize
+VOID
+InternalApfsReadBlocks (
+  IN OUT APFS_READ_REQUEST  *Requests,
+  IN     UINTN              Count
   )
 {
-  UINT32        *Walker;
-  UINT32        *WalkerEnd;
-  UINT64        Sum1;
-  UINT64        Sum2;
-  UINT32        Rem;
+  EFI_STATUS         Status;
+  APFS_READ_REQUEST  *Request;
+  UINTN              Index;
+  UINTN              Pending;
+  UINTN              Elapsed;
 
   //
-  // For APFS we have the following guarantees (checked outside).
-  // - DataSize is always divisible by 4 (UINT32), the only potential exceptions
-  //   are multiples of block sizes of 1 and 2, which we do not support and filter out.
-  // - DataSize is always between 0x1000-8 and 0x10000-8, i.e. within UINT16.
+  // Submit asynchronous reads first. Single reads gain nothing from this,
+  // and may be requested at TPL_CALLBACK from partition arrival notifications.
   //
-  ASSERT (DataSize >= APFS_NX_MINIMUM_BLOCK_SIZE - sizeof (UINT64));
-  ASSERT (DataSize <= APFS_NX_MAXIMUM_BLOCK_SIZE - sizeof (UINT64));
-  ASSERT (DataSize % sizeof (UINT32) == 0);
+  Pending = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    Request              = &Requests[Index];
+    Request->Token.Event = NULL;
+    Request->Status      = EFI_SUCCESS;
+
+    if (Count == 1 || Request->Buffer == NULL || Request->Size == 0 || Request->BlockIo2 == NULL) {
+      continue;
+    }
+
+    Status = gBS->CreateEvent (
+      0,
+      TPL_CALLBACK,
+      NULL,
+      NULL,
+      &Request->Token.Event
+      );
+    if (EFI_ERROR (Status)) {
+      Request->Token.Event = NULL;
+      continue;
+    }
 
-  Sum1 = 0;
-  Sum2 = 0;
+    Status = Request->BlockIo2->ReadBlocksEx (
+      Request->BlockIo2,
+      Request->BlockIo2->Media->MediaId,
+      Request->Lba,
+      &Request->Token,
+      Request->Size,
+      Request->Buffer
+      );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Request->Token.Event);
+      Request->Token.Event = NULL;
+      continue;
+    }
 
-  Walker     = Data;
-  WalkerEnd  = Walker + DataSize / sizeof (UINT32);
+    ++Pending;
+  }
 
   //
-  // Do usual Fletcher-64 rounds without modulo due to impossible overflow.
+  // Perform synchronous reads while asynchronous ones are in flight.
   //
-  while (Walker < WalkerEnd) {
-    //
-    // Sum1 never overflows, because 0xFFFFFFFF * (0x10000-8) < MAX_UINT64.
-    // This is just a normal sum of data values.
-    //
-    Sum1 += *Walker;
-    //
-    // Sum2 never overflows, because 0xFFFFFFFF * (0x4000-1) * 0x1FFF < MAX_UINT64.
-    // This is just a normal arithmetical progression of sums.
-    //
-    Sum2 += Sum1;
-    ++Walker;
+  for (Index = 0; Index < Count; ++Index) {
+    Request = &Requests[Index];
+    if (Request->Token.Event != NULL || Request->Buffer == NULL || Request->Size == 0) {
+      continue;
+    }
+
+    Request->Status = Request->BlockIo->ReadBlocks (
+      Request->BlockIo,
+      Request->BlockIo->Media->MediaId,
+      Request->Lba,
+      Request->Size,
+      Request->Buffer
+      );
   }
 
   //
-  // Split Fletcher-64 halves.
-  // As per Chinese remainder theorem, perform the modulo now.
-  // No overflows also possible as seen from Sum1/Sum2 upper bounds above.
+  // Poll for completion, as we cannot wait for events at TPL above TPL_APPLICATION.
   //
+  for (Elapsed = 0; Pending > 0 && Elapsed < APFS_READ_TIMEOUT; Elapsed += APFS_READ_POLL_INTERVAL) {
+    for (Index = 0; Index < Count; ++Index) {
+      Request = &Requests[Index];
+      if (Request->Token.Event == NULL
+        || gBS->CheckEvent (Request->Token.Event) != EFI_SUCCESS) {
+        continue;
+      }
+
+      Request->Status = Request->Token.TransactionStatus;
+      gBS->CloseEvent (Request->Token.Event);
+      Request->Token.Event = NULL;
+      --Pending;
+    }
 
-  Sum2 += Sum1;
-  APFS_MOD_MAX_UINT32 (Sum2, &Rem);
-  Sum2  = ~Rem;
-
-  Sum1 += Sum2;
-  APFS_MOD_MAX_UINT32 (Sum1, &Rem);
-  Sum1  = ~Rem;
+    if (Pending > 0) {
+      gBS->Stall (APFS_READ_POLL_INTERVAL);
+    }
+  }
 
-  return (Sum1 << 32U) | Sum2;
-}
+  if (Pending == 0) {
+    return;
+  }
 
-STATIC
-BOOLEAN
-ApfsBlockChecksumVerify (
-  APFS_OBJ_PHYS   *Block,
-  UINTN           DataSize
-  )
-{
-  UINT64  NewChecksum;
+  //
+  // Some BlockIo2 implementations never complete requests. Reset aborts
+  // outstanding requests, so the buffer can be reused for a synchronous read.
+  //
+  for (Index = 0; Index < Count; ++Index) {
+    Request = &Requests[Index];
+    if (Request->Token.Event == NULL) {
+      continue;
+    }
 
-  ASSERT (DataSize > sizeof (*Block));
+    DEBUG ((DEBUG_INFO, "OCJS: Async read of %Lx timed out, retrying\n", Request->Lba));
 
-  NewChecksum = ApfsFletcher64 (
-    &Block->ObjectOid,
-    DataSize - sizeof (Block->Checksum)
-    );
+    Request->BlockIo2->Reset (Request->BlockIo2, FALSE);
+    gBS->CloseEvent (Request->Token.Event);
+    Request->Token.Event = NULL;
 
-  if (NewChecksum == Block->Checksum) {
-    return TRUE;
+    Request->Status = Request->BlockIo->ReadBlocks (
+      Request->BlockIo,
+      Request->BlockIo->Media->MediaId,
+      Request->Lba,
+      Request->Size,
+      Request->Buffer
+      );
   }
-
-  DEBUG ((DEBUG_INFO, "OCJS: Checksum mismatch for %Lx\n", Block->ObjectOid));
-  return FALSE;
 }
 
 STATIC
 EFI_STATUS
-ApfsReadJumpStart (
-  IN  APFS_PRIVATE_DATA      *PrivateData,
-  OUT APFS_NX_EFI_JUMPSTART  **JumpStartPtr
+ApfsVerifySuperBlock (
+  IN     EFI_BLOCK_IO_PROTOCOL  *BlockIo,
+  IN     APFS_NX_SUPERBLOCK     *SuperBlock,
+  IN OUT UINTN                  *ReadSize
   )
 {
-  EFI_STATUS             Status;
-  APFS_NX_EFI_JUMPSTART  *JumpStart;
-  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
-  EFI_LBA                Lba;
-  UINT32                 MaxExtents;
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCJS: Testing disk with %8X magic %u block\n",
+    SuperBlock->Magic,
+    SuperBlock->BlockSize
+    ));
 
   //
-  // No jump start driver, ignore.
+  // Super block is expected to have NXSB magic.
   //
-  if (PrivateData->EfiJumpStart == 0) {
-    DEBUG ((DEBUG_INFO, "OCJS: Missing JumpStart for %g\n", &PrivateData->LocationInfo.ContainerUuid));
+  if (SuperBlock->Magic != APFS_NX_SIGNATURE) {
     return EFI_UNSUPPORTED;
   }
 
   //
-  // Allocate memory for jump start.
+  // Ensure APFS block size is:
+  // - A multiple of disk block size.
+  // - Divisible by UINT32 for fletcher checksum to work (e.g. when block size is 1 or 2).
+  // - Within minimum and maximum edges.
   //
-  JumpStart = AllocateZeroPool (PrivateData->ApfsBlockSize);
-  if (JumpStart == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  if (SuperBlock->BlockSize < BlockIo->Media->BlockSize
+    || (SuperBlock->BlockSize & (BlockIo->Media->BlockSize - 1)) != 0
+    || (SuperBlock->BlockSize & (sizeof (UINT32) - 1)) != 0
+    || SuperBlock->BlockSize < APFS_NX_MINIMUM_BLOCK_SIZE
+    || SuperBlock->BlockSize > APFS_NX_MAXIMUM_BLOCK_SIZE) {
+    return EFI_UNSUPPORTED;
   }
 
-  BlockIo = InternalApfsTranslateBlock (PrivateData, PrivateData->EfiJumpStart, &Lba);
-
   //
-  // Read jump start and abort on failure.
+  // Check if we can calculate the checksum and request a bigger read otherwise.
   //
-  Status = BlockIo->ReadBlocks (
-    BlockIo,
-    BlockIo->Media->MediaId,
-    Lba,
-    PrivateData->ApfsBlockSize,
-    JumpStart
-    );
+  if (SuperBlock->BlockSize > *ReadSize) {
+    *ReadSize = SuperBlock->BlockSize;
+    return EFI_BUFFER_TOO_SMALL;
+  }
 
-  DEBUG ((
-    DEBUG_INFO,
-    "OCJS: Block (P:%d|F:%d) read req %Lx -> %Lx of %x (mask %u, mul %u) - %r\n",
-    BlockIo == PrivateData->BlockIo,
-    PrivateData->IsFusion,
-    PrivateData->EfiJumpStart,
-    Lba,
-    PrivateData->ApfsBlockSize,
-    PrivateData->FusionMask,
-    PrivateData->LbaMultiplier,
-    Status
-    ));
+  //
+  // Calculate and verify checksum.
+  //
+  if (!InternalApfsObjectChecksumVerify (&SuperBlock->BlockHeader, SuperBlock->BlockSize)) {
+    return EFI_UNSUPPORTED;
+  }
 
-  if (EFI_ERROR (Status)) {
-    FreePool (JumpStart);
-    return Status;
+  //
+  // Verify object type and flags.
+  // SubType being 0 comes from ApfsJumpStart and is not documented.
+  // ObjectOid being 1 comes from ApfsJumpStart and is not documented.
+  //
+  if (SuperBlock->BlockHeader.ObjectType != (APFS_OBJ_EPHEMERAL | APFS_OBJECT_TYPE_NX_SUPERBLOCK)
+    || SuperBlock->BlockHeader.ObjectSubType != 0
+    || SuperBlock->BlockHeader.ObjectOid != 1) {
+    return EFI_UNSUPPORTED;
   }
 
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+ApfsVerifyJumpStart (
+  IN APFS_PRIVATE_DATA      *PrivateData,
+  IN APFS_NX_EFI_JUMPSTART  *JumpStart
+  )
+{
+  UINT32  MaxExtents;
+
   //
   // Jump start is expected to have JSDR magic.
   // Version is not checked by ApfsJumpStart driver.
   //
   if (JumpStart->Magic != APFS_NX_EFI_JUMPSTART_MAGIC) {
     DEBUG ((DEBUG_INFO, "OCJS: Unknown JSDR magic %08x, expected %08x\n", JumpStart->Magic, APFS_NX_EFI_JUMPSTART_MAGIC));
-    FreePool (JumpStart);
     return EFI_UNSUPPORTED;
   }
 
   //
   // Calculate and verify checksum.
   //
-  if (!ApfsBlockChecksumVerify (&JumpStart->BlockHeader, PrivateData->ApfsBlockSize)) {
-    FreePool (JumpStart);
+  if (!InternalApfsObjectChecksumVerify (&JumpStart->BlockHeader, PrivateData->ApfsBlockSize)) {
     return EFI_UNSUPPORTED;
   }
 
@@ -192,252 +243,379 @@ ApfsReadJumpStart (
   MaxExtents = (PrivateData->ApfsBlockSize - sizeof (*JumpStart)) / sizeof (JumpStart->RecordExtents[0]);
   if (MaxExtents < JumpStart->NumExtents) {
     DEBUG ((DEBUG_INFO, "OCJS: Invalid extent count %u / %u\n", JumpStart->NumExtents, MaxExtents));
-    FreePool (JumpStart);
     return EFI_UNSUPPORTED;
   }
 
-  *JumpStartPtr = JumpStart;
   return EFI_SUCCESS;
 }
 
 STATIC
-EFI_STATUS
-ApfsReadDriver (
-  IN  APFS_PRIVATE_DATA      *PrivateData,
-  IN  APFS_NX_EFI_JUMPSTART  *JumpStart,
-  OUT UINT32                 *DriverSize,
-  OUT VOID                   **DriverBuffer
+VOID
+ApfsReadJumpStarts (
+  IN OUT APFS_CONNECT_CONTEXT   *Contexts,
+  IN     UINTN                  Count,
+     OUT APFS_NX_EFI_JUMPSTART  **JumpStarts
   )
 {
-  EFI_STATUS             Status;
-  VOID                   *EfiFile;
-  UINTN                  EfiFileSize;
-  UINTN                  OrgEfiFileSize;
-  UINT8                  *ChunkPtr;
-  UINTN                  ChunkSize;
-  UINTN                  Index;
-  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
-  EFI_LBA                Lba;
+  APFS_READ_REQUEST     *Requests;
+  APFS_READ_REQUEST     *Request;
+  APFS_CONNECT_CONTEXT  *Context;
+  APFS_PRIVATE_DATA     *PrivateData;
+  UINTN                 Index;
+
+  Requests = AllocateZeroPool (Count * sizeof (*Requests));
+
+  for (Index = 0; Index < Count; ++Index) {
+    Context           = &Contexts[Index];
+    JumpStarts[Index] = NULL;
+    if (EFI_ERROR (Context->Status)) {
+      continue;
+    }
 
-  EfiFileSize = JumpStart->EfiFileLen / PrivateData->ApfsBlockSize + 1;
-  if (OcOverflowMulUN (EfiFileSize, PrivateData->ApfsBlockSize, &EfiFileSize)) {
-    return EFI_SECURITY_VIOLATION;
-  }
+    if (Requests == NULL) {
+      Context->Status = EFI_OUT_OF_RESOURCES;
+      continue;
+    }
 
-  OrgEfiFileSize = EfiFileSize;
+    PrivateData = Context->PrivateData;
 
-  EfiFile = AllocateZeroPool (EfiFileSize);
-  if (EfiFile == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
+    //
+    // No jump start driver, ignore.
+    //
+    if (PrivateData->EfiJumpStart == 0) {
+      DEBUG ((DEBUG_INFO, "OCJS: Missing JumpStart for %g\n", &PrivateData->LocationInfo.ContainerUuid));
+      Context->Status = EFI_UNSUPPORTED;
+      continue;
+    }
 
-  ChunkPtr = EfiFile;
+    //
+    // Allocate memory for jump start.
+    //
+    Request         = &Requests[Index];
+    Request->Buffer = AllocateZeroPool (PrivateData->ApfsBlockSize);
+    if (Request->Buffer == NULL) {
+      Context->Status = EFI_OUT_OF_RESOURCES;
+      continue;
+    }
 
-  for (Index = 0; Index < JumpStart->NumExtents || EfiFileSize != 0; ++Index) {
-    BlockIo = InternalApfsTranslateBlock (
+    Request->Size    = PrivateData->ApfsBlockSize;
+    Request->BlockIo = InternalApfsTranslateBlock (
       PrivateData,
-      JumpStart->RecordExtents[Index].StartPhysicalAddr,
-      &Lba
+      PrivateData->EfiJumpStart,
+      &Request->Lba,
+      &Request->BlockIo2
       );
+  }
+
+  if (Requests == NULL) {
+    return;
+  }
+
+  InternalApfsReadBlocks (Requests, Count);
 
-    if (JumpStart->RecordExtents[Index].BlockCount > MAX_UINTN
-      || OcOverflowMulUN ((UINTN) JumpStart->RecordExtents[Index].BlockCount, PrivateData->ApfsBlockSize, &ChunkSize)
-      || ChunkSize > EfiFileSize) {
-      FreePool (EfiFile);
-      return EFI_SECURITY_VIOLATION;
+  for (Index = 0; Index < Count; ++Index) {
+    Request = &Requests[Index];
+    if (Request->Buffer == NULL) {
+      continue;
     }
 
-    Status = BlockIo->ReadBlocks (
-      BlockIo,
-      BlockIo->Media->MediaId,
-      Lba,
-      ChunkSize,
-      ChunkPtr
-      );
+    Context     = &Contexts[Index];
+    PrivateData = Context->PrivateData;
 
-    if (EFI_ERROR (Status)) {
-      FreePool (EfiFile);
-      return Status;
+    DEBUG ((
+      DEBUG_INFO,
+      "OCJS: Block (P:%d|F:%d) read req %Lx -> %Lx of %x (mask %u, mul %u) - %r\n",
+      Request->BlockIo == PrivateData->BlockIo,
+      PrivateData->IsFusion,
+      PrivateData->EfiJumpStart,
+      Request->Lba,
+      PrivateData->ApfsBlockSize,
+      PrivateData->FusionMask,
+      PrivateData->LbaMultiplier,
+      Request->Status
+      ));
+
+    Context->Status = Request->Status;
+    if (!EFI_ERROR (Context->Status)) {
+      Context->Status = ApfsVerifyJumpStart (PrivateData, Request->Buffer);
     }
 
-    ChunkPtr    += ChunkSize;
-    EfiFileSize -= ChunkSize;
-  }
+    if (EFI_ERROR (Context->Status)) {
+      DEBUG ((
+        DEBUG_INFO,
+        "OCJS: Failed to read JumpStart for %g - %r\n",
+        &PrivateData->LocationInfo.ContainerUuid,
+        Context->Status
+        ));
+      FreePool (Request->Buffer);
+      continue;
+    }
 
-  //
-  // Ensure that we do not have meaningful trailing memory just in case.
-  //
-  if (OrgEfiFileSize != JumpStart->EfiFileLen) {
-    ChunkPtr  = EfiFile;
-    ChunkPtr += JumpStart->EfiFileLen;
-    ZeroMem (ChunkPtr, OrgEfiFileSize - JumpStart->EfiFileLen);
+    JumpStarts[Index] = Request->Buffer;
   }
 
-  *DriverSize   = JumpStart->EfiFileLen;
-  *DriverBuffer = EfiFile;
-
-  return EFI_SUCCESS;
+  FreePool (Requests);
 }
 
-EFI_STATUS
-InternalApfsReadSuperBlock (
-  IN  EFI_BLOCK_IO_PROTOCOL  *BlockIo,
-  OUT APFS_NX_SUPERBLOCK     **SuperBlockPtr
+VOID
+InternalApfsReadSuperBlocks (
+  IN OUT APFS_CONNECT_CONTEXT  *Contexts,
+  IN     UINTN                 Count
   )
 {
-  EFI_STATUS           Status;
-  APFS_NX_SUPERBLOCK   *SuperBlock;
-  UINTN                ReadSize;
-  UINTN                Retry;
+  EFI_STATUS            Status;
+  APFS_READ_REQUEST     *Requests;
+  APFS_READ_REQUEST     *Request;
+  APFS_CONNECT_CONTEXT  *Context;
+  UINTN                 Index;
+  UINTN                 Retry;
+  BOOLEAN               Pending;
+
+  Requests = AllocateZeroPool (Count * sizeof (*Requests));
 
   //
   // According to APFS spec APFS block size is a multiple of disk block size.
-  // Start by reading APFS_NX_MINIMUM_BLOCK_SIZE aligned to block size. 
+  // Start by reading APFS_NX_MINIMUM_BLOCK_SIZE aligned to block size.
   //
-  ReadSize = ALIGN_VALUE (APFS_NX_MINIMUM_BLOCK_SIZE, BlockIo->Media->BlockSize);
+  for (Index = 0; Index < Count; ++Index) {
+    Context = &Contexts[Index];
+    if (EFI_ERROR (Context->Status)) {
+      continue;
+    }
 
-  SuperBlock = NULL;
+    if (Requests == NULL) {
+      Context->Status = EFI_OUT_OF_RESOURCES;
+      continue;
+    }
+
+    Requests[Index].BlockIo  = Context->BlockIo;
+    Requests[Index].BlockIo2 = Context->BlockIo2;
+    Requests[Index].Size     = ALIGN_VALUE (APFS_NX_MINIMUM_BLOCK_SIZE, Context->BlockIo->Media->BlockSize);
+  }
+
+  if (Requests == NULL) {
+    return;
+  }
 
   //
   // Second attempt is given for cases when block size is bigger than our guessed size.
   //
   for (Retry = 0; Retry < 2; ++Retry) {
-    //
-    // Allocate memory for super block.
-    //
-    SuperBlock = AllocateZeroPool (ReadSize);
-    if (SuperBlock == NULL) {
-      break;
+    Pending = FALSE;
+
+    for (Index = 0; Index < Count; ++Index) {
+      Context         = &Contexts[Index];
+      Request         = &Requests[Index];
+      Request->Buffer = NULL;
+      if (EFI_ERROR (Context->Status) || Context->SuperBlock != NULL) {
+        continue;
+      }
+
+      //
+      // Allocate memory for super block.
+      //
+      Request->Buffer = AllocateZeroPool (Request->Size);
+      if (Request->Buffer == NULL) {
+        Context->Status = EFI_OUT_OF_RESOURCES;
+        continue;
+      }
+
+      Pending = TRUE;
     }
 
-    //
-    // Read super block and abort on failure.
-    //
-    Status = BlockIo->ReadBlocks (
-      BlockIo,
-      BlockIo->Media->MediaId,
-      0,
-      ReadSize,
-      SuperBlock
-      );
-    if (EFI_ERROR (Status)) {
+    if (!Pending) {
       break;
     }
 
-    DEBUG ((
-      DEBUG_VERBOSE,
-      "OCJS: Testing disk with %8X magic %u block\n",
-      SuperBlock->Magic,
-      SuperBlock->BlockSize
-      ));
+    InternalApfsReadBlocks (Requests, Count);
+
+    for (Index = 0; Index < Count; ++Index) {
+      Context = &Contexts[Index];
+      Request = &Requests[Index];
+      if (Request->Buffer == NULL) {
+        continue;
+      }
+
+      Status = Request->Status;
+      if (!EFI_ERROR (Status)) {
+        Status = ApfsVerifySuperBlock (Context->BlockIo, Request->Buffer, &Request->Size);
+      }
+
+      //
+      // Super block is assumed to be legit.
+      //
+      if (!EFI_ERROR (Status)) {
+        Context->SuperBlock = Request->Buffer;
+        continue;
+      }
+
+      FreePool (Request->Buffer);
+
+      if (Status != EFI_BUFFER_TOO_SMALL || Retry > 0) {
+        Context->Status = EFI_UNSUPPORTED;
+      }
+    }
+  }
 
-    //
-    // Super block is expected to have NXSB magic.
-    //
-    if (SuperBlock->Magic != APFS_NX_SIGNATURE) {
-      break;
+  FreePool (Requests);
+}
+
+VOID
+InternalApfsReadDrivers (
+  IN OUT APFS_CONNECT_CONTEXT  *Contexts,
+  IN     UINTN                 Count
+  )
+{
+  APFS_NX_EFI_JUMPSTART  **JumpStarts;
+  APFS_NX_EFI_JUMPSTART  *JumpStart;
+  APFS_READ_REQUEST      *Requests;
+  APFS_READ_REQUEST      *Request;
+  APFS_CONNECT_CONTEXT   *Context;
+  APFS_PRIVATE_DATA      *PrivateData;
+  UINTN                  Index;
+  UINTN                  ExtentIndex;
+  UINTN                  RequestCount;
+  UINTN                  FirstRequest;
+  UINTN                  EfiFileSize;
+  UINTN                  ChunkSize;
+  UINTN                  ReadSize;
+  UINT8                  *ChunkPtr;
+
+  JumpStarts = AllocateZeroPool (Count * sizeof (*JumpStarts));
+  if (JumpStarts == NULL) {
+    for (Index = 0; Index < Count; ++Index) {
+      if (!EFI_ERROR (Contexts[Index].Status)) {
+        Contexts[Index].Status = EFI_OUT_OF_RESOURCES;
+      }
     }
+    return;
+  }
 
-    //
-    // Ensure APFS block size is:
-    // - A multiple of disk block size.
-    // - Divisible by UINT32 for fletcher checksum to work (e.g. when block size is 1 or 2).
-    // - Within minimum and maximum edges.
-    //
-    if (SuperBlock->BlockSize < BlockIo->Media->BlockSize
-      || (SuperBlock->BlockSize & (BlockIo->Media->BlockSize - 1)) != 0
-      || (SuperBlock->BlockSize & (sizeof (UINT32) - 1)) != 0
-      || SuperBlock->BlockSize < APFS_NX_MINIMUM_BLOCK_SIZE
-      || SuperBlock->BlockSize > APFS_NX_MAXIMUM_BLOCK_SIZE) {
-      break;
+  ApfsReadJumpStarts (Contexts, Count, JumpStarts);
+
+  //
+  // Read extents of all drivers at once.
+  //
+  RequestCount = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    if (JumpStarts[Index] != NULL) {
+      RequestCount += JumpStarts[Index]->NumExtents;
     }
+  }
 
-    //
-    // Check if we can calculate the checksum and try again on failure.
-    //
-    if (SuperBlock->BlockSize > ReadSize) {
-      ReadSize = SuperBlock->BlockSize;
-      FreePool (SuperBlock);
-      SuperBlock = NULL;
+  Requests = AllocateZeroPool (MAX (RequestCount, 1) * sizeof (*Requests));
+
+  RequestCount = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    Context   = &Contexts[Index];
+    JumpStart = JumpStarts[Index];
+    if (JumpStart == NULL) {
       continue;
     }
 
-    //
-    // Calculate and verify checksum.
-    //
-    if (!ApfsBlockChecksumVerify (&SuperBlock->BlockHeader, SuperBlock->BlockSize)) {
-      break;
+    if (Requests == NULL) {
+      Context->Status = EFI_OUT_OF_RESOURCES;
+      continue;
     }
 
-    //
-    // Verify object type and flags.
-    // SubType being 0 comes from ApfsJumpStart and is not documented.
-    // ObjectOid being 1 comes from ApfsJumpStart and is not documented.
-    //
-    if (SuperBlock->BlockHeader.ObjectType != (APFS_OBJ_EPHEMERAL | APFS_OBJECT_TYPE_NX_SUPERBLOCK)
-      || SuperBlock->BlockHeader.ObjectSubType != 0
-      || SuperBlock->BlockHeader.ObjectOid != 1) {
-      break;
+    PrivateData = Context->PrivateData;
+
+    EfiFileSize = JumpStart->EfiFileLen / PrivateData->ApfsBlockSize + 1;
+    if (OcOverflowMulUN (EfiFileSize, PrivateData->ApfsBlockSize, &EfiFileSize)) {
+      Context->Status = EFI_SECURITY_VIOLATION;
+      continue;
     }
 
     //
-    // Super block is assumed to be legit.
+    // Zeroed allocation ensures that we do not have meaningful trailing memory.
     //
-    *SuperBlockPtr = SuperBlock;
-    return EFI_SUCCESS;
+    Context->DriverBuffer = AllocateZeroPool (EfiFileSize);
+    if (Context->DriverBuffer == NULL) {
+      Context->Status = EFI_OUT_OF_RESOURCES;
+      continue;
+    }
+
+    ChunkPtr     = Context->DriverBuffer;
+    ReadSize     = 0;
+    FirstRequest = RequestCount;
+
+    for (ExtentIndex = 0; ExtentIndex < JumpStart->NumExtents; ++ExtentIndex) {
+      if (JumpStart->RecordExtents[ExtentIndex].BlockCount > MAX_UINTN
+        || OcOverflowMulUN ((UINTN) JumpStart->RecordExtents[ExtentIndex].BlockCount, PrivateData->ApfsBlockSize, &ChunkSize)
+        || ChunkSize > EfiFileSize - ReadSize) {
+        Context->Status = EFI_SECURITY_VIOLATION;
+        break;
+      }
+
+      Request          = &Requests[RequestCount++];
+      Request->Buffer  = ChunkPtr;
+      Request->Size    = ChunkSize;
+      Request->BlockIo = InternalApfsTranslateBlock (
+        PrivateData,
+        JumpStart->RecordExtents[ExtentIndex].StartPhysicalAddr,
+        &Request->Lba,
+        &Request->BlockIo2
+        );
+
+      ChunkPtr += ChunkSize;
+      ReadSize += ChunkSize;
+    }
+
+    if (!EFI_ERROR (Context->Status) && ReadSize < JumpStart->EfiFileLen) {
+      Context->Status = EFI_SECURITY_VIOLATION;
+    }
+
+    if (EFI_ERROR (Context->Status)) {
+      RequestCount = FirstRequest;
+      FreePool (Context->DriverBuffer);
+      Context->DriverBuffer = NULL;
+      continue;
+    }
+
+    Context->DriverSize = JumpStart->EfiFileLen;
   }
 
-  //
-  // All retry attempts exceeded.
-  //
-  if (SuperBlock != NULL) {
-    FreePool (SuperBlock);
+  if (Requests != NULL) {
+    InternalApfsReadBlocks (Requests, RequestCount);
   }
-  return EFI_UNSUPPORTED;
-}
 
-EFI_STATUS
-InternalApfsReadDriver (
-  IN  APFS_PRIVATE_DATA    *PrivateData,
-  OUT UINT32               *DriverSize,
-  OUT VOID                 **DriverBuffer
-  )
-{
-  EFI_STATUS             Status;
-  APFS_NX_EFI_JUMPSTART  *JumpStart;
+  RequestCount = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    Context   = &Contexts[Index];
+    JumpStart = JumpStarts[Index];
+    if (JumpStart == NULL) {
+      continue;
+    }
 
-  Status = ApfsReadJumpStart (
-    PrivateData,
-    &JumpStart
-    );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((
-      DEBUG_INFO,
-      "OCJS: Failed to read JumpStart for %g - %r\n",
-      &PrivateData->LocationInfo.ContainerUuid,
-      Status
-      ));
-    return Status;
-  }
+    if (Context->DriverBuffer != NULL) {
+      for (ExtentIndex = 0; ExtentIndex < JumpStart->NumExtents; ++ExtentIndex) {
+        if (EFI_ERROR (Requests[RequestCount].Status)) {
+          Context->Status = Requests[RequestCount].Status;
+        }
+        ++RequestCount;
+      }
+
+      if (EFI_ERROR (Context->Status)) {
+        FreePool (Context->DriverBuffer);
+        Context->DriverBuffer = NULL;
+      }
+    }
 
-  Status = ApfsReadDriver (
-    PrivateData,
-    JumpStart,
-    DriverSize,
-    DriverBuffer
-    );
+    if (EFI_ERROR (Context->Status)) {
+      DEBUG ((
+        DEBUG_INFO,
+        "OCJS: Failed to read driver for %g - %r\n",
+        &Context->PrivateData->LocationInfo.ContainerUuid,
+        Context->Status
+        ));
+    }
 
-  FreePool (JumpStart);
+    FreePool (JumpStart);
+  }
 
-  if (EFI_ERROR (Status)) {
-    DEBUG ((
-      DEBUG_INFO,
-      "OCJS: Failed to read driver for %g - %r\n",
-      &PrivateData->LocationInfo.ContainerUuid,
-      Status
-      ));
-    return Status;
+  if (Requests != NULL) {
+    FreePool (Requests);
   }
 
-  return EFI_SUCCESS;
+  FreePool (JumpStarts);
 }
@@ -99,6 +99,7 @@ OcApfsConnectParentDevice (
   EFI_DEVICE_PATH  *ParentDevicePath;
   EFI_DEVICE_PATH  *ChildDevicePath;
   UINTN            Index;
+  UINTN            MatchCount;
   UINTN            PrefixLength;
 
   HandleCount = 0;
@@ -127,7 +128,7 @@ OcApfsConnectParentDevice (
   }
 
   if (!EFI_ERROR (Status)) {
-    Status = EFI_NOT_FOUND;
+    MatchCount = 0;
 
     for (Index = 0; Index < HandleCount; ++Index) {
       if (ParentDevicePath != NULL && PrefixLength > 0) {
@@ -148,8 +149,17 @@ OcApfsConnectParentDevice (
         }
       }
 
-      Status2 = OcApfsConnectHandle (
-        HandleBuffer[Index],
+      HandleBuffer[MatchCount++] = HandleBuffer[Index];
+    }
+
+    //
+    // Connect all matching handles at once to overlap disk reads.
+    //
+    Status = EFI_NOT_FOUND;
+    if (MatchCount > 0) {
+      Status2 = InternalApfsConnectHandles (
+        HandleBuffer,
+        MatchCount,
         VerifyPolicy
         );
       if (!EFI_ERROR (Status2)) {
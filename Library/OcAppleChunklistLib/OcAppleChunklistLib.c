@@ -19,6 +19,7 @@
 #include <Library/OcAppleRamDiskLib.h>
 #include <Library/OcCryptoLib.h>
 #include <Library/OcGuardLib.h>
+#include <Library/OcParallelLib.h>
 
 BOOLEAN
 OcAppleChunklistInitializeContext (
@@ -124,21 +125,116 @@ OcAppleChunklistVerifySignature (
   return Result;
 }
 
+/**
+  Chunk verification job context.
+**/
+typedef struct {
+  CONST OC_APPLE_CHUNKLIST_CONTEXT   *Chunklist;
+  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable;
+  CONST UINTN                        *Offsets;
+  volatile BOOLEAN                   Failed;
+} OC_APPLE_CHUNKLIST_VERIFY_JOB;
+
+/**
+  Hash RAM disk data directly from the extents without copying.
+
+  @param[in]  ExtentTable  RAM disk extent table.
+  @param[in]  Offset       Data offset.
+  @param[in]  Size         Data size.
+  @param[out] Hash         Resulting SHA-256 hash.
+
+  @retval TRUE when the whole range was hashed.
+**/
+STATIC
+BOOLEAN
+InternalHashRamDiskRange (
+  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN  UINTN                              Offset,
+  IN  UINTN                              Size,
+  OUT UINT8                              *Hash
+  )
+{
+  SHA256_CONTEXT               Sha256Context;
+  UINT32                       Index;
+  CONST APPLE_RAM_DISK_EXTENT  *Extent;
+  UINTN                        CurrentOffset;
+  UINTN                        LocalOffset;
+  UINTN                        LocalSize;
+
+  Sha256Init (&Sha256Context);
+
+  for (
+    Index = 0, CurrentOffset = 0;
+    Index < ExtentTable->ExtentCount && Size > 0;
+    ++Index, CurrentOffset += (UINTN) Extent->Length
+    ) {
+    Extent = &ExtentTable->Extents[Index];
+
+    if (Offset >= CurrentOffset && (Offset - CurrentOffset) < Extent->Length) {
+      LocalOffset = Offset - CurrentOffset;
+      LocalSize   = (UINTN) MIN (Extent->Length - LocalOffset, Size);
+
+      Sha256Update (
+        &Sha256Context,
+        (CONST UINT8 *) (UINTN) Extent->Start + LocalOffset,
+        LocalSize
+        );
+
+      Size   -= LocalSize;
+      Offset += LocalSize;
+    }
+  }
+
+  if (Size > 0) {
+    return FALSE;
+  }
+
+  Sha256Final (&Sha256Context, Hash);
+  return TRUE;
+}
+
+/**
+  Verify a single chunk. Executed on any processor.
+
+  @param[in]      Index    Chunk index.
+  @param[in,out]  Context  Chunk verification job context.
+**/
+STATIC
+VOID
+EFIAPI
+InternalVerifyChunk (
+  IN     UINTN  Index,
+  IN OUT VOID   *Context
+  )
+{
+  OC_APPLE_CHUNKLIST_VERIFY_JOB  *Job;
+  CONST APPLE_CHUNKLIST_CHUNK    *Chunk;
+  UINT8                          ChunkHash[SHA256_DIGEST_SIZE];
+
+  Job = Context;
+
+  if (Job->Failed) {
+    return;
+  }
+
+  Chunk = &Job->Chunklist->Chunks[Index];
+
+  if (!InternalHashRamDiskRange (Job->ExtentTable, Job->Offsets[Index], Chunk->Length, ChunkHash)
+    || CompareMem (ChunkHash, Chunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
+    Job->Failed = TRUE;
+  }
+}
+
 BOOLEAN
 OcAppleChunklistVerifyData (
   IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
   IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
   )
 {
-  BOOLEAN                     Result;
-
-  UINTN                       Index;
-  UINT8                       ChunkHash[SHA256_DIGEST_SIZE];
-  CONST APPLE_CHUNKLIST_CHUNK *CurrentChunk;
-  UINTN                       CurrentOffset;
-
-  UINT32                      ChunkDataSize;
-  VOID                        *ChunkData;
+  OC_APPLE_CHUNKLIST_VERIFY_JOB  Job;
+  UINTN                          *Offsets;
+  UINTN                          Index;
+  UINTN                          CurrentOffset;
 
   ASSERT (Context != NULL);
   ASSERT (Context->Chunks != NULL);
@@ -148,47 +244,46 @@ OcAppleChunklistVerifyData (
     ASSERT (Context->Signature == NULL);
     );
 
-  ChunkDataSize = 0;
-  for (Index = 0; Index < Context->ChunkCount; ++Index) {
-    CurrentChunk = &Context->Chunks[Index];
-    if (ChunkDataSize < CurrentChunk->Length) {
-      ChunkDataSize = CurrentChunk->Length;
-    }
+  if (Context->ChunkCount == 0) {
+    return TRUE;
+  }
+
+  if (OcOverflowMulUN (Context->ChunkCount, sizeof (*Offsets), &CurrentOffset)) {
+    return FALSE;
   }
 
-  ChunkData = AllocatePool (ChunkDataSize);
-  if (ChunkData == NULL) {
+  Offsets = AllocatePool (CurrentOffset);
+  if (Offsets == NULL) {
     return FALSE;
   }
 
   CurrentOffset = 0;
-  for (Index = 0; Index < Context->ChunkCount; Index++) {
-    CurrentChunk = &Context->Chunks[Index];
-
-    Result = OcAppleRamDiskRead (
-               ExtentTable,
-               CurrentOffset,
-               CurrentChunk->Length,
-               ChunkData
-               );
-    if (!Result) {
-      FreePool (ChunkData);
-      return FALSE;
-    }
-    //
-    // Calculate checksum of data and ensure they match.
-    //
-    DEBUG ((DEBUG_VERBOSE, "OCCL: Validating chunk %lu of %lu\n",
-      (UINT64)Index + 1, (UINT64)Context->ChunkCount));
-    Sha256 (ChunkHash, ChunkData, CurrentChunk->Length);
-    if (CompareMem (ChunkHash, CurrentChunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
-      FreePool (ChunkData);
+  for (Index = 0; Index < Context->ChunkCount; ++Index) {
+    Offsets[Index] = CurrentOffset;
+    if (OcOverflowAddUN (CurrentOffset, Context->Chunks[Index].Length, &CurrentOffset)) {
+      FreePool (Offsets);
       return FALSE;
     }
-
-    CurrentOffset += CurrentChunk->Length;
   }
 
-  FreePool (ChunkData);
-  return TRUE;
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCCL: Validating %Lu chunks on %Lu processors\n",
+    (UINT64) Context->ChunkCount,
+    (UINT64) OcParallelGetWorkerCount ()
+    ));
+
+  //
+  // Chunks are hashed straight from RAM disk memory, which makes each chunk
+  // an independent pure computation suitable for running on APs.
+  //
+  Job.Chunklist   = Context;
+  Job.ExtentTable = ExtentTable;
+  Job.Offsets     = Offsets;
+  Job.Failed      = FALSE;
+
+  OcParallelRun (InternalVerifyChunk, &Job, Context->ChunkCount);
+
+  FreePool (Offsets);
+  return !Job.Failed;
 }
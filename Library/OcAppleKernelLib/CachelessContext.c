@@ -65,6 +65,21 @@ FreeBuiltInKext (
   FreePool (BuiltinKext);
 }
 
+STATIC
+VOID
+InternalFreeBuiltInKexts (
+  IN OUT CACHELESS_CONTEXT    *Context
+  )
+{
+  LIST_ENTRY        *KextLink;
+
+  while (!IsListEmpty (&Context->BuiltInKexts)) {
+    KextLink = GetFirstNode (&Context->BuiltInKexts);
+    RemoveEntryList (KextLink);
+    FreeBuiltInKext (GET_BUILTIN_KEXT_FROM_LINK (KextLink));
+  }
+}
+
 STATIC
 EFI_STATUS
 AddKextDependency (
@@ -447,6 +462,315 @@ ScanExtensions (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+InternalGetExtensionsTime (
+  IN  CACHELESS_CONTEXT  *Context,
+  OUT EFI_TIME           *Time
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = GetFileModificationTime (Context->ExtensionsDir, Time);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Some drivers do not report modification time, the index cannot be
+  // validated in this case.
+  //
+  if (Time->Year == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Time->Pad1 = 0;
+  Time->Pad2 = 0;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+InternalGetKextFileStamp (
+  IN  CACHELESS_CONTEXT      *Context,
+  IN  CONST CHAR16           *Path,
+  OUT CACHELESS_INDEX_STAMP  *Stamp
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *File;
+  UINTN              PrefixLength;
+
+  ZeroMem (Stamp, sizeof (*Stamp));
+
+  //
+  // Built-in kext paths are within Extensions directory.
+  //
+  PrefixLength = StrLen (Context->ExtensionsDirFileName);
+  if (StrnCmp (Path, Context->ExtensionsDirFileName, PrefixLength) != 0
+    || Path[PrefixLength] != L'\\'
+    || Path[PrefixLength + 1] == L'\0') {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = SafeFileOpen (
+    Context->ExtensionsDir,
+    &File,
+    &Path[PrefixLength + 1],
+    EFI_FILE_MODE_READ,
+    0
+    );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = GetFileSize (File, &Stamp->Size);
+  if (!EFI_ERROR (Status)) {
+    Status = GetFileModificationTime (File, &Stamp->ModificationTime);
+  }
+
+  File->Close (File);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Stamp->ModificationTime.Year == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Stamp->ModificationTime.Pad1 = 0;
+  Stamp->ModificationTime.Pad2 = 0;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+InternalGetKextStamps (
+  IN  CACHELESS_CONTEXT      *Context,
+  IN  BUILTIN_KEXT           *BuiltinKext,
+  OUT CACHELESS_INDEX_STAMP  *PlistStamp,
+  OUT CACHELESS_INDEX_STAMP  *BinaryStamp
+  )
+{
+  EFI_STATUS  Status;
+
+  ZeroMem (BinaryStamp, sizeof (*BinaryStamp));
+
+  Status = InternalGetKextFileStamp (Context, BuiltinKext->PlistPath, PlistStamp);
+  if (EFI_ERROR (Status) || BuiltinKext->BinaryPath == NULL) {
+    return Status;
+  }
+
+  return InternalGetKextFileStamp (Context, BuiltinKext->BinaryPath, BinaryStamp);
+}
+
+STATIC
+EFI_STATUS
+InternalValidateIndexStamps (
+  IN CACHELESS_CONTEXT  *Context
+  )
+{
+  EFI_STATUS             Status;
+  BUILTIN_KEXT           *BuiltinKext;
+  LIST_ENTRY             *KextLink;
+  CACHELESS_INDEX_STAMP  PlistStamp;
+  CACHELESS_INDEX_STAMP  BinaryStamp;
+
+  KextLink = GetFirstNode (&Context->BuiltInKexts);
+  while (!IsNull (&Context->BuiltInKexts, KextLink)) {
+    BuiltinKext = GET_BUILTIN_KEXT_FROM_LINK (KextLink);
+    KextLink    = GetNextNode (&Context->BuiltInKexts, KextLink);
+
+    //
+    // Unused kexts are not read, so their changes do not matter.
+    //
+    if (!BuiltinKext->PatchKext && !BuiltinKext->PatchValidOSBundleRequired) {
+      continue;
+    }
+
+    //
+    // This also ensures that the paths are within Extensions directory.
+    //
+    Status = InternalGetKextStamps (Context, BuiltinKext, &PlistStamp, &BinaryStamp);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (CompareMem (&BuiltinKext->PlistStamp, &PlistStamp, sizeof (PlistStamp)) != 0
+      || CompareMem (&BuiltinKext->BinaryStamp, &BinaryStamp, sizeof (BinaryStamp)) != 0) {
+      DEBUG ((DEBUG_INFO, "OCAK: Built-in kext %a changed since indexing\n", BuiltinKext->Identifier));
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+BOOLEAN
+InternalIndexPut (
+  IN OUT UINT8        *Index  OPTIONAL,
+  IN OUT UINT32       *Offset,
+  IN     CONST VOID   *Data,
+  IN     UINT32       Size
+  )
+{
+  UINT32  NewOffset;
+
+  if (OcOverflowAddU32 (*Offset, Size, &NewOffset)) {
+    return FALSE;
+  }
+
+  if (Index != NULL && Size > 0) {
+    CopyMem (&Index[*Offset], Data, Size);
+  }
+
+  *Offset = NewOffset;
+  return TRUE;
+}
+
+STATIC
+CONST VOID *
+InternalIndexGet (
+  IN     CONST UINT8  *Index,
+  IN     UINT32       IndexSize,
+  IN OUT UINT32       *Offset,
+  IN     UINT32       Size
+  )
+{
+  CONST VOID  *Data;
+
+  if (IndexSize - *Offset < Size) {
+    return NULL;
+  }
+
+  Data     = &Index[*Offset];
+  *Offset += Size;
+  return Data;
+}
+
+STATIC
+VOID *
+InternalIndexGetString (
+  IN     CONST UINT8  *Index,
+  IN     UINT32       IndexSize,
+  IN OUT UINT32       *Offset,
+  IN     UINT32       Size,
+  IN     BOOLEAN      IsUnicode
+  )
+{
+  CONST UINT8  *Data;
+  UINT32       CharSize;
+
+  CharSize = IsUnicode ? sizeof (CHAR16) : sizeof (CHAR8);
+
+  if (Size < CharSize || Size % CharSize != 0) {
+    return NULL;
+  }
+
+  Data = InternalIndexGet (Index, IndexSize, Offset, Size);
+  if (Data == NULL
+    || Data[Size - 1] != 0
+    || (IsUnicode && Data[Size - 2] != 0)) {
+    return NULL;
+  }
+
+  //
+  // Copying also ensures alignment.
+  //
+  return AllocateCopyPool (Size, Data);
+}
+
+STATIC
+EFI_STATUS
+InternalExportIndex (
+  IN     CACHELESS_CONTEXT       *Context,
+  IN OUT CACHELESS_INDEX_HEADER  *Header,
+     OUT UINT8                   *Index  OPTIONAL,
+     OUT UINT32                  *IndexSize
+  )
+{
+  EFI_STATUS            Status;
+  BUILTIN_KEXT          *BuiltinKext;
+  DEPEND_KEXT           *DependKext;
+  LIST_ENTRY            *KextLink;
+  LIST_ENTRY            *DependLink;
+  CACHELESS_INDEX_KEXT  Entry;
+  UINT32                Offset;
+  UINT32                Size;
+  BOOLEAN               Result;
+
+  //
+  // Header is written last, once the size is known.
+  //
+  Offset = sizeof (*Header);
+
+  KextLink = GetFirstNode (&Context->BuiltInKexts);
+  while (!IsNull (&Context->BuiltInKexts, KextLink)) {
+    BuiltinKext = GET_BUILTIN_KEXT_FROM_LINK (KextLink);
+
+    ZeroMem (&Entry, sizeof (Entry));
+    Entry.OSBundleRequiredValue = BuiltinKext->OSBundleRequiredValue;
+    Entry.IdentifierSize        = (UINT32) AsciiStrSize (BuiltinKext->Identifier);
+    Entry.PlistPathSize         = (UINT32) StrSize (BuiltinKext->PlistPath);
+    if (BuiltinKext->BinaryFileName != NULL && BuiltinKext->BinaryPath != NULL) {
+      Entry.BinaryFileNameSize  = (UINT32) StrSize (BuiltinKext->BinaryFileName);
+      Entry.BinaryPathSize      = (UINT32) StrSize (BuiltinKext->BinaryPath);
+    }
+
+    DependLink = GetFirstNode (&BuiltinKext->Dependencies);
+    while (!IsNull (&BuiltinKext->Dependencies, DependLink)) {
+      ++Entry.DependencyCount;
+      DependLink = GetNextNode (&BuiltinKext->Dependencies, DependLink);
+    }
+
+    //
+    // Stamps do not affect the size, so only obtain them when serialising.
+    //
+    if (Index != NULL) {
+      Status = InternalGetKextStamps (Context, BuiltinKext, &Entry.PlistStamp, &Entry.BinaryStamp);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_INFO, "OCAK: Failed to stamp %a for index - %r\n", BuiltinKext->Identifier, Status));
+        return Status;
+      }
+    }
+
+    Result = InternalIndexPut (Index, &Offset, &Entry, sizeof (Entry))
+      && InternalIndexPut (Index, &Offset, BuiltinKext->Identifier, Entry.IdentifierSize)
+      && InternalIndexPut (Index, &Offset, BuiltinKext->PlistPath, Entry.PlistPathSize)
+      && InternalIndexPut (Index, &Offset, BuiltinKext->BinaryFileName, Entry.BinaryFileNameSize)
+      && InternalIndexPut (Index, &Offset, BuiltinKext->BinaryPath, Entry.BinaryPathSize);
+    if (!Result) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    DependLink = GetFirstNode (&BuiltinKext->Dependencies);
+    while (!IsNull (&BuiltinKext->Dependencies, DependLink)) {
+      DependKext = GET_DEPEND_KEXT_FROM_LINK (DependLink);
+      Size       = (UINT32) AsciiStrSize (DependKext->Identifier);
+
+      Result = InternalIndexPut (Index, &Offset, &Size, sizeof (Size))
+        && InternalIndexPut (Index, &Offset, DependKext->Identifier, Size);
+      if (!Result) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      DependLink = GetNextNode (&BuiltinKext->Dependencies, DependLink);
+    }
+
+    KextLink = GetNextNode (&Context->BuiltInKexts, KextLink);
+  }
+
+  Header->Size = Offset;
+  if (Index != NULL) {
+    CopyMem (Index, Header, sizeof (*Header));
+  }
+
+  *IndexSize = Offset;
+  return EFI_SUCCESS;
+}
+
 STATIC
 PATCHED_KEXT*
 LookupPatchedKextForIdentifier (
@@ -754,20 +1078,229 @@ CachelessContextFree (
     KextLink = GetFirstNode (&Context->BuiltInKexts);
     BuiltinKext = GET_BUILTIN_KEXT_FROM_LINK (KextLink);
     RemoveEntryList (KextLink);
+    FreeBuiltInKext (BuiltinKext);
+  }
+  
+  ZeroMem (Context, sizeof (*Context));
+}
+
+STATIC
+EFI_STATUS
+InternalValidateIndexKext (
+  IN BUILTIN_KEXT                *BuiltinKext
+  )
+{
+  UINTN  PathLength;
+  UINTN  NameLength;
+
+  if (BuiltinKext->Identifier[0] == '\0') {
+    return EFI_INVALID_PARAMETER;
+  }
 
-    if (BuiltinKext->PlistPath != NULL) {
-      FreePool (BuiltinKext->PlistPath);
+  //
+  // Binary file name must match the end of binary path.
+  //
+  if (BuiltinKext->BinaryPath != NULL) {
+    PathLength = StrLen (BuiltinKext->BinaryPath);
+    NameLength = StrLen (BuiltinKext->BinaryFileName);
+    if (NameLength == 0
+      || PathLength <= NameLength
+      || BuiltinKext->BinaryPath[PathLength - NameLength - 1] != L'\\'
+      || StrCmp (&BuiltinKext->BinaryPath[PathLength - NameLength], BuiltinKext->BinaryFileName) != 0) {
+      return EFI_INVALID_PARAMETER;
     }
-    if (BuiltinKext->Identifier != NULL) {
-      FreePool (BuiltinKext->Identifier);
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+CachelessContextLoadIndex (
+  IN OUT CACHELESS_CONTEXT    *Context,
+  IN     CONST VOID           *Index,
+  IN     UINT32               IndexSize
+  )
+{
+  EFI_STATUS                    Status;
+  CONST CACHELESS_INDEX_HEADER  *Header;
+  CONST CACHELESS_INDEX_KEXT    *Entry;
+  CONST UINT32                  *DependSize;
+  BUILTIN_KEXT                  *BuiltinKext;
+  CHAR8                         *Identifier;
+  EFI_TIME                      ModificationTime;
+  UINT32                        Offset;
+  UINT32                        KextIndex;
+  UINT32                        DependIndex;
+
+  ASSERT (Context != NULL);
+  ASSERT (Index != NULL);
+  ASSERT (!Context->BuiltInKextsValid);
+  ASSERT (IsListEmpty (&Context->BuiltInKexts));
+
+  Status = InternalGetExtensionsTime (Context, &ModificationTime);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Offset = 0;
+  Header = InternalIndexGet (Index, IndexSize, &Offset, sizeof (*Header));
+  if (Header == NULL
+    || Header->Signature != CACHELESS_INDEX_SIGNATURE
+    || Header->Version != CACHELESS_INDEX_VERSION
+    || Header->Size != IndexSize) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (Header->KernelVersion != Context->KernelVersion
+    || CompareMem (&Header->ModificationTime, &ModificationTime, sizeof (ModificationTime)) != 0) {
+    DEBUG ((DEBUG_INFO, "OCAK: Built-in kext index is outdated\n"));
+    return EFI_NOT_FOUND;
+  }
+
+  Status = EFI_SUCCESS;
+
+  for (KextIndex = 0; KextIndex < Header->KextCount && !EFI_ERROR (Status); ++KextIndex) {
+    Entry = InternalIndexGet (Index, IndexSize, &Offset, sizeof (*Entry));
+    if (Entry == NULL
+      || Entry->OSBundleRequiredValue > KEXT_OSBUNDLE_REQUIRED_VALID
+      || Entry->Reserved[0] != 0
+      || Entry->Reserved[1] != 0
+      || Entry->Reserved[2] != 0
+      || (Entry->BinaryFileNameSize == 0) != (Entry->BinaryPathSize == 0)) {
+      Status = EFI_INVALID_PARAMETER;
+      break;
+    }
+
+    BuiltinKext = AllocateZeroPool (sizeof (*BuiltinKext));
+    if (BuiltinKext == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
     }
-    if (BuiltinKext->BinaryFileName != NULL) {
-      FreePool (BuiltinKext->BinaryFileName);
+    BuiltinKext->Signature             = BUILTIN_KEXT_SIGNATURE;
+    BuiltinKext->OSBundleRequiredValue = Entry->OSBundleRequiredValue;
+    InitializeListHead (&BuiltinKext->Dependencies);
+    InsertTailList (&Context->BuiltInKexts, &BuiltinKext->Link);
+
+    BuiltinKext->Identifier = InternalIndexGetString (Index, IndexSize, &Offset, Entry->IdentifierSize, FALSE);
+    BuiltinKext->PlistPath  = InternalIndexGetString (Index, IndexSize, &Offset, Entry->PlistPathSize, TRUE);
+    if (BuiltinKext->Identifier == NULL || BuiltinKext->PlistPath == NULL) {
+      Status = EFI_INVALID_PARAMETER;
+      break;
+    }
+
+    if (Entry->BinaryPathSize > 0) {
+      BuiltinKext->BinaryFileName = InternalIndexGetString (Index, IndexSize, &Offset, Entry->BinaryFileNameSize, TRUE);
+      BuiltinKext->BinaryPath     = InternalIndexGetString (Index, IndexSize, &Offset, Entry->BinaryPathSize, TRUE);
+      if (BuiltinKext->BinaryFileName == NULL || BuiltinKext->BinaryPath == NULL) {
+        Status = EFI_INVALID_PARAMETER;
+        break;
+      }
+    }
+
+    Status = InternalValidateIndexKext (BuiltinKext);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    //
+    // Checking file stamps requires opening the files, so only do that
+    // for the kexts actually used by CachelessContextHookBuiltin.
+    //
+    CopyMem (&BuiltinKext->PlistStamp, &Entry->PlistStamp, sizeof (BuiltinKext->PlistStamp));
+    CopyMem (&BuiltinKext->BinaryStamp, &Entry->BinaryStamp, sizeof (BuiltinKext->BinaryStamp));
+
+    for (DependIndex = 0; DependIndex < Entry->DependencyCount; ++DependIndex) {
+      DependSize = InternalIndexGet (Index, IndexSize, &Offset, sizeof (*DependSize));
+      if (DependSize == NULL) {
+        Status = EFI_INVALID_PARAMETER;
+        break;
+      }
+
+      Identifier = InternalIndexGetString (Index, IndexSize, &Offset, ReadUnaligned32 (DependSize), FALSE);
+      if (Identifier == NULL) {
+        Status = EFI_INVALID_PARAMETER;
+        break;
+      }
+
+      Status = AddKextDependency (&BuiltinKext->Dependencies, Identifier);
+      FreePool (Identifier);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
     }
-    FreePool (BuiltinKext);
   }
-  
-  ZeroMem (Context, sizeof (*Context));
+
+  if (!EFI_ERROR (Status) && Offset != IndexSize) {
+    Status = EFI_INVALID_PARAMETER;
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Built-in kext index is invalid - %r\n", Status));
+    InternalFreeBuiltInKexts (Context);
+    return Status;
+  }
+
+  Context->BuiltInKextsIndexed = TRUE;
+  DEBUG ((DEBUG_INFO, "OCAK: Loaded %u built-in kexts from index\n", Header->KextCount));
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+CachelessContextExportIndex (
+  IN     CACHELESS_CONTEXT    *Context,
+     OUT VOID                 **Index,
+     OUT UINT32               *IndexSize
+  )
+{
+  EFI_STATUS              Status;
+  CACHELESS_INDEX_HEADER  Header;
+  LIST_ENTRY              *KextLink;
+
+  ASSERT (Context != NULL);
+  ASSERT (Index != NULL);
+  ASSERT (IndexSize != NULL);
+
+  if (!Context->BuiltInKextsValid) {
+    return EFI_NOT_READY;
+  }
+
+  ZeroMem (&Header, sizeof (Header));
+  Status = InternalGetExtensionsTime (Context, &Header.ModificationTime);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Header.Signature     = CACHELESS_INDEX_SIGNATURE;
+  Header.Version       = CACHELESS_INDEX_VERSION;
+  Header.KernelVersion = Context->KernelVersion;
+
+  KextLink = GetFirstNode (&Context->BuiltInKexts);
+  while (!IsNull (&Context->BuiltInKexts, KextLink)) {
+    ++Header.KextCount;
+    KextLink = GetNextNode (&Context->BuiltInKexts, KextLink);
+  }
+
+  //
+  // Calculate the size first, then serialise.
+  //
+  Status = InternalExportIndex (Context, &Header, NULL, IndexSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  *Index = AllocatePool (*IndexSize);
+  if (*Index == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = InternalExportIndex (Context, &Header, *Index, IndexSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (*Index);
+    *Index = NULL;
+  }
+
+  return Status;
 }
 
 EFI_STATUS
@@ -1294,6 +1827,72 @@ CachelessContextPerformInject (
   return EFI_NOT_FOUND;
 }
 
+STATIC
+EFI_STATUS
+InternalBuildBuiltInKexts (
+  IN OUT CACHELESS_CONTEXT    *Context
+  )
+{
+  EFI_STATUS          Status;
+  BUILTIN_KEXT        *BuiltinKext;
+  PATCHED_KEXT        *PatchedKext;
+  DEPEND_KEXT         *DependKext;
+  LIST_ENTRY          *KextLink;
+
+  //
+  // Build list of kexts in system Extensions directory, unless it was
+  // loaded from a valid index.
+  //
+  if (!Context->BuiltInKextsIndexed) {
+    Status = ScanExtensions (Context, Context->ExtensionsDir, Context->ExtensionsDirFileName, TRUE);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  //
+  // Ensure all kexts to be patched will be loaded.
+  //
+  KextLink = GetFirstNode (&Context->PatchedKexts);
+  while (!IsNull (&Context->PatchedKexts, KextLink)) {
+    PatchedKext = GET_PATCHED_KEXT_FROM_LINK (KextLink);
+
+    BuiltinKext = LookupBuiltinKextForIdentifier (Context, PatchedKext->Identifier);
+    if (BuiltinKext == NULL) {
+      //
+      // Kext is not present, skip.
+      //
+      DEBUG ((DEBUG_WARN, "OCAK: Attempted to patch non-existent kext %a\n", PatchedKext->Identifier));
+      
+    } else {
+      BuiltinKext->PatchKext = TRUE;
+      Status = ScanDependencies (Context, PatchedKext->Identifier);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    KextLink = GetNextNode (&Context->PatchedKexts, KextLink);
+  }
+
+  //
+  // Scan dependencies, adding any others besides ones being injected.
+  //
+  KextLink = GetFirstNode (&Context->InjectedDependencies);
+  while (!IsNull (&Context->InjectedDependencies, KextLink)) {
+    DependKext = GET_DEPEND_KEXT_FROM_LINK (KextLink);
+
+    Status = ScanDependencies (Context, DependKext->Identifier);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    KextLink = GetNextNode (&Context->InjectedDependencies, KextLink);
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 CachelessContextHookBuiltin (
   IN OUT CACHELESS_CONTEXT    *Context,
@@ -1307,7 +1906,6 @@ CachelessContextHookBuiltin (
   BUILTIN_KEXT        *BuiltinKext;
   KEXT_PATCH          *KextPatch;
   PATCHED_KEXT        *PatchedKext;
-  DEPEND_KEXT         *DependKext;
   LIST_ENTRY          *KextLink;
 
   PATCHER_CONTEXT     Patcher;
@@ -1336,52 +1934,19 @@ CachelessContextHookBuiltin (
   if (!Context->BuiltInKextsValid) {
     DEBUG ((DEBUG_INFO, "OCAK: Built-in kext cache is not yet built, building...\n"));
 
-    //
-    // Build list of kexts in system Extensions directory.
-    //
-    Status = ScanExtensions (Context, Context->ExtensionsDir, Context->ExtensionsDirFileName, TRUE);
-    if (EFI_ERROR (Status)) {
-      return Status;
-    }
-
-    //
-    // Ensure all kexts to be patched will be loaded.
-    //
-    KextLink = GetFirstNode (&Context->PatchedKexts);
-    while (!IsNull (&Context->PatchedKexts, KextLink)) {
-      PatchedKext = GET_PATCHED_KEXT_FROM_LINK (KextLink);
-
-      BuiltinKext = LookupBuiltinKextForIdentifier (Context, PatchedKext->Identifier);
-      if (BuiltinKext == NULL) {
-        //
-        // Kext is not present, skip.
-        //
-        DEBUG ((DEBUG_WARN, "OCAK: Attempted to patch non-existent kext %a\n", PatchedKext->Identifier));
-        
-      } else {
-        BuiltinKext->PatchKext = TRUE;
-        Status = ScanDependencies (Context, PatchedKext->Identifier);
-        if (EFI_ERROR (Status)) {
-          return Status;
-        }
-      }
-
-      KextLink = GetNextNode (&Context->PatchedKexts, KextLink);
-    }
-
-    //
-    // Scan dependencies, adding any others besides ones being injected.
-    //
-    KextLink = GetFirstNode (&Context->InjectedDependencies);
-    while (!IsNull (&Context->InjectedDependencies, KextLink)) {
-      DependKext = GET_DEPEND_KEXT_FROM_LINK (KextLink);
-
-      Status = ScanDependencies (Context, DependKext->Identifier);
+    Status = InternalBuildBuiltInKexts (Context);
+    if (!EFI_ERROR (Status) && Context->BuiltInKextsIndexed) {
+      Status = InternalValidateIndexStamps (Context);
       if (EFI_ERROR (Status)) {
-        return Status;
+        DEBUG ((DEBUG_INFO, "OCAK: Built-in kext index is outdated - %r, rescanning\n", Status));
+        InternalFreeBuiltInKexts (Context);
+        Context->BuiltInKextsIndexed = FALSE;
+        Status = InternalBuildBuiltInKexts (Context);
       }
+    }
 
-      KextLink = GetNextNode (&Context->InjectedDependencies, KextLink);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
 
     Context->BuiltInKextsValid = TRUE;
@@ -1541,6 +2106,8 @@ CachelessContextHookBuiltin (
           ));
       }
 
+      MachoFreeSymbolIndex (&Patcher.MachContext);
+
       //
       // Virtualize patched binary.
       //
@@ -141,6 +141,24 @@ typedef struct {
   BOOLEAN             Block;
 } PATCHED_KEXT;
 
+#pragma pack(push, 1)
+
+//
+// Built-in kext file stamp, all zero for missing files.
+//
+typedef PACKED struct {
+  //
+  // File modification time with zero padding.
+  //
+  EFI_TIME            ModificationTime;
+  //
+  // File size.
+  //
+  UINT32              Size;
+} CACHELESS_INDEX_STAMP;
+
+#pragma pack(pop)
+
 //
 // Built-in kexts in SLE.
 //
@@ -185,6 +203,14 @@ typedef struct {
   // Needs patches or blocks?
   //
   BOOLEAN             PatchKext;
+  //
+  // Info.plist stamp from the index, checked once the kext is used.
+  //
+  CACHELESS_INDEX_STAMP PlistStamp;
+  //
+  // Binary stamp from the index or zero, checked once the kext is used.
+  //
+  CACHELESS_INDEX_STAMP BinaryStamp;
 } BUILTIN_KEXT;
 
 //
@@ -277,4 +303,88 @@ typedef struct {
     BUILTIN_KEXT_SIGNATURE                \
     ))
 
+//
+// Built-in kext index signature and version.
+//
+#define CACHELESS_INDEX_SIGNATURE  SIGNATURE_32 ('O', 'c', 'K', 'i')
+#define CACHELESS_INDEX_VERSION    2
+
+#pragma pack(push, 1)
+
+//
+// Built-in kext index header.
+//
+typedef PACKED struct {
+  //
+  // Index signature, CACHELESS_INDEX_SIGNATURE.
+  //
+  UINT32              Signature;
+  //
+  // Index version, CACHELESS_INDEX_VERSION.
+  //
+  UINT32              Version;
+  //
+  // Full index size including this header.
+  //
+  UINT32              Size;
+  //
+  // Kernel version the index was built for.
+  //
+  UINT32              KernelVersion;
+  //
+  // Extensions directory modification time the index was built for.
+  //
+  EFI_TIME            ModificationTime;
+  //
+  // Number of CACHELESS_INDEX_KEXT entries following the header.
+  //
+  UINT32              KextCount;
+} CACHELESS_INDEX_HEADER;
+
+//
+// Built-in kext index entry. Followed by null-terminated identifier,
+// plist path, binary file name and binary path (the latter two optional),
+// and then by DependencyCount size-prefixed null-terminated identifiers.
+//
+typedef PACKED struct {
+  //
+  // OSBundleRequired value.
+  //
+  UINT8               OSBundleRequiredValue;
+  //
+  // Reserved for future use.
+  //
+  UINT8               Reserved[3];
+  //
+  // Number of OSBundleLibraries entries.
+  //
+  UINT32              DependencyCount;
+  //
+  // Identifier size including null terminator.
+  //
+  UINT32              IdentifierSize;
+  //
+  // Plist path size including null terminator.
+  //
+  UINT32              PlistPathSize;
+  //
+  // Binary file name size including null terminator or 0.
+  //
+  UINT32              BinaryFileNameSize;
+  //
+  // Binary path size including null terminator or 0.
+  //
+  UINT32              BinaryPathSize;
+  //
+  // Info.plist stamp the entry was built for.
+  //
+  CACHELESS_INDEX_STAMP PlistStamp;
+  //
+  // Binary stamp the entry was built for or zero.
+  //
+  CACHELESS_INDEX_STAMP BinaryStamp;
+} CACHELESS_INDEX_KEXT;
+
+#pragma pack(pop)
+
 #endif
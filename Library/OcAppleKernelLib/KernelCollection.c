@@ -414,67 +414,24 @@ KcInitKextFixupChains (
 }
 
 /*
-  Indexes RelocInfo into the fixup chains SegChain of Segment.
+  Converts the relocation target at RelocOffsetInSeg into a fixup.
 
-  @param[in,out] Context      Prelinked context.
-  @param[in]     MachContext  The context of the Mach-O RelocInfo belongs to. It
-                              must have been prelinked by OcAppleKernelLib. The
-                              image must reside in Segment.
-  @param[in]     RelocInfo    The relocation to add a fixup of.
-  @param[in]     RelocBase    The relocation base address.
+  @param[in] SegmentData       Kexts segment data.
+  @param[in] RelocOffsetInSeg  Relocation offset within the segment.
+  @param[in] Next              Offset delta to the next fixup of the page or 0.
 */
 STATIC
 VOID
-InternalKcConvertRelocToFixup (
-  IN OUT PRELINKED_CONTEXT           *Context,
-  IN     OC_MACHO_CONTEXT            *MachContext,
-  IN     CONST MACH_RELOCATION_INFO  *RelocInfo,
-  IN     UINT64                      RelocBase
+InternalKcWriteFixup (
+  IN UINT8   *SegmentData,
+  IN UINT32  RelocOffsetInSeg,
+  IN UINT16  Next
   )
 {
-  UINT8                                        *SegmentData;
-  UINT8                                        *SegmentPageData;
-
-  UINT64                                       RelocAddress;
-  UINT32                                       RelocOffsetInSeg;
   VOID                                         *RelocDest;
-
-  UINT16                                       NewFixupPage;
-  UINT16                                       NewFixupPageOffset;
   MACH_DYLD_CHAINED_PTR_64_KERNEL_CACHE_REBASE NewFixup;
 
-  UINT16                                       IterFixupPageOffset;
-  VOID                                         *IterFixupData;
-  MACH_DYLD_CHAINED_PTR_64_KERNEL_CACHE_REBASE IterFixup;
-  UINT16                                       NextIterFixupPageOffset;
-
-  UINT16                                       FixupDelta;
-
-  ASSERT (Context != NULL);
-  ASSERT (MachContext != NULL);
-  ASSERT (RelocInfo != NULL);
-
-  ASSERT (Context->KextsFixupChains != NULL);
-  ASSERT (Context->KextsFixupChains->PageSize == MACHO_PAGE_SIZE);
-  //
-  // The entire KEXT and thus its relocations must be in Segment.
-  // Mach-O images are limited to 4 GB size by OcMachoLib, so the cast is safe.
-  //
-  RelocAddress     = RelocBase + (UINT32) RelocInfo->Address;
-  RelocOffsetInSeg = (UINT32) (RelocAddress - Context->KextsVmAddress);
-  //
-  // For now we assume we prelinked already and the relocations are sane.
-  //
-  ASSERT (RelocInfo->Extern == 0);
-  ASSERT (RelocInfo->Type == MachX8664RelocUnsigned);
-  ASSERT (RelocAddress >= Context->KextsVmAddress);
-  ASSERT (RelocOffsetInSeg <= Context->PrelinkedSize - Context->KextsFileOffset);
-  ASSERT (Context->KextsFileOffset - RelocOffsetInSeg >= 8);
-  //
-  // Create a new fixup based on the data of RelocInfo.
-  //
-  SegmentData = Context->Prelinked + Context->KextsFileOffset;
-  RelocDest   = SegmentData + RelocOffsetInSeg;
+  RelocDest = SegmentData + RelocOffsetInSeg;
   //
   // It has been observed all fields but target and next are 0 for the kernel
   // KC. For isAuth, this is because x86 does not support Pointer
@@ -486,7 +443,40 @@ InternalKcConvertRelocToFixup (
   // as KERNEL_BASE_PADDR in OcAfterBootCompatLib.
   //
   NewFixup.Target = ReadUnaligned64 (RelocDest) - KERNEL_FIXUP_OFFSET;
+  NewFixup.Next   = Next;
+
+  CopyMem (RelocDest, &NewFixup, sizeof (NewFixup));
+}
+
+/*
+  Indexes the relocation at RelocOffsetInSeg into the fixup chain of a page
+  that may already contain fixups.
+
+  @param[in,out] Context           Prelinked context.
+  @param[in]     RelocOffsetInSeg  Relocation offset within the kexts segment.
+*/
+STATIC
+VOID
+InternalKcInsertFixup (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     UINT32             RelocOffsetInSeg
+  )
+{
+  UINT8                                        *SegmentData;
+  UINT8                                        *SegmentPageData;
+
+  UINT16                                       NewFixupPage;
+  UINT16                                       NewFixupPageOffset;
+  UINT16                                       NewFixupNext;
+
+  UINT16                                       IterFixupPageOffset;
+  VOID                                         *IterFixupData;
+  MACH_DYLD_CHAINED_PTR_64_KERNEL_CACHE_REBASE IterFixup;
+  UINT16                                       NextIterFixupPageOffset;
+
+  UINT16                                       FixupDelta;
 
+  SegmentData        = Context->Prelinked + Context->KextsFileOffset;
   NewFixupPage       = (UINT16) (RelocOffsetInSeg / MACHO_PAGE_SIZE);
   NewFixupPageOffset = (UINT16) (RelocOffsetInSeg % MACHO_PAGE_SIZE);
 
@@ -497,21 +487,17 @@ InternalKcConvertRelocToFixup (
     // The current page has no fixups, just assign and terminate this one.
     //
     Context->KextsFixupChains->PageStart[NewFixupPage] = NewFixupPageOffset;
-    //
-    // Fixup.next is 0 (i.e. the chain is terminated) already.
-    //
+    NewFixupNext = 0;
   } else if (NewFixupPageOffset < IterFixupPageOffset) {
     //
-    // RelocInfo preceeds the first fixup of the page - prepend the new fixup.
+    // The new fixup preceeds the first fixup of the page - prepend it.
     //
-    NewFixup.Next = IterFixupPageOffset - NewFixupPageOffset;
+    NewFixupNext = IterFixupPageOffset - NewFixupPageOffset;
     Context->KextsFixupChains->PageStart[NewFixupPage] = NewFixupPageOffset;
   } else {
     SegmentPageData = SegmentData + NewFixupPage * MACHO_PAGE_SIZE;
     //
-    // Find the last fixup of this page that preceeds RelocInfo.
-    // FIXME: Consider sorting the relocations in descending order first to
-    //        then always prepend the new fixup.
+    // Find the last fixup of this page that preceeds the new fixup.
     //
     NextIterFixupPageOffset = IterFixupPageOffset;
     do {
@@ -529,23 +515,69 @@ InternalKcConvertRelocToFixup (
     //
     if (IterFixup.Next != 0) {
       ASSERT (IterFixup.Next >= FixupDelta);
-      NewFixup.Next = IterFixup.Next - FixupDelta;
+      NewFixupNext = (UINT16) (IterFixup.Next - FixupDelta);
     } else {
-      NewFixup.Next = 0;
+      NewFixupNext = 0;
     }
     //
-    // The last fixup preceeding RelocInfo must point to our new fixup.
+    // The last fixup preceeding the new fixup must point to it.
     //
     IterFixup.Next = FixupDelta;
     CopyMem (IterFixupData, &IterFixup, sizeof (IterFixup));
   }
 
-  CopyMem (RelocDest, &NewFixup, sizeof (NewFixup));
+  InternalKcWriteFixup (SegmentData, RelocOffsetInSeg, NewFixupNext);
+}
+
+/*
+  Sorts relocation offsets of a single page in ascending order and drops
+  duplicates, which would produce zero deltas terminating the chain early.
+  Relocations are mostly emitted in address order, thus insertion sort.
+
+  @param[in,out] Offsets  Relocation offsets of the page.
+  @param[in]     Count    Number of relocation offsets.
+
+  @returns  Number of unique relocation offsets.
+*/
+STATIC
+UINT32
+InternalKcSortPageRelocs (
+  IN OUT UINT32  *Offsets,
+  IN     UINT32  Count
+  )
+{
+  UINT32  Index;
+  UINT32  Index2;
+  UINT32  Value;
+
+  for (Index = 1; Index < Count; ++Index) {
+    Value  = Offsets[Index];
+    Index2 = Index;
+    while (Index2 > 0 && Offsets[Index2 - 1] > Value) {
+      Offsets[Index2] = Offsets[Index2 - 1];
+      --Index2;
+    }
+
+    Offsets[Index2] = Value;
+  }
+
+  Index2 = Count > 0 ? 1 : 0;
+  for (Index = 1; Index < Count; ++Index) {
+    if (Offsets[Index] != Offsets[Index2 - 1]) {
+      Offsets[Index2] = Offsets[Index];
+      ++Index2;
+    }
+  }
+
+  return Index2;
 }
 
 /*
   Indexes all relocations of MachContext into the kernel described by Context.
 
+  Relocations are grouped by their page first, so that the fixup chain of
+  every page, which had no fixups before, is emitted in a single linear pass.
+
   @param[in,out] Context      Prelinked context.
   @param[in]     MachContext  The context of the Mach-O to index. It must have
                               been prelinked by OcAppleKernelLib. The image
@@ -562,9 +594,26 @@ KcKextIndexFixups (
   MACH_HEADER_64                *MachHeader;
   CONST MACH_RELOCATION_INFO    *Relocations;
   UINT32                        RelocIndex;
+  UINT32                        RelocCount;
+  UINT32                        *RelocOffsets;
+  UINT32                        *SortedOffsets;
+  UINT32                        *PageEnds;
+  UINT64                        RelocAddress;
+  UINT32                        RelocOffsetInSeg;
+  UINT8                         *SegmentData;
+  UINT32                        FirstPage;
+  UINT32                        LastPage;
+  UINT32                        PageIndex;
+  UINT32                        PageStart;
+  UINT32                        PageCount;
+  UINT32                        SortedCount;
+  UINT32                        SortedSize;
+  UINT16                        FixupNext;
 
   ASSERT (Context != NULL);
   ASSERT (MachContext != NULL);
+  ASSERT (Context->KextsFixupChains != NULL);
+  ASSERT (Context->KextsFixupChains->PageSize == MACHO_PAGE_SIZE);
 
   MachHeader = MachoGetMachHeader64 (MachContext);
 
@@ -615,22 +664,145 @@ KcKextIndexFixups (
   Relocations = (MACH_RELOCATION_INFO *) (
     (UINTN) MachHeader + DySymtab->LocalRelocationsOffset
     );
+  RelocCount  = DySymtab->NumOfLocalRelocations;
+  SegmentData = Context->Prelinked + Context->KextsFileOffset;
 
   DEBUG ((
     DEBUG_INFO,
     "OCAK: Local relocs %u on %LX\n",
-    DySymtab->NumOfLocalRelocations,
+    RelocCount,
     FirstSegment->VirtualAddress
     ));
 
-  for (RelocIndex = 0; RelocIndex < DySymtab->NumOfLocalRelocations; ++RelocIndex) {
-    InternalKcConvertRelocToFixup (
-      Context,
-      MachContext,
-      &Relocations[RelocIndex],
-      FirstSegment->VirtualAddress
-      );
+  if (RelocCount == 0) {
+    return;
+  }
+
+  RelocOffsets = NULL;
+  if (!OcOverflowMulU32 (RelocCount, sizeof (*RelocOffsets), &SortedSize)) {
+    RelocOffsets = AllocatePool (SortedSize);
+  }
+
+  FirstPage = MAX_UINT32;
+  LastPage  = 0;
+
+  for (RelocIndex = 0; RelocIndex < RelocCount; ++RelocIndex) {
+    //
+    // The entire KEXT and thus its relocations must be in Segment.
+    // Mach-O images are limited to 4 GB size by OcMachoLib, so the cast is safe.
+    //
+    RelocAddress     = FirstSegment->VirtualAddress + (UINT32) Relocations[RelocIndex].Address;
+    RelocOffsetInSeg = (UINT32) (RelocAddress - Context->KextsVmAddress);
+    //
+    // For now we assume we prelinked already and the relocations are sane.
+    //
+    ASSERT (Relocations[RelocIndex].Extern == 0);
+    ASSERT (Relocations[RelocIndex].Type == MachX8664RelocUnsigned);
+    ASSERT (RelocAddress >= Context->KextsVmAddress);
+    ASSERT (RelocOffsetInSeg <= Context->PrelinkedSize - Context->KextsFileOffset);
+    ASSERT (Context->PrelinkedSize - Context->KextsFileOffset - RelocOffsetInSeg >= 8);
+
+    if (RelocOffsets == NULL) {
+      //
+      // Fall back to indexing relocations one by one when out of memory.
+      //
+      InternalKcInsertFixup (Context, RelocOffsetInSeg);
+      continue;
+    }
+
+    RelocOffsets[RelocIndex] = RelocOffsetInSeg;
+    PageIndex = RelocOffsetInSeg / MACHO_PAGE_SIZE;
+    if (PageIndex < FirstPage) {
+      FirstPage = PageIndex;
+    }
+    if (PageIndex > LastPage) {
+      LastPage = PageIndex;
+    }
+  }
+
+  if (RelocOffsets == NULL) {
+    return;
+  }
+
+  //
+  // Bucket relocations by page. The page span is limited by the 16-bit
+  // page count of the fixup chains.
+  //
+  ASSERT (LastPage < Context->KextsFixupChains->PageCount);
+  PageCount     = LastPage - FirstPage + 1;
+  SortedOffsets = NULL;
+  if (!OcOverflowTriAddU32 (RelocCount, PageCount, 1, &SortedSize)
+    && !OcOverflowMulU32 (SortedSize, sizeof (*SortedOffsets), &SortedSize)) {
+    SortedOffsets = AllocateZeroPool (SortedSize);
   }
+
+  if (SortedOffsets == NULL) {
+    for (RelocIndex = 0; RelocIndex < RelocCount; ++RelocIndex) {
+      InternalKcInsertFixup (Context, RelocOffsets[RelocIndex]);
+    }
+
+    FreePool (RelocOffsets);
+    return;
+  }
+
+  //
+  // Counting sort: PageEnds[Page + 1] first holds the amount of relocations
+  // in the page, then the bucket start, and after scattering the bucket end.
+  //
+  PageEnds = &SortedOffsets[RelocCount];
+  for (RelocIndex = 0; RelocIndex < RelocCount; ++RelocIndex) {
+    ++PageEnds[RelocOffsets[RelocIndex] / MACHO_PAGE_SIZE - FirstPage + 1];
+  }
+
+  for (PageIndex = 1; PageIndex <= PageCount; ++PageIndex) {
+    PageEnds[PageIndex] += PageEnds[PageIndex - 1];
+  }
+
+  for (RelocIndex = 0; RelocIndex < RelocCount; ++RelocIndex) {
+    RelocOffsetInSeg = RelocOffsets[RelocIndex];
+    PageIndex        = RelocOffsetInSeg / MACHO_PAGE_SIZE - FirstPage;
+    SortedOffsets[PageEnds[PageIndex]++] = RelocOffsetInSeg;
+  }
+
+  FreePool (RelocOffsets);
+
+  PageStart = 0;
+  for (PageIndex = 0; PageIndex < PageCount; ++PageIndex) {
+    RelocOffsets = &SortedOffsets[PageStart];
+    SortedCount  = InternalKcSortPageRelocs (RelocOffsets, PageEnds[PageIndex] - PageStart);
+    PageStart    = PageEnds[PageIndex];
+
+    if (SortedCount == 0) {
+      continue;
+    }
+
+    if (Context->KextsFixupChains->PageStart[FirstPage + PageIndex] != MACH_DYLD_CHAINED_PTR_START_NONE) {
+      //
+      // The page is shared with previously indexed fixups, merge into its chain.
+      //
+      for (RelocIndex = 0; RelocIndex < SortedCount; ++RelocIndex) {
+        InternalKcInsertFixup (Context, RelocOffsets[RelocIndex]);
+      }
+
+      continue;
+    }
+
+    //
+    // Emit the chain in order, every fixup points to the next one in the page.
+    //
+    Context->KextsFixupChains->PageStart[FirstPage + PageIndex] = (UINT16) (RelocOffsets[0] % MACHO_PAGE_SIZE);
+
+    for (RelocIndex = 0; RelocIndex < SortedCount; ++RelocIndex) {
+      FixupNext = 0;
+      if (RelocIndex + 1 < SortedCount) {
+        FixupNext = (UINT16) (RelocOffsets[RelocIndex + 1] - RelocOffsets[RelocIndex]);
+      }
+
+      InternalKcWriteFixup (SegmentData, RelocOffsets[RelocIndex], FixupNext);
+    }
+  }
+
+  FreePool (SortedOffsets);
 }
 
 UINT32
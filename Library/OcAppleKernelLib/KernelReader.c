@@ -18,6 +18,7 @@
 #include <IndustryStandard/AppleFatBinaryImage.h>
 
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcAppleKernelLib.h>
@@ -25,16 +26,13 @@
 #include <Library/OcCryptoLib.h>
 #include <Library/OcFileLib.h>
 #include <Library/OcGuardLib.h>
+#include <Library/OcTraceLib.h>
 
 //
 // Pick a reasonable maximum to fit.
 //
 #define KERNEL_HEADER_SIZE (EFI_PAGE_SIZE * 2)
 
-STATIC SHA384_CONTEXT mKernelDigestContext;
-STATIC UINT32         mKernelDigestPosition;
-STATIC BOOLEAN        mNeedKernelDigest;
-
 typedef enum {
   KernelArchUnknown,
   KernelArch32,
@@ -65,83 +63,21 @@ ReplaceBuffer (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  FreePool (*Buffer);
+  if (*Buffer != NULL) {
+    FreePool (*Buffer);
+  }
   *Buffer = TmpBuffer;
   *AllocatedSize = TargetSize;
 
   return EFI_SUCCESS;
 }
 
-STATIC
-EFI_STATUS
-KernelGetFileData (
-  IN  EFI_FILE_PROTOCOL  *File,
-  IN  UINT32             Position,
-  IN  UINT32             Size,
-  OUT UINT8              *Buffer
-  )
-{
-  EFI_STATUS  Status;
-  UINT32      RemainingSize;
-  UINT32      ChunkSize;
-
-  //
-  // Calculate hash for the prefix.
-  //
-  if (mNeedKernelDigest && Position > mKernelDigestPosition) {
-    RemainingSize = Position - mKernelDigestPosition;
-
-    while (RemainingSize > 0) {
-      ChunkSize = MIN (RemainingSize, Size);
-      Status = GetFileData (
-        File,
-        mKernelDigestPosition,
-        ChunkSize,
-        Buffer
-        );
-      if (EFI_ERROR (Status)) {
-        return Status;
-      }
-
-      Sha384Update (&mKernelDigestContext, Buffer, ChunkSize);
-      mKernelDigestPosition += ChunkSize;
-      RemainingSize -= ChunkSize;
-    }
-  }
-
-  Status = GetFileData (
-    File,
-    Position,
-    Size,
-    Buffer
-    );
-
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
-
-  //
-  // Calculate hash for the suffix.
-  //
-  if (mNeedKernelDigest && Position >= mKernelDigestPosition) {
-    RemainingSize = Position + Size - mKernelDigestPosition;
-    Sha384Update (
-      &mKernelDigestContext,
-      Buffer + (Position - mKernelDigestPosition),
-      RemainingSize
-      );
-    mKernelDigestPosition += RemainingSize;
-  }
-
-  return Status;
-}
-
 STATIC
 EFI_STATUS
 ParseFatArchitecture (
-  IN     EFI_FILE_PROTOCOL  *File,
+  IN     UINT32             FileSize,
   IN     BOOLEAN            Prefer32Bit,
-  IN     UINT8              *Buffer,
+  IN     CONST UINT8        *Buffer,
   IN     UINT32             BufferSize,
      OUT BOOLEAN            *Is32Bit,
      OUT UINT32             *FatOffset,
@@ -149,12 +85,7 @@ ParseFatArchitecture (
   )
 {
   EFI_STATUS        Status;
-  UINT32            FileSize;
 
-  Status = GetFileSize (File, &FileSize);
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
   if (BufferSize >= FileSize) {
     return EFI_INVALID_PARAMETER;
   }
@@ -190,24 +121,26 @@ ParseFatArchitecture (
 STATIC
 UINT32
 ParseCompressedHeader (
-  IN     EFI_FILE_PROTOCOL  *File,
+  IN     CONST UINT8        *FileData,
+  IN     UINT32             FileSize,
   IN OUT UINT8              **Buffer,
   IN     UINT32             Offset,
      OUT UINT32             *AllocatedSize,
   IN     UINT32             ReservedSize
   )
 {
-  EFI_STATUS        Status;
-
-  UINT32            KernelSize;
-  MACH_COMP_HEADER  *CompHeader;
-  UINT8             *CompressedBuffer;
-  UINT32            CompressionType;
-  UINT32            CompressedSize;
-  UINT32            DecompressedSize;
-  UINT32            DecompressedHash;
-
-  CompHeader       = (MACH_COMP_HEADER *)*Buffer;
+  EFI_STATUS              Status;
+
+  UINT32                  KernelSize;
+  CONST MACH_COMP_HEADER  *CompHeader;
+  CONST UINT8             *CompressedBuffer;
+  UINT32                  CompressionType;
+  UINT32                  CompressedSize;
+  UINT32                  DecompressedSize;
+  UINT32                  DecompressedHash;
+  UINT32                  CompressedEnd;
+
+  CompHeader       = (CONST MACH_COMP_HEADER *) (FileData + Offset);
   CompressionType  = CompHeader->Compression;
   CompressedSize   = SwapBytes32 (CompHeader->Compressed);
   DecompressedSize = SwapBytes32 (CompHeader->Decompressed);
@@ -223,30 +156,30 @@ ParseCompressedHeader (
     return KernelSize;
   }
 
-  Status = ReplaceBuffer (DecompressedSize, Buffer, AllocatedSize, ReservedSize);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "OCAK: Decomp kernel (%u bytes) cannot be allocated at %08X\n", DecompressedSize, Offset));
-    return KernelSize;
-  }
-
-  CompressedBuffer = AllocatePool (CompressedSize);
-  if (CompressedBuffer == NULL) {
-    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be allocated at %08X\n", CompressedSize, Offset));
+  if (OcOverflowTriAddU32 (Offset, sizeof (MACH_COMP_HEADER), CompressedSize, &CompressedEnd)
+    || CompressedEnd > FileSize) {
+    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be read at %08X\n", CompressedSize, Offset));
     return KernelSize;
   }
 
-  Status = KernelGetFileData (File, Offset + sizeof (MACH_COMP_HEADER), CompressedSize, CompressedBuffer);
+  Status = ReplaceBuffer (DecompressedSize, Buffer, AllocatedSize, ReservedSize);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be read at %08X\n", CompressedSize, Offset));
-    FreePool (CompressedBuffer);
+    DEBUG ((DEBUG_INFO, "OCAK: Decomp kernel (%u bytes) cannot be allocated at %08X\n", DecompressedSize, Offset));
     return KernelSize;
   }
 
+  //
+  // Decompress right from the file image, it is already in memory.
+  //
+  CompressedBuffer = FileData + Offset + sizeof (MACH_COMP_HEADER);
+
+  OcTraceBegin ("Decompress");
   if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN) {
     KernelSize = (UINT32)DecompressLZVN (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
   } else if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZSS) {
-    KernelSize = (UINT32)DecompressLZSS (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
+    KernelSize = (UINT32)DecompressLZSS (*Buffer, DecompressedSize, (UINT8 *) CompressedBuffer, CompressedSize);
   }
+  OcTraceEnd ("Decompress");
 
   if (KernelSize != DecompressedSize) {
     KernelSize = 0;
@@ -257,15 +190,14 @@ ParseCompressedHeader (
   //
   (VOID) DecompressedHash;
 
-  FreePool (CompressedBuffer);
-
   return KernelSize;
 }
 
 STATIC
 EFI_STATUS
 ReadAppleKernelImage (
-  IN     EFI_FILE_PROTOCOL  *File,
+  IN     CONST UINT8        *FileData,
+  IN     UINT32             FileSize,
   IN     BOOLEAN            Prefer32Bit,
   IN OUT KERNEL_ARCH        *Arch,
   IN OUT UINT8              **Buffer,
@@ -276,16 +208,19 @@ ReadAppleKernelImage (
   )
 {
   EFI_STATUS        Status;
-  UINT32            *MagicPtr;
+  CONST UINT8       *Image;
+  CONST UINT32      *MagicPtr;
   BOOLEAN           ForbidFat;
   BOOLEAN           Compressed;
   BOOLEAN           Is32Bit;
 
-  Status = KernelGetFileData (File, Offset, KERNEL_HEADER_SIZE, *Buffer);
-  if (EFI_ERROR (Status)) {
-    return Status;
+  if (Offset > FileSize || FileSize - Offset < KERNEL_HEADER_SIZE) {
+    DEBUG ((DEBUG_INFO, "OCAK: Kernel header cannot be read at %08X of %u\n", Offset, FileSize));
+    return EFI_INVALID_PARAMETER;
   }
 
+  Image = FileData + Offset;
+
   //
   // Do not allow FAT architectures with Offset > 0 (recursion).
   //
@@ -293,11 +228,11 @@ ReadAppleKernelImage (
   Compressed = FALSE;
 
   while (TRUE) {
-    if (!OC_TYPE_ALIGNED (UINT32 , *Buffer)) {
-      DEBUG ((DEBUG_INFO, "OCAK: Misaligned kernel header %p at %08X\n", *Buffer, Offset));
+    if (!OC_TYPE_ALIGNED (UINT32 , Image)) {
+      DEBUG ((DEBUG_INFO, "OCAK: Misaligned kernel header %p at %08X\n", Image, Offset));
       return EFI_INVALID_PARAMETER;
     }
-    MagicPtr = (UINT32 *)* Buffer;
+    MagicPtr = (CONST UINT32 *) Image;
 
     switch (*MagicPtr) {
       case MACH_HEADER_SIGNATURE:
@@ -318,6 +253,14 @@ ReadAppleKernelImage (
           || (!Is32Bit && *MagicPtr != MACH_HEADER_64_SIGNATURE)) {
           return EFI_INVALID_PARAMETER;
         }
+
+        //
+        // Figure out size for a non fat image.
+        //
+        if (!Compressed && Offset == 0) {
+          *KernelSize = FileSize;
+        }
+
         DEBUG ((
           DEBUG_VERBOSE,
           "OCAK: Found %a Mach-O compressed %d offset %u size %u\n",
@@ -335,33 +278,20 @@ ReadAppleKernelImage (
         }
 
         //
-        // This is an uncompressed image, just fully read it.
+        // This is an uncompressed image, take it from the file image
+        // unless it was read right into the resulting buffer.
         //
-        if (Offset == 0) {
-          //
-          // Figure out size for a non fat image.
-          //
-          Status = GetFileSize (File, KernelSize);
-          if (EFI_ERROR (Status)) {
-            DEBUG ((DEBUG_INFO, "OCAK: Kernel size cannot be determined - %r\n", Status));
-            return EFI_OUT_OF_RESOURCES;
-          }
-
-          DEBUG ((DEBUG_VERBOSE, "OCAK: Determined kernel size is %u bytes\n", *KernelSize));
-        }
-
         Status = ReplaceBuffer (*KernelSize, Buffer, AllocatedSize, ReservedSize);
         if (EFI_ERROR (Status)) {
           DEBUG ((DEBUG_INFO, "OCAK: Kernel (%u bytes) cannot be allocated at %08X\n", *KernelSize, Offset));
           return Status;
         }
 
-        Status = KernelGetFileData (File, Offset, *KernelSize, *Buffer);
-        if (EFI_ERROR (Status)) {
-          DEBUG ((DEBUG_INFO, "OCAK: Kernel (%u bytes) cannot be read at %08X\n", *KernelSize, Offset));
+        if (*Buffer != Image) {
+          CopyMem (*Buffer, Image, *KernelSize);
         }
 
-        return Status;
+        return EFI_SUCCESS;
       case MACH_FAT_BINARY_SIGNATURE:
       case MACH_FAT_BINARY_INVERT_SIGNATURE:
       {
@@ -370,12 +300,12 @@ ReadAppleKernelImage (
           return EFI_INVALID_PARAMETER;
         }
 
-        Status = ParseFatArchitecture (File, Prefer32Bit, *Buffer, KERNEL_HEADER_SIZE, &Is32Bit, &Offset, KernelSize);
+        Status = ParseFatArchitecture (FileSize, Prefer32Bit, Image, KERNEL_HEADER_SIZE, &Is32Bit, &Offset, KernelSize);
         if (EFI_ERROR (Status)) {
           return Status;
         }
         *Arch = Is32Bit ? KernelArch32 : KernelArch64;
-        return ReadAppleKernelImage (File, Prefer32Bit, Arch, Buffer, KernelSize, AllocatedSize, ReservedSize, Offset);
+        return ReadAppleKernelImage (FileData, FileSize, Prefer32Bit, Arch, Buffer, KernelSize, AllocatedSize, ReservedSize, Offset);
       }
       case MACH_COMPRESSED_BINARY_INVERT_SIGNATURE:
       {
@@ -392,9 +322,10 @@ ReadAppleKernelImage (
         //
         // Loop into updated image in Buffer.
         //
-        *KernelSize = ParseCompressedHeader (File, Buffer, Offset, AllocatedSize, ReservedSize);
+        *KernelSize = ParseCompressedHeader (FileData, FileSize, Buffer, Offset, AllocatedSize, ReservedSize);
         if (*KernelSize != 0) {
-          DEBUG ((DEBUG_VERBOSE, "OCAK: Compressed result has %08X magic\n", *(UINT32 *) Buffer));
+          Image = *Buffer;
+          DEBUG ((DEBUG_VERBOSE, "OCAK: Compressed result has %08X magic\n", *(CONST UINT32 *) Image));
           continue;
         }
         return EFI_INVALID_PARAMETER;
@@ -406,6 +337,70 @@ ReadAppleKernelImage (
   }
 }
 
+/**
+  Locate the preferred architecture slice of a fat kernel file.
+
+  @param[in]   File         Kernel file.
+  @param[in]   FileSize     Kernel file size.
+  @param[in]   Prefer32Bit  Prefer 32-bit slice.
+  @param[out]  Arch         Slice architecture.
+  @param[out]  SliceOffset  Slice offset in the file.
+  @param[out]  SliceSize    Slice size.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
+EFI_STATUS
+ReadAppleKernelFatSlice (
+  IN     EFI_FILE_PROTOCOL  *File,
+  IN     UINT32             FileSize,
+  IN     BOOLEAN            Prefer32Bit,
+     OUT KERNEL_ARCH        *Arch,
+     OUT UINT32             *SliceOffset,
+     OUT UINT32             *SliceSize
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *FatHeader;
+  UINT32      FatHeaderSize;
+  BOOLEAN     Is32Bit;
+
+  FatHeaderSize = MIN (FileSize, KERNEL_HEADER_SIZE);
+  FatHeader     = AllocatePool (FatHeaderSize);
+  if (FatHeader == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = GetFileData (File, 0, FatHeaderSize, FatHeader);
+  if (!EFI_ERROR (Status)) {
+    Status = ParseFatArchitecture (
+      FileSize,
+      Prefer32Bit,
+      FatHeader,
+      FatHeaderSize,
+      &Is32Bit,
+      SliceOffset,
+      SliceSize
+      );
+  }
+
+  FreePool (FatHeader);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Fat kernel slice cannot be found - %r\n", Status));
+    return Status;
+  }
+
+  if (*SliceSize < KERNEL_HEADER_SIZE) {
+    DEBUG ((DEBUG_INFO, "OCAK: Fat kernel slice is too small %u\n", *SliceSize));
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *Arch = Is32Bit ? KernelArch32 : KernelArch64;
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 ReadAppleKernel (
   IN     EFI_FILE_PROTOCOL  *File,
@@ -418,10 +413,15 @@ ReadAppleKernel (
      OUT UINT8              *Digest  OPTIONAL
   )
 {
-  EFI_STATUS  Status;
-  UINT32      FullSize;
-  UINT8       *Remainder;
-  KERNEL_ARCH Arch;
+  EFI_STATUS      Status;
+  UINT32          FileSize;
+  UINT32          ReadOffset;
+  UINT32          ReadSize;
+  UINT32          Magic;
+  UINT8           *FileData;
+  UINTN           FilePages;
+  KERNEL_ARCH     Arch;
+  SHA384_CONTEXT  DigestContext;
 
   ASSERT (File != NULL);
   ASSERT (Is32Bit != NULL);
@@ -430,75 +430,126 @@ ReadAppleKernel (
   ASSERT (AllocatedSize != NULL);
 
   *Is32Bit       = FALSE;
+  *Kernel        = NULL;
   *KernelSize    = 0;
-  *AllocatedSize = KERNEL_HEADER_SIZE;
-  *Kernel        = AllocatePool (*AllocatedSize);
+  *AllocatedSize = 0;
   Arch           = KernelArchUnknown;
+  FilePages      = 0;
 
-  if (*Kernel == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  Status = GetFileSize (File, &FileSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Kernel size cannot be determined - %r\n", Status));
+    return Status;
   }
 
-  mNeedKernelDigest = Digest != NULL;
-  if (mNeedKernelDigest) {
-    mKernelDigestPosition = 0;
-    Sha384Init (&mKernelDigestContext);
+  if (FileSize < KERNEL_HEADER_SIZE) {
+    return EFI_INVALID_PARAMETER;
   }
 
-  Status = ReadAppleKernelImage (
-    File,
-    Prefer32Bit,
-    &Arch,
-    Kernel,
-    KernelSize,
-    AllocatedSize,
-    ReservedSize,
-    0
-    );
-
+  Status = GetFileData (File, 0, sizeof (Magic), (UINT8 *) &Magic);
   if (EFI_ERROR (Status)) {
-    FreePool (*Kernel);
-    mNeedKernelDigest = FALSE;
     return Status;
   }
 
-  *Is32Bit = Arch == KernelArch32;
+  //
+  // Read the whole file or fat slice at once, as many small reads are slow
+  // on firmware filesystems. Uncompressed kernels are read right into the
+  // resulting buffer, others go to a page-aligned buffer to be parsed.
+  //
+  if (Magic != MACH_HEADER_SIGNATURE
+    && Magic != MACH_HEADER_64_SIGNATURE
+    && Magic != MACH_FAT_BINARY_SIGNATURE
+    && Magic != MACH_FAT_BINARY_INVERT_SIGNATURE
+    && Magic != MACH_COMPRESSED_BINARY_INVERT_SIGNATURE) {
+    DEBUG ((DEBUG_VERBOSE, "OCAK: Invalid kernel magic %08X\n", Magic));
+    return EFI_INVALID_PARAMETER;
+  }
 
-  if (mNeedKernelDigest) {
-    Status = GetFileSize (File, &FullSize);
+  ReadOffset = 0;
+  ReadSize   = FileSize;
+
+  //
+  // Unless the whole file is digested, only the preferred fat slice is needed.
+  // It is then handled as if it was the whole file.
+  //
+  if (Digest == NULL
+    && (Magic == MACH_FAT_BINARY_SIGNATURE || Magic == MACH_FAT_BINARY_INVERT_SIGNATURE)) {
+    Status = ReadAppleKernelFatSlice (File, FileSize, Prefer32Bit, &Arch, &ReadOffset, &ReadSize);
     if (EFI_ERROR (Status)) {
-      mNeedKernelDigest = FALSE;
-      FreePool (*Kernel);
       return Status;
     }
 
-    if (FullSize > mKernelDigestPosition) {
-      Remainder = AllocatePool (FullSize - mKernelDigestPosition);
-      if (Remainder == NULL) {
-        mNeedKernelDigest = FALSE;
-        FreePool (*Kernel);
-        return EFI_OUT_OF_RESOURCES;
-      }
+    Status = GetFileData (File, ReadOffset, sizeof (Magic), (UINT8 *) &Magic);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
-      Status = KernelGetFileData (
-        File,
-        mKernelDigestPosition,
-        FullSize - mKernelDigestPosition,
-        Remainder
-        );
-      mNeedKernelDigest = FALSE;
-      FreePool (Remainder);
-      if (EFI_ERROR (Status)) {
-        FreePool (*Kernel);
-        return Status;
-      }
+    //
+    // Do not allow FAT architectures within the slice (recursion).
+    //
+    if (Magic == MACH_FAT_BINARY_SIGNATURE || Magic == MACH_FAT_BINARY_INVERT_SIGNATURE) {
+      DEBUG ((DEBUG_INFO, "OCAK: Fat kernel recursion at %08X\n", ReadOffset));
+      return EFI_INVALID_PARAMETER;
+    }
+  }
 
-      ASSERT (FullSize == mKernelDigestPosition);
+  if (Magic == MACH_HEADER_SIGNATURE || Magic == MACH_HEADER_64_SIGNATURE) {
+    Status = ReplaceBuffer (ReadSize, Kernel, AllocatedSize, ReservedSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "OCAK: Kernel (%u bytes) cannot be allocated\n", ReadSize));
+      return Status;
     }
 
-    Sha384Final (&mKernelDigestContext, Digest);
+    FileData = *Kernel;
+  } else {
+    FilePages = EFI_SIZE_TO_PAGES (ReadSize);
+    FileData  = AllocatePages (FilePages);
+    if (FileData == NULL) {
+      DEBUG ((DEBUG_INFO, "OCAK: Kernel file (%u bytes) cannot be allocated\n", ReadSize));
+      return EFI_OUT_OF_RESOURCES;
+    }
   }
 
+  Status = GetFileData (File, ReadOffset, ReadSize, FileData);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Kernel file (%u bytes) cannot be read - %r\n", ReadSize, Status));
+  } else {
+    Status = ReadAppleKernelImage (
+      FileData,
+      ReadSize,
+      Prefer32Bit,
+      &Arch,
+      Kernel,
+      KernelSize,
+      AllocatedSize,
+      ReservedSize,
+      0
+      );
+  }
+
+  //
+  // Digest the file image in one pass, so that every byte is read only once.
+  //
+  if (!EFI_ERROR (Status) && Digest != NULL) {
+    Sha384Init (&DigestContext);
+    Sha384Update (&DigestContext, FileData, FileSize);
+    Sha384Final (&DigestContext, Digest);
+  }
+
+  if (FilePages > 0) {
+    FreePages (FileData, FilePages);
+  }
+
+  if (EFI_ERROR (Status)) {
+    if (*Kernel != NULL) {
+      FreePool (*Kernel);
+      *Kernel = NULL;
+    }
+    return Status;
+  }
+
+  *Is32Bit = Arch == KernelArch32;
+
   return EFI_SUCCESS;
 }
 
@@ -514,6 +565,7 @@ ReadAppleMkext (
   )
 {
   EFI_STATUS        Status;
+  UINT32            FileSize;
   UINT32            Offset;
   BOOLEAN           Is32Bit;
   UINT8             *TmpMkext;
@@ -524,6 +576,11 @@ ReadAppleMkext (
   ASSERT (MkextSize != NULL);
   ASSERT (AllocatedSize != NULL);
 
+  Status = GetFileSize (File, &FileSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Read enough to get fat binary header if present.
   //
@@ -538,7 +595,7 @@ ReadAppleMkext (
     FreePool (TmpMkext);
     return Status;
   }
-  Status = ParseFatArchitecture (File, Prefer32Bit, TmpMkext, TmpMkextSize, &Is32Bit, &Offset, &TmpMkextSize);
+  Status = ParseFatArchitecture (FileSize, Prefer32Bit, TmpMkext, TmpMkextSize, &Is32Bit, &Offset, &TmpMkextSize);
   FreePool (TmpMkext);
   if (EFI_ERROR (Status)) {
     return Status;
@@ -592,7 +649,9 @@ ReadAppleMkext (
   //
   // Decompress mkext into final buffer.
   //
+  OcTraceBegin ("Decompress");
   Status = MkextDecompress (TmpMkext, TmpMkextSize, NumReservedKexts, *Mkext, *AllocatedSize, MkextSize);
+  OcTraceEnd ("Decompress");
   FreePool (TmpMkext);
 
   if (EFI_ERROR (Status)) {
@@ -111,6 +111,12 @@ PatcherInitContextFromPrelinked (
     return EFI_NOT_FOUND;
   }
 
+  //
+  // Build the symbol index in the cached kext so that every patcher context
+  // shares it. The index is freed together with the kext.
+  //
+  MachoInitializeSymbolIndex (&Kext->Context.MachContext);
+
   CopyMem (Context, &Kext->Context, sizeof (*Context));
   return EFI_SUCCESS;
 }
@@ -220,59 +226,44 @@ PatcherGetSymbolAddress (
   )
 {
   MACH_NLIST_ANY  *Symbol;
-  CONST CHAR8     *SymbolName;
   UINT64          SymbolAddress;
   UINT32          Offset;
-  UINT32          Index;
 
-  Index  = 0;
   Offset = 0;
-  while (TRUE) {
+
+  //
+  // Try the usual way first via SYMTAB.
+  //
+  Symbol = MachoGetSymbolByName (&Context->MachContext, Name);
+  if (Symbol != NULL) {
     //
-    // Try the usual way first via SYMTAB.
+    // Once we have a symbol, get its ondisk offset.
     //
-    Symbol = MachoGetSymbolByIndex (&Context->MachContext, Index);
-    if (Symbol == NULL) {
-      //
-      // If we have KxldState, use it.
-      //
-      if (Index == 0 && Context->KxldState != NULL) {
-        SymbolAddress = InternalKxldSolveSymbol (
-          Context->Is32Bit,
-          Context->KxldState,
-          Context->KxldStateSize,
-          Name
-          );
-        //
-        // If we have a symbol, get its ondisk offset.
-        //
-        if (SymbolAddress != 0 && MachoSymbolGetDirectFileOffset (&Context->MachContext, SymbolAddress, &Offset, NULL)) {
-          //
-          // Proceed to success.
-          //
-          break;
-        }
-      }
-
+    if (!MachoSymbolGetFileOffset (&Context->MachContext, Symbol, &Offset, NULL)) {
+      return EFI_INVALID_PARAMETER;
+    }
+  } else {
+    //
+    // If we have KxldState and no SYMTAB, use it.
+    //
+    if (Context->KxldState == NULL
+      || MachoGetSymbolByIndex (&Context->MachContext, 0) != NULL) {
       return EFI_NOT_FOUND;
     }
 
-    SymbolName = MachoGetSymbolName (&Context->MachContext, Symbol);
-    if (SymbolName != NULL && AsciiStrCmp (Name, SymbolName) == 0) {
-      //
-      // Once we have a symbol, get its ondisk offset.
-      //
-      if (MachoSymbolGetFileOffset (&Context->MachContext, Symbol, &Offset, NULL)) {
-        //
-        // Proceed to success.
-        //
-        break;
-      }
-
-      return EFI_INVALID_PARAMETER;
+    SymbolAddress = InternalKxldSolveSymbol (
+      Context->Is32Bit,
+      Context->KxldState,
+      Context->KxldStateSize,
+      Name
+      );
+    //
+    // If we have a symbol, get its ondisk offset.
+    //
+    if (SymbolAddress == 0
+      || !MachoSymbolGetDirectFileOffset (&Context->MachContext, SymbolAddress, &Offset, NULL)) {
+      return EFI_NOT_FOUND;
     }
-
-    Index++;
   }
 
   *Address = (UINT8 *) MachoGetMachHeader (&Context->MachContext) + Offset;
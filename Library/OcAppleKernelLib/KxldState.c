@@ -407,7 +407,10 @@ InternalKxldStateRebasePlist (
 
   KextCount = XmlNodeChildren (Context->KextList);
 
-  Context->KextScratchBuffer = ScratchWalker = AllocatePool (KextCount * KEXT_OFFSET_STR_LEN);
+  Context->KextScratchBuffer = ScratchWalker = InternalPrelinkedAllocateScratch (
+    Context,
+    KextCount * KEXT_OFFSET_STR_LEN
+    );
   if (Context->KextScratchBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
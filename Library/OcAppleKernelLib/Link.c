@@ -35,6 +35,42 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 // Symbols
 //
 
+/**
+  Decide how to search a dependency closure entry for the requested level.
+  Direct dependencies export all their symbols, while dependencies of
+  dependencies export only C++ symbols.
+
+  @param[in]  Dependency   Dependency closure entry.
+  @param[in]  SymbolLevel  Requested symbol level.
+  @param[out] KextLevel    Symbol level to search the dependency with.
+
+  @retval TRUE  The dependency needs to be searched.
+**/
+STATIC
+BOOLEAN
+InternalGetDependencySymbolLevel (
+  IN  CONST PRELINKED_KEXT_DEPENDENCY  *Dependency,
+  IN  OC_GET_SYMBOL_LEVEL              SymbolLevel,
+  OUT OC_GET_SYMBOL_LEVEL              *KextLevel
+  )
+{
+  if (SymbolLevel == OcGetSymbolFirstLevel) {
+    *KextLevel = OcGetSymbolFirstLevel;
+    return Dependency->Direct;
+  }
+
+  if (SymbolLevel == OcGetSymbolOnlyCxx) {
+    //
+    // Repeated dependencies had their C++ symbols searched already.
+    //
+    *KextLevel = OcGetSymbolOnlyCxx;
+    return !Dependency->Repeated;
+  }
+
+  *KextLevel = Dependency->Direct ? OcGetSymbolAnyLevel : OcGetSymbolOnlyCxx;
+  return TRUE;
+}
+
 STATIC
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolWorkerName (
@@ -44,17 +80,11 @@ InternalOcGetSymbolWorkerName (
   IN OC_GET_SYMBOL_LEVEL              SymbolLevel
   )
 {
-  PRELINKED_KEXT              *Dependency;
   CONST PRELINKED_KEXT_SYMBOL *Symbols;
   CONST PRELINKED_KEXT_SYMBOL *SymbolsEnd;
   UINT32                      Index;
   UINT32                      NumSymbols;
 
-  //
-  // Block any 1+ level dependencies.
-  //
-  Kext->Processed = TRUE;
-
   if (Kext->LinkedSymbolTable != NULL) {
     NumSymbols = Kext->NumberOfSymbols;
     Symbols    = Kext->LinkedSymbolTable;
@@ -88,29 +118,6 @@ InternalOcGetSymbolWorkerName (
     }
   }
 
-  if (SymbolLevel != OcGetSymbolFirstLevel) {
-    for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
-      Dependency = Kext->Dependencies[Index];
-      if (Dependency == NULL) {
-        return NULL;
-      }
-
-      if (Dependency->Processed) {
-        continue;
-      }
-
-      Symbols = InternalOcGetSymbolWorkerName (
-                 Dependency,
-                 LookupValue,
-                 LookupValueLength,
-                 OcGetSymbolOnlyCxx
-                 );
-      if (Symbols != NULL) {
-        return Symbols;
-      }
-    }
-  }
-
   return NULL;
 }
 
@@ -122,17 +129,10 @@ InternalOcGetSymbolWorkerValue (
   IN OC_GET_SYMBOL_LEVEL              SymbolLevel
   )
 {
-  PRELINKED_KEXT              *Dependency;
   CONST PRELINKED_KEXT_SYMBOL *Symbols;
   CONST PRELINKED_KEXT_SYMBOL *SymbolsEnd;
-  UINT32                      Index;
   UINT32                      NumSymbols;
 
-  //
-  // Block any 1+ level dependencies.
-  //
-  Kext->Processed = TRUE;
-
   if (Kext->LinkedSymbolTable != NULL) {
     NumSymbols = Kext->NumberOfSymbols;
     Symbols    = Kext->LinkedSymbolTable;
@@ -158,28 +158,6 @@ InternalOcGetSymbolWorkerValue (
     }
   }
 
-  if (SymbolLevel != OcGetSymbolFirstLevel) {
-    for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
-      Dependency = Kext->Dependencies[Index];
-      if (Dependency == NULL) {
-        return NULL;
-      }
-
-      if (Dependency->Processed) {
-        continue;
-      }
-
-      Symbols = InternalOcGetSymbolWorkerValue (
-                 Dependency,
-                 LookupValue,
-                 OcGetSymbolOnlyCxx
-                 );
-      if (Symbols != NULL) {
-        return Symbols;
-      }
-    }
-  }
-
   return NULL;
 }
 
@@ -191,11 +169,11 @@ InternalOcGetSymbolName (
   IN OC_GET_SYMBOL_LEVEL  SymbolLevel
   )
 {
-  CONST PRELINKED_KEXT_SYMBOL *Symbol;
-
-  PRELINKED_KEXT              *Dependency;
-  UINT32                      Index;
-  UINT32                      LookupValueLength;
+  CONST PRELINKED_KEXT_SYMBOL     *Symbol;
+  CONST PRELINKED_KEXT_DEPENDENCY *Dependency;
+  OC_GET_SYMBOL_LEVEL             KextLevel;
+  UINT32                          Index;
+  UINT32                          LookupValueLength;
 
   Symbol = NULL;
   LookupValueLength = (UINT32)AsciiStrLen (LookupValue);
@@ -207,6 +185,8 @@ InternalOcGetSymbolName (
     return NULL;
   }
 
+  ASSERT (Kext->DependencyClosureBuilt);
+
   if ((SymbolLevel == OcGetSymbolOnlyCxx) && (Kext->LinkedSymbolTable != NULL)) {
     Symbol = InternalOcGetSymbolWorkerName (
       Kext,
@@ -214,27 +194,20 @@ InternalOcGetSymbolName (
       LookupValueLength,
       SymbolLevel
       );
-  } else {
-    for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
-      Dependency = Kext->Dependencies[Index];
-      if (Dependency == NULL) {
-        break;
-      }
+  }
 
+  for (Index = 0; Symbol == NULL && Index < Kext->NumberOfClosureDependencies; ++Index) {
+    Dependency = &Kext->DependencyClosure[Index];
+    if (InternalGetDependencySymbolLevel (Dependency, SymbolLevel, &KextLevel)) {
       Symbol = InternalOcGetSymbolWorkerName (
-                 Dependency,
+                 Dependency->Kext,
                  LookupValue,
                  LookupValueLength,
-                 SymbolLevel
+                 KextLevel
                  );
-      if (Symbol != NULL) {
-        break;
-      }
     }
   }
 
-  InternalUnlockContextKexts (Context);
-
   return Symbol;
 }
 
@@ -246,35 +219,30 @@ InternalOcGetSymbolValue (
   IN OC_GET_SYMBOL_LEVEL  SymbolLevel
   )
 {
-  CONST PRELINKED_KEXT_SYMBOL *Symbol;
-
-  PRELINKED_KEXT              *Dependency;
-  UINT32                      Index;
+  CONST PRELINKED_KEXT_SYMBOL     *Symbol;
+  CONST PRELINKED_KEXT_DEPENDENCY *Dependency;
+  OC_GET_SYMBOL_LEVEL             KextLevel;
+  UINT32                          Index;
 
   Symbol = NULL;
 
+  ASSERT (Kext->DependencyClosureBuilt);
+
   if ((SymbolLevel == OcGetSymbolOnlyCxx) && (Kext->LinkedSymbolTable != NULL)) {
     Symbol = InternalOcGetSymbolWorkerValue (Kext, LookupValue, SymbolLevel);
-  } else {
-    for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
-      Dependency = Kext->Dependencies[Index];
-      if (Dependency == NULL) {
-        break;
-      }
+  }
 
+  for (Index = 0; Symbol == NULL && Index < Kext->NumberOfClosureDependencies; ++Index) {
+    Dependency = &Kext->DependencyClosure[Index];
+    if (InternalGetDependencySymbolLevel (Dependency, SymbolLevel, &KextLevel)) {
       Symbol = InternalOcGetSymbolWorkerValue (
-                 Dependency,
+                 Dependency->Kext,
                  LookupValue,
-                 SymbolLevel
+                 KextLevel
                  );
-      if (Symbol != NULL) {
-        break;
-      }
     }
   }
 
-  InternalUnlockContextKexts (Context);
-
   return Symbol;
 }
 
@@ -2098,6 +2066,7 @@ InternalPrelinkKext (
   // Reinitialize the Mach-O context to account for the changed __LINKEDIT
   // segment and file size.
   //
+  MachoFreeSymbolIndex (MachoContext);
   if (!MachoInitializeContext (MachoContext, MachHeader, MachSize, MachoContext->ContainerOffset, Context->Is32Bit)) { 
     //
     // This should never failed under normal and abnormal conditions.
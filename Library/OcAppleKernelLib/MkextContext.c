@@ -61,24 +61,180 @@ ParseKextBinary (
   return FALSE;
 }
 
+//
+// Adler-32 modulus, largest prime below 65536. Both checksum halves
+// are below it, so their products fit UINT32.
+//
+#define MKEXT_ADLER32_BASE     65521U
+
+//
+// Offset of the first byte covered by mkext checksum.
+//
+#define MKEXT_CHECKSUM_START   (OFFSET_OF (MKEXT_CORE_HEADER, Version))
+
+/**
+  Calculate Adler-32 of two adjacent blocks from their checksums.
+
+  @param[in] Adler1    Checksum of the first block.
+  @param[in] Adler2    Checksum of the second block.
+  @param[in] Length2   Length of the second block.
+
+  @return  Checksum of both blocks.
+**/
+STATIC
+UINT32
+MkextAdler32Combine (
+  IN UINT32  Adler1,
+  IN UINT32  Adler2,
+  IN UINT32  Length2
+  )
+{
+  UINT32  Sum1;
+  UINT32  Sum2;
+  UINT32  Rem;
+
+  Rem  = Length2 % MKEXT_ADLER32_BASE;
+  Sum1 = ((Adler1 & 0xFFFFU) + (Adler2 & 0xFFFFU) + MKEXT_ADLER32_BASE - 1) % MKEXT_ADLER32_BASE;
+  Sum2 = (Rem * (Adler1 & 0xFFFFU)) % MKEXT_ADLER32_BASE;
+  Sum2 = ((Adler1 >> 16U) + (Adler2 >> 16U) + MKEXT_ADLER32_BASE - Rem + Sum2) % MKEXT_ADLER32_BASE;
+
+  return (Sum2 << 16U) | Sum1;
+}
+
+/**
+  Calculate Adler-32 of the first block from the checksum of two adjacent
+  blocks and the checksum of the second block.
+
+  @param[in] Adler     Checksum of both blocks.
+  @param[in] Adler2    Checksum of the second block.
+  @param[in] Length2   Length of the second block.
+
+  @return  Checksum of the first block.
+**/
+STATIC
+UINT32
+MkextAdler32Split (
+  IN UINT32  Adler,
+  IN UINT32  Adler2,
+  IN UINT32  Length2
+  )
+{
+  UINT32  Sum1;
+  UINT32  Sum2;
+  UINT32  Rem;
+
+  Rem  = Length2 % MKEXT_ADLER32_BASE;
+  Sum1 = ((Adler & 0xFFFFU) + MKEXT_ADLER32_BASE - (Adler2 & 0xFFFFU) + 1) % MKEXT_ADLER32_BASE;
+  Sum2 = (Rem * Sum1) % MKEXT_ADLER32_BASE;
+  Sum2 = ((Adler >> 16U) + 2 * MKEXT_ADLER32_BASE - (Adler2 >> 16U) + Rem - Sum2) % MKEXT_ADLER32_BASE;
+
+  return (Sum2 << 16U) | Sum1;
+}
+
+/**
+  Update Adler-32 of a block after a region within it was overwritten.
+
+  @param[in] Adler       Checksum of the block.
+  @param[in] Length      Length of the block.
+  @param[in] Offset      Region offset within the block.
+  @param[in] Size        Region size.
+  @param[in] OldAdler    Checksum of the region before the change.
+  @param[in] NewAdler    Checksum of the region after the change.
+
+  @return  Updated checksum of the block.
+**/
+STATIC
+UINT32
+MkextAdler32Replace (
+  IN UINT32  Adler,
+  IN UINT32  Length,
+  IN UINT32  Offset,
+  IN UINT32  Size,
+  IN UINT32  OldAdler,
+  IN UINT32  NewAdler
+  )
+{
+  UINT32  Sum1;
+  UINT32  Sum2;
+  UINT32  Delta;
+  UINT32  Rem;
+
+  ASSERT (Offset <= Length && Size <= Length - Offset);
+
+  //
+  // Each byte contributes once to the first sum and once per every
+  // following byte to the second sum, so only the bytes after
+  // the region need to be accounted for separately.
+  //
+  Rem   = (Length - Offset - Size) % MKEXT_ADLER32_BASE;
+  Delta = ((NewAdler & 0xFFFFU) + MKEXT_ADLER32_BASE - (OldAdler & 0xFFFFU)) % MKEXT_ADLER32_BASE;
+  Sum1  = ((Adler & 0xFFFFU) + Delta) % MKEXT_ADLER32_BASE;
+  Sum2  = (Rem * Delta) % MKEXT_ADLER32_BASE;
+  Sum2  = ((Adler >> 16U) + (NewAdler >> 16U) + MKEXT_ADLER32_BASE - (OldAdler >> 16U) + Sum2) % MKEXT_ADLER32_BASE;
+
+  return (Sum2 << 16U) | Sum1;
+}
+
 STATIC
 VOID
 UpdateMkextLengthChecksum (
   IN MKEXT_HEADER_ANY   *Mkext,
-  IN UINT32             Length
+  IN UINT32             Length,
+  IN UINT32             Checksum
   )
 {
   Mkext->Common.Length  = SwapBytes32 (Length);
-  Mkext->Common.Adler32 = SwapBytes32 (
-    Adler32 ((UINT8*)&Mkext->Common.Version,
-      Length - OFFSET_OF (MKEXT_CORE_HEADER, Version))
-      );
+  Mkext->Common.Adler32 = SwapBytes32 (Checksum);
 }
 
+/**
+  Calculate Adler-32 of mkext header part covered by the checksum,
+  including v1 kext slots.
+
+  @param[in]  Context     Mkext context.
+  @param[out] HeaderSize  Size of the header part.
+
+  @return  Header checksum.
+**/
+STATIC
+UINT32
+MkextHeaderChecksum (
+  IN  MKEXT_CONTEXT   *Context,
+  OUT UINT32          *HeaderSize
+  )
+{
+  if (Context->MkextVersion == MKEXT_VERSION_V1) {
+    //
+    // Bounds verified at context creation.
+    //
+    *HeaderSize = sizeof (MKEXT_V1_HEADER) + Context->NumMaxKexts * sizeof (MKEXT_V1_KEXT);
+  } else {
+    *HeaderSize = sizeof (MKEXT_V2_HEADER);
+  }
+
+  *HeaderSize -= MKEXT_CHECKSUM_START;
+  return Adler32Update (1, &Context->Mkext[MKEXT_CHECKSUM_START], *HeaderSize);
+}
+
+/**
+  Parse mkext v2 plist.
+
+  @param[in]  Mkext         Mkext v2 buffer.
+  @param[in]  ForExport     Keep an unmodified copy of the plist right after
+                            the parsed one, so that exporting the document
+                            copies unchanged parts verbatim.
+  @param[out] Plist         Parsed plist buffer, to be freed by the caller.
+  @param[out] PlistSize     Plist size.
+  @param[out] PlistDoc      Parsed plist document.
+  @param[out] PlistBundles  Array of bundles.
+
+  @return  TRUE on success.
+**/
 STATIC
 BOOLEAN
 ParseMkextV2Plist (
   IN  MKEXT_V2_HEADER   *Mkext,
+  IN  BOOLEAN           ForExport,
   OUT UINT8             **Plist,
   OUT UINT32            *PlistSize,
   OUT XML_DOCUMENT      **PlistDoc,
@@ -93,6 +249,7 @@ ParseMkextV2Plist (
   UINT32              PlistCompressedSize;
   UINT32              PlistFullSize;
   UINT32              PlistStoredSize;
+  UINT32              PlistAllocSize;
   UINT32              Tmp;
 
   XML_NODE            *MkextInfoRoot;
@@ -118,7 +275,12 @@ ParseMkextV2Plist (
     return FALSE;
   }
 
-  PlistBuffer = AllocatePool (PlistFullSize);
+  PlistAllocSize = PlistFullSize;
+  if (ForExport && OcOverflowMulU32 (PlistFullSize, 2, &PlistAllocSize)) {
+    return FALSE;
+  }
+
+  PlistBuffer = AllocatePool (PlistAllocSize);
   if (PlistBuffer == NULL) {
     return FALSE;
   }
@@ -140,12 +302,20 @@ ParseMkextV2Plist (
     CopyMem (PlistBuffer, &MkextBuffer[PlistOffset], PlistFullSize);
   }
 
+  if (ForExport) {
+    CopyMem ((UINT8 *) PlistBuffer + PlistFullSize, PlistBuffer, PlistFullSize);
+  }
+
   PlistXml = XmlDocumentParse (PlistBuffer, PlistFullSize, FALSE);
   if (PlistXml == NULL) {
     FreePool (PlistBuffer);
     return FALSE;
   }
 
+  if (ForExport) {
+    XmlDocumentSetSource (PlistXml, (CHAR8 *) PlistBuffer + PlistFullSize);
+  }
+
   //
   // Mkext v2 root element is a dictionary containing an array of bundles.
   //
@@ -194,28 +364,30 @@ UpdateMkextV2Plist (
   )
 {
   UINT8       *MkextBuffer;
-  CHAR8       *ExportedInfo;
   UINT32      ExportedInfoSize;
   UINT32      TmpSize;
 
   //
-  // Export plist and include \0 terminator in size.
+  // Export plist directly to its final location and include \0 terminator in size.
   //
-  ExportedInfo = XmlDocumentExport (PlistDoc, &ExportedInfoSize, 0, FALSE);
-  if (ExportedInfo == NULL) {
-    return 0;
-  }
-  ExportedInfoSize++;
-
-  if (OcOverflowAddU32 (Offset, ExportedInfoSize, &TmpSize)
+  if (!XmlDocumentExportSize (PlistDoc, &ExportedInfoSize, 0, FALSE)
+    || OcOverflowTriAddU32 (Offset, ExportedInfoSize, 1, &TmpSize)
     || TmpSize > AllocatedSize) {
-    FreePool (ExportedInfo);
     return 0;
   }
 
   MkextBuffer = (UINT8 *) Mkext;
-  CopyMem (&MkextBuffer[Offset], ExportedInfo, ExportedInfoSize);
-  FreePool (ExportedInfo);
+  if (!XmlDocumentExportToBuffer (
+    PlistDoc,
+    (CHAR8 *) &MkextBuffer[Offset],
+    AllocatedSize - Offset,
+    &ExportedInfoSize,
+    0,
+    FALSE
+    )) {
+    return 0;
+  }
+  ExportedInfoSize++;
 
   Mkext->PlistOffset          = SwapBytes32 (Offset);
   Mkext->PlistFullSize        = SwapBytes32 (ExportedInfoSize);
@@ -503,6 +675,8 @@ MkextDecompress (
   UINT32                BinCompSize;
   UINT32                BinFullSize;
   UINT32                BinFullSizeAligned;
+  UINT32                BodyOffset;
+  UINT32                BodyChecksum;
 
   UINT8                 *PlistBuffer;
   XML_DOCUMENT          *PlistXml;
@@ -546,6 +720,8 @@ MkextDecompress (
   }
 
   MkextHeaderOut = NULL;
+  BodyOffset     = 0;
+  BodyChecksum   = 1;
 
   //
   // Mkext v1.
@@ -562,6 +738,7 @@ MkextDecompress (
       return EFI_INVALID_PARAMETER;
     }
     CurrentOffset = MKEXT_ALIGN (CurrentOffset);
+    BodyOffset    = CurrentOffset;
 
     if (Decompress) {
       //
@@ -573,10 +750,12 @@ MkextDecompress (
       }
       
       //
-      // Copy header.
+      // Copy header. Reserved kext slots are zeroed to keep the checksum deterministic.
       //
       CopyMem (OutBuffer, Buffer, sizeof (MKEXT_V1_HEADER));
       MkextHeaderOut = (MKEXT_HEADER_ANY *) OutBuffer;
+      Tmp            = sizeof (MKEXT_V1_HEADER) + NumKexts * sizeof (MKEXT_V1_KEXT);
+      ZeroMem (&OutBuffer[Tmp], CurrentOffset - Tmp);
     }
 
     //
@@ -635,7 +814,13 @@ MkextDecompress (
         MkextHeaderOut->V1.Kexts[Index].Plist.CompressedSize  = 0;
         MkextHeaderOut->V1.Kexts[Index].Plist.FullSize        = SwapBytes32 (PlistFullSize);
         MkextHeaderOut->V1.Kexts[Index].Plist.ModifiedSeconds = MkextHeader->V1.Kexts[Index].Plist.ModifiedSeconds;
-        CurrentOffset                                         += PlistFullSizeAligned;
+
+        //
+        // Checksum each entry right after writing, while it is still in cache.
+        //
+        ZeroMem (&OutBuffer[CurrentOffset + PlistFullSize], PlistFullSizeAligned - PlistFullSize);
+        BodyChecksum   = Adler32Update (BodyChecksum, &OutBuffer[CurrentOffset], PlistFullSizeAligned);
+        CurrentOffset += PlistFullSizeAligned;
 
         if (BinFullSize > 0) {
           //
@@ -664,7 +849,10 @@ MkextDecompress (
           MkextHeaderOut->V1.Kexts[Index].Binary.CompressedSize   = 0;
           MkextHeaderOut->V1.Kexts[Index].Binary.FullSize         = SwapBytes32 (BinFullSize);
           MkextHeaderOut->V1.Kexts[Index].Binary.ModifiedSeconds  = MkextHeader->V1.Kexts[Index].Binary.ModifiedSeconds;
-          CurrentOffset                                           += BinFullSizeAligned;
+
+          ZeroMem (&OutBuffer[CurrentOffset + BinFullSize], BinFullSizeAligned - BinFullSize);
+          BodyChecksum   = Adler32Update (BodyChecksum, &OutBuffer[CurrentOffset], BinFullSizeAligned);
+          CurrentOffset += BinFullSizeAligned;
         } else {
           ZeroMem (&MkextHeaderOut->V1.Kexts[Index].Binary, sizeof (MKEXT_V1_KEXT_FILE));
         }
@@ -694,6 +882,7 @@ MkextDecompress (
       return EFI_INVALID_PARAMETER;
     }
     CurrentOffset = MKEXT_ALIGN (sizeof (MKEXT_V2_HEADER));
+    BodyOffset    = CurrentOffset;
 
     if (Decompress) {
       //
@@ -708,10 +897,11 @@ MkextDecompress (
       // Copy header.
       //
       CopyMem (OutBuffer, Buffer, sizeof (MKEXT_V2_HEADER));
+      ZeroMem (&OutBuffer[sizeof (MKEXT_V2_HEADER)], CurrentOffset - sizeof (MKEXT_V2_HEADER));
       MkextHeaderOut = (MKEXT_HEADER_ANY *) OutBuffer;
     }
 
-    if (!ParseMkextV2Plist (&MkextHeader->V2, &PlistBuffer, &PlistFullSize, &PlistXml, &PlistBundles)) {
+    if (!ParseMkextV2Plist (&MkextHeader->V2, Decompress, &PlistBuffer, &PlistFullSize, &PlistXml, &PlistBundles)) {
       return EFI_INVALID_PARAMETER;
     }
 
@@ -837,6 +1027,15 @@ MkextDecompress (
               return EFI_INVALID_PARAMETER;
             }
             XmlNodeChangeContent (BundleExecutable, &BinaryOffsetStrings[Index * KEXT_OFFSET_STR_LEN]);
+
+            //
+            // Checksum each entry right after writing, while it is still in cache.
+            //
+            ZeroMem (
+              &MkextOutExecutableEntry->Data[BinFullSize],
+              NewOffset - CurrentOffset - sizeof (MKEXT_V2_FILE_ENTRY) - BinFullSize
+              );
+            BodyChecksum = Adler32Update (BodyChecksum, &OutBuffer[CurrentOffset], NewOffset - CurrentOffset);
           }
 
           //
@@ -860,6 +1059,8 @@ MkextDecompress (
         || OcOverflowAddU32 (CurrentOffset, PlistFullSize, OutMkextSize)) {
         return EFI_INVALID_PARAMETER;
       }
+
+      BodyChecksum = Adler32Update (BodyChecksum, &OutBuffer[CurrentOffset], PlistFullSize);
     } else {
       //
       // Account for plist, future plist expansion for each bundle, 
@@ -881,7 +1082,18 @@ MkextDecompress (
   }
 
   if (Decompress) {
-    UpdateMkextLengthChecksum (MkextHeaderOut, *OutMkextSize);
+    //
+    // Header fields are final only now, so combine their checksum with the entries.
+    //
+    UpdateMkextLengthChecksum (
+      MkextHeaderOut,
+      *OutMkextSize,
+      MkextAdler32Combine (
+        Adler32Update (1, &OutBuffer[MKEXT_CHECKSUM_START], BodyOffset - MKEXT_CHECKSUM_START),
+        BodyChecksum,
+        *OutMkextSize - BodyOffset
+        )
+      );
   }
   return EFI_SUCCESS;
 }
@@ -942,6 +1154,7 @@ MkextContextInit (
   UINT32              PlistOffset;
   UINT32              PlistFullSize;
   XML_NODE            *PlistBundles;
+  UINT32              HeaderSize;
 
   //
   // Assumptions:
@@ -1032,13 +1245,16 @@ MkextContextInit (
   //
   } else if (MkextVersion == MKEXT_VERSION_V2) {
     if (MkextSize < sizeof (MKEXT_V2_HEADER)
-      || !ParseMkextV2Plist (&MkextHeader->V2, &PlistBuffer, &PlistFullSize, &PlistXml, &PlistBundles)) {
+      || !ParseMkextV2Plist (&MkextHeader->V2, TRUE, &PlistBuffer, &PlistFullSize, &PlistXml, &PlistBundles)) {
       return EFI_INVALID_PARAMETER;
     }
     PlistOffset = SwapBytes32 (MkextHeader->V2.PlistOffset);
 
-    if (OcOverflowAddU32 (PlistOffset, PlistFullSize, &Tmp)
+    if (PlistOffset < sizeof (MKEXT_V2_HEADER)
+      || OcOverflowAddU32 (PlistOffset, PlistFullSize, &Tmp)
       || Tmp != MkextSize) {
+      XmlDocumentFree (PlistXml);
+      FreePool (PlistBuffer);
       return EFI_INVALID_PARAMETER;
     }
 
@@ -1059,6 +1275,13 @@ MkextContextInit (
   Context->NumKexts             = NumKexts;
   InitializeListHead (&Context->CachedKexts);
 
+  //
+  // Injected kexts and v2 plist are placed after the original data, so only
+  // its checksum is kept, updated when the header or kexts are changed.
+  //
+  Context->MkextChecksum        = SwapBytes32 (MkextHeader->Common.Adler32);
+  Context->MkextChecksumSize    = MkextSize - MKEXT_CHECKSUM_START;
+
   if (MkextVersion == MKEXT_VERSION_V1) {
     Context->NumMaxKexts        = NumMaxKexts;
   } else if (MkextVersion == MKEXT_VERSION_V2) {
@@ -1066,8 +1289,17 @@ MkextContextInit (
     Context->MkextInfo          = PlistBuffer;
     Context->MkextInfoDocument  = PlistXml;
     Context->MkextKexts         = PlistBundles;
+
+    Context->MkextChecksumSize  = PlistOffset - MKEXT_CHECKSUM_START;
+    Context->MkextChecksum      = MkextAdler32Split (
+      Context->MkextChecksum,
+      Adler32Update (1, &Mkext[PlistOffset], PlistFullSize),
+      PlistFullSize
+      );
   }
 
+  Context->MkextHeaderChecksum  = MkextHeaderChecksum (Context, &HeaderSize);
+
   return EFI_SUCCESS;
 }
 
@@ -1407,6 +1639,60 @@ MkextInjectKext (
   return EFI_SUCCESS;
 }
 
+/**
+  Calculate Adler-32 of kext binary before modifying it in place.
+
+  @param[in]  Context     Mkext context.
+  @param[in]  Kext        Cached kext.
+  @param[out] Checksum    Binary checksum.
+
+  @return  FALSE if the binary is not covered by tracked mkext checksum.
+**/
+STATIC
+BOOLEAN
+MkextKextChecksum (
+  IN  MKEXT_CONTEXT  *Context,
+  IN  MKEXT_KEXT     *Kext,
+  OUT UINT32         *Checksum
+  )
+{
+  //
+  // Bounds were verified when caching the kext.
+  //
+  if (Kext->BinaryOffset < MKEXT_CHECKSUM_START
+    || Kext->BinaryOffset - MKEXT_CHECKSUM_START + Kext->BinarySize > Context->MkextChecksumSize) {
+    return FALSE;
+  }
+
+  *Checksum = Adler32Update (1, &Context->Mkext[Kext->BinaryOffset], Kext->BinarySize);
+  return TRUE;
+}
+
+/**
+  Account for in-place kext binary modification in mkext checksum.
+
+  @param[in,out] Context      Mkext context.
+  @param[in]     Kext         Cached kext.
+  @param[in]     OldChecksum  Binary checksum before modification.
+**/
+STATIC
+VOID
+UpdateMkextKextChecksum (
+  IN OUT MKEXT_CONTEXT  *Context,
+  IN     MKEXT_KEXT     *Kext,
+  IN     UINT32         OldChecksum
+  )
+{
+  Context->MkextChecksum = MkextAdler32Replace (
+    Context->MkextChecksum,
+    Context->MkextChecksumSize,
+    Kext->BinaryOffset - MKEXT_CHECKSUM_START,
+    Kext->BinarySize,
+    OldChecksum,
+    Adler32Update (1, &Context->Mkext[Kext->BinaryOffset], Kext->BinarySize)
+    );
+}
+
 EFI_STATUS
 MkextContextApplyPatch (
   IN OUT MKEXT_CONTEXT          *Context,
@@ -1416,6 +1702,9 @@ MkextContextApplyPatch (
 {
   EFI_STATUS            Status;
   PATCHER_CONTEXT       Patcher;
+  MKEXT_KEXT            *Kext;
+  UINT32                Checksum;
+  BOOLEAN               HasChecksum;
 
   ASSERT (Context != NULL);
   ASSERT (Identifier != NULL);
@@ -1427,7 +1716,16 @@ MkextContextApplyPatch (
     return Status;
   }
 
-  return PatcherApplyGenericPatch (&Patcher, Patch);
+  Kext        = InternalCachedMkextKext (Context, Identifier);
+  HasChecksum = MkextKextChecksum (Context, Kext, &Checksum);
+
+  Status = PatcherApplyGenericPatch (&Patcher, Patch);
+  MachoFreeSymbolIndex (&Patcher.MachContext);
+
+  if (HasChecksum) {
+    UpdateMkextKextChecksum (Context, Kext, Checksum);
+  }
+  return Status;
 }
 
 EFI_STATUS
@@ -1440,6 +1738,9 @@ MkextContextApplyQuirk (
   EFI_STATUS            Status;
   KERNEL_QUIRK          *KernelQuirk;
   PATCHER_CONTEXT       Patcher;
+  MKEXT_KEXT            *Kext;
+  UINT32                Checksum;
+  BOOLEAN               HasChecksum;
 
   ASSERT (Context != NULL);
 
@@ -1448,7 +1749,16 @@ MkextContextApplyQuirk (
 
   Status = PatcherInitContextFromMkext (&Patcher, Context, KernelQuirk->Identifier);
   if (!EFI_ERROR (Status)) {
-    return KernelQuirk->PatchFunction (&Patcher, KernelVersion);
+    Kext        = InternalCachedMkextKext (Context, KernelQuirk->Identifier);
+    HasChecksum = MkextKextChecksum (Context, Kext, &Checksum);
+
+    Status = KernelQuirk->PatchFunction (&Patcher, KernelVersion);
+    MachoFreeSymbolIndex (&Patcher.MachContext);
+
+    if (HasChecksum) {
+      UpdateMkextKextChecksum (Context, Kext, Checksum);
+    }
+    return Status;
   }
 
   //
@@ -1466,6 +1776,9 @@ MkextContextBlock (
 {
   EFI_STATUS            Status;
   PATCHER_CONTEXT       Patcher;
+  MKEXT_KEXT            *Kext;
+  UINT32                Checksum;
+  BOOLEAN               HasChecksum;
 
   ASSERT (Context != NULL);
   ASSERT (Identifier != NULL);
@@ -1476,7 +1789,15 @@ MkextContextBlock (
     return Status;
   }
 
-  return PatcherBlockKext (&Patcher);
+  Kext        = InternalCachedMkextKext (Context, Identifier);
+  HasChecksum = MkextKextChecksum (Context, Kext, &Checksum);
+
+  Status = PatcherBlockKext (&Patcher);
+
+  if (HasChecksum) {
+    UpdateMkextKextChecksum (Context, Kext, Checksum);
+  }
+  return Status;
 }
 
 EFI_STATUS
@@ -1485,6 +1806,9 @@ MkextInjectPatchComplete (
   )
 {
   UINT32 MkextPlistSize;
+  UINT32 HeaderSize;
+  UINT32 Checksum;
+  UINT32 TailOffset;
 
   ASSERT (Context != NULL);
 
@@ -1504,6 +1828,9 @@ MkextInjectPatchComplete (
       Context->MkextInfoDocument,
       Context->MkextInfoOffset
       );
+    if (MkextPlistSize == 0) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
     Context->MkextSize = Context->MkextInfoOffset + MkextPlistSize;
 
   //
@@ -1513,6 +1840,28 @@ MkextInjectPatchComplete (
     return EFI_UNSUPPORTED;
   }
 
-  UpdateMkextLengthChecksum (Context->MkextHeader, Context->MkextSize);
+  //
+  // Only the header and the data appended after the original mkext need to
+  // be checksummed, kext binaries changed in place are already accounted for.
+  //
+  Checksum   = MkextHeaderChecksum (Context, &HeaderSize);
+  Checksum   = MkextAdler32Replace (
+    Context->MkextChecksum,
+    Context->MkextChecksumSize,
+    0,
+    HeaderSize,
+    Context->MkextHeaderChecksum,
+    Checksum
+    );
+  TailOffset = MKEXT_CHECKSUM_START + Context->MkextChecksumSize;
+  UpdateMkextLengthChecksum (
+    Context->MkextHeader,
+    Context->MkextSize,
+    MkextAdler32Combine (
+      Checksum,
+      Adler32Update (1, &Context->Mkext[TailOffset], Context->MkextSize - TailOffset),
+      Context->MkextSize - TailOffset
+      )
+    );
   return EFI_SUCCESS;
 }
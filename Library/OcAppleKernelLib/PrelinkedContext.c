@@ -23,6 +23,7 @@
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcMachoLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 
 #include "PrelinkedInternal.h"
 #include "ProcessorBind.h"
@@ -216,6 +217,8 @@ PrelinkedContextInit (
   UINT64                   SegmentEndOffset;
   UINT32                   PrelinkedInfoRootIndex;
   UINT32                   PrelinkedInfoRootCount;
+  UINT32                   PrelinkedInfoSize;
+  UINT32                   ScratchSize;
   PRELINKED_KEXT           *PrelinkedKext;
 
   ASSERT (Context != NULL);
@@ -335,20 +338,53 @@ PrelinkedContextInit (
     }
   }
 
-  Context->PrelinkedInfo = Context->Is32Bit ?
-    AllocateCopyPool (Context->PrelinkedInfoSection->Section32.Size,
-      &Context->Prelinked[Context->PrelinkedInfoSection->Section32.Offset]) :
-    AllocateCopyPool ((UINTN) Context->PrelinkedInfoSection->Section64.Size,
-      &Context->Prelinked[Context->PrelinkedInfoSection->Section64.Offset]);  
+  PrelinkedInfoSize = Context->Is32Bit ?
+    Context->PrelinkedInfoSection->Section32.Size : (UINT32) Context->PrelinkedInfoSection->Section64.Size;
+
+  //
+  // Prelinked info copies and identifiers of kexts cached afterwards all live
+  // as long as the context, so reserve one scratch arena chunk for them.
+  //
+  if (OcOverflowAlignUpU32 (PrelinkedInfoSize, sizeof (UINT64), &ScratchSize)
+    || OcOverflowMulAddU32 (ScratchSize, 2, PRELINKED_SCRATCH_CHUNK_SIZE, &ScratchSize)) {
+    PrelinkedContextFree (Context);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = InternalPrelinkedReserveScratch (Context, ScratchSize);
+  if (EFI_ERROR (Status)) {
+    PrelinkedContextFree (Context);
+    return Status;
+  }
+
+  Context->PrelinkedInfo = InternalPrelinkedAllocateScratch (Context, PrelinkedInfoSize);
   if (Context->PrelinkedInfo == NULL) {
     PrelinkedContextFree (Context);
     return EFI_OUT_OF_RESOURCES;
   }
 
+  CopyMem (
+    Context->PrelinkedInfo,
+    &Context->Prelinked[Context->Is32Bit ?
+      Context->PrelinkedInfoSection->Section32.Offset : Context->PrelinkedInfoSection->Section64.Offset],
+    PrelinkedInfoSize
+    );
+
+  //
+  // The original section may be overwritten by injected kexts, and parsing
+  // modifies the buffer, so keep one more copy for splicing the plist on export.
+  //
+  Context->PrelinkedInfoSource = InternalPrelinkedAllocateScratch (Context, PrelinkedInfoSize);
+  if (Context->PrelinkedInfoSource == NULL) {
+    PrelinkedContextFree (Context);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (Context->PrelinkedInfoSource, Context->PrelinkedInfo, PrelinkedInfoSize);
+
   Context->PrelinkedInfoDocument = XmlDocumentParse (
     Context->PrelinkedInfo,
-    (UINT32) (Context->Is32Bit ?
-      Context->PrelinkedInfoSection->Section32.Size : Context->PrelinkedInfoSection->Section64.Size),
+    PrelinkedInfoSize,
     TRUE
     );
   if (Context->PrelinkedInfoDocument == NULL) {
@@ -356,6 +392,8 @@ PrelinkedContextInit (
     return EFI_INVALID_PARAMETER;
   }
 
+  XmlDocumentSetSource (Context->PrelinkedInfoDocument, Context->PrelinkedInfoSource);
+
   //
   // For a kernel collection the this is a full plist, while for legacy prelinked format
   // it starts with a <dict> node.
@@ -427,15 +465,13 @@ PrelinkedContextFree (
     Context->PrelinkedInfoDocument = NULL;
   }
 
-  if (Context->KextScratchBuffer != NULL) {
-    FreePool (Context->KextScratchBuffer);
-    Context->KextScratchBuffer = NULL;
-  }
-
-  if (Context->PrelinkedInfo != NULL) {
-    FreePool (Context->PrelinkedInfo);
-    Context->PrelinkedInfo = NULL;
-  }
+  //
+  // Plist copies and scratch buffer are allocated from the scratch arena,
+  // which is freed with the pooled buffers.
+  //
+  Context->KextScratchBuffer   = NULL;
+  Context->PrelinkedInfo       = NULL;
+  Context->PrelinkedInfoSource = NULL;
 
   if (Context->PooledBuffers != NULL) {
     for (Index = 0; Index < Context->PooledBuffersCount; ++Index) {
@@ -445,12 +481,22 @@ PrelinkedContextFree (
     Context->PooledBuffers = NULL;
   }
 
+  Context->ScratchArena      = NULL;
+  Context->ScratchArenaSize  = 0;
+  Context->ScratchArenaUsed  = 0;
+  Context->ScratchArenaTotal = 0;
+
   if (Context->LinkBuffer != NULL) {
     ZeroMem (Context->LinkBuffer, Context->LinkBufferSize);
     FreePool (Context->LinkBuffer);
     Context->LinkBuffer = NULL;
   }
 
+  if (Context->VtableCache != NULL) {
+    FreePool (Context->VtableCache);
+    Context->VtableCache = NULL;
+  }
+
   if (Context->PrelinkedStateKernel != NULL) {
     FreePool (Context->PrelinkedStateKernel);
     Context->PrelinkedStateKernel = NULL;
@@ -509,6 +555,73 @@ PrelinkedDependencyInsert (
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+InternalPrelinkedReserveScratch (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     UINT32             Size
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Chunk;
+  UINT32      ChunkSize;
+  UINT32      ScratchTotal;
+
+  if (Context->ScratchArenaSize - Context->ScratchArenaUsed >= Size) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // The remainder of the current chunk is abandoned, which is fine as
+  // most allocations are small and large ones are reserved in advance.
+  //
+  ChunkSize = MAX (Size, PRELINKED_SCRATCH_CHUNK_SIZE);
+  if (OcOverflowAddU32 (Context->ScratchArenaTotal, ChunkSize, &ScratchTotal)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Chunk = AllocatePool (ChunkSize);
+  if (Chunk == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = PrelinkedDependencyInsert (Context, Chunk);
+  if (EFI_ERROR (Status)) {
+    FreePool (Chunk);
+    return Status;
+  }
+
+  Context->ScratchArena      = Chunk;
+  Context->ScratchArenaSize  = ChunkSize;
+  Context->ScratchArenaUsed  = 0;
+  Context->ScratchArenaTotal = ScratchTotal;
+
+  return EFI_SUCCESS;
+}
+
+VOID *
+InternalPrelinkedAllocateScratch (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     UINT32             Size
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Buffer;
+
+  if (OcOverflowAlignUpU32 (Size, sizeof (UINT64), &Size)) {
+    return NULL;
+  }
+
+  Status = InternalPrelinkedReserveScratch (Context, Size);
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  Buffer = &Context->ScratchArena[Context->ScratchArenaUsed];
+  Context->ScratchArenaUsed += Size;
+
+  return Buffer;
+}
+
 EFI_STATUS
 PrelinkedInjectPrepare (
   IN OUT PRELINKED_CONTEXT  *Context,
@@ -740,7 +853,6 @@ PrelinkedInjectComplete (
   )
 {
   EFI_STATUS  Status;
-  CHAR8       *ExportedInfo;
   UINT32      ExportedInfoSize;
   UINT32      NewSize;
   UINT32      KextsSize;
@@ -773,19 +885,22 @@ PrelinkedInjectComplete (
     }
   }
 
-  ExportedInfo = XmlDocumentExport (Context->PrelinkedInfoDocument, &ExportedInfoSize, 0, FALSE);
-  if (ExportedInfo == NULL) {
+  //
+  // Measure the plist first, so that it can be exported directly to its
+  // final location at the end of the image. Unchanged parts of the plist
+  // are copied from PrelinkedInfoSource, and only the injected kexts and
+  // modified values are serialised.
+  //
+  if (!XmlDocumentExportSize (Context->PrelinkedInfoDocument, &ExportedInfoSize, 0, FALSE)) {
     return EFI_OUT_OF_RESOURCES;
   }
 
   //
   // Include \0 terminator.
   //
-  ExportedInfoSize++;
-
-  if (OcOverflowAddU32 (Context->PrelinkedSize, MACHO_ALIGN (ExportedInfoSize), &NewSize)
+  if (OcOverflowAddU32 (ExportedInfoSize, 1, &ExportedInfoSize)
+    || OcOverflowAddU32 (Context->PrelinkedSize, MACHO_ALIGN (ExportedInfoSize), &NewSize)
     || NewSize > Context->PrelinkedAllocSize) {
-    FreePool (ExportedInfo);
     return EFI_BUFFER_TOO_SMALL;
   }
 
@@ -795,23 +910,42 @@ PrelinkedInjectComplete (
   // This requires disable __KREMLIN relocation segment addition.
   //
   if (Context->IsKernelCollection && MACHO_ALIGN (ExportedInfoSize) <= Context->PrelinkedInfoSegment->Size) {
-    CopyMem (
-      &Context->Prelinked[Context->PrelinkedInfoSegment->FileOffset],
-      ExportedInfo,
-      ExportedInfoSize
-      );
+    if (!XmlDocumentExportToBuffer (
+      Context->PrelinkedInfoDocument,
+      (CHAR8 *) &Context->Prelinked[Context->PrelinkedInfoSegment->FileOffset],
+      ExportedInfoSize,
+      NULL,
+      0,
+      FALSE
+      )) {
+      return EFI_OUT_OF_RESOURCES;
+    }
 
     ZeroMem (
       &Context->Prelinked[Context->PrelinkedInfoSegment->FileOffset + ExportedInfoSize],
       Context->PrelinkedInfoSegment->FileSize - ExportedInfoSize
       );
 
-    FreePool (ExportedInfo);
-
     return EFI_SUCCESS;
   }
 #endif
 
+  if (!XmlDocumentExportToBuffer (
+    Context->PrelinkedInfoDocument,
+    (CHAR8 *) &Context->Prelinked[Context->PrelinkedSize],
+    ExportedInfoSize,
+    NULL,
+    0,
+    FALSE
+    )) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ZeroMem (
+    &Context->Prelinked[Context->PrelinkedSize + ExportedInfoSize],
+    MACHO_ALIGN (ExportedInfoSize) - ExportedInfoSize
+    );
+
   if (Context->Is32Bit) {
     Context->PrelinkedInfoSegment->Segment32.VirtualAddress = (UINT32) Context->PrelinkedLastAddress;
     Context->PrelinkedInfoSegment->Segment32.Size           = MACHO_ALIGN (ExportedInfoSize);
@@ -844,17 +978,6 @@ PrelinkedInjectComplete (
     Context->InnerInfoSection->Offset         = Context->PrelinkedSize;
   }
 
-  CopyMem (
-    &Context->Prelinked[Context->PrelinkedSize],
-    ExportedInfo,
-    ExportedInfoSize
-    );
-
-  ZeroMem (
-    &Context->Prelinked[Context->PrelinkedSize + ExportedInfoSize],
-    MACHO_ALIGN (ExportedInfoSize) - ExportedInfoSize
-    );
-
   Context->PrelinkedLastAddress += MACHO_ALIGN (ExportedInfoSize);
   Context->PrelinkedSize        += MACHO_ALIGN (ExportedInfoSize);
 
@@ -872,8 +995,6 @@ PrelinkedInjectComplete (
       );
   }
 
-  FreePool (ExportedInfo);
-
   return EFI_SUCCESS;
 }
 
@@ -1096,6 +1217,7 @@ PrelinkedInjectKext (
   }
 
   if (Executable != NULL) {
+    OcTraceBegin ("Link");
     PrelinkedKext = InternalLinkPrelinkedKext (
       Context,
       &ExecutableContext,
@@ -1104,6 +1226,7 @@ PrelinkedInjectKext (
       KmodAddress,
       FileOffset
       );
+    OcTraceEnd ("Link");
 
     if (PrelinkedKext == NULL) {
       XmlDocumentFree (InfoPlistDocument);
@@ -32,6 +32,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 //
 #define KEXT_OFFSET_STR_LEN    24
 
+//
+// Minimal scratch arena chunk size, enough for identifiers of most kexts.
+//
+#define PRELINKED_SCRATCH_CHUNK_SIZE  SIZE_64KB
+
 //
 // Kernel quirks array.
 //
@@ -48,6 +53,12 @@ typedef struct {
   UINT32       Length;
 } PRELINKED_KEXT_SYMBOL;
 
+typedef struct {
+  PRELINKED_KEXT  *Kext;      ///< Dependency kext.
+  BOOLEAN         Direct;     ///< Listed in Dependencies, all symbols are visible.
+  BOOLEAN         Repeated;   ///< Already listed earlier in the closure.
+} PRELINKED_KEXT_DEPENDENCY;
+
 typedef struct {
   CONST CHAR8 *Name;    ///< The symbol's name.
   UINT64      Address;  ///< The symbol's address.
@@ -127,9 +138,19 @@ struct PRELINKED_KEXT_ {
   //
   PRELINKED_KEXT_SYMBOL    *LinkedSymbolTable;
   //
-  // A flag set during dependency walk BFS to avoid going through the same path.
+  // Flattened dependency closure in symbol lookup order: every direct
+  // dependency followed by its not yet listed dependencies in depth-first
+  // order. Built once by InternalScanPrelinkedKext, may be NULL when empty.
+  //
+  PRELINKED_KEXT_DEPENDENCY *DependencyClosure;
+  //
+  // Number of entries in DependencyClosure.
+  //
+  UINT32                   NumberOfClosureDependencies;
   //
-  BOOLEAN                  Processed;
+  // Whether DependencyClosure is built.
+  //
+  BOOLEAN                  DependencyClosureBuilt;
   //
   // Number of vtables in this kext.
   //
@@ -138,6 +159,15 @@ struct PRELINKED_KEXT_ {
   // Scanned vtable buffer. Iterated with GET_NEXT_PRELINKED_VTABLE.
   //
   PRELINKED_VTABLE         *LinkedVtables;
+  //
+  // Vtable name hash index over LinkedVtables (open addressing), may be NULL.
+  // Built for dependencies together with LinkedSymbolTable.
+  //
+  CONST PRELINKED_VTABLE   **VtableIndex;
+  //
+  // Vtable name hash index size - 1.
+  //
+  UINT32                   VtableIndexMask;
 };
 
 //
@@ -172,6 +202,37 @@ struct PRELINKED_KEXT_ {
     ))
 
 
+/**
+  Allocate memory living as long as PRELINKED_CONTEXT from its scratch arena.
+  The memory is freed upon context destruction.
+
+  @param[in,out] Context  Prelinked context.
+  @param[in]     Size     Allocation size.
+
+  @return  8-byte aligned memory or NULL.
+**/
+VOID *
+InternalPrelinkedAllocateScratch (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     UINT32             Size
+  );
+
+/**
+  Ensure that PRELINKED_CONTEXT scratch arena has at least Size bytes
+  available in a single chunk, so that subsequent allocations of the
+  estimated total size do not fragment memory.
+
+  @param[in,out] Context  Prelinked context.
+  @param[in]     Size     Estimated total allocation size.
+
+  @retval  EFI_SUCCESS on success.
+**/
+EFI_STATUS
+InternalPrelinkedReserveScratch (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     UINT32             Size
+  );
+
 /**
   Creates new PRELINKED_KEXT from OC_MACHO_CONTEXT.
 **/
@@ -216,16 +277,6 @@ InternalScanPrelinkedKext (
   IN     BOOLEAN            Dependency
   );
 
-/**
-  Unlock all context dependency kexts by unsetting Processed flag.
-
-  @param[in] Context      Prelinked context.
-**/
-VOID
-InternalUnlockContextKexts (
-  IN PRELINKED_CONTEXT  *Context
-  );
-
 /**
   Link executable within current prelink context.
 
@@ -383,6 +434,48 @@ InternalGetOcVtableByName (
   IN CONST CHAR8           *Name
   );
 
+/**
+  Build vtable name hash index for dependency kext vtables.
+  Lookups fall back to linear search when the index cannot be allocated.
+
+  @param[in,out] Kext  Kext dependency with LinkedVtables.
+**/
+VOID
+InternalBuildVtableIndex (
+  IN OUT PRELINKED_KEXT  *Kext
+  );
+
+/**
+  Free vtable name hash index if any.
+
+  @param[in,out] Kext  Kext dependency.
+**/
+VOID
+InternalFreeVtableIndex (
+  IN OUT PRELINKED_KEXT  *Kext
+  );
+
+//
+// Number of parent vtable lookup results memorised per prelinked context.
+// Must be a power of two.
+//
+#define PRELINKED_VTABLE_CACHE_SIZE  1024U
+
+typedef struct {
+  //
+  // Dependency kext the lookup was started from.
+  //
+  PRELINKED_KEXT          *Dependency;
+  //
+  // Vtable found in the dependency or its own dependencies.
+  //
+  CONST PRELINKED_VTABLE  *Vtable;
+  //
+  // Vtable name hash.
+  //
+  UINT32                  Hash;
+} PRELINKED_VTABLE_CACHE_ENTRY;
+
 //
 // Prelink
 //
@@ -625,6 +625,200 @@ InternalInsertPrelinkedKextDependency (
   return EFI_SUCCESS;
 }
 
+/**
+  Check whether a kext is already listed in the dependency closure.
+
+  @param[in] Closure         Dependency closure being built.
+  @param[in] Count           Number of entries in Closure.
+  @param[in] DependencyKext  Kext to look up.
+
+  @retval TRUE  DependencyKext is listed in Closure.
+**/
+STATIC
+BOOLEAN
+InternalIsInDependencyClosure (
+  IN CONST PRELINKED_KEXT_DEPENDENCY  *Closure,
+  IN UINT32                           Count,
+  IN CONST PRELINKED_KEXT             *DependencyKext
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < Count; ++Index) {
+    if (Closure[Index].Kext == DependencyKext) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Append a dependency to the dependency closure being built.
+
+  @param[in,out] Closure         Dependency closure being built.
+  @param[in,out] Count           Number of entries in Closure.
+  @param[in,out] AllocCount      Number of entries allocated for Closure.
+  @param[in]     DependencyKext  Kext to append.
+  @param[in]     Direct          Whether DependencyKext is a direct dependency.
+  @param[in]     Repeated        Whether DependencyKext is already in Closure.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
+EFI_STATUS
+InternalAppendDependencyClosure (
+  IN OUT PRELINKED_KEXT_DEPENDENCY  **Closure,
+  IN OUT UINT32                     *Count,
+  IN OUT UINT32                     *AllocCount,
+  IN     PRELINKED_KEXT             *DependencyKext,
+  IN     BOOLEAN                    Direct,
+  IN     BOOLEAN                    Repeated
+  )
+{
+  PRELINKED_KEXT_DEPENDENCY  *NewClosure;
+
+  if (*Count == *AllocCount) {
+    NewClosure = AllocatePool (2 * (*AllocCount + 4) * sizeof (NewClosure[0]));
+    if (NewClosure == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    if (*Closure != NULL) {
+      CopyMem (NewClosure, *Closure, *Count * sizeof (NewClosure[0]));
+      FreePool (*Closure);
+    }
+
+    *Closure    = NewClosure;
+    *AllocCount = 2 * (*AllocCount + 4);
+  }
+
+  (*Closure)[*Count].Kext     = DependencyKext;
+  (*Closure)[*Count].Direct   = Direct;
+  (*Closure)[*Count].Repeated = Repeated;
+  ++*Count;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Append not yet listed dependencies of Parent to the dependency closure
+  of Kext in depth-first order.
+
+  @param[in]     Kext        Kext owning the closure.
+  @param[in]     Parent      Kext to append the dependencies of.
+  @param[in,out] Closure     Dependency closure being built.
+  @param[in,out] Count       Number of entries in Closure.
+  @param[in,out] AllocCount  Number of entries allocated for Closure.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
+EFI_STATUS
+InternalAppendIndirectDependencies (
+  IN     CONST PRELINKED_KEXT       *Kext,
+  IN     CONST PRELINKED_KEXT       *Parent,
+  IN OUT PRELINKED_KEXT_DEPENDENCY  **Closure,
+  IN OUT UINT32                     *Count,
+  IN OUT UINT32                     *AllocCount
+  )
+{
+  EFI_STATUS      Status;
+  UINT32          Index;
+  PRELINKED_KEXT  *Dependency;
+
+  for (Index = 0; Index < ARRAY_SIZE (Parent->Dependencies); ++Index) {
+    Dependency = Parent->Dependencies[Index];
+    if (Dependency == NULL) {
+      break;
+    }
+
+    if (Dependency == Kext || InternalIsInDependencyClosure (*Closure, *Count, Dependency)) {
+      continue;
+    }
+
+    Status = InternalAppendDependencyClosure (Closure, Count, AllocCount, Dependency, FALSE, FALSE);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Status = InternalAppendIndirectDependencies (Kext, Dependency, Closure, Count, AllocCount);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Build flattened dependency closure of a kext with all its dependencies
+  scanned. The order matches a depth-first walk over Dependencies, which
+  skips already visited kexts except for direct dependencies.
+
+  @param[in,out] Kext  Kext to build the closure of.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
+EFI_STATUS
+InternalBuildDependencyClosure (
+  IN OUT PRELINKED_KEXT  *Kext
+  )
+{
+  EFI_STATUS                 Status;
+  PRELINKED_KEXT_DEPENDENCY  *Closure;
+  UINT32                     Count;
+  UINT32                     AllocCount;
+  UINT32                     Index;
+  PRELINKED_KEXT             *Dependency;
+  BOOLEAN                    Repeated;
+
+  if (Kext->DependencyClosureBuilt) {
+    return EFI_SUCCESS;
+  }
+
+  Closure    = NULL;
+  Count      = 0;
+  AllocCount = 0;
+  Status     = EFI_SUCCESS;
+
+  for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
+    Dependency = Kext->Dependencies[Index];
+    if (Dependency == NULL) {
+      break;
+    }
+
+    Repeated = InternalIsInDependencyClosure (Closure, Count, Dependency);
+
+    Status = InternalAppendDependencyClosure (&Closure, &Count, &AllocCount, Dependency, TRUE, Repeated);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    if (!Repeated) {
+      Status = InternalAppendIndirectDependencies (Kext, Dependency, &Closure, &Count, &AllocCount);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    if (Closure != NULL) {
+      FreePool (Closure);
+    }
+
+    return Status;
+  }
+
+  Kext->DependencyClosure           = Closure;
+  Kext->NumberOfClosureDependencies = Count;
+  Kext->DependencyClosureBuilt      = TRUE;
+
+  return EFI_SUCCESS;
+}
+
 PRELINKED_KEXT *
 InternalNewPrelinkedKext (
   IN OC_MACHO_CONTEXT       *Context,
@@ -652,11 +846,20 @@ InternalFreePrelinkedKext (
     Kext->LinkedSymbolTable = NULL;
   }
 
+  if (Kext->DependencyClosure != NULL) {
+    FreePool (Kext->DependencyClosure);
+    Kext->DependencyClosure = NULL;
+  }
+
+  InternalFreeVtableIndex (Kext);
+
   if (Kext->LinkedVtables != NULL) {
     FreePool (Kext->LinkedVtables);
     Kext->LinkedVtables = NULL;
   }
 
+  MachoFreeSymbolIndex (&Kext->Context.MachContext);
+
   FreePool (Kext);
 }
 
@@ -988,6 +1191,14 @@ InternalScanPrelinkedKext (
     Kext->BundleLibraries = NULL;
   }
 
+  //
+  // All dependencies are scanned, flatten them for symbol and vtable lookups.
+  //
+  Status = InternalBuildDependencyClosure (Kext);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Extend or allocate LinkBuffer in case there are no dependencies (kernel).
   //
@@ -1032,23 +1243,43 @@ InternalScanPrelinkedKext (
         return Status;
       }
     }
+
+    InternalBuildVtableIndex (Kext);
   }
 
   return EFI_SUCCESS;
 }
 
-VOID
-InternalUnlockContextKexts (
-  IN PRELINKED_CONTEXT                *Context
+/**
+  Copy string into context scratch arena, so that it lives as long as the context.
+
+  @param[in,out] Context  Prelinked context.
+  @param[in]     String   String to copy.
+
+  @return  copied string or NULL.
+**/
+STATIC
+CONST CHAR8 *
+InternalPrelinkedCopyString (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     CONST CHAR8        *String
   )
 {
-  LIST_ENTRY  *Kext;
+  CHAR8   *Copy;
+  UINTN   Size;
 
-  Kext = GetFirstNode (&Context->PrelinkedKexts);
-  while (!IsNull (&Context->PrelinkedKexts, Kext)) {
-    GET_PRELINKED_KEXT_FROM_LINK (Kext)->Processed = FALSE;
-    Kext = GetNextNode (&Context->PrelinkedKexts, Kext);
+  Size = AsciiStrSize (String);
+  if (Size > MAX_UINT32) {
+    return NULL;
+  }
+
+  Copy = InternalPrelinkedAllocateScratch (Context, (UINT32) Size);
+  if (Copy == NULL) {
+    return NULL;
   }
+
+  CopyMem (Copy, String, Size);
+  return Copy;
 }
 
 PRELINKED_KEXT *
@@ -1078,34 +1309,20 @@ InternalLinkPrelinkedKext (
   //
   // Detach Identifier from temporary memory location.
   //
-  Kext->Identifier = AllocateCopyPool (AsciiStrSize (Kext->Identifier), Kext->Identifier);
+  Kext->Identifier = InternalPrelinkedCopyString (Context, Kext->Identifier);
   if (Kext->Identifier == NULL) {
     InternalFreePrelinkedKext (Kext);
     return NULL;
   }
-
-  Status = PrelinkedDependencyInsert (Context, (VOID *)Kext->Identifier);
-  if (EFI_ERROR (Status)) {
-    FreePool ((VOID *)Kext->Identifier);
-    InternalFreePrelinkedKext (Kext);
-    return NULL;
-  }
   //
   // Also detach bundle compatible version if any.
   //
   if (Kext->CompatibleVersion != NULL) {
-    Kext->CompatibleVersion = AllocateCopyPool (AsciiStrSize (Kext->CompatibleVersion), Kext->CompatibleVersion);
+    Kext->CompatibleVersion = InternalPrelinkedCopyString (Context, Kext->CompatibleVersion);
     if (Kext->CompatibleVersion == NULL) {
       InternalFreePrelinkedKext (Kext);
       return NULL;
     }
-
-    Status = PrelinkedDependencyInsert (Context, (VOID *)Kext->CompatibleVersion);
-    if (EFI_ERROR (Status)) {
-      FreePool ((VOID *)Kext->CompatibleVersion);
-      InternalFreePrelinkedKext (Kext);
-      return NULL;
-    }
   }
   //
   // Set virtual addresses.
@@ -1131,6 +1348,8 @@ InternalLinkPrelinkedKext (
   // We could also store the name's offset and access via a StringTable pointer,
   // yet it was prone to errors and was already removed once.
   //
+  InternalFreeVtableIndex (Kext);
+
   if (Kext->LinkedVtables != NULL) {
     FreePool (Kext->LinkedVtables);
     Kext->LinkedVtables   = NULL;
@@ -25,44 +25,135 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include "PrelinkedInternal.h"
 
-CONST PRELINKED_VTABLE *
-InternalGetOcVtableByNameWorker (
-  IN PRELINKED_CONTEXT     *Context,
-  IN PRELINKED_KEXT        *Kext,
-  IN CONST CHAR8           *Name
+/**
+  Computes the vtable name hash (FNV-1a).
+
+  @param[in] Name  Vtable name.
+
+  @returns  Name hash.
+**/
+STATIC
+UINT32
+InternalVtableNameHash (
+  IN CONST CHAR8  *Name
   )
 {
-  CONST PRELINKED_VTABLE *Vtable;
+  UINT32  Hash;
+
+  Hash = 2166136261U;
+  while (*Name != '\0') {
+    Hash = (Hash ^ (UINT8) *Name) * 16777619U;
+    ++Name;
+  }
+
+  return Hash;
+}
+
+VOID
+InternalBuildVtableIndex (
+  IN OUT PRELINKED_KEXT  *Kext
+  )
+{
+  CONST PRELINKED_VTABLE  *Vtable;
+  UINT32                  NumBuckets;
+  UINT32                  IndexSize;
+  UINT32                  Bucket;
+  UINT32                  Index;
+
+  ASSERT (Kext != NULL);
+
+  if (Kext->VtableIndex != NULL || Kext->NumberOfVtables == 0
+    || Kext->NumberOfVtables > BIT29) {
+    return;
+  }
 
-  UINTN                  Index;
-  PRELINKED_KEXT         *Dependency;
-  INTN                   Result;
+  //
+  // Keep the load factor at most 1/2 for short probe sequences.
+  //
+  NumBuckets = GetPowerOfTwo32 (Kext->NumberOfVtables) << 2U;
+  if (OcOverflowMulU32 (NumBuckets, sizeof (*Kext->VtableIndex), &IndexSize)) {
+    return;
+  }
 
-  Kext->Processed = TRUE;
+  Kext->VtableIndex = AllocateZeroPool (IndexSize);
+  if (Kext->VtableIndex == NULL) {
+    return;
+  }
+
+  Kext->VtableIndexMask = NumBuckets - 1;
 
+  //
+  // Insert in order, so that lookups find the first vtable of the same name
+  // just like the linear search does.
+  //
   for (
     Index = 0, Vtable = Kext->LinkedVtables;
     Index < Kext->NumberOfVtables;
     ++Index, Vtable = GET_NEXT_PRELINKED_VTABLE (Vtable)
     ) {
-    Result = AsciiStrCmp (Vtable->Name, Name);
-    if (Result == 0) {
-      return Vtable;
+    Bucket = InternalVtableNameHash (Vtable->Name) & Kext->VtableIndexMask;
+    while (Kext->VtableIndex[Bucket] != NULL) {
+      Bucket = (Bucket + 1) & Kext->VtableIndexMask;
     }
+
+    Kext->VtableIndex[Bucket] = Vtable;
   }
+}
 
-  for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
-    Dependency = Kext->Dependencies[Index];
-    if (Dependency == NULL) {
-      break;
-    }
+VOID
+InternalFreeVtableIndex (
+  IN OUT PRELINKED_KEXT  *Kext
+  )
+{
+  ASSERT (Kext != NULL);
 
-    if (Dependency->Processed) {
-      continue;
+  if (Kext->VtableIndex != NULL) {
+    FreePool ((VOID *) Kext->VtableIndex);
+    Kext->VtableIndex = NULL;
+  }
+
+  Kext->VtableIndexMask = 0;
+}
+
+/**
+  Lookup vtable by name in the kext itself.
+
+  @param[in] Kext  Kext to search.
+  @param[in] Name  Vtable name.
+  @param[in] Hash  Vtable name hash.
+
+  @returns  Vtable or NULL.
+**/
+STATIC
+CONST PRELINKED_VTABLE *
+InternalGetKextVtableByName (
+  IN PRELINKED_KEXT        *Kext,
+  IN CONST CHAR8           *Name,
+  IN UINT32                Hash
+  )
+{
+  CONST PRELINKED_VTABLE *Vtable;
+  UINT32                 Index;
+
+  if (Kext->VtableIndex != NULL) {
+    Index = Hash & Kext->VtableIndexMask;
+    while ((Vtable = Kext->VtableIndex[Index]) != NULL) {
+      if (AsciiStrCmp (Vtable->Name, Name) == 0) {
+        return Vtable;
+      }
+
+      Index = (Index + 1) & Kext->VtableIndexMask;
     }
 
-    Vtable = InternalGetOcVtableByName (Context, Dependency, Name);
-    if (Vtable != NULL) {
+    return NULL;
+  }
+
+  for (
+    Index = 0, Vtable = Kext->LinkedVtables;
+    Index < Kext->NumberOfVtables;
+    ++Index, Vtable = GET_NEXT_PRELINKED_VTABLE (Vtable)
+    ) {
+    if (AsciiStrCmp (Vtable->Name, Name) == 0) {
       return Vtable;
     }
   }
@@ -77,13 +168,77 @@ InternalGetOcVtableByName (
   IN CONST CHAR8           *Name
   )
 {
-  CONST PRELINKED_VTABLE *Vtable;
+  CONST PRELINKED_VTABLE          *Vtable;
+  PRELINKED_VTABLE_CACHE_ENTRY    *Cache;
+  CONST PRELINKED_KEXT_DEPENDENCY *Dependency;
+  PRELINKED_KEXT                  *DirectDependency;
+  UINT32                          Index;
+  UINT32                          Hash;
+  UINT32                          Slot;
+
+  ASSERT (Kext->DependencyClosureBuilt);
+
+  Hash = InternalVtableNameHash (Name);
+
+  //
+  // The kext being linked is still getting its vtables patched,
+  // so it is always searched directly.
+  //
+  Vtable = InternalGetKextVtableByName (Kext, Name, Hash);
+  if (Vtable != NULL) {
+    return Vtable;
+  }
+
+  if (Context->VtableCache == NULL) {
+    Context->VtableCache = AllocateZeroPool (
+      PRELINKED_VTABLE_CACHE_SIZE * sizeof (PRELINKED_VTABLE_CACHE_ENTRY)
+      );
+  }
+
+  Cache            = Context->VtableCache;
+  DirectDependency = NULL;
+  Slot             = 0;
 
-  Vtable = InternalGetOcVtableByNameWorker (Context, Kext, Name);
+  //
+  // Every direct dependency is followed by the dependencies reachable
+  // only through it, hence search the closure in order.
+  //
+  for (Index = 0; Index < Kext->NumberOfClosureDependencies; ++Index) {
+    Dependency = &Kext->DependencyClosure[Index];
+    if (Dependency->Repeated) {
+      continue;
+    }
 
-  InternalUnlockContextKexts (Context);
+    if (Dependency->Direct) {
+      DirectDependency = Dependency->Kext;
 
-  return Vtable;
+      //
+      // Dependency vtables do not change during linking, so the lookup result
+      // for a dependency is memorised. Many classes share the same parents,
+      // and every metaclass inherits from OSMetaClass.
+      //
+      Slot = (Hash ^ (UINT32) ((UINTN) DirectDependency >> 4U)) & (PRELINKED_VTABLE_CACHE_SIZE - 1);
+      if (Cache != NULL
+        && Cache[Slot].Dependency == DirectDependency
+        && Cache[Slot].Hash == Hash
+        && AsciiStrCmp (Cache[Slot].Vtable->Name, Name) == 0) {
+        return Cache[Slot].Vtable;
+      }
+    }
+
+    Vtable = InternalGetKextVtableByName (Dependency->Kext, Name, Hash);
+    if (Vtable != NULL) {
+      if (Cache != NULL) {
+        Cache[Slot].Dependency = DirectDependency;
+        Cache[Slot].Vtable     = Vtable;
+        Cache[Slot].Hash       = Hash;
+      }
+
+      return Vtable;
+    }
+  }
+
+  return NULL;
 }
 
 STATIC
@@ -0,0 +1,1036 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "BootManagementInternal.h"
+
+#include <Guid/AppleDevicePath.h>
+#include <Guid/OcVariable.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcBootManagementLib.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+//
+// Scan cache variable signature and version.
+//
+#define OC_SCAN_CACHE_SIGNATURE  SIGNATURE_32 ('O', 'c', 'S', 'c')
+#define OC_SCAN_CACHE_VERSION    1
+
+//
+// Maximum number of filesystems revalidated within one boot.
+//
+#define OC_SCAN_CACHE_MAX_VALIDATED  32
+
+//
+// Filesystem record flags.
+//
+#define OC_SCAN_CACHE_FS_SELF_RECOVERY     BIT0
+
+//
+// Boot entry record flags.
+//
+#define OC_SCAN_CACHE_ENTRY_FOLDER         BIT0
+#define OC_SCAN_CACHE_ENTRY_GENERIC        BIT1
+#define OC_SCAN_CACHE_ENTRY_RECOVERY_PART  BIT2
+
+//
+// Boot entry types produced by filesystem scanning. Tools and system
+// entries are never cached, so that the cache cannot create them.
+//
+#define OC_SCAN_CACHE_ENTRY_TYPES  (OC_BOOT_UNKNOWN | OC_BOOT_APPLE_ANY | OC_BOOT_WINDOWS)
+
+//
+// Scan cache variable attributes, the variable is not accessible from the OS.
+//
+#define OC_SCAN_CACHE_ATTRIBUTES   (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS)
+
+#pragma pack(push, 1)
+
+/**
+  Scan cache variable header, followed by FileSystemCount records.
+**/
+typedef struct {
+  ///
+  /// OC_SCAN_CACHE_SIGNATURE.
+  ///
+  UINT32  Signature;
+  ///
+  /// OC_SCAN_CACHE_VERSION.
+  ///
+  UINT16  Version;
+  ///
+  /// Number of filesystem records following the header.
+  ///
+  UINT16  FileSystemCount;
+  ///
+  /// Hash of picker settings affecting the scan results.
+  ///
+  UINT32  Stamp;
+} OC_SCAN_CACHE_HEADER;
+
+/**
+  Filesystem identifier, which does not depend on the device location.
+**/
+typedef struct {
+  ///
+  /// GPT partition GUID.
+  ///
+  GUID  Partition;
+  ///
+  /// APFS volume UUID, zero for other filesystems.
+  ///
+  GUID  Volume;
+} OC_SCAN_CACHE_KEY;
+
+/**
+  Filesystem record, followed by EntryCount boot entry records.
+**/
+typedef struct {
+  ///
+  /// Filesystem identifier.
+  ///
+  OC_SCAN_CACHE_KEY  Key;
+  ///
+  /// APFS recovery volume UUID within the same container, zero when none.
+  ///
+  GUID               RecoveryVolume;
+  ///
+  /// Record size including boot entry records.
+  ///
+  UINT32             Size;
+  ///
+  /// Number of boot entry records.
+  ///
+  UINT16             EntryCount;
+  ///
+  /// OC_SCAN_CACHE_FS flags.
+  ///
+  UINT8              Flags;
+  ///
+  /// Reserved, zero.
+  ///
+  UINT8              Reserved;
+} OC_SCAN_CACHE_RECORD;
+
+/**
+  Boot entry record, followed by null-terminated name, optional null-terminated
+  path name, and device path relative to the filesystem.
+**/
+typedef struct {
+  ///
+  /// Boot entry type.
+  ///
+  UINT32  Type;
+  ///
+  /// OC_SCAN_CACHE_ENTRY flags.
+  ///
+  UINT8   Flags;
+  ///
+  /// Reserved, zero.
+  ///
+  UINT8   Reserved;
+  ///
+  /// Name size in bytes.
+  ///
+  UINT16  NameSize;
+  ///
+  /// Path name size in bytes, 0 when missing.
+  ///
+  UINT16  PathNameSize;
+  ///
+  /// Relative device path size in bytes.
+  ///
+  UINT16  FilePathSize;
+} OC_SCAN_CACHE_ENTRY;
+
+#pragma pack(pop)
+
+STATIC OC_SCAN_CACHE_KEY  mScanCacheValidated[OC_SCAN_CACHE_MAX_VALIDATED];
+STATIC UINT32             mScanCacheValidatedCount;
+
+/**
+  Obtain filesystem identifier from its device path. Only GPT partitions
+  are supported, APFS volumes are additionally identified by volume UUID.
+
+  @param[in]  Handle  Filesystem handle.
+  @param[out] Key     Filesystem identifier.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalGetScanCacheKey (
+  IN  EFI_HANDLE         Handle,
+  OUT OC_SCAN_CACHE_KEY  *Key
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  HARDDRIVE_DEVICE_PATH     *HdNode;
+
+  if (Handle == OC_CUSTOM_FS_HANDLE) {
+    return FALSE;
+  }
+
+  DevicePath = DevicePathFromHandle (Handle);
+  if (DevicePath == NULL) {
+    return FALSE;
+  }
+
+  ZeroMem (Key, sizeof (*Key));
+  HdNode = NULL;
+
+  while (!IsDevicePathEnd (DevicePath)) {
+    if (DevicePathType (DevicePath) == MEDIA_DEVICE_PATH) {
+      if (DevicePathSubType (DevicePath) == MEDIA_HARDDRIVE_DP
+        && DevicePathNodeLength (DevicePath) >= sizeof (HARDDRIVE_DEVICE_PATH)) {
+        HdNode = (HARDDRIVE_DEVICE_PATH *) DevicePath;
+      } else if (HdNode != NULL
+        && DevicePathSubType (DevicePath) == MEDIA_VENDOR_DP
+        && DevicePathNodeLength (DevicePath) >= sizeof (APPLE_APFS_VOLUME_DEVICE_PATH)
+        && CompareGuid (&((VENDOR_DEVICE_PATH *) DevicePath)->Guid, &gAppleApfsVolumeDevicePathGuid)) {
+        CopyMem (&Key->Volume, &((APPLE_APFS_VOLUME_DEVICE_PATH *) DevicePath)->Uuid, sizeof (Key->Volume));
+      }
+    }
+
+    DevicePath = NextDevicePathNode (DevicePath);
+  }
+
+  if (HdNode == NULL || HdNode->SignatureType != SIGNATURE_TYPE_GUID) {
+    return FALSE;
+  }
+
+  CopyMem (&Key->Partition, HdNode->Signature, sizeof (Key->Partition));
+  return TRUE;
+}
+
+/**
+  Find filesystem by identifier. Filesystems with non-unique identifiers
+  (e.g. cloned disks) are never matched.
+
+  @param[in]  BootContext  Context of filesystems.
+  @param[in]  Key          Filesystem identifier.
+
+  @retval filesystem or NULL.
+**/
+STATIC
+OC_BOOT_FILESYSTEM *
+InternalFindScanCacheFileSystem (
+  IN OC_BOOT_CONTEXT          *BootContext,
+  IN CONST OC_SCAN_CACHE_KEY  *Key
+  )
+{
+  LIST_ENTRY          *Link;
+  OC_BOOT_FILESYSTEM  *FileSystem;
+  OC_BOOT_FILESYSTEM  *Found;
+  OC_SCAN_CACHE_KEY   FileSystemKey;
+
+  Found = NULL;
+
+  for (
+    Link = GetFirstNode (&BootContext->FileSystems);
+    !IsNull (&BootContext->FileSystems, Link);
+    Link = GetNextNode (&BootContext->FileSystems, Link)) {
+    FileSystem = BASE_CR (Link, OC_BOOT_FILESYSTEM, Link);
+
+    if (InternalGetScanCacheKey (FileSystem->Handle, &FileSystemKey)
+      && CompareMem (&FileSystemKey, Key, sizeof (*Key)) == 0) {
+      if (Found != NULL) {
+        return NULL;
+      }
+
+      Found = FileSystem;
+    }
+  }
+
+  return Found;
+}
+
+/**
+  Find filesystem record in loaded scan cache.
+
+  @param[in]  ScanCache  Scan cache state.
+  @param[in]  Key        Filesystem identifier.
+
+  @retval filesystem record or NULL.
+**/
+STATIC
+CONST OC_SCAN_CACHE_RECORD *
+InternalFindScanCacheRecord (
+  IN CONST OC_SCAN_CACHE      *ScanCache,
+  IN CONST OC_SCAN_CACHE_KEY  *Key
+  )
+{
+  CONST OC_SCAN_CACHE_HEADER  *Header;
+  CONST OC_SCAN_CACHE_RECORD  *Record;
+  UINTN                       Offset;
+  UINT32                      Index;
+
+  if (ScanCache->Data == NULL) {
+    return NULL;
+  }
+
+  Header = ScanCache->Data;
+  Offset = sizeof (*Header);
+
+  for (Index = 0; Index < Header->FileSystemCount; ++Index) {
+    Record = (CONST OC_SCAN_CACHE_RECORD *) ((CONST UINT8 *) ScanCache->Data + Offset);
+    if (CompareMem (&Record->Key, Key, sizeof (*Key)) == 0) {
+      return Record;
+    }
+
+    Offset += Record->Size;
+  }
+
+  return NULL;
+}
+
+/**
+  Calculate FNV-1a hash of a byte sequence.
+
+  @param[in]  Hash  Previous hash value.
+  @param[in]  Data  Data to hash.
+  @param[in]  Size  Data size.
+
+  @retval updated hash value.
+**/
+STATIC
+UINT32
+InternalHashScanCacheData (
+  IN UINT32      Hash,
+  IN CONST VOID  *Data,
+  IN UINTN       Size
+  )
+{
+  CONST UINT8  *Bytes;
+  UINTN        Index;
+
+  Bytes = Data;
+
+  for (Index = 0; Index < Size; ++Index) {
+    Hash ^= Bytes[Index];
+    Hash *= 16777619U;
+  }
+
+  return Hash;
+}
+
+/**
+  Calculate hash of picker settings affecting the scan results.
+
+  @param[in]  Context  Picker context.
+
+  @retval settings hash.
+**/
+STATIC
+UINT32
+InternalGetScanCacheStamp (
+  IN OC_PICKER_CONTEXT  *Context
+  )
+{
+  UINT32  Hash;
+  UINT32  DmgLoading;
+  UINTN   Index;
+
+  DmgLoading = (UINT32) Context->DmgLoading;
+
+  Hash = 2166136261U;
+  Hash = InternalHashScanCacheData (Hash, &Context->ScanPolicy, sizeof (Context->ScanPolicy));
+  Hash = InternalHashScanCacheData (Hash, &DmgLoading, sizeof (DmgLoading));
+  Hash = InternalHashScanCacheData (Hash, &Context->HideAuxiliary, sizeof (Context->HideAuxiliary));
+
+  for (Index = 0; Index < Context->NumCustomBootPaths; ++Index) {
+    Hash = InternalHashScanCacheData (
+      Hash,
+      Context->CustomBootPaths[Index],
+      StrSize (Context->CustomBootPaths[Index])
+      );
+  }
+
+  return Hash;
+}
+
+/**
+  Check that boot entry type is a single type produced by filesystem scanning.
+
+  @param[in]  Type  Boot entry type.
+
+  @retval TRUE when the type can be cached.
+**/
+STATIC
+BOOLEAN
+InternalIsScanCacheTypeValid (
+  IN UINT32  Type
+  )
+{
+  return Type != 0
+    && (Type & ~OC_SCAN_CACHE_ENTRY_TYPES) == 0
+    && (Type & (Type - 1)) == 0;
+}
+
+/**
+  Check that a string in scan cache is null-terminated.
+
+  @param[in]  String  String data.
+  @param[in]  Size    String size in bytes.
+
+  @retval TRUE when the string is valid.
+**/
+STATIC
+BOOLEAN
+InternalIsScanCacheStringValid (
+  IN CONST UINT8  *String,
+  IN UINTN        Size
+  )
+{
+  return Size >= sizeof (CHAR16)
+    && Size % sizeof (CHAR16) == 0
+    && String[Size - 2] == 0
+    && String[Size - 1] == 0;
+}
+
+/**
+  Validate scan cache variable contents.
+
+  @param[in]  Data   Variable contents.
+  @param[in]  Size   Variable size.
+  @param[in]  Stamp  Current picker settings hash.
+
+  @retval TRUE when scan cache is valid for these settings.
+**/
+STATIC
+BOOLEAN
+InternalIsScanCacheValid (
+  IN CONST VOID  *Data,
+  IN UINTN       Size,
+  IN UINT32      Stamp
+  )
+{
+  CONST OC_SCAN_CACHE_HEADER  *Header;
+  CONST OC_SCAN_CACHE_RECORD  *Record;
+  CONST OC_SCAN_CACHE_ENTRY   *Entry;
+  CONST UINT8                 *Walker;
+  UINTN                       Offset;
+  UINTN                       EntryOffset;
+  UINTN                       EntrySize;
+  UINT32                      Index;
+  UINT32                      EntryIndex;
+
+  Header = Data;
+
+  if (Size < sizeof (*Header)
+    || Header->Signature != OC_SCAN_CACHE_SIGNATURE
+    || Header->Version != OC_SCAN_CACHE_VERSION
+    || Header->Stamp != Stamp) {
+    return FALSE;
+  }
+
+  Offset = sizeof (*Header);
+
+  for (Index = 0; Index < Header->FileSystemCount; ++Index) {
+    if (Size - Offset < sizeof (*Record)) {
+      return FALSE;
+    }
+
+    Record = (CONST OC_SCAN_CACHE_RECORD *) ((CONST UINT8 *) Data + Offset);
+    if (Record->Size < sizeof (*Record) || Record->Size > Size - Offset) {
+      return FALSE;
+    }
+
+    EntryOffset = sizeof (*Record);
+    for (EntryIndex = 0; EntryIndex < Record->EntryCount; ++EntryIndex) {
+      if (Record->Size - EntryOffset < sizeof (*Entry)) {
+        return FALSE;
+      }
+
+      Entry     = (CONST OC_SCAN_CACHE_ENTRY *) ((CONST UINT8 *) Record + EntryOffset);
+      EntrySize = sizeof (*Entry) + Entry->NameSize + Entry->PathNameSize + Entry->FilePathSize;
+      if (EntrySize > Record->Size - EntryOffset
+        || !InternalIsScanCacheTypeValid (Entry->Type)) {
+        return FALSE;
+      }
+
+      Walker = (CONST UINT8 *) (Entry + 1);
+      if (!InternalIsScanCacheStringValid (Walker, Entry->NameSize)) {
+        return FALSE;
+      }
+
+      Walker += Entry->NameSize;
+      if (Entry->PathNameSize > 0 && !InternalIsScanCacheStringValid (Walker, Entry->PathNameSize)) {
+        return FALSE;
+      }
+
+      //
+      // IsDevicePathValid does not bound the walk with zero size.
+      //
+      Walker += Entry->PathNameSize;
+      if (Entry->FilePathSize < END_DEVICE_PATH_LENGTH
+        || !IsDevicePathValid ((CONST EFI_DEVICE_PATH_PROTOCOL *) Walker, Entry->FilePathSize)) {
+        return FALSE;
+      }
+
+      EntryOffset += EntrySize;
+    }
+
+    if (EntryOffset != Record->Size) {
+      return FALSE;
+    }
+
+    Offset += Record->Size;
+  }
+
+  return Offset == Size;
+}
+
+/**
+  Check whether filesystem was revalidated during this boot.
+
+  @param[in]  Key  Filesystem identifier.
+
+  @retval TRUE when revalidated.
+**/
+STATIC
+BOOLEAN
+InternalIsScanCacheValidated (
+  IN CONST OC_SCAN_CACHE_KEY  *Key
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < mScanCacheValidatedCount; ++Index) {
+    if (CompareMem (&mScanCacheValidated[Index], Key, sizeof (*Key)) == 0) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Free boot entries restored from scan cache.
+
+  @param[in,out]  Entries  Boot entry list.
+**/
+STATIC
+VOID
+InternalFreeScanCacheEntries (
+  IN OUT LIST_ENTRY  *Entries
+  )
+{
+  LIST_ENTRY     *Link;
+  OC_BOOT_ENTRY  *BootEntry;
+
+  while (!IsListEmpty (Entries)) {
+    Link      = GetFirstNode (Entries);
+    BootEntry = BASE_CR (Link, OC_BOOT_ENTRY, Link);
+    RemoveEntryList (Link);
+
+    if (BootEntry->DevicePath != NULL) {
+      FreePool (BootEntry->DevicePath);
+    }
+
+    if (BootEntry->Name != NULL) {
+      FreePool (BootEntry->Name);
+    }
+
+    if (BootEntry->PathName != NULL) {
+      FreePool (BootEntry->PathName);
+    }
+
+    FreePool (BootEntry);
+  }
+}
+
+/**
+  Serialise boot entries of a filesystem into a scan cache record.
+
+  @param[in]  FileSystem  Filesystem with scanned boot entries.
+  @param[in]  Key         Filesystem identifier.
+  @param[out] Buffer      Record buffer.
+  @param[in]  BufferSize  Record buffer size.
+
+  @retval record size or 0 when entries cannot be cached or do not fit.
+**/
+STATIC
+UINTN
+InternalWriteScanCacheRecord (
+  IN  OC_BOOT_FILESYSTEM       *FileSystem,
+  IN  CONST OC_SCAN_CACHE_KEY  *Key,
+  OUT UINT8                    *Buffer,
+  IN  UINTN                    BufferSize
+  )
+{
+  OC_SCAN_CACHE_RECORD      *Record;
+  OC_SCAN_CACHE_ENTRY       *Entry;
+  OC_SCAN_CACHE_KEY         RecoveryKey;
+  LIST_ENTRY                *Link;
+  OC_BOOT_ENTRY             *BootEntry;
+  EFI_DEVICE_PATH_PROTOCOL  *FsDevicePath;
+  EFI_DEVICE_PATH_PROTOCOL  *RecoveryDevicePath;
+  UINTN                     FsPrefixSize;
+  UINTN                     RecoveryPrefixSize;
+  UINTN                     DevicePathSize;
+  UINTN                     PrefixSize;
+  UINTN                     NameSize;
+  UINTN                     PathNameSize;
+  UINTN                     EntrySize;
+  UINTN                     Offset;
+  UINT8                     Flags;
+
+  if (BufferSize < sizeof (*Record)) {
+    return 0;
+  }
+
+  FsDevicePath = DevicePathFromHandle (FileSystem->Handle);
+  if (FsDevicePath == NULL) {
+    return 0;
+  }
+
+  FsPrefixSize = GetDevicePathSize (FsDevicePath) - END_DEVICE_PATH_LENGTH;
+
+  Record = (OC_SCAN_CACHE_RECORD *) Buffer;
+  ZeroMem (Record, sizeof (*Record));
+  CopyMem (&Record->Key, Key, sizeof (Record->Key));
+
+  if (FileSystem->HasSelfRecovery) {
+    Record->Flags |= OC_SCAN_CACHE_FS_SELF_RECOVERY;
+  }
+
+  //
+  // APFS recovery is only cached when it is within the same container.
+  //
+  RecoveryDevicePath = NULL;
+  RecoveryPrefixSize = 0;
+  if (FileSystem->RecoveryFs != NULL
+    && InternalGetScanCacheKey (FileSystem->RecoveryFs->Handle, &RecoveryKey)
+    && CompareGuid (&RecoveryKey.Partition, &Key->Partition)
+    && !IsZeroGuid (&RecoveryKey.Volume)) {
+    RecoveryDevicePath = DevicePathFromHandle (FileSystem->RecoveryFs->Handle);
+    if (RecoveryDevicePath != NULL) {
+      RecoveryPrefixSize = GetDevicePathSize (RecoveryDevicePath) - END_DEVICE_PATH_LENGTH;
+      CopyMem (&Record->RecoveryVolume, &RecoveryKey.Volume, sizeof (Record->RecoveryVolume));
+    }
+  }
+
+  Offset = sizeof (*Record);
+
+  for (
+    Link = GetFirstNode (&FileSystem->BootEntries);
+    !IsNull (&FileSystem->BootEntries, Link);
+    Link = GetNextNode (&FileSystem->BootEntries, Link)) {
+    BootEntry = BASE_CR (Link, OC_BOOT_ENTRY, Link);
+
+    if (BootEntry->DevicePath == NULL
+      || BootEntry->Name == NULL
+      || !InternalIsScanCacheTypeValid (BootEntry->Type)) {
+      return 0;
+    }
+
+    //
+    // Only store the part of device path following the filesystem.
+    //
+    DevicePathSize = GetDevicePathSize (BootEntry->DevicePath);
+    if (DevicePathSize > FsPrefixSize
+      && CompareMem (BootEntry->DevicePath, FsDevicePath, FsPrefixSize) == 0) {
+      PrefixSize = FsPrefixSize;
+      Flags      = 0;
+    } else if (RecoveryDevicePath != NULL
+      && DevicePathSize > RecoveryPrefixSize
+      && CompareMem (BootEntry->DevicePath, RecoveryDevicePath, RecoveryPrefixSize) == 0) {
+      PrefixSize = RecoveryPrefixSize;
+      Flags      = OC_SCAN_CACHE_ENTRY_RECOVERY_PART;
+    } else {
+      return 0;
+    }
+
+    if (BootEntry->IsFolder) {
+      Flags |= OC_SCAN_CACHE_ENTRY_FOLDER;
+    }
+
+    if (BootEntry->IsGeneric) {
+      Flags |= OC_SCAN_CACHE_ENTRY_GENERIC;
+    }
+
+    NameSize     = StrSize (BootEntry->Name);
+    PathNameSize = BootEntry->PathName != NULL ? StrSize (BootEntry->PathName) : 0;
+    EntrySize    = sizeof (*Entry) + NameSize + PathNameSize + DevicePathSize - PrefixSize;
+
+    if (NameSize > MAX_UINT16
+      || PathNameSize > MAX_UINT16
+      || DevicePathSize - PrefixSize > MAX_UINT16
+      || Record->EntryCount == MAX_UINT16
+      || EntrySize > BufferSize - Offset) {
+      return 0;
+    }
+
+    Entry               = (OC_SCAN_CACHE_ENTRY *) (Buffer + Offset);
+    Entry->Type         = BootEntry->Type;
+    Entry->Flags        = Flags;
+    Entry->Reserved     = 0;
+    Entry->NameSize     = (UINT16) NameSize;
+    Entry->PathNameSize = (UINT16) PathNameSize;
+    Entry->FilePathSize = (UINT16) (DevicePathSize - PrefixSize);
+    Offset += sizeof (*Entry);
+
+    CopyMem (Buffer + Offset, BootEntry->Name, NameSize);
+    Offset += NameSize;
+    if (PathNameSize > 0) {
+      CopyMem (Buffer + Offset, BootEntry->PathName, PathNameSize);
+      Offset += PathNameSize;
+    }
+
+    CopyMem (Buffer + Offset, (UINT8 *) BootEntry->DevicePath + PrefixSize, DevicePathSize - PrefixSize);
+    Offset += DevicePathSize - PrefixSize;
+
+    ++Record->EntryCount;
+  }
+
+  Record->Size = (UINT32) Offset;
+  return Offset;
+}
+
+OC_SCAN_CACHE *
+InternalLoadScanCache (
+  IN OC_PICKER_CONTEXT  *Context
+  )
+{
+  EFI_STATUS     Status;
+  OC_SCAN_CACHE  *ScanCache;
+  UINT32         Attributes;
+
+  //
+  // Booting without the picker gives no chance to revalidate the entries.
+  //
+  if (!Context->ScanCache || Context->PickerCommand != OcPickerShowPicker) {
+    return NULL;
+  }
+
+  ScanCache = AllocateZeroPool (sizeof (*ScanCache));
+  if (ScanCache == NULL) {
+    return NULL;
+  }
+
+  InitializeListHead (&ScanCache->StaleEntries);
+
+  Status = GetVariable3 (
+    OC_SCAN_CACHE_VARIABLE_NAME,
+    &gOcVendorVariableGuid,
+    &ScanCache->Data,
+    &ScanCache->DataSize,
+    &Attributes
+    );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCB: Scan cache is missing - %r\n", Status));
+    ScanCache->Data     = NULL;
+    ScanCache->DataSize = 0;
+    return ScanCache;
+  }
+
+  //
+  // Variables writable from the OS cannot be trusted, drop them to be
+  // able to create the cache with proper attributes.
+  //
+  if (Attributes != OC_SCAN_CACHE_ATTRIBUTES) {
+    DEBUG ((DEBUG_WARN, "OCB: Scan cache has invalid attributes %X\n", Attributes));
+    gRT->SetVariable (
+      OC_SCAN_CACHE_VARIABLE_NAME,
+      &gOcVendorVariableGuid,
+      0,
+      0,
+      NULL
+      );
+    FreePool (ScanCache->Data);
+    ScanCache->Data     = NULL;
+    ScanCache->DataSize = 0;
+    return ScanCache;
+  }
+
+  if (!InternalIsScanCacheValid (ScanCache->Data, ScanCache->DataSize, InternalGetScanCacheStamp (Context))) {
+    DEBUG ((DEBUG_INFO, "OCB: Scan cache is outdated or invalid\n"));
+    FreePool (ScanCache->Data);
+    ScanCache->Data     = NULL;
+    ScanCache->DataSize = 0;
+    return ScanCache;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCB: Scan cache has %u filesystems\n",
+    ((OC_SCAN_CACHE_HEADER *) ScanCache->Data)->FileSystemCount
+    ));
+
+  return ScanCache;
+}
+
+EFI_STATUS
+InternalRestoreScanCacheEntries (
+  IN     OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem,
+     OUT LIST_ENTRY          *Entries
+  )
+{
+  OC_SCAN_CACHE_KEY           Key;
+  OC_SCAN_CACHE_KEY           RecoveryKey;
+  CONST OC_SCAN_CACHE_RECORD  *Record;
+  CONST OC_SCAN_CACHE_ENTRY   *Entry;
+  CONST UINT8                 *Walker;
+  OC_BOOT_FILESYSTEM          *RecoveryFs;
+  EFI_DEVICE_PATH_PROTOCOL    *FsDevicePath;
+  EFI_DEVICE_PATH_PROTOCOL    *RecoveryDevicePath;
+  OC_BOOT_ENTRY               *BootEntry;
+  BOOLEAN                     RecoveryPart;
+  UINT32                      Index;
+
+  if (BootContext->ScanCacheState == NULL
+    || BootContext->ScanCacheState->Data == NULL
+    || !InternalGetScanCacheKey (FileSystem->Handle, &Key)
+    || InternalFindScanCacheFileSystem (BootContext, &Key) != FileSystem) {
+    return EFI_NOT_FOUND;
+  }
+
+  Record = InternalFindScanCacheRecord (BootContext->ScanCacheState, &Key);
+  if (Record == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  FsDevicePath = DevicePathFromHandle (FileSystem->Handle);
+  if (FsDevicePath == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  RecoveryFs         = NULL;
+  RecoveryDevicePath = NULL;
+  if (!IsZeroGuid (&Record->RecoveryVolume)) {
+    CopyMem (&RecoveryKey.Partition, &Key.Partition, sizeof (RecoveryKey.Partition));
+    CopyMem (&RecoveryKey.Volume, &Record->RecoveryVolume, sizeof (RecoveryKey.Volume));
+    RecoveryFs = InternalFindScanCacheFileSystem (BootContext, &RecoveryKey);
+    if (RecoveryFs != NULL) {
+      RecoveryDevicePath = DevicePathFromHandle (RecoveryFs->Handle);
+    }
+
+    if (RecoveryDevicePath == NULL) {
+      DEBUG ((DEBUG_INFO, "OCB: Cached recovery fs for %p is missing\n", FileSystem->Handle));
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  Walker = (CONST UINT8 *) (Record + 1);
+
+  for (Index = 0; Index < Record->EntryCount; ++Index) {
+    Entry  = (CONST OC_SCAN_CACHE_ENTRY *) Walker;
+    Walker = (CONST UINT8 *) (Entry + 1);
+
+    RecoveryPart = (Entry->Flags & OC_SCAN_CACHE_ENTRY_RECOVERY_PART) != 0;
+    if (RecoveryPart && RecoveryDevicePath == NULL) {
+      InternalFreeScanCacheEntries (Entries);
+      return EFI_NOT_FOUND;
+    }
+
+    BootEntry = AllocateZeroPool (sizeof (*BootEntry));
+    if (BootEntry == NULL) {
+      InternalFreeScanCacheEntries (Entries);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    InsertTailList (Entries, &BootEntry->Link);
+
+    BootEntry->Name = AllocateCopyPool (Entry->NameSize, Walker);
+    Walker += Entry->NameSize;
+
+    if (Entry->PathNameSize > 0) {
+      BootEntry->PathName = AllocateCopyPool (Entry->PathNameSize, Walker);
+      Walker += Entry->PathNameSize;
+    }
+
+    BootEntry->DevicePath = AppendDevicePath (
+      RecoveryPart ? RecoveryDevicePath : FsDevicePath,
+      (CONST EFI_DEVICE_PATH_PROTOCOL *) Walker
+      );
+    Walker += Entry->FilePathSize;
+
+    if (BootEntry->Name == NULL
+      || (Entry->PathNameSize > 0 && BootEntry->PathName == NULL)
+      || BootEntry->DevicePath == NULL) {
+      InternalFreeScanCacheEntries (Entries);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    BootEntry->Type       = Entry->Type;
+    BootEntry->IsFolder   = (Entry->Flags & OC_SCAN_CACHE_ENTRY_FOLDER) != 0;
+    BootEntry->IsGeneric  = (Entry->Flags & OC_SCAN_CACHE_ENTRY_GENERIC) != 0;
+    BootEntry->IsExternal = RecoveryPart ? RecoveryFs->External : FileSystem->External;
+  }
+
+  if (RecoveryFs != NULL) {
+    FileSystem->RecoveryFs = RecoveryFs;
+  }
+
+  FileSystem->HasSelfRecovery = (Record->Flags & OC_SCAN_CACHE_FS_SELF_RECOVERY) != 0;
+  FileSystem->ScanCacheable   = TRUE;
+  FileSystem->FromScanCache   = !InternalIsScanCacheValidated (&Key);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCB: Restored %u cached entries for fs %p%a\n",
+    Record->EntryCount,
+    FileSystem->Handle,
+    FileSystem->FromScanCache ? "" : " (validated)"
+    ));
+
+  return EFI_SUCCESS;
+}
+
+VOID
+InternalSetScanCacheValidated (
+  IN OC_BOOT_FILESYSTEM  *FileSystem
+  )
+{
+  OC_SCAN_CACHE_KEY  Key;
+
+  if (mScanCacheValidatedCount == OC_SCAN_CACHE_MAX_VALIDATED
+    || !InternalGetScanCacheKey (FileSystem->Handle, &Key)
+    || InternalIsScanCacheValidated (&Key)) {
+    return;
+  }
+
+  CopyMem (&mScanCacheValidated[mScanCacheValidatedCount], &Key, sizeof (Key));
+  ++mScanCacheValidatedCount;
+}
+
+EFI_STATUS
+InternalSaveScanCache (
+  IN OC_BOOT_CONTEXT  *BootContext
+  )
+{
+  EFI_STATUS                  Status;
+  OC_SCAN_CACHE               *ScanCache;
+  OC_SCAN_CACHE_HEADER        *Header;
+  CONST OC_SCAN_CACHE_RECORD  *OldRecord;
+  OC_SCAN_CACHE_KEY           Key;
+  LIST_ENTRY                  *Link;
+  OC_BOOT_FILESYSTEM          *FileSystem;
+  UINT8                       *Buffer;
+  UINTN                       Offset;
+  UINTN                       RecordSize;
+
+  ScanCache = BootContext->ScanCacheState;
+  ASSERT (ScanCache != NULL);
+
+  Buffer = AllocatePool (OC_SCAN_CACHE_MAX_SIZE);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Header                  = (OC_SCAN_CACHE_HEADER *) Buffer;
+  Header->Signature       = OC_SCAN_CACHE_SIGNATURE;
+  Header->Version         = OC_SCAN_CACHE_VERSION;
+  Header->FileSystemCount = 0;
+  Header->Stamp           = InternalGetScanCacheStamp (BootContext->PickerContext);
+
+  Offset = sizeof (*Header);
+
+  for (
+    Link = GetFirstNode (&BootContext->FileSystems);
+    !IsNull (&BootContext->FileSystems, Link);
+    Link = GetNextNode (&BootContext->FileSystems, Link)) {
+    FileSystem = BASE_CR (Link, OC_BOOT_FILESYSTEM, Link);
+
+    if (!InternalGetScanCacheKey (FileSystem->Handle, &Key)
+      || InternalFindScanCacheFileSystem (BootContext, &Key) != FileSystem) {
+      continue;
+    }
+
+    if (FileSystem->ScanCacheable) {
+      RecordSize = InternalWriteScanCacheRecord (
+        FileSystem,
+        &Key,
+        Buffer + Offset,
+        OC_SCAN_CACHE_MAX_SIZE - Offset
+        );
+    } else {
+      //
+      // Entries affected by BootOrder are not cached, but previous ones are kept.
+      //
+      OldRecord  = InternalFindScanCacheRecord (ScanCache, &Key);
+      RecordSize = 0;
+      if (OldRecord != NULL && OldRecord->Size <= OC_SCAN_CACHE_MAX_SIZE - Offset) {
+        CopyMem (Buffer + Offset, OldRecord, OldRecord->Size);
+        RecordSize = OldRecord->Size;
+      }
+    }
+
+    if (RecordSize > 0) {
+      Offset += RecordSize;
+      ++Header->FileSystemCount;
+    }
+  }
+
+  //
+  // Avoid wearing NVRAM when nothing changed.
+  //
+  if ((ScanCache->Data == NULL && Header->FileSystemCount == 0)
+    || (ScanCache->DataSize == Offset && CompareMem (ScanCache->Data, Buffer, Offset) == 0)) {
+    DEBUG ((DEBUG_INFO, "OCB: Scan cache is up to date\n"));
+    FreePool (Buffer);
+    return EFI_SUCCESS;
+  }
+
+  Status = gRT->SetVariable (
+    OC_SCAN_CACHE_VARIABLE_NAME,
+    &gOcVendorVariableGuid,
+    OC_SCAN_CACHE_ATTRIBUTES,
+    Offset,
+    Buffer
+    );
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCB: Saved scan cache with %u filesystems (%u bytes) - %r\n",
+    Header->FileSystemCount,
+    (UINT32) Offset,
+    Status
+    ));
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Buffer);
+    return Status;
+  }
+
+  if (ScanCache->Data != NULL) {
+    FreePool (ScanCache->Data);
+  }
+
+  ScanCache->Data     = Buffer;
+  ScanCache->DataSize = Offset;
+
+  return EFI_SUCCESS;
+}
+
+VOID
+InternalFreeScanCache (
+  IN OC_SCAN_CACHE  *ScanCache
+  )
+{
+  ASSERT (IsListEmpty (&ScanCache->StaleEntries));
+
+  if (ScanCache->Data != NULL) {
+    FreePool (ScanCache->Data);
+  }
+
+  FreePool (ScanCache);
+}
@@ -984,6 +984,87 @@ AddBootEntryFromSelfRecovery (
   return Status;
 }
 
+/**
+  Create bootable entries found on the filesystem during one of the previous boots.
+
+  @param[in,out] BootContext   Context of filesystems.
+  @param[in,out] FileSystem    Filesystem to restore entries for.
+
+  @retval EFI_SUCCESS when entries were restored from scan cache.
+**/
+STATIC
+EFI_STATUS
+AddBootEntryFromScanCache (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem
+  )
+{
+  EFI_STATUS     Status;
+  LIST_ENTRY     Entries;
+  LIST_ENTRY     *Link;
+  OC_BOOT_ENTRY  *BootEntry;
+
+  InitializeListHead (&Entries);
+
+  Status = InternalRestoreScanCacheEntries (BootContext, FileSystem, &Entries);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  while (!IsListEmpty (&Entries)) {
+    Link = GetFirstNode (&Entries);
+    BootEntry = BASE_CR (Link, OC_BOOT_ENTRY, Link);
+    RemoveEntryList (Link);
+    RegisterBootOption (BootContext, FileSystem, BootEntry);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Compare boot entry lists for visible differences.
+
+  @param[in]  First   First boot entry list.
+  @param[in]  Second  Second boot entry list.
+
+  @retval TRUE when lists describe the same entries in the same order.
+**/
+STATIC
+BOOLEAN
+IsBootEntryListEqual (
+  IN LIST_ENTRY  *First,
+  IN LIST_ENTRY  *Second
+  )
+{
+  LIST_ENTRY     *FirstLink;
+  LIST_ENTRY     *SecondLink;
+  OC_BOOT_ENTRY  *FirstEntry;
+  OC_BOOT_ENTRY  *SecondEntry;
+
+  for (
+    FirstLink = GetFirstNode (First), SecondLink = GetFirstNode (Second);
+    !IsNull (First, FirstLink) && !IsNull (Second, SecondLink);
+    FirstLink = GetNextNode (First, FirstLink), SecondLink = GetNextNode (Second, SecondLink)) {
+    FirstEntry  = BASE_CR (FirstLink, OC_BOOT_ENTRY, Link);
+    SecondEntry = BASE_CR (SecondLink, OC_BOOT_ENTRY, Link);
+
+    if (FirstEntry->Type != SecondEntry->Type
+      || FirstEntry->IsFolder != SecondEntry->IsFolder
+      || FirstEntry->IsGeneric != SecondEntry->IsGeneric
+      || FirstEntry->IsExternal != SecondEntry->IsExternal
+      || FirstEntry->DevicePath == NULL
+      || SecondEntry->DevicePath == NULL
+      || !IsDevicePathEqual (FirstEntry->DevicePath, SecondEntry->DevicePath)
+      || StrCmp (FirstEntry->Name, SecondEntry->Name) != 0
+      || (FirstEntry->PathName == NULL) != (SecondEntry->PathName == NULL)
+      || (FirstEntry->PathName != NULL && StrCmp (FirstEntry->PathName, SecondEntry->PathName) != 0)) {
+      return FALSE;
+    }
+  }
+
+  return IsNull (First, FirstLink) && IsNull (Second, SecondLink);
+}
+
 /**
   Create bootable entries from boot options.
 
@@ -1419,6 +1500,8 @@ AddFileSystemEntry (
   Entry->External        = IsExternal;
   Entry->LoaderFs        = LoaderFs;
   Entry->HasSelfRecovery = FALSE;
+  Entry->FromScanCache   = FALSE;
+  Entry->ScanCacheable   = FALSE;
   InsertTailList (&BootContext->FileSystems, &Entry->Link);
   ++BootContext->FileSystemCount;
 
@@ -1594,8 +1677,13 @@ BuildFileSystemList (
   } else {
     BootContext->BootVariableGuid = &gEfiGlobalVariableGuid;
   }
-  BootContext->DefaultEntry  = NULL;
-  BootContext->PickerContext = Context;
+  BootContext->DefaultEntry            = NULL;
+  BootContext->PickerContext           = Context;
+  BootContext->ScanCacheState          = NULL;
+  BootContext->VisibleEntryCount       = 0;
+  BootContext->PendingFileSystem       = NULL;
+  BootContext->PendingCustomFileSystem = NULL;
+  BootContext->DefaultCustomIndex      = MAX_UINT32;
 
   if (Empty) {
     return BootContext;
@@ -1631,6 +1719,15 @@ OcFreeBootContext (
 {
   LIST_ENTRY          *Link;
   OC_BOOT_FILESYSTEM  *FileSystem;
+  OC_BOOT_ENTRY       *BootEntry;
+
+  //
+  // Custom entries are not inserted until scanning is complete.
+  //
+  if (Context->PendingCustomFileSystem != NULL) {
+    InsertTailList (&Context->FileSystems, &Context->PendingCustomFileSystem->Link);
+    ++Context->FileSystemCount;
+  }
 
   while (!IsListEmpty (&Context->FileSystems)) {
     Link = GetFirstNode (&Context->FileSystems);
@@ -1638,6 +1735,17 @@ OcFreeBootContext (
     FreeFileSystemEntry (Context, FileSystem);
   }
 
+  if (Context->ScanCacheState != NULL) {
+    while (!IsListEmpty (&Context->ScanCacheState->StaleEntries)) {
+      Link = GetFirstNode (&Context->ScanCacheState->StaleEntries);
+      BootEntry = BASE_CR (Link, OC_BOOT_ENTRY, Link);
+      RemoveEntryList (Link);
+      FreeBootEntry (BootEntry);
+    }
+
+    InternalFreeScanCache (Context->ScanCacheState);
+  }
+
   FreePool (Context);
 }
 
@@ -1722,18 +1830,187 @@ OcSetDefaultBootRecovery (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Move filesystems on slow devices to the end of the list preserving
+  their order, so that they do not delay the picker.
+
+  @param[in,out] BootContext   Context of filesystems.
+**/
+STATIC
+VOID
+DeferSlowFileSystems (
+  IN OUT OC_BOOT_CONTEXT  *BootContext
+  )
+{
+  LIST_ENTRY          SlowFileSystems;
+  LIST_ENTRY          *Link;
+  LIST_ENTRY          *NextLink;
+  OC_BOOT_FILESYSTEM  *FileSystem;
+
+  InitializeListHead (&SlowFileSystems);
+
+  for (
+    Link = GetFirstNode (&BootContext->FileSystems);
+    !IsNull (&BootContext->FileSystems, Link);
+    Link = NextLink) {
+    NextLink   = GetNextNode (&BootContext->FileSystems, Link);
+    FileSystem = BASE_CR (Link, OC_BOOT_FILESYSTEM, Link);
+
+    if ((OcGetDevicePolicyType (FileSystem->Handle, NULL) & OC_SCAN_SLOW_DEVICE_POLICY) != 0) {
+      DEBUG ((DEBUG_INFO, "OCB: Deferring fs %p on slow device\n", FileSystem->Handle));
+      RemoveEntryList (Link);
+      InsertTailList (&SlowFileSystems, Link);
+    }
+  }
+
+  while (!IsListEmpty (&SlowFileSystems)) {
+    Link = GetFirstNode (&SlowFileSystems);
+    RemoveEntryList (Link);
+    InsertTailList (&BootContext->FileSystems, Link);
+  }
+}
+
+/**
+  Create primary and alternate boot entries on the filesystem.
+
+  @param[in,out] BootContext   Context of filesystems.
+  @param[in,out] FileSystem    Filesystem to scan.
+**/
+STATIC
+VOID
+ScanFileSystem (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem
+  )
+{
+  EFI_STATUS  Status;
+
+  //
+  // No entries, so we process this directory with Apple Bless,
+  // unless the entries can be restored from scan cache.
+  //
+  if (IsListEmpty (&FileSystem->BootEntries)) {
+    Status = AddBootEntryFromScanCache (BootContext, FileSystem);
+    if (!EFI_ERROR (Status)) {
+      return;
+    }
+
+    AddBootEntryFromBless (
+      BootContext,
+      FileSystem,
+      gAppleBootPolicyPredefinedPaths,
+      gAppleBootPolicyNumPredefinedPaths,
+      FALSE,
+      FALSE
+      );
+    FileSystem->ScanCacheable = TRUE;
+  }
+
+  //
+  // Record predefined recoveries.
+  //
+  AddBootEntryFromSelfRecovery (BootContext, FileSystem);
+}
+
+/**
+  Finish boot entry scanning once all filesystems are scanned.
+
+  @param[in,out] BootContext   Context of filesystems.
+
+  @retval filesystem with custom entries or NULL.
+**/
+STATIC
+OC_BOOT_FILESYSTEM *
+CompleteBootEntryScan (
+  IN OUT OC_BOOT_CONTEXT  *BootContext
+  )
+{
+  OC_BOOT_FILESYSTEM  *CustomFileSystem;
+
+  BootContext->PendingFileSystem = NULL;
+
+  if (BootContext->ScanCacheState != NULL) {
+    InternalSaveScanCache (BootContext);
+  }
+
+  CustomFileSystem = BootContext->PendingCustomFileSystem;
+  BootContext->PendingCustomFileSystem = NULL;
+
+  if (CustomFileSystem != NULL) {
+    //
+    // Insert the custom file system last for entry order.
+    //
+    InsertTailList (&BootContext->FileSystems, &CustomFileSystem->Link);
+    ++BootContext->FileSystemCount;
+
+    //
+    // Build custom and system options.
+    //
+    AddFileSystemEntryForCustom (BootContext, CustomFileSystem, BootContext->DefaultCustomIndex);
+  }
+
+  return CustomFileSystem;
+}
+
+EFI_STATUS
+EFIAPI
+OcScanNextFileSystem (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+     OUT OC_BOOT_FILESYSTEM  **FileSystem
+  )
+{
+  OC_BOOT_FILESYSTEM  *ScannedFileSystem;
+  LIST_ENTRY          *Link;
+  OC_BOOT_ENTRY       *BootEntry;
+
+  *FileSystem = NULL;
+
+  if (BootContext->PendingFileSystem == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (!IsNull (&BootContext->FileSystems, BootContext->PendingFileSystem)) {
+    ScannedFileSystem = BASE_CR (BootContext->PendingFileSystem, OC_BOOT_FILESYSTEM, Link);
+    //
+    // Filesystems created during scanning are appended to the list and are scanned later.
+    //
+    BootContext->PendingFileSystem = GetNextNode (&BootContext->FileSystems, BootContext->PendingFileSystem);
+    ScanFileSystem (BootContext, ScannedFileSystem);
+  } else {
+    ScannedFileSystem = CompleteBootEntryScan (BootContext);
+    if (ScannedFileSystem == NULL) {
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  //
+  // Entries of the scanned filesystem go after all visible entries.
+  //
+  for (
+    Link = GetFirstNode (&ScannedFileSystem->BootEntries);
+    !IsNull (&ScannedFileSystem->BootEntries, Link);
+    Link = GetNextNode (&ScannedFileSystem->BootEntries, Link)) {
+    BootEntry = BASE_CR (Link, OC_BOOT_ENTRY, Link);
+    BootEntry->EntryIndex = (UINT32) ++BootContext->VisibleEntryCount;
+  }
+
+  *FileSystem = ScannedFileSystem;
+  return EFI_SUCCESS;
+}
+
 OC_BOOT_CONTEXT *
 OcScanForBootEntries (
   IN  OC_PICKER_CONTEXT  *Context
   )
 {
+  EFI_STATUS                       Status;
   OC_BOOT_CONTEXT                  *BootContext;
   UINTN                            Index;
-  LIST_ENTRY                       *Link;
   OC_BOOT_FILESYSTEM               *FileSystem;
   OC_BOOT_FILESYSTEM               *CustomFileSystem;
   OC_BOOT_FILESYSTEM               *CustomFileSystemDefault;
   UINT32                           DefaultCustomIndex;
+  BOOLEAN                          Progressive;
 
   //
   // Obtain the list of filesystems filtered by scan policy.
@@ -1748,6 +2025,8 @@ OcScanForBootEntries (
 
   DEBUG ((DEBUG_INFO, "OCB: Found %u potentially bootable filesystems\n", (UINT32) BootContext->FileSystemCount));
 
+  BootContext->ScanCacheState = InternalLoadScanCache (Context);
+
   //
   // Create primary boot options from BootOrder.
   //
@@ -1789,64 +2068,247 @@ OcScanForBootEntries (
     }
   }
 
-  DEBUG ((DEBUG_INFO, "OCB: Processing blessed list\n"));
+  //
+  // The picker is shown as soon as the default entry is found, and
+  // the rest is scanned while it waits for user input. Audio assist
+  // reads the whole list once, so it needs all entries upfront.
+  //
+  Progressive = Context->PickerCommand == OcPickerShowPicker && !Context->PickerAudioAssist;
+  if (Progressive) {
+    DeferSlowFileSystems (BootContext);
+  }
+
+  BootContext->PendingFileSystem       = GetFirstNode (&BootContext->FileSystems);
+  BootContext->PendingCustomFileSystem = CustomFileSystem;
+  BootContext->DefaultCustomIndex      = DefaultCustomIndex;
+
+  DEBUG ((DEBUG_INFO, "OCB: Processing blessed list%a\n", Progressive ? " progressively" : ""));
 
   //
   // Create primary boot options on filesystems without options
   // and alternate boot options on all filesystems.
   //
+  do {
+    Status = OcScanNextFileSystem (BootContext, &FileSystem);
+  } while (!EFI_ERROR (Status)
+    && (!Progressive || BootContext->DefaultEntry == NULL || BootContext->DefaultEntry->EntryIndex == 0));
+
+  if (BootContext->BootEntryCount == 0) {
+    OcFreeBootContext (BootContext);
+    return NULL;
+  }
+
+  //
+  // Find recovery.
+  //
+  if (BootContext->PickerContext->PickerCommand == OcPickerBootAppleRecovery) {
+    OcSetDefaultBootRecovery (BootContext);
+  }
+
+  return BootContext;
+}
+
+/**
+  Revalidate boot entries restored from scan cache on the filesystem.
+
+  @param[in,out] BootContext   Context of filesystems.
+  @param[in,out] FileSystem    Filesystem with cached entries.
+  @param[out]    Changed       Set to TRUE when boot entries changed.
+**/
+STATIC
+VOID
+RevalidateFileSystem (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem,
+     OUT BOOLEAN             *Changed
+  )
+{
+  LIST_ENTRY          *EntryLink;
+  LIST_ENTRY          CachedEntries;
+  OC_BOOT_ENTRY       *BootEntry;
+  OC_BOOT_ENTRY       *DefaultEntry;
+  BOOLEAN             WasDefault;
+
+  ASSERT (FileSystem->FromScanCache);
+
+  *Changed = FALSE;
+
+  FileSystem->FromScanCache = FALSE;
+
+  //
+  // Detach cached entries and rescan the filesystem as usual.
+  //
+  InitializeListHead (&CachedEntries);
+  DefaultEntry = BootContext->DefaultEntry;
+  WasDefault   = FALSE;
+  while (!IsListEmpty (&FileSystem->BootEntries)) {
+    EntryLink = GetFirstNode (&FileSystem->BootEntries);
+    BootEntry = BASE_CR (EntryLink, OC_BOOT_ENTRY, Link);
+    RemoveEntryList (EntryLink);
+    InsertTailList (&CachedEntries, EntryLink);
+    --BootContext->BootEntryCount;
+    WasDefault |= BootEntry == DefaultEntry;
+  }
+
+  //
+  // Let the rescanned entries provide the default one when it was cached.
+  //
+  if (WasDefault) {
+    BootContext->DefaultEntry = NULL;
+  }
+
+  FileSystem->HasSelfRecovery = FALSE;
+
+  AddBootEntryFromBless (
+    BootContext,
+    FileSystem,
+    gAppleBootPolicyPredefinedPaths,
+    gAppleBootPolicyNumPredefinedPaths,
+    FALSE,
+    FALSE
+    );
+  AddBootEntryFromSelfRecovery (BootContext, FileSystem);
+
+  InternalSetScanCacheValidated (FileSystem);
+
+  if (IsBootEntryListEqual (&CachedEntries, &FileSystem->BootEntries)) {
+    //
+    // Keep cached entries, as the picker refers to them.
+    //
+    while (!IsListEmpty (&FileSystem->BootEntries)) {
+      EntryLink = GetFirstNode (&FileSystem->BootEntries);
+      BootEntry = BASE_CR (EntryLink, OC_BOOT_ENTRY, Link);
+      RemoveEntryList (EntryLink);
+      FreeBootEntry (BootEntry);
+      --BootContext->BootEntryCount;
+    }
+
+    while (!IsListEmpty (&CachedEntries)) {
+      EntryLink = GetFirstNode (&CachedEntries);
+      RemoveEntryList (EntryLink);
+      InsertTailList (&FileSystem->BootEntries, EntryLink);
+      ++BootContext->BootEntryCount;
+    }
+
+    BootContext->DefaultEntry = DefaultEntry;
+
+    DEBUG ((DEBUG_INFO, "OCB: Cached entries for fs %p are valid\n", FileSystem->Handle));
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCB: Cached entries for fs %p changed\n", FileSystem->Handle));
+
+  //
+  // The picker may still refer to replaced entries until it reloads.
+  //
+  while (!IsListEmpty (&CachedEntries)) {
+    EntryLink = GetFirstNode (&CachedEntries);
+    RemoveEntryList (EntryLink);
+    InsertTailList (&BootContext->ScanCacheState->StaleEntries, EntryLink);
+  }
+
+  BootContext->ScanCacheState->Changed = TRUE;
+  BootContext->VisibleEntryCount       = BootContext->BootEntryCount;
+  *Changed = TRUE;
+
+  InternalSaveScanCache (BootContext);
+}
+
+EFI_STATUS
+EFIAPI
+OcRevalidateBootEntries (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+     OUT BOOLEAN          *Changed
+  )
+{
+  LIST_ENTRY          *Link;
+  OC_BOOT_FILESYSTEM  *FileSystem;
+
+  *Changed = FALSE;
+
+  if (BootContext->ScanCacheState == NULL || BootContext->ScanCacheState->Complete) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (BootContext->PendingFileSystem != NULL) {
+    return EFI_NOT_READY;
+  }
+
   for (
     Link = GetFirstNode (&BootContext->FileSystems);
     !IsNull (&BootContext->FileSystems, Link);
     Link = GetNextNode (&BootContext->FileSystems, Link)) {
     FileSystem = BASE_CR (Link, OC_BOOT_FILESYSTEM, Link);
-
-    //
-    // No entries, so we process this directory with Apple Bless.
-    //
-    if (IsListEmpty (&FileSystem->BootEntries)) {
-      AddBootEntryFromBless (
-        BootContext,
-        FileSystem,
-        gAppleBootPolicyPredefinedPaths,
-        gAppleBootPolicyNumPredefinedPaths,
-        FALSE,
-        FALSE
-        );
+    if (FileSystem->FromScanCache) {
+      break;
     }
+  }
 
-    //
-    // Record predefined recoveries.
-    //
-    AddBootEntryFromSelfRecovery (BootContext, FileSystem);
+  if (IsNull (&BootContext->FileSystems, Link)) {
+    DEBUG ((DEBUG_INFO, "OCB: Revalidated all cached entries\n"));
+    BootContext->ScanCacheState->Complete = TRUE;
+    InternalSaveScanCache (BootContext);
+    return EFI_NOT_FOUND;
   }
 
-  if (CustomFileSystem != NULL) {
-    //
-    // Insert the custom file system last for entry order.
-    //
-    InsertTailList (&BootContext->FileSystems, &CustomFileSystem->Link);
-    ++BootContext->FileSystemCount;
+  RevalidateFileSystem (BootContext, FileSystem, Changed);
+  return EFI_SUCCESS;
+}
 
-    //
-    // Build custom and system options.
-    //
-    AddFileSystemEntryForCustom (BootContext, CustomFileSystem, DefaultCustomIndex);
+EFI_STATUS
+EFIAPI
+OcRevalidateChosenEntry (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+  IN     OC_BOOT_ENTRY    *BootEntry
+  )
+{
+  LIST_ENTRY          *Link;
+  LIST_ENTRY          *EntryLink;
+  OC_BOOT_FILESYSTEM  *FileSystem;
+  BOOLEAN             Changed;
+
+  if (BootContext->ScanCacheState == NULL) {
+    return EFI_SUCCESS;
   }
 
-  if (BootContext->BootEntryCount == 0) {
-    OcFreeBootContext (BootContext);
-    return NULL;
+  for (
+    EntryLink = GetFirstNode (&BootContext->ScanCacheState->StaleEntries);
+    !IsNull (&BootContext->ScanCacheState->StaleEntries, EntryLink);
+    EntryLink = GetNextNode (&BootContext->ScanCacheState->StaleEntries, EntryLink)) {
+    if (EntryLink == &BootEntry->Link) {
+      DEBUG ((DEBUG_INFO, "OCB: Chosen entry %s was replaced\n", BootEntry->Name));
+      return EFI_NOT_FOUND;
+    }
   }
 
-  //
-  // Find recovery.
-  //
-  if (BootContext->PickerContext->PickerCommand == OcPickerBootAppleRecovery) {
-    OcSetDefaultBootRecovery (BootContext);
+  for (
+    Link = GetFirstNode (&BootContext->FileSystems);
+    !IsNull (&BootContext->FileSystems, Link);
+    Link = GetNextNode (&BootContext->FileSystems, Link)) {
+    FileSystem = BASE_CR (Link, OC_BOOT_FILESYSTEM, Link);
+    if (!FileSystem->FromScanCache) {
+      continue;
+    }
+
+    for (
+      EntryLink = GetFirstNode (&FileSystem->BootEntries);
+      !IsNull (&FileSystem->BootEntries, EntryLink);
+      EntryLink = GetNextNode (&FileSystem->BootEntries, EntryLink)) {
+      if (EntryLink != &BootEntry->Link) {
+        continue;
+      }
+
+      RevalidateFileSystem (BootContext, FileSystem, &Changed);
+      if (Changed) {
+        DEBUG ((DEBUG_INFO, "OCB: Chosen entry %s is no longer valid\n", BootEntry->Name));
+        return EFI_NOT_FOUND;
+      }
+
+      return EFI_SUCCESS;
+    }
   }
 
-  return BootContext;
+  return EFI_SUCCESS;
 }
 
 OC_BOOT_CONTEXT *
@@ -2000,7 +2462,7 @@ OcEnumerateEntries (
   LIST_ENTRY          *EnLink;
   OC_BOOT_ENTRY       *BootEntry;
 
-  Entries = AllocatePool (sizeof (*Entries) * BootContext->BootEntryCount);
+  Entries = AllocatePool (sizeof (*Entries) * BootContext->VisibleEntryCount);
   if (Entries == NULL) {
     return NULL;
   }
@@ -2008,7 +2470,7 @@ OcEnumerateEntries (
   EntryIndex = 0;
   for (
     FsLink = GetFirstNode (&BootContext->FileSystems);
-    !IsNull (&BootContext->FileSystems, FsLink);
+    !IsNull (&BootContext->FileSystems, FsLink) && FsLink != BootContext->PendingFileSystem;
     FsLink = GetNextNode (&BootContext->FileSystems, FsLink)) {
     FileSystem = BASE_CR (FsLink, OC_BOOT_FILESYSTEM, Link);
 
@@ -2018,13 +2480,13 @@ OcEnumerateEntries (
       EnLink = GetNextNode (&FileSystem->BootEntries, EnLink)) {
       BootEntry = BASE_CR (EnLink, OC_BOOT_ENTRY, Link);
 
-      ASSERT (EntryIndex < BootContext->BootEntryCount);
+      ASSERT (EntryIndex < BootContext->VisibleEntryCount);
       Entries[EntryIndex] = BootEntry;
       BootEntry->EntryIndex = ++EntryIndex;
     }
   }
 
-  ASSERT (EntryIndex == BootContext->BootEntryCount);
+  ASSERT (EntryIndex == BootContext->VisibleEntryCount);
   ASSERT (BootContext->DefaultEntry == NULL || BootContext->DefaultEntry->EntryIndex > 0);
   return Entries;
 }
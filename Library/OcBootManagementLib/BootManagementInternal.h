@@ -61,6 +61,47 @@ typedef PACKED struct {
 #define SIZE_OF_OC_CUSTOM_BOOT_DEVICE_PATH  \
   (sizeof (VENDOR_DEVICE_PATH) + SIZE_OF_FILEPATH_DEVICE_PATH)
 
+///
+/// Devices scanned after all others when the picker is shown progressively.
+///
+#define OC_SCAN_SLOW_DEVICE_POLICY  \
+  (OC_SCAN_ALLOW_DEVICE_ATAPI | OC_SCAN_ALLOW_DEVICE_USB | \
+   OC_SCAN_ALLOW_DEVICE_FIREWIRE | OC_SCAN_ALLOW_DEVICE_SDCARD)
+
+///
+/// Maximum scan cache variable size, filesystems not fitting are scanned every boot.
+///
+#define OC_SCAN_CACHE_MAX_SIZE  SIZE_4KB
+
+///
+/// Picker input polling interval while boot entries are being scanned or revalidated.
+///
+#define OC_PICKER_POLL_MS       10
+
+struct OC_SCAN_CACHE_ {
+  //
+  // Scan cache variable contents, NULL when missing or not valid.
+  //
+  VOID        *Data;
+  //
+  // Scan cache variable size.
+  //
+  UINTN       DataSize;
+  //
+  // Boot entries replaced during revalidation (OC_BOOT_ENTRY).
+  // The picker may still refer to them, so they are freed with boot context.
+  //
+  LIST_ENTRY  StaleEntries;
+  //
+  // Boot entries changed during revalidation.
+  //
+  BOOLEAN     Changed;
+  //
+  // All filesystems were revalidated.
+  //
+  BOOLEAN     Complete;
+};
+
 typedef struct {
   EFI_DEVICE_PATH_PROTOCOL       *DevicePath;
   OC_APPLE_DISK_IMAGE_CONTEXT    *DmgContext;
@@ -196,6 +237,70 @@ InternalFileSystemForHandle (
   IN BOOLEAN          LazyScan
   );
 
+/**
+  Load scan cache when it is enabled and the picker is going to be shown.
+
+  @param[in]  Context  Picker context.
+
+  @retval scan cache state allocated from pool or NULL.
+**/
+OC_SCAN_CACHE *
+InternalLoadScanCache (
+  IN OC_PICKER_CONTEXT  *Context
+  );
+
+/**
+  Restore boot entries of a filesystem from scan cache.
+  Restored entries are described, but not registered.
+  Filesystem RecoveryFs, HasSelfRecovery, and scan cache fields are updated.
+
+  @param[in]     BootContext  Context of filesystems.
+  @param[in,out] FileSystem   Filesystem to restore entries for.
+  @param[out]    Entries      Initialised list to append OC_BOOT_ENTRY to.
+
+  @retval EFI_SUCCESS when entries were restored.
+**/
+EFI_STATUS
+InternalRestoreScanCacheEntries (
+  IN     OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem,
+     OUT LIST_ENTRY          *Entries
+  );
+
+/**
+  Mark filesystem entries as revalidated for the rest of this boot,
+  so that rescans restore them without revalidation.
+
+  @param[in]  FileSystem  Revalidated filesystem.
+**/
+VOID
+InternalSetScanCacheValidated (
+  IN OC_BOOT_FILESYSTEM  *FileSystem
+  );
+
+/**
+  Store boot entries of cacheable filesystems in scan cache.
+  The variable is only written when its contents change.
+
+  @param[in]  BootContext  Context of filesystems.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+InternalSaveScanCache (
+  IN OC_BOOT_CONTEXT  *BootContext
+  );
+
+/**
+  Free scan cache state. Stale entries must be freed by the caller.
+
+  @param[in]  ScanCache  Scan cache state.
+**/
+VOID
+InternalFreeScanCache (
+  IN OC_SCAN_CACHE  *ScanCache
+  );
+
 /**
   Resets selected NVRAM variables and reboots the system.
 **/
@@ -86,10 +86,11 @@ InternalEfiLoadImageFile (
   OUT VOID                      **FileBuffer
   )
 {
-  EFI_STATUS         Status;
-  EFI_FILE_PROTOCOL  *File;
-  VOID               *Buffer;
-  UINT32             Size;
+  EFI_STATUS            Status;
+  EFI_FILE_PROTOCOL     *File;
+  VOID                  *Buffer;
+  EFI_PHYSICAL_ADDRESS  BufferArea;
+  UINT32                Size;
 
   Status = OcOpenFileByDevicePath (
     &DevicePath,
@@ -110,12 +111,22 @@ InternalEfiLoadImageFile (
     return EFI_UNSUPPORTED;
   }
 
-  Buffer = AllocatePool (Size);
-  if (Buffer == NULL) {
+  //
+  // Read into loader code pages, so that applications can be loaded in place.
+  //
+  Status = gBS->AllocatePages (
+    AllocateAnyPages,
+    EfiLoaderCode,
+    EFI_SIZE_TO_PAGES (Size),
+    &BufferArea
+    );
+  if (EFI_ERROR (Status)) {
     File->Close (File);
     return EFI_OUT_OF_RESOURCES;
   }
 
+  Buffer = (VOID *)(UINTN) BufferArea;
+
   Status = GetFileData (
     File,
     0,
@@ -123,7 +134,7 @@ InternalEfiLoadImageFile (
     Buffer
     );
   if (EFI_ERROR (Status)) {
-    FreePool (Buffer);
+    FreePages (Buffer, EFI_SIZE_TO_PAGES (Size));
     File->Close (File);
     return EFI_DEVICE_ERROR;
   }
@@ -144,6 +155,7 @@ InternalEfiLoadImageProtocol (
 {
   //
   // TODO: Implement image load protocol if necessary.
+  // FileBuffer is to be allocated as EfiLoaderCode pages.
   //
   return EFI_UNSUPPORTED;
 }
@@ -186,15 +198,31 @@ InternalUpdateLoadedImage (
   return EFI_SUCCESS;
 }
 
+/**
+  Load the image directly, bypassing UEFI.
+
+  @param[in]   ParentImageHandle  The caller's image handle.
+  @param[in]   SourceBuffer       Pointer to the memory location containing image to be loaded.
+  @param[in]   SourceSize         The size in bytes of SourceBuffer.
+  @param[in]   SourceArea         Page memory containing SourceBuffer, allocated as
+                                  EfiLoaderCode, or NULL. When not NULL, the image may
+                                  be loaded in place and take ownership of SourceArea.
+  @param[in]   SourcePageCount    The size of SourceArea in pages.
+  @param[out]  ImageHandle        The pointer to the returned image handle created on success.
+  @param[out]  InPlace            On success, whether SourceArea is now owned by the image.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
 EFI_STATUS
-EFIAPI
-OcImageLoaderLoad (
-  IN  BOOLEAN                  BootPolicy,
+InternalDirectLoadImage (
   IN  EFI_HANDLE               ParentImageHandle,
-  IN  EFI_DEVICE_PATH_PROTOCOL *DevicePath,
-  IN  VOID                     *SourceBuffer OPTIONAL,
+  IN  VOID                     *SourceBuffer,
   IN  UINTN                    SourceSize,
-  OUT EFI_HANDLE               *ImageHandle
+  IN  VOID                     *SourceArea OPTIONAL,
+  IN  UINTN                    SourcePageCount,
+  OUT EFI_HANDLE               *ImageHandle,
+  OUT BOOLEAN                  *InPlace
   )
 {
   EFI_STATUS                   Status;
@@ -202,11 +230,15 @@ OcImageLoaderLoad (
   PE_COFF_IMAGE_CONTEXT        ImageContext;
   EFI_PHYSICAL_ADDRESS         DestinationArea;
   VOID                         *DestinationBuffer;
+  UINTN                        DestinationPageCount;
+  UINTN                        SourceCapacity;
   OC_LOADED_IMAGE_PROTOCOL     *OcLoadedImage;
   EFI_LOADED_IMAGE_PROTOCOL    *LoadedImage;
 
   ASSERT (SourceBuffer != NULL);
 
+  *InPlace = FALSE;
+
   //
   // Reject very large files.
   //
@@ -240,48 +272,57 @@ OcImageLoaderLoad (
     DEBUG ((DEBUG_INFO, "OCB: PeCoff no support for RT drivers\n"));
     return EFI_UNSUPPORTED;
   }
+
   //
-  // Allocate the image destination memory.
-  // FIXME: RT drivers require EfiRuntimeServicesCode.
+  // Load applications within their source pages when the layout permits,
+  // the memory type of the source pages only suits applications.
   //
-  Status = gBS->AllocatePages (
-    AllocateAnyPages,
-    ImageContext.Subsystem == EFI_IMAGE_SUBSYSTEM_EFI_APPLICATION
-      ? EfiLoaderCode : EfiBootServicesCode,
-    EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage),
-    &DestinationArea
-    );
-  if (EFI_ERROR (Status)) {
-    return Status;
+  SourceCapacity = 0;
+  if (SourceArea != NULL && ImageContext.Subsystem == EFI_IMAGE_SUBSYSTEM_EFI_APPLICATION) {
+    SourceCapacity = EFI_PAGES_TO_SIZE (SourcePageCount) - ((UINTN) SourceBuffer - (UINTN) SourceArea);
   }
 
-  DestinationBuffer = (VOID *)(UINTN) DestinationArea;
+  if (SourceCapacity > 0
+    && PeCoffCanLoadInPlace (&ImageContext, (UINT32) MIN (SourceCapacity, MAX_UINT32))) {
+    DestinationArea      = (EFI_PHYSICAL_ADDRESS) (UINTN) SourceArea;
+    DestinationBuffer    = SourceBuffer;
+    DestinationPageCount = SourcePageCount;
+  } else {
+    //
+    // Allocate the image destination memory.
+    // FIXME: RT drivers require EfiRuntimeServicesCode.
+    //
+    DestinationPageCount = EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage);
+    Status = gBS->AllocatePages (
+      AllocateAnyPages,
+      ImageContext.Subsystem == EFI_IMAGE_SUBSYSTEM_EFI_APPLICATION
+        ? EfiLoaderCode : EfiBootServicesCode,
+      DestinationPageCount,
+      &DestinationArea
+      );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
-  //
-  // Load SourceBuffer into DestinationBuffer.
-  //
-  ImageStatus = PeCoffLoadImage (
-    &ImageContext,
-    DestinationBuffer,
-    ImageContext.SizeOfImage
-    );
-  if (EFI_ERROR (ImageStatus)) {
-    DEBUG ((DEBUG_INFO, "OCB: PeCoff load image error - %r\n", ImageStatus));
-    FreePages (DestinationBuffer, EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage));
-    return EFI_UNSUPPORTED;
+    DestinationBuffer = (VOID *)(UINTN) DestinationArea;
   }
+
   //
-  // Relocate the loaded image to the destination address.
+  // Load SourceBuffer into DestinationBuffer and relocate it to the destination
+  // address in one pass, in place when DestinationBuffer is SourceBuffer.
   //
-  ImageStatus = PeCoffRelocateImage (
+  ImageStatus = PeCoffLoadRelocateImage (
     &ImageContext,
-    (UINTN) DestinationBuffer,
+    DestinationBuffer,
+    ImageContext.SizeOfImage,
     NULL,
-    0
+    NULL
     );
   if (EFI_ERROR (ImageStatus)) {
-    DEBUG ((DEBUG_INFO, "OCB: PeCoff relocate image error - %r\n", ImageStatus));
-    FreePages (DestinationBuffer, EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage));
+    DEBUG ((DEBUG_INFO, "OCB: PeCoff load image error - %r\n", ImageStatus));
+    if (DestinationBuffer != SourceBuffer) {
+      FreePages ((VOID *)(UINTN) DestinationArea, DestinationPageCount);
+    }
     return EFI_UNSUPPORTED;
   }
   //
@@ -289,13 +330,15 @@ OcImageLoaderLoad (
   //
   OcLoadedImage = AllocateZeroPool (sizeof (*OcLoadedImage));
   if (OcLoadedImage == NULL) {
-    FreePages (DestinationBuffer, EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage));
+    if (DestinationBuffer != SourceBuffer) {
+      FreePages ((VOID *)(UINTN) DestinationArea, DestinationPageCount);
+    }
     return EFI_OUT_OF_RESOURCES;
   }
 
   OcLoadedImage->EntryPoint = (EFI_IMAGE_ENTRY_POINT) ((UINTN) DestinationBuffer + ImageContext.AddressOfEntryPoint);
   OcLoadedImage->ImageArea  = DestinationArea;
-  OcLoadedImage->PageCount  = EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage);
+  OcLoadedImage->PageCount  = DestinationPageCount;
   OcLoadedImage->Subsystem  = ImageContext.Subsystem;
 
   LoadedImage = &OcLoadedImage->LoadedImage;
@@ -330,15 +373,48 @@ OcImageLoaderLoad (
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "OCB: PeCoff proto install error - %r\n", Status));
     FreePool (OcLoadedImage);
-    FreePages (DestinationBuffer, EFI_SIZE_TO_PAGES (ImageContext.SizeOfImage));
+    if (DestinationBuffer != SourceBuffer) {
+      FreePages ((VOID *)(UINTN) DestinationArea, DestinationPageCount);
+    }
     return Status;
   }
 
-  DEBUG ((DEBUG_VERBOSE, "OCB: Loaded image at %p\n", *ImageHandle));
+  *InPlace = DestinationBuffer == SourceBuffer;
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCB: Loaded image at %p%a\n",
+    *ImageHandle,
+    *InPlace ? " in place" : ""
+    ));
 
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+EFIAPI
+OcImageLoaderLoad (
+  IN  BOOLEAN                  BootPolicy,
+  IN  EFI_HANDLE               ParentImageHandle,
+  IN  EFI_DEVICE_PATH_PROTOCOL *DevicePath,
+  IN  VOID                     *SourceBuffer OPTIONAL,
+  IN  UINTN                    SourceSize,
+  OUT EFI_HANDLE               *ImageHandle
+  )
+{
+  BOOLEAN  InPlace;
+
+  return InternalDirectLoadImage (
+    ParentImageHandle,
+    SourceBuffer,
+    SourceSize,
+    NULL,
+    0,
+    ImageHandle,
+    &InPlace
+    );
+}
+
 /**
   Unload image routine for OcImageLoaderLoad.
 
@@ -689,7 +765,9 @@ InternalEfiLoadImage (
   EFI_STATUS                 SecureBootStatus;
   EFI_STATUS                 Status;
   VOID                       *AllocatedBuffer;
+  UINTN                      AllocatedPageCount;
   UINT32                     RealSize;
+  BOOLEAN                    InPlace;
 
   if (ParentImageHandle == NULL || ImageHandle == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -703,7 +781,8 @@ InternalEfiLoadImage (
     return EFI_UNSUPPORTED;
   }
 
-  AllocatedBuffer = NULL;
+  AllocatedBuffer    = NULL;
+  AllocatedPageCount = 0;
   if (SourceBuffer == NULL) {
     Status = InternalEfiLoadImageFile (
       DevicePath,
@@ -720,7 +799,8 @@ InternalEfiLoadImage (
     }
 
     if (!EFI_ERROR (Status)) {
-      AllocatedBuffer = SourceBuffer;
+      AllocatedBuffer    = SourceBuffer;
+      AllocatedPageCount = EFI_SIZE_TO_PAGES (SourceSize);
     }
   }
 
@@ -802,14 +882,21 @@ InternalEfiLoadImage (
   //
   if (SecureBootStatus == EFI_SUCCESS) {
     if (SourceBuffer != NULL) {
-      Status = OcImageLoaderLoad (
-        FALSE,
+      Status = InternalDirectLoadImage (
         ParentImageHandle,
-        DevicePath,
         SourceBuffer,
         SourceSize,
-        ImageHandle
+        AllocatedBuffer,
+        AllocatedPageCount,
+        ImageHandle,
+        &InPlace
         );
+      //
+      // The image now owns the buffer it was loaded in.
+      //
+      if (!EFI_ERROR (Status) && InPlace) {
+        AllocatedBuffer = NULL;
+      }
     } else {
       //
       // We verified the image, but contained garbage.
@@ -829,7 +916,7 @@ InternalEfiLoadImage (
   }
 
   if (AllocatedBuffer != NULL) {
-    FreePool (AllocatedBuffer);
+    FreePages (AllocatedBuffer, AllocatedPageCount);
   }
 
   //
@@ -43,6 +43,7 @@
 #include <Library/OcMiscLib.h>
 #include <Library/OcRtcLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
@@ -95,11 +96,16 @@ RunShowMenu (
     &EntryReason
     );
 
+  //
+  // Pickers end this phase once their first frame is drawn.
+  //
+  OcTraceBegin ("PickerFrame");
   Status = BootContext->PickerContext->ShowMenu (
     BootContext,
     BootEntries,
     ChosenBootEntry
     );
+  OcTraceEnd ("PickerFrame");
   FreePool (BootEntries);
 
   return Status;
@@ -125,12 +131,127 @@ GetPickerEntryCursor (
   return L' ';
 }
 
+/**
+  Scan the next pending filesystem, or revalidate boot entries restored
+  from scan cache once scanning is complete.
+
+  @param[in,out] BootContext  Boot context.
+  @param[out]    Added        Set when new boot entries became visible.
+  @param[out]    Changed      Set when boot entries changed and the menu must be reloaded.
+
+  @retval EFI_SUCCESS when more boot entries may be pending.
+**/
+STATIC
 EFI_STATUS
-EFIAPI
-OcShowSimpleBootMenu (
-  IN  OC_BOOT_CONTEXT             *BootContext,
-  IN  OC_BOOT_ENTRY               **BootEntries,
-  OUT OC_BOOT_ENTRY               **ChosenBootEntry
+ProcessPendingBootEntries (
+  IN OUT OC_BOOT_CONTEXT  *BootContext,
+     OUT BOOLEAN          *Added,
+     OUT BOOLEAN          *Changed
+  )
+{
+  EFI_STATUS          Status;
+  OC_BOOT_FILESYSTEM  *FileSystem;
+
+  *Added   = FALSE;
+  *Changed = FALSE;
+
+  Status = OcScanNextFileSystem (BootContext, &FileSystem);
+  if (!EFI_ERROR (Status)) {
+    *Added = !IsListEmpty (&FileSystem->BootEntries);
+    return EFI_SUCCESS;
+  }
+
+  return OcRevalidateBootEntries (BootContext, Changed);
+}
+
+/**
+  Wait for picker key press while processing pending boot entries.
+  Time spent on processing counts towards the deadline.
+
+  @param[in]     BootContext  Boot context.
+  @param[in]     KeyMap       Apple Key Map Aggregator protocol.
+  @param[in]     Deadline     Deadline in nanoseconds, 0 for none.
+  @param[in,out] Pending      Boot entries are pending, reset once complete.
+  @param[out]    Added        Set when new boot entries became visible.
+  @param[out]    Changed      Set when boot entries changed.
+  @param[out]    SetDefault   Set when default entry is requested.
+
+  @retval key index or OC_INPUT_TIMEOUT.
+**/
+STATIC
+INTN
+WaitForPickerKeyIndex (
+  IN     OC_BOOT_CONTEXT                    *BootContext,
+  IN     APPLE_KEY_MAP_AGGREGATOR_PROTOCOL  *KeyMap,
+  IN     UINT64                             Deadline,
+  IN OUT BOOLEAN                            *Pending,
+     OUT BOOLEAN                            *Added,
+     OUT BOOLEAN                            *Changed,
+     OUT BOOLEAN                            *SetDefault
+  )
+{
+  EFI_STATUS  Status;
+  INTN        KeyIndex;
+  UINT64      CurrTime;
+  UINTN       Timeout;
+
+  *Added   = FALSE;
+  *Changed = FALSE;
+
+  while (*Pending) {
+    Status = ProcessPendingBootEntries (BootContext, Added, Changed);
+    if (EFI_ERROR (Status)) {
+      *Pending = FALSE;
+      break;
+    }
+
+    if (*Added || *Changed) {
+      return OC_INPUT_TIMEOUT;
+    }
+
+    KeyIndex = OcWaitForAppleKeyIndex (
+      BootContext->PickerContext,
+      KeyMap,
+      OC_PICKER_POLL_MS,
+      SetDefault
+      );
+    CurrTime = GetTimeInNanoSecond (GetPerformanceCounter ());
+    if (KeyIndex != OC_INPUT_TIMEOUT || (Deadline != 0 && CurrTime >= Deadline)) {
+      return KeyIndex;
+    }
+  }
+
+  Timeout = 0;
+  if (Deadline != 0) {
+    CurrTime = GetTimeInNanoSecond (GetPerformanceCounter ());
+    if (CurrTime >= Deadline) {
+      return OC_INPUT_TIMEOUT;
+    }
+
+    Timeout = MAX ((UINTN) DivU64x32 (Deadline - CurrTime, 1000000), 1);
+  }
+
+  return OcWaitForAppleKeyIndex (BootContext->PickerContext, KeyMap, Timeout, SetDefault);
+}
+
+/**
+  Show simple boot menu, which grows while pending boot entries are scanned.
+
+  @param[in]     BootContext      Boot context.
+  @param[in]     BootEntries      Enumerated boot entries.
+  @param[in,out] GrownEntries     Boot entries enumerated after growing, allocated from pool.
+  @param[out]    ChosenBootEntry  Chosen boot entry.
+
+  @retval EFI_SUCCESS when an entry was chosen.
+  @retval EFI_ABORTED when the menu must be reloaded.
+**/
+STATIC
+EFI_STATUS
+RunSimpleBootMenu (
+  IN     OC_BOOT_CONTEXT             *BootContext,
+  IN     OC_BOOT_ENTRY               **BootEntries,
+  IN OUT OC_BOOT_ENTRY               ***GrownEntries,
+     OUT OC_BOOT_ENTRY               **ChosenBootEntry
   )
 {
   APPLE_KEY_MAP_AGGREGATOR_PROTOCOL  *KeyMap;
@@ -150,6 +271,12 @@ OcShowSimpleBootMenu (
   BOOLEAN                            SetDefault;
   BOOLEAN                            PlayedOnce;
   BOOLEAN                            PlayChosen;
+  BOOLEAN                            Pending;
+  BOOLEAN                            Added;
+  BOOLEAN                            Changed;
+  UINT64                             TimeOutEnd;
+  UINT64                             Deadline;
+  OC_BOOT_ENTRY                      **NewEntries;
 
   Code[1]        = L'\0';
 
@@ -163,6 +290,11 @@ OcShowSimpleBootMenu (
 
   PlayedOnce     = FALSE;
   PlayChosen     = FALSE;
+  Pending        = TRUE;
+  TimeOutEnd     = 0;
+  if (TimeOutSeconds > 0) {
+    TimeOutEnd = GetTimeInNanoSecond (GetPerformanceCounter ()) + TimeOutSeconds * 1000000000ULL;
+  }
 
   KeyMap = OcAppleKeyMapInstallProtocols (FALSE);
   if (KeyMap == NULL) {
@@ -170,7 +302,7 @@ OcShowSimpleBootMenu (
     return EFI_UNSUPPORTED;
   }
 
-  Count = (UINT32) BootContext->BootEntryCount;
+  Count = (UINT32) BootContext->VisibleEntryCount;
 
   if (Count != MIN (Count, OC_INPUT_MAX)) {
     DEBUG ((DEBUG_WARN, "OCB: Cannot display all entries in the menu!\n"));
@@ -283,17 +415,57 @@ OcShowSimpleBootMenu (
       PlayedOnce = TRUE;
     }
 
+    OcTraceEnd ("PickerFrame");
+
     while (TRUE) {
       //
       // Pronounce entry name only after N ms of idleness.
       //
-      KeyIndex = OcWaitForAppleKeyIndex (
-        BootContext->PickerContext,
+      if (PlayChosen) {
+        Deadline = GetTimeInNanoSecond (GetPerformanceCounter ()) + OC_VOICE_OVER_IDLE_TIMEOUT_MS * 1000000ULL;
+      } else if (TimeOutSeconds > 0) {
+        Deadline = TimeOutEnd;
+      } else {
+        Deadline = 0;
+      }
+
+      KeyIndex = WaitForPickerKeyIndex (
+        BootContext,
         KeyMap,
-        PlayChosen ? OC_VOICE_OVER_IDLE_TIMEOUT_MS : TimeOutSeconds * 1000,
+        Deadline,
+        &Pending,
+        &Added,
+        &Changed,
         &SetDefault
         );
 
+      //
+      // Reload the menu with revalidated entries.
+      //
+      if (Changed) {
+        return EFI_ABORTED;
+      }
+
+      //
+      // Redraw the menu with newly scanned entries appended.
+      //
+      if (Added) {
+        NewEntries = OcEnumerateEntries (BootContext);
+        if (NewEntries != NULL) {
+          if (*GrownEntries != NULL) {
+            FreePool (*GrownEntries);
+          }
+
+          *GrownEntries = NewEntries;
+          BootEntries   = NewEntries;
+          Count         = (UINT32) BootContext->VisibleEntryCount;
+          FirstIndexRow = -1;
+          break;
+        }
+
+        continue;
+      }
+
       if (PlayChosen && KeyIndex == OC_INPUT_TIMEOUT) {
         OcPlayAudioFile (BootContext->PickerContext, OcVoiceOverAudioFileSelected, FALSE);
         OcPlayAudioEntry (BootContext->PickerContext, BootEntries[ChosenEntry]);
@@ -389,6 +561,33 @@ OcShowSimpleBootMenu (
   ASSERT (FALSE);
 }
 
+EFI_STATUS
+EFIAPI
+OcShowSimpleBootMenu (
+  IN  OC_BOOT_CONTEXT             *BootContext,
+  IN  OC_BOOT_ENTRY               **BootEntries,
+  OUT OC_BOOT_ENTRY               **ChosenBootEntry
+  )
+{
+  EFI_STATUS     Status;
+  OC_BOOT_ENTRY  **GrownEntries;
+
+  GrownEntries = NULL;
+
+  Status = RunSimpleBootMenu (
+    BootContext,
+    BootEntries,
+    &GrownEntries,
+    ChosenBootEntry
+    );
+
+  if (GrownEntries != NULL) {
+    FreePool (GrownEntries);
+  }
+
+  return Status;
+}
+
 EFI_STATUS
 EFIAPI
 OcShowSimplePasswordRequest (
@@ -612,6 +811,7 @@ OcRunBootPicker (
     //
     // Turbo-boost scanning when bypassing picker.
     //
+    OcTraceBegin ("Scan");
     if (Context->PickerCommand == OcPickerDefault) {
       BootContext = OcScanForDefaultBootEntry (Context);
     } else {
@@ -623,6 +823,7 @@ OcRunBootPicker (
 
       BootContext = OcScanForBootEntries (Context);
     }
+    OcTraceEnd ("Scan");
 
     //
     // We have no entries at all or have auxiliary entries.
@@ -676,7 +877,24 @@ OcRunBootPicker (
 
     ASSERT (!EFI_ERROR (Status) || Status == EFI_ABORTED);
 
-    Context->TimeoutSeconds = 0;
+    //
+    // Keep the timeout when reloading the menu due to revalidated entries.
+    //
+    if (Status != EFI_ABORTED
+      || BootContext->ScanCacheState == NULL
+      || !BootContext->ScanCacheState->Changed) {
+      Context->TimeoutSeconds = 0;
+    }
+
+    //
+    // Never boot an entry restored from scan cache without revalidation.
+    //
+    if (!EFI_ERROR (Status) && EFI_ERROR (OcRevalidateChosenEntry (BootContext, Chosen))) {
+      DEBUG ((DEBUG_INFO, "OCB: Chosen entry changed, reloading menu\n"));
+      Context->PickerCommand = OcPickerShowPicker;
+      OcFreeBootContext (BootContext);
+      continue;
+    }
 
     if (!EFI_ERROR (Status)) {
       DEBUG ((
@@ -731,6 +949,8 @@ OcRunBootPicker (
         }
       }
 
+      OcTraceSave ();
+
       Status = OcLoadBootEntry (
         Context,
         Chosen,
@@ -0,0 +1,111 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/OcCpuLib.h>
+#include <Library/OcCompressionLib.h>
+
+#include "ChecksumInternal.h"
+#include "zlib/zlib.h"
+
+UINTN
+InternalAdler32Simd (
+  IN OUT UINT32       *Adler,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        BufferLen
+  )
+{
+#if CHECKSUM_HAS_SIMD
+  UINT32  Features;
+
+  if (BufferLen < CHECKSUM_SIMD_MIN_LENGTH) {
+    return 0;
+  }
+
+  Features  = OcCpuGetSimdFeatures ();
+  BufferLen = BufferLen - BufferLen % ADLER32_SIMD_BLOCK_SIZE;
+
+  if ((Features & OC_CPU_SIMD_AVX2) != 0) {
+    *Adler = InternalAdler32Avx2 (*Adler, Buffer, BufferLen);
+    return BufferLen;
+  }
+
+  if ((Features & OC_CPU_SIMD_SSSE3) != 0) {
+    *Adler = InternalAdler32Ssse3 (*Adler, Buffer, BufferLen);
+    return BufferLen;
+  }
+#endif
+
+  return 0;
+}
+
+UINTN
+InternalCrc32Simd (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        BufferLen
+  )
+{
+#if CHECKSUM_HAS_SIMD
+  if (BufferLen < CHECKSUM_SIMD_MIN_LENGTH) {
+    return 0;
+  }
+
+  if ((OcCpuGetSimdFeatures () & OC_CPU_SIMD_PCLMULQDQ) != 0) {
+    BufferLen = BufferLen - BufferLen % CRC32_SIMD_BLOCK_SIZE;
+    *Crc      = InternalCrc32Pclmul (*Crc, Buffer, BufferLen);
+    return BufferLen;
+  }
+#endif
+
+  return 0;
+}
+
+UINT32
+Adler32 (
+  IN CONST UINT8  *Buffer,
+  IN UINT32       BufferLen
+  )
+{
+  return Adler32Update (1, Buffer, BufferLen);
+}
+
+UINT32
+Adler32Update (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  return (UINT32) adler32_z (Adler, Buffer, BufferLen);
+}
+
+UINT32
+Crc32 (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  return Crc32Update (0, Buffer, BufferLen);
+}
+
+UINT32
+Crc32Update (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  return (UINT32) crc32_z (Crc, Buffer, BufferLen);
+}
@@ -0,0 +1,140 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef CHECKSUM_INTERNAL_H
+#define CHECKSUM_INTERNAL_H
+
+/**
+  SIMD kernels are written with GCC vector extensions and x86 builtins,
+  which are supported by both GCC and clang. Other compilers use the
+  scalar zlib implementation.
+**/
+#if (defined (__GNUC__) || defined (__clang__)) && (defined (MDE_CPU_IA32) || defined (MDE_CPU_X64))
+#define CHECKSUM_HAS_SIMD 1
+#else
+#define CHECKSUM_HAS_SIMD 0
+#endif
+
+/**
+  Minimum buffer size worth dispatching to SIMD kernels.
+**/
+#define CHECKSUM_SIMD_MIN_LENGTH  64
+
+/**
+  Adler-32 SIMD kernels process the buffer in blocks of this size.
+**/
+#define ADLER32_SIMD_BLOCK_SIZE   32
+
+/**
+  CRC-32 SIMD kernel processes the buffer in blocks of this size.
+**/
+#define CRC32_SIMD_BLOCK_SIZE     16
+
+/**
+  Largest number of bytes that can be summed before Adler-32 sums
+  must be reduced modulo ADLER32_BASE.
+**/
+#define ADLER32_BASE              65521U
+#define ADLER32_NMAX              5552U
+
+/**
+  Update Adler-32 checksum with the fastest available SIMD kernel.
+  Processes the largest prefix of the buffer that is a multiple of
+  ADLER32_SIMD_BLOCK_SIZE.
+
+  @param[in,out]  Adler      Adler-32 checksum to update.
+  @param[in]      Buffer     Source buffer.
+  @param[in]      BufferLen  Source buffer size.
+
+  @return  Number of bytes processed, 0 when no SIMD kernel is available.
+**/
+UINTN
+InternalAdler32Simd (
+  IN OUT UINT32       *Adler,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        BufferLen
+  );
+
+/**
+  Update CRC-32 checksum with the fastest available SIMD kernel.
+  Processes the largest prefix of the buffer that is a multiple of
+  CRC32_SIMD_BLOCK_SIZE.
+
+  @param[in,out]  Crc        Pre-conditioned (inverted) CRC-32 to update.
+  @param[in]      Buffer     Source buffer.
+  @param[in]      BufferLen  Source buffer size.
+
+  @return  Number of bytes processed, 0 when no SIMD kernel is available.
+**/
+UINTN
+InternalCrc32Simd (
+  IN OUT UINT32       *Crc,
+  IN     CONST UINT8  *Buffer,
+  IN     UINTN        BufferLen
+  );
+
+#if CHECKSUM_HAS_SIMD
+
+/**
+  Adler-32 SSSE3 kernel.
+
+  @param[in]  Adler      Adler-32 checksum to update.
+  @param[in]  Buffer     Source buffer.
+  @param[in]  BufferLen  Source buffer size, multiple of ADLER32_SIMD_BLOCK_SIZE.
+
+  @return  Updated checksum.
+**/
+UINT32
+InternalAdler32Ssse3 (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
+/**
+  Adler-32 AVX2 kernel.
+
+  @param[in]  Adler      Adler-32 checksum to update.
+  @param[in]  Buffer     Source buffer.
+  @param[in]  BufferLen  Source buffer size, multiple of ADLER32_SIMD_BLOCK_SIZE.
+
+  @return  Updated checksum.
+**/
+UINT32
+InternalAdler32Avx2 (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
+/**
+  CRC-32 PCLMULQDQ folding kernel.
+
+  @param[in]  Crc        Pre-conditioned (inverted) CRC-32 to update.
+  @param[in]  Buffer     Source buffer.
+  @param[in]  BufferLen  Source buffer size, multiple of CRC32_SIMD_BLOCK_SIZE,
+                         at least CHECKSUM_SIMD_MIN_LENGTH.
+
+  @return  Updated pre-conditioned CRC-32.
+**/
+UINT32
+InternalCrc32Pclmul (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  );
+
+#endif // CHECKSUM_HAS_SIMD
+
+#endif // CHECKSUM_INTERNAL_H
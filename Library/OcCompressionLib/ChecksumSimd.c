@@ -0,0 +1,280 @@
+/** @file
+  SIMD checksum kernels.
+
+  Adler-32 kernels are based on the approach used by Chromium zlib,
+  CRC-32 kernel implements PCLMULQDQ folding as described in Intel's
+  "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcCompressionLib.h>
+
+#include "ChecksumInternal.h"
+
+#if CHECKSUM_HAS_SIMD
+
+//
+// Intrinsic headers are not usable in freestanding firmware builds with
+// all toolchains, thus use vector extensions and builtins directly.
+//
+typedef char       V16QI __attribute__ ((vector_size (16)));
+typedef short      V8HI  __attribute__ ((vector_size (16)));
+typedef int        V4SI  __attribute__ ((vector_size (16)));
+typedef long long  V2DI  __attribute__ ((vector_size (16)));
+typedef unsigned   V4SU  __attribute__ ((vector_size (16)));
+typedef char       V32QI __attribute__ ((vector_size (32)));
+typedef short      V16HI __attribute__ ((vector_size (32)));
+typedef unsigned   V8SU  __attribute__ ((vector_size (32)));
+
+#define CHECKSUM_TARGET(x) __attribute__ ((target (x)))
+
+//
+// Bit-reflected CRC-32 folding constants and Barrett reduction constants.
+//
+#define CRC32_K1  0x0154442BD4ULL
+#define CRC32_K2  0x01C6E41596ULL
+#define CRC32_K3  0x01751997D0ULL
+#define CRC32_K4  0x00CCAA009EULL
+#define CRC32_K5  0x0163CD6124ULL
+#define CRC32_P   0x01DB710641ULL
+#define CRC32_U   0x01F7011641ULL
+
+CHECKSUM_TARGET ("ssse3")
+UINT32
+InternalAdler32Ssse3 (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  CONST V16QI  Tap1 = {32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17};
+  CONST V16QI  Tap2 = {16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1};
+  CONST V16QI  Zero = {0};
+  CONST V8HI   Ones = {1, 1, 1, 1, 1, 1, 1, 1};
+  V16QI        Bytes1;
+  V16QI        Bytes2;
+  V4SU         PrevSum;
+  V4SU         Sum1;
+  V4SU         Sum2;
+  UINT32       S1;
+  UINT32       S2;
+  UINTN        Blocks;
+  UINT32       Count;
+
+  S1     = Adler & 0xFFFFU;
+  S2     = Adler >> 16U;
+  Blocks = BufferLen / ADLER32_SIMD_BLOCK_SIZE;
+
+  while (Blocks > 0) {
+    //
+    // At most ADLER32_NMAX bytes can be summed before S2 must be reduced.
+    //
+    Count   = (UINT32) MIN (Blocks, ADLER32_NMAX / ADLER32_SIMD_BLOCK_SIZE);
+    Blocks -= Count;
+
+    PrevSum = (V4SU) {S1 * Count, 0, 0, 0};
+    Sum2    = (V4SU) {S2, 0, 0, 0};
+    Sum1    = (V4SU) {0, 0, 0, 0};
+
+    do {
+      __builtin_memcpy (&Bytes1, Buffer, sizeof (Bytes1));
+      __builtin_memcpy (&Bytes2, Buffer + sizeof (Bytes1), sizeof (Bytes2));
+
+      //
+      // Every byte summed in the previous blocks contributes to S2 once per
+      // byte of this block.
+      //
+      PrevSum += Sum1;
+
+      //
+      // Horizontal byte sums for S1, byte sums weighted by [32, 31, ... 1] for S2.
+      //
+      Sum1 += (V4SU) __builtin_ia32_psadbw128 (Bytes1, Zero);
+      Sum2 += (V4SU) __builtin_ia32_pmaddwd128 (__builtin_ia32_pmaddubsw128 (Bytes1, Tap1), Ones);
+      Sum1 += (V4SU) __builtin_ia32_psadbw128 (Bytes2, Zero);
+      Sum2 += (V4SU) __builtin_ia32_pmaddwd128 (__builtin_ia32_pmaddubsw128 (Bytes2, Tap2), Ones);
+
+      Buffer += ADLER32_SIMD_BLOCK_SIZE;
+    } while (--Count > 0);
+
+    Sum2 += PrevSum << 5;
+
+    //
+    // psadbw produces 64-bit sums, upper halves are always zero.
+    //
+    S1 += Sum1[0] + Sum1[2];
+    S2  = Sum2[0] + Sum2[1] + Sum2[2] + Sum2[3];
+
+    S1 %= ADLER32_BASE;
+    S2 %= ADLER32_BASE;
+  }
+
+  return S1 | (S2 << 16U);
+}
+
+CHECKSUM_TARGET ("avx2")
+UINT32
+InternalAdler32Avx2 (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  CONST V32QI  Tap  = {
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+    16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1
+  };
+  CONST V32QI  Zero = {0};
+  CONST V16HI  Ones = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+  V32QI        Bytes;
+  V8SU         PrevSum;
+  V8SU         Sum1;
+  V8SU         Sum2;
+  UINT32       S1;
+  UINT32       S2;
+  UINTN        Blocks;
+  UINT32       Count;
+
+  S1     = Adler & 0xFFFFU;
+  S2     = Adler >> 16U;
+  Blocks = BufferLen / ADLER32_SIMD_BLOCK_SIZE;
+
+  while (Blocks > 0) {
+    Count   = (UINT32) MIN (Blocks, ADLER32_NMAX / ADLER32_SIMD_BLOCK_SIZE);
+    Blocks -= Count;
+
+    PrevSum = (V8SU) {S1 * Count, 0, 0, 0, 0, 0, 0, 0};
+    Sum2    = (V8SU) {S2, 0, 0, 0, 0, 0, 0, 0};
+    Sum1    = (V8SU) {0, 0, 0, 0, 0, 0, 0, 0};
+
+    do {
+      __builtin_memcpy (&Bytes, Buffer, sizeof (Bytes));
+
+      PrevSum += Sum1;
+      Sum1    += (V8SU) __builtin_ia32_psadbw256 (Bytes, Zero);
+      Sum2    += (V8SU) __builtin_ia32_pmaddwd256 (__builtin_ia32_pmaddubsw256 (Bytes, Tap), Ones);
+
+      Buffer += ADLER32_SIMD_BLOCK_SIZE;
+    } while (--Count > 0);
+
+    Sum2 += PrevSum << 5;
+
+    S1 += Sum1[0] + Sum1[2] + Sum1[4] + Sum1[6];
+    S2  = Sum2[0] + Sum2[1] + Sum2[2] + Sum2[3]
+      + Sum2[4] + Sum2[5] + Sum2[6] + Sum2[7];
+
+    S1 %= ADLER32_BASE;
+    S2 %= ADLER32_BASE;
+  }
+
+  return S1 | (S2 << 16U);
+}
+
+CHECKSUM_TARGET ("sse2,pclmul")
+UINT32
+InternalCrc32Pclmul (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferLen
+  )
+{
+  CONST V2DI  K1K2 = {(INT64) CRC32_K1, (INT64) CRC32_K2};
+  CONST V2DI  K3K4 = {(INT64) CRC32_K3, (INT64) CRC32_K4};
+  CONST V2DI  K5K0 = {(INT64) CRC32_K5, 0};
+  CONST V2DI  Poly = {(INT64) CRC32_P, (INT64) CRC32_U};
+  CONST V2DI  Mask = (V2DI) (V4SI) {-1, 0, -1, 0};
+  V2DI        X1;
+  V2DI        X2;
+  V2DI        X3;
+  V2DI        X4;
+  V2DI        Y1;
+  V2DI        Y2;
+  V2DI        Y3;
+  V2DI        Y4;
+  V2DI        T;
+  V4SI        W;
+
+  ASSERT (BufferLen >= CHECKSUM_SIMD_MIN_LENGTH);
+  ASSERT (BufferLen % CRC32_SIMD_BLOCK_SIZE == 0);
+
+  __builtin_memcpy (&X1, Buffer + 0x00, sizeof (X1));
+  __builtin_memcpy (&X2, Buffer + 0x10, sizeof (X2));
+  __builtin_memcpy (&X3, Buffer + 0x20, sizeof (X3));
+  __builtin_memcpy (&X4, Buffer + 0x30, sizeof (X4));
+
+  X1 ^= (V2DI) (V4SI) {(INT32) Crc, 0, 0, 0};
+
+  Buffer    += 64;
+  BufferLen -= 64;
+
+  //
+  // Fold 4 x 128 bits in parallel.
+  //
+  while (BufferLen >= 64) {
+    __builtin_memcpy (&Y1, Buffer + 0x00, sizeof (Y1));
+    __builtin_memcpy (&Y2, Buffer + 0x10, sizeof (Y2));
+    __builtin_memcpy (&Y3, Buffer + 0x20, sizeof (Y3));
+    __builtin_memcpy (&Y4, Buffer + 0x30, sizeof (Y4));
+
+    X1 = __builtin_ia32_pclmulqdq128 (X1, K1K2, 0x00) ^ __builtin_ia32_pclmulqdq128 (X1, K1K2, 0x11) ^ Y1;
+    X2 = __builtin_ia32_pclmulqdq128 (X2, K1K2, 0x00) ^ __builtin_ia32_pclmulqdq128 (X2, K1K2, 0x11) ^ Y2;
+    X3 = __builtin_ia32_pclmulqdq128 (X3, K1K2, 0x00) ^ __builtin_ia32_pclmulqdq128 (X3, K1K2, 0x11) ^ Y3;
+    X4 = __builtin_ia32_pclmulqdq128 (X4, K1K2, 0x00) ^ __builtin_ia32_pclmulqdq128 (X4, K1K2, 0x11) ^ Y4;
+
+    Buffer    += 64;
+    BufferLen -= 64;
+  }
+
+  //
+  // Fold into 128 bits.
+  //
+  X1 = __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x00) ^ __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x11) ^ X2;
+  X1 = __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x00) ^ __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x11) ^ X3;
+  X1 = __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x00) ^ __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x11) ^ X4;
+
+  //
+  // Fold remaining 128-bit blocks.
+  //
+  while (BufferLen >= 16) {
+    __builtin_memcpy (&Y1, Buffer, sizeof (Y1));
+    X1 = __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x00) ^ __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x11) ^ Y1;
+
+    Buffer    += 16;
+    BufferLen -= 16;
+  }
+
+  //
+  // Fold 128 bits to 64 bits.
+  //
+  T  = __builtin_ia32_pclmulqdq128 (X1, K3K4, 0x10);
+  X1 = (V2DI) {X1[1], 0} ^ T;
+
+  W  = (V4SI) X1;
+  T  = (V2DI) (V4SI) {W[1], W[2], W[3], 0};
+  X1 = __builtin_ia32_pclmulqdq128 (X1 & Mask, K5K0, 0x00) ^ T;
+
+  //
+  // Barrett reduction to 32 bits.
+  //
+  T  = __builtin_ia32_pclmulqdq128 (X1 & Mask, Poly, 0x10);
+  T  = __builtin_ia32_pclmulqdq128 (T & Mask, Poly, 0x00);
+  X1 ^= T;
+
+  W = (V4SI) X1;
+  return (UINT32) W[1];
+}
+
+#endif // CHECKSUM_HAS_SIMD
@@ -76,32 +76,64 @@ typedef struct {
 
 } lzvn_decoder_state;
 
+/*! @abstract Fixed-size unaligned copy. In UEFI builds memcpy is an
+ *  out-of-line CopyMem call, so prefer the builtin, which the compiler
+ *  expands into plain loads and stores. */
+#if defined(__GNUC__) || defined(__clang__)
+#  define lzvn_copy_fixed(dst, src, size) __builtin_memcpy((dst), (src), (size))
+#else
+#  define lzvn_copy_fixed(dst, src, size) memcpy((dst), (src), (size))
+#endif
+
 /*! @abstract Load bytes from memory location SRC. */
 LZFSE_INLINE uint16_t load2(const void *ptr) {
   uint16_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_copy_fixed(&data, ptr, sizeof data);
   return data;
 }
 
 LZFSE_INLINE uint32_t load4(const void *ptr) {
   uint32_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_copy_fixed(&data, ptr, sizeof data);
   return data;
 }
 
 LZFSE_INLINE uint64_t load8(const void *ptr) {
   uint64_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_copy_fixed(&data, ptr, sizeof data);
   return data;
 }
 
 /*! @abstract Store bytes to memory location DST. */
 LZFSE_INLINE void store4(void *ptr, uint32_t data) {
-  memcpy(ptr, &data, sizeof data);
+  lzvn_copy_fixed(ptr, &data, sizeof data);
 }
 
 LZFSE_INLINE void store8(void *ptr, uint64_t data) {
-  memcpy(ptr, &data, sizeof data);
+  lzvn_copy_fixed(ptr, &data, sizeof data);
+}
+
+/*! @abstract Copy 16 bytes from SRC to DST. All loads are issued before the
+ *  stores, so the copy is exact as long as DST >= SRC + 16 or the ranges do
+ *  not overlap. */
+LZFSE_INLINE void copy16(unsigned char *dst, const unsigned char *src) {
+  uint64_t q0 = load8(src);
+  uint64_t q1 = load8(src + 8);
+  store8(dst, q0);
+  store8(dst + 8, q1);
+}
+
+/*! @abstract Copy 32 bytes from SRC to DST. Same overlap rules as copy16
+ *  apply with a distance of 32 bytes. */
+LZFSE_INLINE void copy32(unsigned char *dst, const unsigned char *src) {
+  uint64_t q0 = load8(src);
+  uint64_t q1 = load8(src + 8);
+  uint64_t q2 = load8(src + 16);
+  uint64_t q3 = load8(src + 24);
+  store8(dst, q0);
+  store8(dst + 8, q1);
+  store8(dst + 16, q2);
+  store8(dst + 24, q3);
 }
 
 /*! @abstract Extracts \p width bits from \p container, starting with \p lsb; if
@@ -614,6 +646,10 @@ sml_m:
   opc_len = 1;
   if (src_len <= opc_len)
     return; // source truncated
+  //  There may be no previous match to take the distance from. Copying with
+  //  zero distance would expose uninitialised destination bytes.
+  if (D == 0)
+    goto invalid_match_distance;
   M = (size_t)extract(opc, 0, 4);
   PTR_LEN_INC(src_ptr, src_len, opc_len);
   goto copy_match;
@@ -632,6 +668,8 @@ lrg_m:
   opc_len = 2;
   if (src_len <= opc_len)
     return; // source truncated
+  if (D == 0)
+    goto invalid_match_distance;
   M = src_ptr[1] + 16;
   PTR_LEN_INC(src_ptr, src_len, opc_len);
   goto copy_match;
@@ -817,8 +855,163 @@ invalid_match_distance:
 #endif
 }
 
-size_t lzvn_decode_buffer(unsigned char *dst, size_t dst_size,
-                          const unsigned char *src, size_t src_size) {
+/*! @abstract Number of bytes the fast path may read past the end of a
+ *  literal or write past the end of a literal or match. Every instruction
+ *  handled by lzvn_decode_fast requires this much room in both buffers. */
+#define LZVN_FAST_SLACK 32
+
+/*! @abstract Decode source to destination using wide copies.
+ *  Only decodes instructions that are fully contained in the buffers with
+ *  at least LZVN_FAST_SLACK bytes to spare and stops at the first one that
+ *  is not, leaving \p state (src,dst,d_prev) at the start of the preceding
+ *  instruction. End-of-stream,
+ *  invalid instructions, buffer edges and partial matches are left to
+ *  lzvn_decode, which must be called afterwards. */
+static void lzvn_decode_fast(lzvn_decoder_state *state) {
+  const unsigned char *src_ptr = state->src;
+  unsigned char *dst_ptr = state->dst;
+  size_t src_len = state->src_end - state->src;
+  size_t dst_len = state->dst_end - state->dst;
+  size_t D = state->d_prev;
+  size_t L;
+  size_t M;
+  size_t opc_len;
+  size_t i;
+  unsigned char opc;
+  const unsigned char *prev_src = src_ptr;
+  unsigned char *prev_dst = dst_ptr;
+  size_t prev_D = D;
+
+  //  Resuming from a partially expanded match is not supported.
+  if (state->L != 0 || state->M != 0)
+    return;
+
+  for (;;) {
+    //  On errors the reference decoder reports the start of the last
+    //  instruction it began, not the failing one. Keep the state one
+    //  instruction behind, so that lzvn_decode replays the last decoded
+    //  instruction and stops at exactly the same position.
+    state->src = prev_src;
+    state->dst = prev_dst;
+    state->d_prev = prev_D;
+    prev_src = src_ptr;
+    prev_dst = dst_ptr;
+    prev_D = D;
+
+    //  The longest opcode header (lrg_l, lrg_m, med_d, lrg_d) is 3 bytes,
+    //  and it must be followed by at least one more byte.
+    if (src_len < LZVN_FAST_SLACK)
+      return;
+
+    opc = src_ptr[0];
+    if (opc >= 0xE0) {
+      if (opc < 0xF0) {
+        //  sml_l (1110LLLL) and lrg_l (11100000 LLLLLLLL).
+        if (opc == 0xE0) {
+          opc_len = 2;
+          L = (size_t)src_ptr[1] + 16;
+        } else {
+          opc_len = 1;
+          L = (size_t)extract(opc, 0, 4);
+        }
+        if (src_len < opc_len + L + LZVN_FAST_SLACK
+          || dst_len < L + LZVN_FAST_SLACK)
+          return;
+        PTR_LEN_INC(src_ptr, src_len, opc_len);
+        copy16(dst_ptr, src_ptr);
+        for (i = 16; i < L; i += 32)
+          copy32(&dst_ptr[i], &src_ptr[i]);
+        PTR_LEN_INC(dst_ptr, dst_len, L);
+        PTR_LEN_INC(src_ptr, src_len, L);
+        continue;
+      }
+
+      //  sml_m (1111MMMM) and lrg_m (11110000 MMMMMMMM), previous distance.
+      if (opc == 0xF0) {
+        opc_len = 2;
+        M = (size_t)src_ptr[1] + 16;
+      } else {
+        opc_len = 1;
+        M = (size_t)extract(opc, 0, 4);
+      }
+      L = 0;
+    } else if (opc >= 0xA0 && opc < 0xC0) {
+      //  med_d: 101LLMMM DDDDDDMM DDDDDDDD LITERAL.
+      uint16_t opc23 = load2(&src_ptr[1]);
+      opc_len = 3;
+      L = (size_t)extract(opc, 3, 2);
+      M = (size_t)((extract(opc, 0, 3) << 2 | extract(opc23, 0, 2)) + 3);
+      D = (size_t)extract(opc23, 2, 14);
+    } else if ((opc & 0xF0) == 0x70 || (opc & 0xF0) == 0xD0) {
+      //  udef, reported by the reference decoder.
+      return;
+    } else if ((opc & 7) == 7) {
+      //  lrg_d: LLMMM111 DDDDDDDD DDDDDDDD LITERAL.
+      opc_len = 3;
+      L = (size_t)extract(opc, 6, 2);
+      M = (size_t)extract(opc, 3, 3) + 3;
+      D = load2(&src_ptr[1]);
+    } else if ((opc & 7) == 6) {
+      if (opc == 14 || opc == 22) {
+        //  nop.
+        PTR_LEN_INC(src_ptr, src_len, 1);
+        continue;
+      }
+      //  eos and udef are handled by the reference decoder.
+      if (opc < 0x40)
+        return;
+      //  pre_d: LLMMM110 LITERAL, previous distance.
+      opc_len = 1;
+      L = (size_t)extract(opc, 6, 2);
+      M = (size_t)extract(opc, 3, 3) + 3;
+    } else {
+      //  sml_d: LLMMMDDD DDDDDDDD LITERAL.
+      opc_len = 2;
+      L = (size_t)extract(opc, 6, 2);
+      M = (size_t)extract(opc, 3, 3) + 3;
+      D = (size_t)extract(opc, 0, 3) << 8 | src_ptr[1];
+    }
+
+    //  Literals of opcodes with a match are at most 3 bytes, thus the source
+    //  check above already covers them. Matches are at most 271 bytes.
+    if (dst_len < L + M + LZVN_FAST_SLACK
+      || D > (size_t)(dst_ptr - state->dst_begin) + L || D == 0)
+      return;
+
+    PTR_LEN_INC(src_ptr, src_len, opc_len);
+    if (L != 0) {
+      copy16(dst_ptr, src_ptr);
+      PTR_LEN_INC(dst_ptr, dst_len, L);
+      PTR_LEN_INC(src_ptr, src_len, L);
+    }
+
+    //  Match copy, see copy_match in lzvn_decode for the overlap semantics.
+    //  Wide copies are only exact when the distance is at least their width.
+    if (D >= 32) {
+      for (i = 0; i < M; i += 32)
+        copy32(&dst_ptr[i], dst_ptr + i - D);
+    } else if (D >= 16) {
+      for (i = 0; i < M; i += 16)
+        copy16(&dst_ptr[i], dst_ptr + i - D);
+    } else if (D >= 8) {
+      for (i = 0; i < M; i += 8)
+        store8(&dst_ptr[i], load8(dst_ptr + i - D));
+    } else if (D == 1) {
+      uint64_t splat = dst_ptr[-1] * 0x0101010101010101ULL;
+      for (i = 0; i < M; i += 8)
+        store8(&dst_ptr[i], splat);
+    } else {
+      for (i = 0; i < M; ++i)
+        dst_ptr[i] = *(dst_ptr + i - D);
+    }
+    PTR_LEN_INC(dst_ptr, dst_len, M);
+  }
+}
+
+/*! @abstract Decode buffer, optionally trying the fast path first. */
+static size_t lzvn_decode_buffer_common(unsigned char *dst, size_t dst_size,
+                                        const unsigned char *src,
+                                        size_t src_size, int use_fast) {
   // Init LZVN decoder state
   lzvn_decoder_state dstate;
 
@@ -837,9 +1030,23 @@ size_t lzvn_decode_buffer(unsigned char *dst, size_t dst_size,
   dstate.d_prev = 0;
   dstate.end_of_stream = 0;
 
-  // Run LZVN decoder
+  // Run LZVN decoder, using the fast path for the bulk of the stream and
+  // the reference state machine for the buffer edges.
+  if (use_fast)
+    lzvn_decode_fast(&dstate);
   lzvn_decode(&dstate);
 
   // This is how much we decompressed
   return dstate.dst - dst;
 }
+
+size_t lzvn_decode_buffer(unsigned char *dst, size_t dst_size,
+                          const unsigned char *src, size_t src_size) {
+  return lzvn_decode_buffer_common(dst, dst_size, src, src_size, 1);
+}
+
+size_t lzvn_decode_buffer_reference(unsigned char *dst, size_t dst_size,
+                                    const unsigned char *src,
+                                    size_t src_size) {
+  return lzvn_decode_buffer_common(dst, dst_size, src, src_size, 0);
+}
@@ -58,4 +58,24 @@ typedef UINTN uintmax_t;
 
 #endif
 
+/**
+  Decompress buffer with LZVN algorithm without the wide-copy fast path.
+  Produces the same results as DecompressLZVN and is only meant for
+  differential testing and benchmarking.
+
+  @param[out]  dst         Destination buffer.
+  @param[in]   dst_size    Destination buffer size.
+  @param[in]   src         Source buffer.
+  @param[in]   src_size    Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+size_t
+lzvn_decode_buffer_reference (
+  unsigned char        *dst,
+  size_t               dst_size,
+  const unsigned char  *src,
+  size_t               src_size
+  );
+
 #endif /* LZVN_H */
@@ -7,6 +7,11 @@
 
 #include "zutil.h"
 
+//
+// EDIT (vit9696): Use SIMD kernels for the bulk of the data when available.
+//
+#include "../ChecksumInternal.h"
+
 local uLong adler32_combine_ OF((uLong adler1, uLong adler2, z_off64_t len2));
 
 #define BASE 65521U     /* largest prime smaller than 65536 */
@@ -67,6 +72,17 @@ uLong ZEXPORT adler32_z(adler, buf, len)
 {
     unsigned long sum2;
     unsigned n;
+    UINT32 simd_adler;
+    z_size_t simd_len;
+
+    /* process whole SIMD blocks first, leaving the tail to the code below */
+    if (buf != Z_NULL && len >= CHECKSUM_SIMD_MIN_LENGTH) {
+        simd_adler = (UINT32)adler;
+        simd_len = InternalAdler32Simd(&simd_adler, buf, len);
+        adler = simd_adler;
+        buf += simd_len;
+        len -= simd_len;
+    }
 
     /* split Adler-32 into component sums */
     sum2 = (adler >> 16) & 0xffff;
@@ -29,6 +29,11 @@
 
 #include "zutil.h"      /* for Z_U4, Z_U8, z_crc_t, and FAR definitions */
 
+//
+// EDIT (vit9696): Use PCLMULQDQ folding for the bulk of the data when available.
+//
+#include "../ChecksumInternal.h"
+
  /*
   A CRC of a message is computed on N braids of words in the message, where
   each word consists of W bytes (4 or 8). If N is 3, for example, then three
@@ -749,6 +754,18 @@ unsigned long ZEXPORT crc32_z(crc, buf, len)
     /* Pre-condition the CRC */
     crc ^= 0xffffffff;
 
+    /* Process whole SIMD blocks first, leaving the tail to the code below. */
+    if (len >= CHECKSUM_SIMD_MIN_LENGTH) {
+        UINT32 simd_crc;
+        z_size_t simd_len;
+
+        simd_crc = (UINT32)crc;
+        simd_len = InternalCrc32Simd(&simd_crc, buf, len);
+        crc = simd_crc;
+        buf += simd_len;
+        len -= simd_len;
+    }
+
 #ifdef W
 
     /* If provided enough bytes, do a braided CRC calculation. */
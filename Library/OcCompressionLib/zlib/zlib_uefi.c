@@ -75,12 +75,3 @@ DecompressZLIB (
 
   return 0;
 }
-
-UINT32
-Adler32 (
-  IN CONST UINT8  *Buffer,
-  IN UINT32       BufferLen
-  )
-{
-  return adler32 (1, Buffer, BufferLen);
-}
@@ -118,6 +118,8 @@ mAcpiDeleteSchema = OC_SCHEMA_DICT (NULL, mAcpiDeleteSchemaEntry);
 STATIC
 OC_SCHEMA
 mAcpiPatchSchemaEntry[] = {
+  OC_SCHEMA_STRING_IN    ("Base",           OC_ACPI_PATCH_ENTRY, Base),
+  OC_SCHEMA_INTEGER_IN   ("BaseSkip",       OC_ACPI_PATCH_ENTRY, BaseSkip),
   OC_SCHEMA_STRING_IN    ("Comment",        OC_ACPI_PATCH_ENTRY, Comment),
   OC_SCHEMA_INTEGER_IN   ("Count",          OC_ACPI_PATCH_ENTRY, Count),
   OC_SCHEMA_BOOLEAN_IN   ("Enabled",        OC_ACPI_PATCH_ENTRY, Enabled),
@@ -366,6 +368,7 @@ mKernelQuirksSchema[] = {
 STATIC
 OC_SCHEMA
 mKernelSchemeSchema[] = {
+  OC_SCHEMA_BOOLEAN_IN ("CachelessIndex",     OC_GLOBAL_CONFIG, Kernel.Scheme.CachelessIndex),
   OC_SCHEMA_BOOLEAN_IN ("FuzzyMatch",         OC_GLOBAL_CONFIG, Kernel.Scheme.FuzzyMatch),
   OC_SCHEMA_STRING_IN  ("KernelArch",         OC_GLOBAL_CONFIG, Kernel.Scheme.KernelArch),
   OC_SCHEMA_STRING_IN  ("KernelCache",        OC_GLOBAL_CONFIG, Kernel.Scheme.KernelCache),
@@ -404,6 +407,7 @@ mMiscConfigurationBootSchema[] = {
   OC_SCHEMA_STRING_IN  ("PickerMode",          OC_GLOBAL_CONFIG, Misc.Boot.PickerMode),
   OC_SCHEMA_STRING_IN  ("PickerVariant",       OC_GLOBAL_CONFIG, Misc.Boot.PickerVariant),
   OC_SCHEMA_BOOLEAN_IN ("PollAppleHotKeys",    OC_GLOBAL_CONFIG, Misc.Boot.PollAppleHotKeys),
+  OC_SCHEMA_BOOLEAN_IN ("ScanCache",           OC_GLOBAL_CONFIG, Misc.Boot.ScanCache),
   OC_SCHEMA_BOOLEAN_IN ("ShowPicker",          OC_GLOBAL_CONFIG, Misc.Boot.ShowPicker),
   OC_SCHEMA_INTEGER_IN ("TakeoffDelay",        OC_GLOBAL_CONFIG, Misc.Boot.TakeoffDelay),
   OC_SCHEMA_INTEGER_IN ("Timeout",             OC_GLOBAL_CONFIG, Misc.Boot.Timeout),
@@ -414,6 +418,7 @@ OC_SCHEMA
 mMiscConfigurationDebugSchema[] = {
   OC_SCHEMA_BOOLEAN_IN ("AppleDebug",       OC_GLOBAL_CONFIG, Misc.Debug.AppleDebug),
   OC_SCHEMA_BOOLEAN_IN ("ApplePanic",       OC_GLOBAL_CONFIG, Misc.Debug.ApplePanic),
+  OC_SCHEMA_BOOLEAN_IN ("BootTrace",        OC_GLOBAL_CONFIG, Misc.Debug.BootTrace),
   OC_SCHEMA_BOOLEAN_IN ("DisableWatchDog",  OC_GLOBAL_CONFIG, Misc.Debug.DisableWatchDog),
   OC_SCHEMA_INTEGER_IN ("DisplayDelay",     OC_GLOBAL_CONFIG, Misc.Debug.DisplayDelay),
   OC_SCHEMA_INTEGER_IN ("DisplayLevel",     OC_GLOBAL_CONFIG, Misc.Debug.DisplayLevel),
@@ -438,7 +443,10 @@ mMiscConfigurationSecuritySchema[] = {
   OC_SCHEMA_DATA_IN    ("PasswordSalt",         OC_GLOBAL_CONFIG, Misc.Security.PasswordSalt),
   OC_SCHEMA_INTEGER_IN ("ScanPolicy",           OC_GLOBAL_CONFIG, Misc.Security.ScanPolicy),
   OC_SCHEMA_STRING_IN  ("SecureBootModel",      OC_GLOBAL_CONFIG, Misc.Security.SecureBootModel),
+  OC_SCHEMA_BOOLEAN_IN ("StorageCache",         OC_GLOBAL_CONFIG, Misc.Security.StorageCache),
   OC_SCHEMA_STRING_IN  ("Vault",                OC_GLOBAL_CONFIG, Misc.Security.Vault),
+  OC_SCHEMA_BOOLEAN_IN ("VaultPrefetch",        OC_GLOBAL_CONFIG, Misc.Security.VaultPrefetch),
+  OC_SCHEMA_BOOLEAN_IN ("VaultPreload",         OC_GLOBAL_CONFIG, Misc.Security.VaultPreload),
 };
 
 STATIC
@@ -171,6 +171,20 @@ STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION mForegroundColor;
 STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION *mCharacterBuffer;
 STATIC EFI_CONSOLE_CONTROL_SCREEN_MODE     mConsoleMode = EfiConsoleControlScreenText;
 
+///
+/// Shadow copy of the text area, flushed to the screen in dirty line spans.
+/// NULL when it could not be allocated or would exceed TGT_SHADOW_SIZE_MAX,
+/// in which case every character is drawn directly. Padding is not covered
+/// to leave graphics drawn around the text area intact.
+///
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION *mShadowBuffer;
+STATIC UINTN   mShadowWidth;  ///< Text area width in pixels.
+STATIC UINT32  *mDirtyLeft;   ///< Leftmost dirty column per row.
+STATIC UINT32  *mDirtyRight;  ///< Rightmost dirty column per row plus one.
+STATIC UINTN   mDirtyTop;     ///< Topmost dirty row.
+STATIC UINTN   mDirtyBottom;  ///< Bottommost dirty row plus one.
+STATIC BOOLEAN mShadowFullDirty;
+
 #define SCR_PADD           1
 #define TGT_CHAR_WIDTH     ((UINTN)(ISO_CHAR_WIDTH) * mFontScale)
 #define TGT_CHAR_HEIGHT    ((UINTN)(ISO_CHAR_HEIGHT) * mFontScale)
@@ -181,67 +195,328 @@ STATIC EFI_CONSOLE_CONTROL_SCREEN_MODE     mConsoleMode = EfiConsoleControlScree
 #define TGT_CURSOR_Y       ((TGT_CHAR_HEIGHT) - mFontScale)
 #define TGT_CURSOR_WIDTH   ((TGT_CHAR_WIDTH) - mFontScale*2)
 #define TGT_CURSOR_HEIGHT  (mFontScale)
+#define TGT_SHADOW_WIDTH   (mShadowWidth)
+#define TGT_SHADOW_HEIGHT  ((TGT_CHAR_HEIGHT) * mConsoleHeight)
+#define TGT_SHADOW_SIZE_MAX SIZE_16MB
+
+///
+/// Glyph 0 is blank, the rest follow ISO font order.
+///
+#define GLYPH_BLANK        0
+#define GLYPH_COUNT        (ISO_CHAR_MAX - ISO_CHAR_MIN + 2)
+#define GLYPH_CACHE_SLOTS  4
+
+///
+/// Glyphs expanded at current scale for one foreground/background pair.
+///
+typedef struct {
+  UINT32                               Foreground;
+  UINT32                               Background;
+  UINT32                               LastUse;
+  BOOLEAN                              Valid[GLYPH_COUNT];
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *Glyphs;
+} GLYPH_CACHE_SLOT;
+
+STATIC GLYPH_CACHE_SLOT  mGlyphCache[GLYPH_CACHE_SLOTS];
+STATIC GLYPH_CACHE_SLOT  *mGlyphSlot;
+STATIC UINT32            mGlyphCacheUse;
 
 /**
-  Render character onscreen.
+  Expand glyph at current scale and colours.
 
-  @param[in]  Char  Character code.
-  @param[in]  PosX  Character X position.
-  @param[in]  PosY  Character Y position.
+  @param[in]  Glyph      Glyph index.
+  @param[out] DstBuffer  Destination of TGT_CHAR_AREA pixels.
 **/
 STATIC
 VOID
-RenderChar (
-  IN CHAR16   Char,
-  IN UINTN    PosX,
-  IN UINTN    PosY
+ExpandGlyph (
+  IN  UINTN   Glyph,
+  OUT UINT32  *DstBuffer
   )
 {
-  UINT32  *DstBuffer;
   UINT8   *SrcBuffer;
   UINT32  Line;
   UINT32  Index;
   UINT32  Index2;
   UINT8   Mask;
 
-  DstBuffer = &mCharacterBuffer[0].Raw;
+  if (Glyph == GLYPH_BLANK) {
+    SetMem32 (DstBuffer, TGT_CHAR_AREA * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
+    return;
+  }
+
+  SrcBuffer = mIsoFontData + ((Glyph - 1) * (ISO_CHAR_HEIGHT - 2));
+
+  SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
+  DstBuffer += TGT_CHAR_WIDTH * mFontScale;
+
+  for (Line = 0; Line < ISO_CHAR_HEIGHT - 2; ++Line) {
+    //
+    // Iterate, while the single bit drops to the right.
+    //
+    for (Index = 0; Index < mFontScale; ++Index) {
+      Mask = 1;
+      do {
+        for (Index2 = 0; Index2 < mFontScale; ++Index2) {
+          *DstBuffer = (*SrcBuffer & Mask) ? mForegroundColor.Raw : mBackgroundColor.Raw;
+          ++DstBuffer;
+        }
+        Mask <<= 1U;
+      } while (Mask != 0);
+    }
+    ++SrcBuffer;
+  }
+
+  SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
+}
+
+/**
+  Select glyph cache slot for current colours, evicting the least recently
+  used one when needed.
+
+  @retval Glyph cache slot or NULL.
+**/
+STATIC
+GLYPH_CACHE_SLOT *
+SelectGlyphSlot (
+  VOID
+  )
+{
+  GLYPH_CACHE_SLOT  *Slot;
+  UINTN             Index;
+
+  if (mGlyphSlot != NULL
+    && mGlyphSlot->Foreground == mForegroundColor.Raw
+    && mGlyphSlot->Background == mBackgroundColor.Raw) {
+    return mGlyphSlot;
+  }
+
+  Slot = &mGlyphCache[0];
+  for (Index = 0; Index < GLYPH_CACHE_SLOTS; ++Index) {
+    if (mGlyphCache[Index].Glyphs != NULL
+      && mGlyphCache[Index].Foreground == mForegroundColor.Raw
+      && mGlyphCache[Index].Background == mBackgroundColor.Raw) {
+      Slot = &mGlyphCache[Index];
+      break;
+    }
+
+    if (mGlyphCache[Index].LastUse < Slot->LastUse) {
+      Slot = &mGlyphCache[Index];
+    }
+  }
+
+  if (Index == GLYPH_CACHE_SLOTS) {
+    if (Slot->Glyphs == NULL) {
+      Slot->Glyphs = AllocatePool (GLYPH_COUNT * TGT_CHAR_AREA * sizeof (Slot->Glyphs[0]));
+      if (Slot->Glyphs == NULL) {
+        return NULL;
+      }
+    }
+
+    Slot->Foreground = mForegroundColor.Raw;
+    Slot->Background = mBackgroundColor.Raw;
+    ZeroMem (Slot->Valid, sizeof (Slot->Valid));
+  }
+
+  Slot->LastUse = ++mGlyphCacheUse;
+  mGlyphSlot    = Slot;
+  return Slot;
+}
+
+/**
+  Get character glyph at current scale and colours.
+
+  @param[in]  Char  Character code.
+
+  @retval Glyph of TGT_CHAR_AREA pixels.
+**/
+STATIC
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION *
+GetGlyph (
+  IN CHAR16   Char
+  )
+{
+  GLYPH_CACHE_SLOT                     *Slot;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *Glyph;
+  UINTN                                GlyphIndex;
 
   if ((Char >= 0 && Char < ISO_CHAR_MIN) || Char == ' ' || Char == CHAR_TAB || Char == 0x7F) {
-    SetMem32 (DstBuffer, TGT_CHAR_AREA * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
+    GlyphIndex = GLYPH_BLANK;
   } else {
-
     if (Char < 0 || Char > ISO_CHAR_MAX) {
       Char = L'_';
     }
 
-    SrcBuffer = mIsoFontData + ((Char - ISO_CHAR_MIN) * (ISO_CHAR_HEIGHT - 2));
+    GlyphIndex = Char - ISO_CHAR_MIN + 1;
+  }
 
-    SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
-    DstBuffer += TGT_CHAR_WIDTH * mFontScale;
+  Slot = SelectGlyphSlot ();
+  if (Slot == NULL) {
+    ExpandGlyph (GlyphIndex, &mCharacterBuffer[0].Raw);
+    return mCharacterBuffer;
+  }
 
-    for (Line = 0; Line < ISO_CHAR_HEIGHT - 2; ++Line) {
-      //
-      // Iterate, while the single bit drops to the right.
-      //
-      for (Index = 0; Index < mFontScale; ++Index) {
-        Mask = 1;
-        do {
-          for (Index2 = 0; Index2 < mFontScale; ++Index2) {
-            *DstBuffer = (*SrcBuffer & Mask) ? mForegroundColor.Raw : mBackgroundColor.Raw;
-            ++DstBuffer;
-          }
-          Mask <<= 1U;
-        } while (Mask != 0);
+  Glyph = &Slot->Glyphs[GlyphIndex * TGT_CHAR_AREA];
+  if (!Slot->Valid[GlyphIndex]) {
+    ExpandGlyph (GlyphIndex, &Glyph[0].Raw);
+    Slot->Valid[GlyphIndex] = TRUE;
+  }
+
+  return Glyph;
+}
+
+/**
+  Mark shadow buffer character span dirty.
+
+  @param[in]  PosX   Character X position.
+  @param[in]  PosY   Character Y position.
+  @param[in]  Count  Number of characters.
+**/
+STATIC
+VOID
+MarkDirty (
+  IN UINTN    PosX,
+  IN UINTN    PosY,
+  IN UINTN    Count
+  )
+{
+  mDirtyLeft[PosY]  = (UINT32) MIN (mDirtyLeft[PosY], PosX);
+  mDirtyRight[PosY] = (UINT32) MAX (mDirtyRight[PosY], PosX + Count);
+  mDirtyTop         = MIN (mDirtyTop, PosY);
+  mDirtyBottom      = MAX (mDirtyBottom, PosY + 1);
+}
+
+/**
+  Reset shadow buffer dirty state.
+**/
+STATIC
+VOID
+ResetDirty (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mConsoleHeight; ++Index) {
+    mDirtyLeft[Index]  = (UINT32) mConsoleWidth;
+    mDirtyRight[Index] = 0;
+  }
+
+  mDirtyTop        = mConsoleHeight;
+  mDirtyBottom     = 0;
+  mShadowFullDirty = FALSE;
+}
+
+/**
+  Flush dirty shadow buffer areas onscreen, one BLT per dirty line span,
+  or a single BLT when the whole area changed.
+**/
+STATIC
+VOID
+RenderFlush (
+  VOID
+  )
+{
+  UINTN  Row;
+
+  if (mShadowBuffer == NULL) {
+    return;
+  }
+
+  if (mShadowFullDirty) {
+    mGraphicsOutput->Blt (
+      mGraphicsOutput,
+      &mShadowBuffer[0].Pixel,
+      EfiBltBufferToVideo,
+      0,
+      0,
+      TGT_PADD_WIDTH,
+      TGT_PADD_HEIGHT,
+      TGT_SHADOW_WIDTH,
+      TGT_SHADOW_HEIGHT,
+      TGT_SHADOW_WIDTH * sizeof (mShadowBuffer[0])
+      );
+  } else {
+    for (Row = mDirtyTop; Row < mDirtyBottom; ++Row) {
+      if (mDirtyLeft[Row] >= mDirtyRight[Row]) {
+        continue;
       }
-      ++SrcBuffer;
+
+      mGraphicsOutput->Blt (
+        mGraphicsOutput,
+        &mShadowBuffer[0].Pixel,
+        EfiBltBufferToVideo,
+        mDirtyLeft[Row] * TGT_CHAR_WIDTH,
+        Row * TGT_CHAR_HEIGHT,
+        TGT_PADD_WIDTH  + mDirtyLeft[Row] * TGT_CHAR_WIDTH,
+        TGT_PADD_HEIGHT + Row * TGT_CHAR_HEIGHT,
+        (mDirtyRight[Row] - mDirtyLeft[Row]) * TGT_CHAR_WIDTH,
+        TGT_CHAR_HEIGHT,
+        TGT_SHADOW_WIDTH * sizeof (mShadowBuffer[0])
+        );
+    }
+  }
+
+  ResetDirty ();
+}
+
+/**
+  Erase shadow buffer contents without flushing.
+**/
+STATIC
+VOID
+ClearShadow (
+  VOID
+  )
+{
+  if (mShadowBuffer == NULL) {
+    return;
+  }
+
+  SetMem32 (
+    mShadowBuffer,
+    TGT_SHADOW_WIDTH * TGT_SHADOW_HEIGHT * sizeof (mShadowBuffer[0]),
+    mBackgroundColor.Raw
+    );
+  ResetDirty ();
+}
+
+/**
+  Render character onscreen.
+
+  @param[in]  Char  Character code.
+  @param[in]  PosX  Character X position.
+  @param[in]  PosY  Character Y position.
+**/
+STATIC
+VOID
+RenderChar (
+  IN CHAR16   Char,
+  IN UINTN    PosX,
+  IN UINTN    PosY
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *Glyph;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *Dst;
+  UINTN                                Line;
+
+  Glyph = GetGlyph (Char);
+
+  if (mShadowBuffer != NULL) {
+    Dst = &mShadowBuffer[PosY * TGT_CHAR_HEIGHT * TGT_SHADOW_WIDTH + PosX * TGT_CHAR_WIDTH];
+    for (Line = 0; Line < TGT_CHAR_HEIGHT; ++Line) {
+      CopyMem (Dst, Glyph, TGT_CHAR_WIDTH * sizeof (Dst[0]));
+      Dst   += TGT_SHADOW_WIDTH;
+      Glyph += TGT_CHAR_WIDTH;
     }
 
-    SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
+    MarkDirty (PosX, PosY, 1);
+    return;
   }
 
   mGraphicsOutput->Blt (
     mGraphicsOutput,
-    &mCharacterBuffer[0].Pixel,
+    &Glyph[0].Pixel,
     EfiBltBufferToVideo,
     0,
     0,
@@ -270,6 +545,8 @@ FlushCursor (
 {
   EFI_STATUS                           Status;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  Colour;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *Dst;
+  UINTN                                Line;
 
   if (!Enabled) {
     return;
@@ -285,6 +562,21 @@ FlushCursor (
   // This is weird but EDK II implementation seems to match the logic, and as a result we
   // track cursor visibility or easily optimise this logic.
   //
+  if (mShadowBuffer != NULL) {
+    Dst = &mShadowBuffer[
+      (PosY * TGT_CHAR_HEIGHT + TGT_CURSOR_Y) * TGT_SHADOW_WIDTH
+      + PosX * TGT_CHAR_WIDTH + TGT_CURSOR_X
+      ];
+    Colour.Raw = Dst->Raw == mForegroundColor.Raw ? mBackgroundColor.Raw : mForegroundColor.Raw;
+    for (Line = 0; Line < TGT_CURSOR_HEIGHT; ++Line) {
+      SetMem32 (Dst, TGT_CURSOR_WIDTH * sizeof (Dst[0]), Colour.Raw);
+      Dst += TGT_SHADOW_WIDTH;
+    }
+
+    MarkDirty (PosX, PosY, 1);
+    return;
+  }
+
   Status = mGraphicsOutput->Blt (
     mGraphicsOutput,
     &Colour.Pixel,
@@ -322,6 +614,24 @@ RenderScroll (
   VOID
   )
 {
+  //
+  // Scroll in shadow buffer, the whole area is flushed at once afterwards.
+  //
+  if (mShadowBuffer != NULL) {
+    CopyMem (
+      mShadowBuffer,
+      &mShadowBuffer[TGT_CHAR_HEIGHT * TGT_SHADOW_WIDTH],
+      TGT_CHAR_HEIGHT * (mConsoleHeight - 1) * TGT_SHADOW_WIDTH * sizeof (mShadowBuffer[0])
+      );
+    SetMem32 (
+      &mShadowBuffer[TGT_CHAR_HEIGHT * (mConsoleHeight - 1) * TGT_SHADOW_WIDTH],
+      TGT_CHAR_HEIGHT * TGT_SHADOW_WIDTH * sizeof (mShadowBuffer[0]),
+      mBackgroundColor.Raw
+      );
+    mShadowFullDirty = TRUE;
+    return;
+  }
+
   //
   // Move data.
   //
@@ -384,6 +694,46 @@ RenderResync (
   mConsoleHeight           = (Info->VerticalResolution   / TGT_CHAR_HEIGHT) - 2 * SCR_PADD;
   mConsoleMaxPosX          = 0;
   mConsoleMaxPosY          = 0;
+  mShadowWidth             = mConsoleWidth * TGT_CHAR_WIDTH;
+
+  //
+  // Shadow buffer is optional, fall back to direct rendering without it.
+  //
+  if (mShadowBuffer != NULL) {
+    FreePool (mShadowBuffer);
+    FreePool (mDirtyLeft);
+    FreePool (mDirtyRight);
+  }
+
+  mShadowBuffer = NULL;
+  mDirtyLeft    = NULL;
+  mDirtyRight   = NULL;
+
+  //
+  // Large modes make the shadow buffer too expensive, draw directly there.
+  //
+  if (TGT_SHADOW_HEIGHT <= TGT_SHADOW_SIZE_MAX / (TGT_SHADOW_WIDTH * sizeof (mShadowBuffer[0]))) {
+    mShadowBuffer = AllocatePool (TGT_SHADOW_WIDTH * TGT_SHADOW_HEIGHT * sizeof (mShadowBuffer[0]));
+    mDirtyLeft    = AllocatePool (mConsoleHeight * sizeof (mDirtyLeft[0]));
+    mDirtyRight   = AllocatePool (mConsoleHeight * sizeof (mDirtyRight[0]));
+  }
+
+  if (mShadowBuffer == NULL || mDirtyLeft == NULL || mDirtyRight == NULL) {
+    if (mShadowBuffer != NULL) {
+      FreePool (mShadowBuffer);
+      mShadowBuffer = NULL;
+    }
+    if (mDirtyLeft != NULL) {
+      FreePool (mDirtyLeft);
+      mDirtyLeft = NULL;
+    }
+    if (mDirtyRight != NULL) {
+      FreePool (mDirtyRight);
+      mDirtyRight = NULL;
+    }
+  }
+
+  ClearShadow ();
 
   mPrivateColumn = mPrivateRow = 0;
   This->Mode->CursorColumn = This->Mode->CursorRow = 0;
@@ -568,6 +918,7 @@ AsciiTextOutputString (
   }
 
   FlushCursor (This->Mode->CursorVisible, This->Mode->CursorColumn, This->Mode->CursorRow);
+  RenderFlush ();
 
   mPrivateColumn = (UINTN) This->Mode->CursorColumn;
   mPrivateRow    = (UINTN) This->Mode->CursorRow;
@@ -705,6 +1056,7 @@ AsciiTextSetAttribute (
     This->Mode->Attribute = (UINT32) Attribute;
 
     FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+    RenderFlush ();
   }
 
   gBS->RestoreTPL (OldTpl);
@@ -741,6 +1093,8 @@ AsciiTextClearScreen (
   Width  = TGT_PADD_WIDTH  + (mConsoleMaxPosX + 1) * TGT_CHAR_WIDTH;
   Height = TGT_PADD_HEIGHT + (mConsoleMaxPosY + 1) * TGT_CHAR_HEIGHT;
 
+  ClearShadow ();
+
   mGraphicsOutput->Blt (
     mGraphicsOutput,
     &mBackgroundColor.Pixel,
@@ -760,6 +1114,7 @@ AsciiTextClearScreen (
   mPrivateColumn = mPrivateRow = 0;
   This->Mode->CursorColumn  = This->Mode->CursorRow = 0;
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+  RenderFlush ();
 
   //
   // We do not reset max here, as we may still scroll (e.g. in shell via page buttons).
@@ -798,6 +1153,7 @@ AsciiTextSetCursorPosition (
     This->Mode->CursorColumn = (INT32) mPrivateColumn;
     This->Mode->CursorRow    = (INT32) mPrivateRow;
     FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+    RenderFlush ();
     mConsoleMaxPosX = MAX (mConsoleMaxPosX, Column);
     mConsoleMaxPosY = MAX (mConsoleMaxPosY, Row);
     Status = EFI_SUCCESS;
@@ -833,6 +1189,7 @@ AsciiTextEnableCursor (
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
   This->Mode->CursorVisible = Visible;
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+  RenderFlush ();
   gBS->RestoreTPL (OldTpl);
   return EFI_SUCCESS;
 }
@@ -887,6 +1244,14 @@ ConsoleControlSetMode (
   IN EFI_CONSOLE_CONTROL_SCREEN_MODE  Mode
   )
 {
+  //
+  // Graphics mode users overwrite the screen, so the shadow buffer
+  // no longer matches it.
+  //
+  if (Mode != mConsoleMode && Mode == EfiConsoleControlScreenText) {
+    ClearShadow ();
+  }
+
   mConsoleMode = Mode;
   return EFI_SUCCESS;
 }
@@ -43,6 +43,18 @@ AsmReadIntelMicrocodeRevision (
   VOID
   );
 
+/**
+  Reads extended control register XCR0 via XGETBV.
+  Callers must ensure that CPUID reports OSXSAVE support.
+
+  @retval  XCR0 value.
+**/
+UINT64
+EFIAPI
+AsmReadXcr0 (
+  VOID
+  );
+
 /**
   Measures TSC and ACPI ticks over specified ACPI tick amount.
 
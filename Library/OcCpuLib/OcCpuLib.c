@@ -1091,3 +1091,69 @@ InternalDetectIntelProcessorGeneration (
 
   return CpuGeneration;
 }
+
+STATIC BOOLEAN  mSimdDetected;
+STATIC UINT32   mSimdFeatures;
+
+UINT32
+OcCpuGetSimdFeatures (
+  VOID
+  )
+{
+  UINT32                                       MaxLeaf;
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_VERSION_INFO_EDX                       VersionEdx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  UINT64                                       Xcr0;
+
+  if (mSimdDetected) {
+    return mSimdFeatures;
+  }
+
+  mSimdDetected = TRUE;
+  mSimdFeatures = 0;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_VERSION_INFO) {
+    return mSimdFeatures;
+  }
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &VersionEcx.Uint32, &VersionEdx.Uint32);
+
+  if (VersionEdx.Bits.SSE2 != 0) {
+    mSimdFeatures |= OC_CPU_SIMD_SSE2;
+  }
+
+  if (VersionEcx.Bits.SSSE3 != 0) {
+    mSimdFeatures |= OC_CPU_SIMD_SSSE3;
+  }
+
+  if (VersionEcx.Bits.PCLMULQDQ != 0) {
+    mSimdFeatures |= OC_CPU_SIMD_PCLMULQDQ;
+  }
+
+  //
+  // Firmware often leaves AVX state disabled, so in addition to CPU support
+  // both XMM (BIT1) and YMM (BIT2) state must be enabled in XCR0.
+  //
+  if (MaxLeaf >= CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS
+    && VersionEcx.Bits.OSXSAVE != 0
+    && VersionEcx.Bits.AVX != 0) {
+    Xcr0 = AsmReadXcr0 ();
+    if ((Xcr0 & (BIT1 | BIT2)) == (BIT1 | BIT2)) {
+      AsmCpuidEx (
+        CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+        CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+        NULL,
+        &ExtendedEbx.Uint32,
+        NULL,
+        NULL
+        );
+      if (ExtendedEbx.Bits.AVX2 != 0) {
+        mSimdFeatures |= OC_CPU_SIMD_AVX2;
+      }
+    }
+  }
+
+  return mSimdFeatures;
+}
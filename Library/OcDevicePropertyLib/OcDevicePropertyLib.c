@@ -43,12 +43,28 @@
     DEVICE_PATH_PROPERTY_DATA_SIGNATURE       \
     )
 
+//
+// Number of device path hash buckets, must be a power of two.
+//
+#define DEVICE_PATH_PROPERTY_NODE_BUCKETS  64
+
 // DEVICE_PATH_PROPERTY_DATABASE
 typedef struct {
   UINTN                                      Signature;
   LIST_ENTRY                                 Nodes;
   EFI_DEVICE_PATH_PROPERTY_DATABASE_PROTOCOL Protocol;
   BOOLEAN                                    Modified;
+  ///
+  /// Nodes by device path hash.
+  ///
+  LIST_ENTRY                                 NodeBuckets[DEVICE_PATH_PROPERTY_NODE_BUCKETS];
+  ///
+  /// Serialised database returned by GetPropertyBuffer, valid unless BufferDirty.
+  ///
+  EFI_DEVICE_PATH_PROPERTY_BUFFER            *Buffer;
+  UINTN                                      BufferSize;
+  UINTN                                      BufferAllocatedSize;
+  BOOLEAN                                    BufferDirty;
 } DEVICE_PATH_PROPERTY_DATA;
 
 #define APPLE_PATH_PROPERTIES_VARIABLE_NAME    L"AAPL,PathProperties"
@@ -68,8 +84,18 @@ typedef struct {
       )                                        \
     ))
 
+#define PROPERTY_NODE_FROM_HASH_LINK(Entry)    \
+  ((EFI_DEVICE_PATH_PROPERTY_NODE *)(          \
+    CR (                                       \
+      Entry,                                   \
+      EFI_DEVICE_PATH_PROPERTY_NODE_HDR,       \
+      HashLink,                                \
+      EFI_DEVICE_PATH_PROPERTY_NODE_SIGNATURE  \
+      )                                        \
+    ))
+
 #define EFI_DEVICE_PATH_PROPERTY_NODE_SIZE(Node)  \
-  (sizeof (EFI_DEVICE_PATH_PROPERTY_BUFFER_NODE_HDR) + GetDevicePathSize (&(Node)->DevicePath))
+  (sizeof (EFI_DEVICE_PATH_PROPERTY_BUFFER_NODE_HDR) + (Node)->Hdr.DevicePathSize)
 
 // EFI_DEVICE_PATH_PROPERTY_NODE_HDR
 typedef struct {
@@ -77,6 +103,9 @@ typedef struct {
   LIST_ENTRY Link;                ///<
   UINTN      NumberOfProperties;  ///<
   LIST_ENTRY Properties;          ///<
+  LIST_ENTRY HashLink;            ///< Link in device path hash bucket.
+  UINT32     Hash;                ///< Device path hash.
+  UINTN      DevicePathSize;      ///< Device path size.
 } EFI_DEVICE_PATH_PROPERTY_NODE_HDR;
 
 // DEVICE_PATH_PROPERTY_NODE
@@ -115,6 +144,7 @@ typedef struct {
   LIST_ENTRY                    Link;       ///<
   EFI_DEVICE_PATH_PROPERTY_DATA *Name;      ///<
   EFI_DEVICE_PATH_PROPERTY_DATA *Value;     ///<
+  UINT32                        NameHash;   ///< Name hash.
 } EFI_DEVICE_PATH_PROPERTY;
 
 // TODO: Move to own header
@@ -129,30 +159,65 @@ typedef struct {
 
 EFI_GUID mAppleThunderboltNativeHostInterfaceProtocolGuid = APPLE_THUNDERBOLT_NATIVE_HOST_INTERFACE_PROTOCOL_GUID;
 
+// InternalHashBytes
+/** Calculate FNV-1a hash of a byte sequence.
+**/
+STATIC
+UINT32
+InternalHashBytes (
+  IN CONST VOID  *Data,
+  IN UINTN       Size
+  )
+{
+  CONST UINT8  *Bytes;
+  UINT32       Hash;
+
+  Bytes = Data;
+  Hash  = 0x811C9DC5U;
+
+  while (Size-- > 0) {
+    Hash = (Hash ^ *Bytes++) * 0x01000193U;
+  }
+
+  return Hash;
+}
+
 // InternalGetPropertyNode
 STATIC
 EFI_DEVICE_PATH_PROPERTY_NODE *
 InternalGetPropertyNode (
-  IN DEVICE_PATH_PROPERTY_DATA  *DevicePathPropertyData,
-  IN EFI_DEVICE_PATH_PROTOCOL   *DevicePath
+  IN  DEVICE_PATH_PROPERTY_DATA  *DevicePathPropertyData,
+  IN  EFI_DEVICE_PATH_PROTOCOL   *DevicePath,
+  OUT UINTN                      *DevicePathSize OPTIONAL,
+  OUT UINT32                     *Hash OPTIONAL
   )
 {
-  LIST_ENTRY  *Node;
-  UINTN       DevicePathSize;
-  UINTN       DevicePathSize2;
+  LIST_ENTRY                     *Bucket;
+  LIST_ENTRY                     *Link;
+  EFI_DEVICE_PATH_PROPERTY_NODE  *Node;
+  UINTN                          Size;
+  UINT32                         PathHash;
+
+  Size     = GetDevicePathSize (DevicePath);
+  PathHash = InternalHashBytes (DevicePath, Size);
+  Bucket   = &DevicePathPropertyData->NodeBuckets[PathHash & (DEVICE_PATH_PROPERTY_NODE_BUCKETS - 1)];
+
+  if (DevicePathSize != NULL) {
+    *DevicePathSize = Size;
+  }
 
-  Node = GetFirstNode (&DevicePathPropertyData->Nodes);
-  DevicePathSize = GetDevicePathSize (DevicePath);
+  if (Hash != NULL) {
+    *Hash = PathHash;
+  }
 
-  while (!IsNull (&DevicePathPropertyData->Nodes, Node)) {
-    DevicePathSize2 = GetDevicePathSize (&PROPERTY_NODE_FROM_LIST_ENTRY (Node)->DevicePath);
+  for (Link = GetFirstNode (Bucket); !IsNull (Bucket, Link); Link = GetNextNode (Bucket, Link)) {
+    Node = PROPERTY_NODE_FROM_HASH_LINK (Link);
 
-    if (DevicePathSize == DevicePathSize2
-      && CompareMem (DevicePath, &PROPERTY_NODE_FROM_LIST_ENTRY (Node)->DevicePath, DevicePathSize) == 0) {
-      return PROPERTY_NODE_FROM_LIST_ENTRY (Node);
+    if (Node->Hdr.Hash == PathHash
+      && Node->Hdr.DevicePathSize == Size
+      && CompareMem (DevicePath, &Node->DevicePath, Size) == 0) {
+      return Node;
     }
-
-    Node = GetNextNode (&DevicePathPropertyData->Nodes, Node);
   }
 
   return NULL;
@@ -162,21 +227,32 @@ InternalGetPropertyNode (
 STATIC
 EFI_DEVICE_PATH_PROPERTY *
 InternalGetProperty (
-  IN EFI_DEVICE_PATH_PROPERTY_NODE  *Node,
-  IN CONST CHAR16                   *Name
+  IN  EFI_DEVICE_PATH_PROPERTY_NODE  *Node,
+  IN  CONST CHAR16                   *Name,
+  OUT UINT32                         *NameHash OPTIONAL
   )
 {
-  LIST_ENTRY  *Property;
+  LIST_ENTRY                *Link;
+  EFI_DEVICE_PATH_PROPERTY  *Property;
+  UINT32                    Hash;
+
+  Hash = InternalHashBytes (Name, StrSize (Name));
+
+  if (NameHash != NULL) {
+    *NameHash = Hash;
+  }
 
+  Link = GetFirstNode (&Node->Hdr.Properties);
 
-  Property = GetFirstNode (&Node->Hdr.Properties);
+  while (!IsNull (&Node->Hdr.Properties, Link)) {
+    Property = EFI_DEVICE_PATH_PROPERTY_FROM_LIST_ENTRY (Link);
 
-  while (!IsNull (&Node->Hdr.Properties, Property)) {
-    if (StrCmp (Name, (CONST CHAR16 *) &EFI_DEVICE_PATH_PROPERTY_FROM_LIST_ENTRY (Property)->Name->Data[0]) == 0) {
-      return EFI_DEVICE_PATH_PROPERTY_FROM_LIST_ENTRY (Property);
+    if (Property->NameHash == Hash
+      && StrCmp (Name, (CONST CHAR16 *) &Property->Name->Data[0]) == 0) {
+      return Property;
     }
 
-    Property = GetNextNode (&Node->Hdr.Properties, Property);
+    Link = GetNextNode (&Node->Hdr.Properties, Link);
   }
 
   return NULL;
@@ -262,12 +338,12 @@ DppDbGetProperty (
   BOOLEAN                           BufferTooSmall;
 
   Database = PROPERTY_DATABASE_FROM_PROTOCOL (This);
-  Node     = InternalGetPropertyNode (Database, DevicePath);
+  Node     = InternalGetPropertyNode (Database, DevicePath, NULL, NULL);
   if (Node == NULL) {
     return EFI_NOT_FOUND;
   }
 
-  Property = InternalGetProperty (Node, Name);
+  Property = InternalGetProperty (Node, Name, NULL);
   if (Property == NULL) {
     return EFI_NOT_FOUND;
   }
@@ -317,19 +393,22 @@ DppDbSetProperty (
   UINTN                         PropertyValueSize;
   EFI_DEVICE_PATH_PROPERTY_DATA *PropertyName;
   EFI_DEVICE_PATH_PROPERTY_DATA *PropertyValue;
+  UINT32                        DevicePathHash;
+  UINT32                        NameHash;
 
   Database = PROPERTY_DATABASE_FROM_PROTOCOL (This);
-  Node     = InternalGetPropertyNode (Database, DevicePath);
+  Node     = InternalGetPropertyNode (Database, DevicePath, &DevicePathSize, &DevicePathHash);
 
   if (Node == NULL) {
-    DevicePathSize = GetDevicePathSize (DevicePath);
-    Node           = AllocateZeroPool (sizeof (*Node) + DevicePathSize);
+    Node = AllocateZeroPool (sizeof (*Node) + DevicePathSize);
 
     if (Node == NULL) {
       return EFI_OUT_OF_RESOURCES;
     }
 
-    Node->Hdr.Signature = EFI_DEVICE_PATH_PROPERTY_NODE_SIGNATURE;
+    Node->Hdr.Signature      = EFI_DEVICE_PATH_PROPERTY_NODE_SIGNATURE;
+    Node->Hdr.Hash           = DevicePathHash;
+    Node->Hdr.DevicePathSize = DevicePathSize;
 
     InitializeListHead (&Node->Hdr.Properties);
 
@@ -340,11 +419,16 @@ DppDbSetProperty (
       );
 
     InsertTailList (&Database->Nodes, &Node->Hdr.Link);
+    InsertTailList (
+      &Database->NodeBuckets[DevicePathHash & (DEVICE_PATH_PROPERTY_NODE_BUCKETS - 1)],
+      &Node->Hdr.HashLink
+      );
 
-    Database->Modified = TRUE;
+    Database->Modified    = TRUE;
+    Database->BufferDirty = TRUE;
   }
 
-  Property = InternalGetProperty (Node, Name);
+  Property = InternalGetProperty (Node, Name, &NameHash);
 
   if (Property != NULL) {
     if (Property->Value->Size == Size + sizeof (UINT32)
@@ -361,8 +445,9 @@ DppDbSetProperty (
     FreePool (Property);
   }
 
-  Database->Modified = TRUE;
-  Property           = AllocateZeroPool (sizeof (*Property));
+  Database->Modified    = TRUE;
+  Database->BufferDirty = TRUE;
+  Property              = AllocateZeroPool (sizeof (*Property));
   
   if (Property == NULL) {
     return EFI_OUT_OF_RESOURCES;
@@ -387,6 +472,7 @@ DppDbSetProperty (
   }
   
   Property->Signature = EFI_DEVICE_PATH_PROPERTY_SIGNATURE;
+  Property->NameHash  = NameHash;
 
   CopyMem (&Property->Name->Data[0], Name, PropertyNameSize - sizeof (*PropertyName));
   Property->Name->Size = (UINT32) PropertyNameSize;
@@ -426,17 +512,18 @@ DppDbRemoveProperty (
   EFI_DEVICE_PATH_PROPERTY      *Property;
 
   DevicePathPropertyData = PROPERTY_DATABASE_FROM_PROTOCOL (This);
-  Node = InternalGetPropertyNode (DevicePathPropertyData, DevicePath);
+  Node = InternalGetPropertyNode (DevicePathPropertyData, DevicePath, NULL, NULL);
   if (Node == NULL) {
     return EFI_NOT_FOUND;
   }
 
-  Property = InternalGetProperty (Node, Name);
+  Property = InternalGetProperty (Node, Name, NULL);
   if (Property == NULL) {
     return EFI_NOT_FOUND;
   }
 
-  DevicePathPropertyData->Modified = TRUE;
+  DevicePathPropertyData->Modified    = TRUE;
+  DevicePathPropertyData->BufferDirty = TRUE;
 
   RemoveEntryList (&Property->Link);
 
@@ -448,6 +535,7 @@ DppDbRemoveProperty (
 
   if (Node->Hdr.NumberOfProperties == 0) {
     RemoveEntryList (&Node->Hdr.Link);
+    RemoveEntryList (&Node->Hdr.HashLink);
 
     FreePool (Node);
   }
@@ -455,28 +543,23 @@ DppDbRemoveProperty (
   return EFI_SUCCESS;
 }
 
-// DppDbGetPropertyBuffer
-/** Returns a Buffer of all device properties into Buffer.
+// InternalSerialiseProperties
+/** Serialise device property database into Buffer.
 
-  @param[in]      This    A pointer to the protocol instance.
-  @param[out]     Buffer  The Buffer allocated by the caller to return the
-                          property Buffer into.
-  @param[in,out]  Size    On input the size of the allocated Buffer.
-                          On output the size required to fill the Buffer.
+  @param[in]      Database  Device property database.
+  @param[out]     Buffer    The Buffer to return the property Buffer into.
+  @param[in,out]  Size      On input the size of the allocated Buffer.
+                            On output the size required to fill the Buffer.
 
-  @return                       The status of the operation is returned.
-  @retval EFI_BUFFER_TOO_SMALL  The memory required to return the value exceeds
-                                the size of the allocated Buffer.
-                                The required size to complete the operation has
-                                been returned into Size.
+  @retval EFI_BUFFER_TOO_SMALL  Buffer is too small, required size is returned in Size.
   @retval EFI_SUCCESS           The operation completed successfully.
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-DppDbGetPropertyBuffer (
-  IN     EFI_DEVICE_PATH_PROPERTY_DATABASE_PROTOCOL  *This,
-  OUT    EFI_DEVICE_PATH_PROPERTY_BUFFER             *Buffer OPTIONAL,
-  IN OUT UINTN                                       *Size
+InternalSerialiseProperties (
+  IN     DEVICE_PATH_PROPERTY_DATA        *Database,
+  OUT    EFI_DEVICE_PATH_PROPERTY_BUFFER  *Buffer OPTIONAL,
+  IN OUT UINTN                            *Size
   )
 {
   LIST_ENTRY                           *Nodes;
@@ -488,16 +571,7 @@ DppDbGetPropertyBuffer (
   UINT8                                *BufferPtr;
   BOOLEAN                              BufferTooSmall;
 
-  Nodes  = &(PROPERTY_DATABASE_FROM_PROTOCOL (This))->Nodes;
-
-  if (IsListEmpty (Nodes)) {
-    *Size  = 0;
-    return EFI_SUCCESS;
-  }
-
-  if (PcdGetBool (PcdEnableAppleThunderboltSync)) {
-    InternalSyncWithThunderboltDevices ();
-  }
+  Nodes  = &Database->Nodes;
 
   NodeWalker    = GetFirstNode (Nodes);
   BufferSize    = sizeof (*Buffer);
@@ -518,8 +592,6 @@ DppDbGetPropertyBuffer (
     ++NumberOfNodes;
   }
 
-  DEBUG ((DEBUG_VERBOSE, "Saving to %p, given %u, requested %u\n", Buffer, (UINT32) *Size, (UINT32) BufferSize));
-
   BufferTooSmall = *Size < BufferSize;
   *Size  = BufferSize;
   if (BufferTooSmall) {
@@ -535,7 +607,7 @@ DppDbGetPropertyBuffer (
   BufferNode = &Buffer->Nodes[0];
 
   while (!IsNull (Nodes, NodeWalker)) {
-    BufferSize = GetDevicePathSize (&PROPERTY_NODE_FROM_LIST_ENTRY (NodeWalker)->DevicePath);
+    BufferSize = PROPERTY_NODE_FROM_LIST_ENTRY (NodeWalker)->Hdr.DevicePathSize;
 
     CopyMem (
       &BufferNode->DevicePath,
@@ -582,6 +654,90 @@ DppDbGetPropertyBuffer (
   return EFI_SUCCESS;
 }
 
+// DppDbGetPropertyBuffer
+/** Returns a Buffer of all device properties into Buffer.
+
+  @param[in]      This    A pointer to the protocol instance.
+  @param[out]     Buffer  The Buffer allocated by the caller to return the
+                          property Buffer into.
+  @param[in,out]  Size    On input the size of the allocated Buffer.
+                          On output the size required to fill the Buffer.
+
+  @return                       The status of the operation is returned.
+  @retval EFI_BUFFER_TOO_SMALL  The memory required to return the value exceeds
+                                the size of the allocated Buffer.
+                                The required size to complete the operation has
+                                been returned into Size.
+  @retval EFI_SUCCESS           The operation completed successfully.
+**/
+EFI_STATUS
+EFIAPI
+DppDbGetPropertyBuffer (
+  IN     EFI_DEVICE_PATH_PROPERTY_DATABASE_PROTOCOL  *This,
+  OUT    EFI_DEVICE_PATH_PROPERTY_BUFFER             *Buffer OPTIONAL,
+  IN OUT UINTN                                       *Size
+  )
+{
+  EFI_STATUS                 Status;
+  DEVICE_PATH_PROPERTY_DATA  *Database;
+  UINTN                      RequiredSize;
+  BOOLEAN                    BufferTooSmall;
+
+  Database = PROPERTY_DATABASE_FROM_PROTOCOL (This);
+
+  if (IsListEmpty (&Database->Nodes)) {
+    *Size  = 0;
+    return EFI_SUCCESS;
+  }
+
+  if (PcdGetBool (PcdEnableAppleThunderboltSync)) {
+    InternalSyncWithThunderboltDevices ();
+  }
+
+  //
+  // boot.efi queries the buffer size first and the contents right after,
+  // so serialise the database once and reuse it until it gets modified.
+  //
+  if (Database->Buffer == NULL || Database->BufferDirty) {
+    RequiredSize = 0;
+    InternalSerialiseProperties (Database, NULL, &RequiredSize);
+
+    if (RequiredSize > Database->BufferAllocatedSize) {
+      if (Database->Buffer != NULL) {
+        FreePool (Database->Buffer);
+      }
+
+      Database->BufferAllocatedSize = 0;
+      Database->Buffer              = AllocatePool (RequiredSize);
+      if (Database->Buffer == NULL) {
+        return InternalSerialiseProperties (Database, Buffer, Size);
+      }
+
+      Database->BufferAllocatedSize = RequiredSize;
+    }
+
+    Status = InternalSerialiseProperties (Database, Database->Buffer, &RequiredSize);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Database->BufferSize  = RequiredSize;
+    Database->BufferDirty = FALSE;
+  }
+
+  DEBUG ((DEBUG_VERBOSE, "Saving to %p, given %u, requested %u\n", Buffer, (UINT32) *Size, (UINT32) Database->BufferSize));
+
+  BufferTooSmall = *Size < Database->BufferSize;
+  *Size          = Database->BufferSize;
+  if (BufferTooSmall) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  CopyMem (Buffer, Database->Buffer, Database->BufferSize);
+
+  return EFI_SUCCESS;
+}
+
 // InternalReadEfiVariableProperties
 STATIC
 EFI_STATUS
@@ -794,6 +950,7 @@ OcDevicePathPropertyInstallProtocol (
   UINTN                                       VariableSize;
   UINT32                                      Attributes;
   EFI_HANDLE                                  Handle;
+  UINTN                                       Index;
 
   if (Reinstall) {
     Status = OcUninstallAllProtocolInstances (&gEfiDevicePathPropertyDatabaseProtocolGuid);
@@ -827,6 +984,9 @@ OcDevicePathPropertyInstallProtocol (
     );
 
   InitializeListHead (&DevicePathPropertyData->Nodes);
+  for (Index = 0; Index < DEVICE_PATH_PROPERTY_NODE_BUCKETS; ++Index) {
+    InitializeListHead (&DevicePathPropertyData->NodeBuckets[Index]);
+  }
 
   if (PcdGetBool (PcNvramInitDevicePropertyDatabase)) {
     Status = InternalReadEfiVariableProperties (
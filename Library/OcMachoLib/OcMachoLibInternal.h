@@ -33,6 +33,23 @@ InternalRetrieveSymtabs (
   IN OUT OC_MACHO_CONTEXT  *Context
   );
 
+/**
+  Retrieves the index of the next symbol named Name from the built symbol
+  name hash index.  Symbols are returned in symbol table order.
+
+  @param[in,out] Context   Context of the Mach-O with a built index.
+  @param[in]     Name      Name of the symbol to locate.
+  @param[in]     Previous  Previously returned index or MAX_UINT32 to start.
+
+  @retval MAX_UINT32  No more symbols with this name.
+**/
+UINT32
+InternalSymbolIndexLookup (
+  IN OUT OC_MACHO_CONTEXT  *Context,
+  IN     CONST CHAR8       *Name,
+  IN     UINT32            Previous
+  );
+
 /**
   Retrieves an extern Relocation by the address it targets.
 
@@ -19,6 +19,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcGuardLib.h>
 #include <Library/OcMachoLib.h>
 
@@ -76,6 +77,195 @@ MachoGetSymbolByIndex (
     (MACH_NLIST_ANY *) MachoGetSymbolByIndex64 (Context, Index);
 }
 
+/**
+  Computes the symbol name hash (FNV-1a).
+
+  @param[in] Name  Symbol name.
+
+  @returns  Name hash.
+**/
+STATIC
+UINT32
+InternalSymbolNameHash (
+  IN CONST CHAR8  *Name
+  )
+{
+  UINT32  Hash;
+
+  Hash = 2166136261U;
+  while (*Name != '\0') {
+    Hash = (Hash ^ (UINT8) *Name) * 16777619U;
+    ++Name;
+  }
+
+  return Hash;
+}
+
+BOOLEAN
+MachoInitializeSymbolIndex (
+  IN OUT OC_MACHO_CONTEXT  *Context
+  )
+{
+  MACH_NLIST_ANY  *Symbol;
+  UINT32          NumSymbols;
+  UINT32          NumBuckets;
+  UINT32          IndexSize;
+  UINT32          *Links;
+  UINT32          Bucket;
+  UINT32          Index;
+
+  ASSERT (Context != NULL);
+
+  if (Context->SymbolIndexBuilt) {
+    return Context->SymbolIndex != NULL;
+  }
+
+  //
+  // Build the index only once, even on failure, so that copies of Context
+  // never allocate an index of their own.
+  //
+  Context->SymbolIndexBuilt = TRUE;
+
+  if (!InternalRetrieveSymtabs (Context)) {
+    return FALSE;
+  }
+
+  NumSymbols = Context->Symtab->NumSymbols;
+  if (NumSymbols == 0 || NumSymbols > BIT30) {
+    return FALSE;
+  }
+
+  //
+  // The index consists of bucket heads followed by per-symbol links, each
+  // holding a symbol index + 1 with 0 terminating the chain.
+  //
+  NumBuckets = GetPowerOfTwo32 (NumSymbols);
+  if (NumBuckets < NumSymbols) {
+    NumBuckets <<= 1U;
+  }
+
+  if (OcOverflowAddU32 (NumBuckets, NumSymbols, &IndexSize)
+    || OcOverflowMulU32 (IndexSize, sizeof (UINT32), &IndexSize)) {
+    return FALSE;
+  }
+
+  Context->SymbolIndex = AllocateZeroPool (IndexSize);
+  if (Context->SymbolIndex == NULL) {
+    return FALSE;
+  }
+
+  Context->SymbolIndexMask = NumBuckets - 1;
+  Links                    = &Context->SymbolIndex[NumBuckets];
+
+  //
+  // Insert in reverse order to keep chains in symbol table order.
+  //
+  Index = NumSymbols;
+  while (Index > 0) {
+    --Index;
+
+    Symbol = MachoGetSymbolByIndex (Context, Index);
+    if (Symbol == NULL) {
+      continue;
+    }
+
+    Bucket = InternalSymbolNameHash (MachoGetSymbolName (Context, Symbol))
+      & Context->SymbolIndexMask;
+    Links[Index]                  = Context->SymbolIndex[Bucket];
+    Context->SymbolIndex[Bucket]  = Index + 1;
+  }
+
+  return TRUE;
+}
+
+VOID
+MachoFreeSymbolIndex (
+  IN OUT OC_MACHO_CONTEXT  *Context
+  )
+{
+  ASSERT (Context != NULL);
+
+  if (Context->SymbolIndex != NULL) {
+    FreePool (Context->SymbolIndex);
+  }
+
+  Context->SymbolIndex      = NULL;
+  Context->SymbolIndexMask  = 0;
+  Context->SymbolIndexBuilt = FALSE;
+}
+
+UINT32
+InternalSymbolIndexLookup (
+  IN OUT OC_MACHO_CONTEXT  *Context,
+  IN     CONST CHAR8       *Name,
+  IN     UINT32            Previous
+  )
+{
+  UINT32          Link;
+  MACH_NLIST_ANY  *Symbol;
+
+  ASSERT (Context != NULL);
+  ASSERT (Context->SymbolIndex != NULL);
+  ASSERT (Name != NULL);
+
+  if (Previous == MAX_UINT32) {
+    Link = Context->SymbolIndex[InternalSymbolNameHash (Name) & Context->SymbolIndexMask];
+  } else {
+    Link = Context->SymbolIndex[Context->SymbolIndexMask + 1 + Previous];
+  }
+
+  while (Link != 0) {
+    Symbol = MachoGetSymbolByIndex (Context, Link - 1);
+    ASSERT (Symbol != NULL);
+    if (AsciiStrCmp (Name, MachoGetSymbolName (Context, Symbol)) == 0) {
+      return Link - 1;
+    }
+
+    Link = Context->SymbolIndex[Context->SymbolIndexMask + Link];
+  }
+
+  return MAX_UINT32;
+}
+
+MACH_NLIST_ANY *
+MachoGetSymbolByName (
+  IN OUT OC_MACHO_CONTEXT  *Context,
+  IN     CONST CHAR8       *Name
+  )
+{
+  MACH_NLIST_ANY  *Symbol;
+  UINT32          Index;
+
+  ASSERT (Context != NULL);
+  ASSERT (Name != NULL);
+
+  if (MachoInitializeSymbolIndex (Context)) {
+    Index = InternalSymbolIndexLookup (Context, Name, MAX_UINT32);
+    if (Index == MAX_UINT32) {
+      return NULL;
+    }
+
+    return MachoGetSymbolByIndex (Context, Index);
+  }
+
+  //
+  // Fall back to a linear search when the index cannot be built.
+  //
+  Index = 0;
+  while (TRUE) {
+    Symbol = MachoGetSymbolByIndex (Context, Index);
+    if (Symbol == NULL) {
+      return NULL;
+    }
+
+    if (AsciiStrCmp (Name, MachoGetSymbolName (Context, Symbol)) == 0) {
+      return Symbol;
+    }
+
+    ++Index;
+  }
+}
+
 CONST CHAR8 *
 MachoGetSymbolName (
   IN OUT OC_MACHO_CONTEXT     *Context,
@@ -485,6 +485,8 @@ MACH_X (MachoGetLocalDefinedSymbolByName) (
   MACH_NLIST_X                *SymbolTable;
   CONST MACH_DYSYMTAB_COMMAND *DySymtab;
   MACH_NLIST_X                *Symbol;
+  MACH_NLIST_X                *ExternalSymbol;
+  UINT32                      Index;
 
   ASSERT (Context != NULL);
   ASSERT (Name != NULL);
@@ -499,6 +501,37 @@ MACH_X (MachoGetLocalDefinedSymbolByName) (
 
   DySymtab = Context->DySymtab;
 
+  if (Context->SymbolIndex != NULL) {
+    //
+    // Prefer local symbols over external ones as the search below does.
+    //
+    ExternalSymbol = NULL;
+    Index          = MAX_UINT32;
+    while (TRUE) {
+      Index = InternalSymbolIndexLookup (Context, Name, Index);
+      if (Index == MAX_UINT32) {
+        return ExternalSymbol;
+      }
+
+      Symbol = &SymbolTable[Index];
+      if (!MACH_X (MachoSymbolIsDefined) (Symbol)) {
+        continue;
+      }
+
+      if (DySymtab == NULL
+        || (Index >= DySymtab->LocalSymbolsIndex
+          && Index - DySymtab->LocalSymbolsIndex < DySymtab->NumLocalSymbols)) {
+        return Symbol;
+      }
+
+      if (ExternalSymbol == NULL
+        && Index >= DySymtab->ExternalSymbolsIndex
+        && Index - DySymtab->ExternalSymbolsIndex < DySymtab->NumExternalSymbols) {
+        ExternalSymbol = Symbol;
+      }
+    }
+  }
+
   if (DySymtab != NULL) {
     Symbol = InternalGetLocalDefinedSymbolByNameWorker (
                Context,
@@ -23,6 +23,36 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+STATIC
+VOID
+OcAcpiPrefetchTables (
+  IN OC_GLOBAL_CONFIG    *Config,
+  IN OC_STORAGE_CONTEXT  *Storage
+  )
+{
+  UINT32               Index;
+  OC_ACPI_ADD_ENTRY    *Table;
+  CONST CHAR8          **TablePaths;
+
+  if (!Config->Misc.Security.VaultPrefetch || !Storage->HasVault || Config->Acpi.Add.Count == 0) {
+    return;
+  }
+
+  TablePaths = AllocatePool (Config->Acpi.Add.Count * sizeof (*TablePaths));
+  if (TablePaths == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < Config->Acpi.Add.Count; ++Index) {
+    Table             = Config->Acpi.Add.Values[Index];
+    TablePaths[Index] = Table->Enabled ? OC_BLOB_GET (&Table->Path) : NULL;
+  }
+
+  OcStoragePrefetchFilesAscii (Storage, OPEN_CORE_ACPI_PATH, TablePaths, NULL, Config->Acpi.Add.Count);
+
+  FreePool (TablePaths);
+}
+
 STATIC
 VOID
 OcAcpiAddTables (
@@ -39,6 +69,8 @@ OcAcpiAddTables (
   CONST CHAR8          *TablePath;
   CHAR16               FullPath[OC_STORAGE_SAFE_PATH_MAX];
 
+  OcAcpiPrefetchTables (Config, Storage);
+
   for (Index = 0; Index < Config->Acpi.Add.Count; ++Index) {
     Table = Config->Acpi.Add.Values[Index];
     TablePath = OC_BLOB_GET (&Table->Path);
@@ -83,6 +115,11 @@ OcAcpiAddTables (
         ));
     }
   }
+
+  //
+  // Release prefetched files of tables failing to load.
+  //
+  OcStoragePrefetchFilesUnicode (Storage, NULL, 0);
 }
 
 STATIC
@@ -165,6 +202,11 @@ OcAcpiPatchTables (
 
     ZeroMem (&Patch, sizeof (Patch));
 
+    if (OC_BLOB_GET (&UserPatch->Base)[0] != '\0') {
+      Patch.Base     = OC_BLOB_GET (&UserPatch->Base);
+      Patch.BaseSkip = UserPatch->BaseSkip;
+    }
+
     Patch.Find  = OC_BLOB_GET (&UserPatch->Find);
     Patch.Replace = OC_BLOB_GET (&UserPatch->Replace);
 
@@ -189,6 +231,11 @@ OcAcpiPatchTables (
       DEBUG ((DEBUG_WARN, "OC: ACPI patcher failed %u - %r\n", Index, Status));
     }
   }
+
+  //
+  // Refresh checksums of all patched tables at once.
+  //
+  AcpiFlushPatches (Context);
 }
 
 VOID
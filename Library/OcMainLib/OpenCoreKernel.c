@@ -23,6 +23,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcMiscLib.h>
 #include <Library/OcAppleImg4Lib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVirtualFsLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -39,6 +40,57 @@ STATIC BOOLEAN             mUse32BitKernel;
 STATIC CACHELESS_CONTEXT   mOcCachelessContext;
 STATIC BOOLEAN             mOcCachelessInProgress;
 
+//
+// Kernel stage memory, which is used in addition to kernel buffer,
+// i.e. kext sources and prelinked context scratch, and its peak value.
+//
+STATIC UINT32              mOcKernelStageMemory;
+STATIC UINT32              mOcKernelStageMemoryPeak;
+
+STATIC
+VOID
+OcKernelStageAcquire (
+  IN UINT32  Size
+  )
+{
+  if (OcOverflowAddU32 (mOcKernelStageMemory, Size, &mOcKernelStageMemory)) {
+    mOcKernelStageMemory = MAX_UINT32;
+  }
+
+  mOcKernelStageMemoryPeak = MAX (mOcKernelStageMemoryPeak, mOcKernelStageMemory);
+}
+
+STATIC
+VOID
+OcKernelStageRelease (
+  IN UINT32  Size
+  )
+{
+  mOcKernelStageMemory -= MIN (mOcKernelStageMemory, Size);
+}
+
+/**
+  Report peak kernel stage memory usage and start tracking a new peak.
+
+  @param[in] KernelAllocatedSize  Allocated size of kernel buffer.
+**/
+STATIC
+VOID
+OcKernelStageReportPeak (
+  IN UINT32  KernelAllocatedSize
+  )
+{
+  DEBUG ((
+    DEBUG_INFO,
+    "OC: Kernel stage memory peak %u KB - kernel %u KB, scratch %u KB\n",
+    (KernelAllocatedSize + mOcKernelStageMemoryPeak) / BASE_1KB,
+    KernelAllocatedSize / BASE_1KB,
+    mOcKernelStageMemoryPeak / BASE_1KB
+    ));
+
+  mOcKernelStageMemoryPeak = mOcKernelStageMemory;
+}
+
 STATIC
 VOID
 OcKernelConfigureCapabilities (
@@ -221,6 +273,32 @@ OcKernelConfigureCapabilities (
   }
 }
 
+/**
+  Free kext plist and executable data read by OcKernelLoadAndReserveKext.
+
+  @param[in,out] Kext  Kext entry.
+**/
+STATIC
+VOID
+OcKernelFreeKextData (
+  IN OUT OC_KERNEL_ADD_ENTRY  *Kext
+  )
+{
+  if (Kext->PlistData != NULL) {
+    OcKernelStageRelease (Kext->PlistDataSize);
+    FreePool (Kext->PlistData);
+    Kext->PlistDataSize  = 0;
+    Kext->PlistData      = NULL;
+  }
+
+  if (Kext->ImageData != NULL) {
+    OcKernelStageRelease (Kext->ImageDataSize);
+    FreePool (Kext->ImageData);
+    Kext->ImageDataSize  = 0;
+    Kext->ImageData      = NULL;
+  }
+}
+
 STATIC
 VOID
 OcKernelLoadAndReserveKext (
@@ -251,19 +329,11 @@ OcKernelLoadAndReserveKext (
   }
 
   //
-  // Free existing data if present, but only for forced kexts.
-  // Injected kexts will never change.
+  // Free existing data if present, e.g. after a failed kernel read.
+  // Injected kexts may still be referenced by an active cacheless context.
   //
-  if (IsForced && Kext->PlistData != NULL) {
-    FreePool (Kext->PlistData);
-    Kext->PlistDataSize  = 0;
-    Kext->PlistData      = NULL;
-
-    if (Kext->ImageData != NULL) {
-      FreePool (Kext->ImageData);
-      Kext->ImageDataSize  = 0;
-      Kext->ImageData      = NULL;
-    }
+  if (IsForced || !mOcCachelessInProgress) {
+    OcKernelFreeKextData (Kext);
   }
 
   Identifier    = OC_BLOB_GET (&Kext->Identifier);
@@ -355,6 +425,8 @@ OcKernelLoadAndReserveKext (
     return;
   }
 
+  OcKernelStageAcquire (Kext->PlistDataSize);
+
   //
   // Get executable path and data, if present.
   //
@@ -377,8 +449,7 @@ OcKernelLoadAndReserveKext (
         ExecutablePath
         ));
       Kext->Enabled = IsForced;
-      FreePool (Kext->PlistData);
-      Kext->PlistData = NULL;
+      OcKernelFreeKextData (Kext);
       return;
     }
 
@@ -409,10 +480,11 @@ OcKernelLoadAndReserveKext (
         Comment
         ));
       Kext->Enabled = IsForced;
-      FreePool (Kext->PlistData);
-      Kext->PlistData = NULL;
+      OcKernelFreeKextData (Kext);
       return;
     }
+
+    OcKernelStageAcquire (Kext->ImageDataSize);
   }
 
   if (CacheType == CacheTypeCacheless || CacheType == CacheTypeMkext) {
@@ -444,18 +516,66 @@ OcKernelLoadAndReserveKext (
       Comment,
       Status
       ));
-    if (Kext->ImageData != NULL) {
-      FreePool (Kext->ImageData);
-      Kext->ImageData = NULL;
-    }
-    FreePool (Kext->PlistData);
-    Kext->PlistData = NULL;
+    OcKernelFreeKextData (Kext);
     return;
   }
 
   (*NumReservedKexts)++;
 }
 
+STATIC
+VOID
+OcKernelPrefetchKexts (
+  IN  OC_STORAGE_CONTEXT  *Storage,
+  IN  OC_GLOBAL_CONFIG    *Config
+  )
+{
+  UINT32               Index;
+  UINT32               Count;
+  OC_KERNEL_ADD_ENTRY  *Kext;
+  CONST CHAR8          **BundlePaths;
+  CONST CHAR8          **FilePaths;
+
+  if (!Config->Misc.Security.VaultPrefetch || !Storage->HasVault || Config->Kernel.Add.Count == 0) {
+    return;
+  }
+
+  BundlePaths = AllocatePool (Config->Kernel.Add.Count * 2 * sizeof (*BundlePaths));
+  FilePaths   = AllocatePool (Config->Kernel.Add.Count * 2 * sizeof (*FilePaths));
+  if (BundlePaths == NULL || FilePaths == NULL) {
+    if (BundlePaths != NULL) {
+      FreePool (BundlePaths);
+    }
+    if (FilePaths != NULL) {
+      FreePool (FilePaths);
+    }
+    return;
+  }
+
+  //
+  // Collect plist and executable paths of injected kexts, which will be
+  // read by OcKernelLoadAndReserveKext right away.
+  //
+  Count = 0;
+  for (Index = 0; Index < Config->Kernel.Add.Count; ++Index) {
+    Kext = Config->Kernel.Add.Values[Index];
+    if (!Kext->Enabled || Kext->PlistData != NULL) {
+      continue;
+    }
+
+    BundlePaths[Count]     = OC_BLOB_GET (&Kext->BundlePath);
+    FilePaths[Count]       = OC_BLOB_GET (&Kext->PlistPath);
+    BundlePaths[Count + 1] = BundlePaths[Count];
+    FilePaths[Count + 1]   = OC_BLOB_GET (&Kext->ExecutablePath);
+    Count                 += 2;
+  }
+
+  OcStoragePrefetchFilesAscii (Storage, OPEN_CORE_KEXT_PATH, BundlePaths, FilePaths, Count);
+
+  FreePool (FilePaths);
+  FreePool (BundlePaths);
+}
+
 STATIC
 EFI_STATUS
 OcKernelLoadKextsAndReserve (
@@ -499,7 +619,10 @@ OcKernelLoadKextsAndReserve (
 
   //
   // Process kexts to be injected.
+  // Read and verify them all at once first.
   //
+  OcKernelPrefetchKexts (Storage, Config);
+
   for (Index = 0; Index < Config->Kernel.Add.Count; Index++) {
     Kext = Config->Kernel.Add.Values[Index];
 
@@ -518,6 +641,11 @@ OcKernelLoadKextsAndReserve (
       );
   }
 
+  //
+  // Release prefetched files of skipped kexts.
+  //
+  OcStoragePrefetchFilesUnicode (Storage, NULL, 0);
+
   if (CacheType == CacheTypePrelinked) {
     if (*ReservedExeSize > PRELINKED_KEXTS_MAX_SIZE
       || *ReservedInfoSize + *ReservedExeSize < *ReservedExeSize) {
@@ -657,6 +785,15 @@ OcKernelInjectKexts (
 {
   EFI_STATUS      Status;
   UINT32          Index;
+  BOOLEAN         FreeKextData;
+
+  OcTraceBegin ("KernelInject");
+
+  //
+  // Prelinked and mkext injection copy kext data into the cache, so the
+  // sources can be freed right away. Cacheless context references them.
+  //
+  FreeKextData = CacheType != CacheTypeCacheless;
 
   if (CacheType == CacheTypePrelinked) {
     Status = PrelinkedInjectPrepare (
@@ -666,6 +803,7 @@ OcKernelInjectKexts (
       );
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_WARN, "OC: Prelink inject prepare error - %r\n", Status));
+      OcTraceEnd ("KernelInject");
       return;
     }
   }
@@ -683,6 +821,10 @@ OcKernelInjectKexts (
       DarwinVersion,
       Is32Bit
       );
+
+    if (FreeKextData) {
+      OcKernelFreeKextData (Config->Kernel.Force.Values[Index]);
+    }
   }
 
   //
@@ -698,6 +840,10 @@ OcKernelInjectKexts (
       DarwinVersion,
       Is32Bit
       );
+
+    if (FreeKextData) {
+      OcKernelFreeKextData (Config->Kernel.Add.Values[Index]);
+    }
   }
 
   if (CacheType == CacheTypeCacheless || CacheType == CacheTypeMkext) {
@@ -724,6 +870,8 @@ OcKernelInjectKexts (
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_WARN, "OC: %a insertion error - %r\n", PRINT_KERNEL_CACHE_TYPE (CacheType), Status));
   }
+
+  OcTraceEnd ("KernelInject");
 }
 
 STATIC
@@ -741,21 +889,37 @@ OcKernelProcessPrelinked (
 {
   EFI_STATUS           Status;
   PRELINKED_CONTEXT    Context;
+  UINT32               ScratchSize;
+
+  OcTraceBegin ("Prelinked");
 
   Status = PrelinkedContextInit (&Context, Kernel, *KernelSize, AllocatedSize, Is32Bit);
 
   if (!EFI_ERROR (Status)) {
+    ScratchSize = Context.ScratchArenaTotal;
+    OcKernelStageAcquire (ScratchSize);
+
     OcKernelInjectKexts (Config, CacheTypePrelinked, &Context, DarwinVersion, Is32Bit, LinkedExpansion, ReservedExeSize);
 
+    //
+    // Account for scratch arena growth during injection.
+    //
+    OcKernelStageAcquire (Context.ScratchArenaTotal - ScratchSize);
+
+    OcTraceBegin ("KernelPatch");
     OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context, NULL, 0);
+    OcTraceEnd ("KernelPatch");
 
     OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context);
 
     *KernelSize = Context.PrelinkedSize;
 
+    OcKernelStageRelease (Context.ScratchArenaTotal);
     PrelinkedContextFree (&Context);
   }
 
+  OcTraceEnd ("Prelinked");
+
   return Status;
 }
 
@@ -778,9 +942,13 @@ OcKernelProcessMkext (
     return Status;
   }
 
+  OcTraceBegin ("Mkext");
+
   OcKernelInjectKexts (Config, CacheTypeMkext, &Context, DarwinVersion, Is32Bit, 0, 0);
 
+  OcTraceBegin ("KernelPatch");
   OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypeMkext, &Context, NULL, 0);
+  OcTraceEnd ("KernelPatch");
 
   OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypeMkext, &Context);
 
@@ -789,9 +957,77 @@ OcKernelProcessMkext (
   *MkextSize = Context.MkextSize;
 
   MkextContextFree (&Context);
+
+  OcTraceEnd ("Mkext");
   return Status;
 }
 
+STATIC
+VOID
+OcKernelLoadCachelessIndex (
+  IN OUT CACHELESS_CONTEXT      *Context
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Index;
+  UINT32      IndexSize;
+
+  //
+  // The index is kept outside of the vault and cannot be trusted
+  // when the vault is in use.
+  //
+  if (!mOcConfiguration->Kernel.Scheme.CachelessIndex
+    || mOcStorage == NULL
+    || mOcStorage->HasVault
+    || mOcStorage->FileSystem == NULL) {
+    return;
+  }
+
+  Index = ReadFile (mOcStorage->FileSystem, OPEN_CORE_SLE_INDEX_PATH, &IndexSize, BASE_16MB);
+  if (Index == NULL) {
+    DEBUG ((DEBUG_INFO, "OC: Missing SLE index\n"));
+    return;
+  }
+
+  Status = CachelessContextLoadIndex (Context, Index, IndexSize);
+  DEBUG ((DEBUG_INFO, "OC: Loading %u byte SLE index - %r\n", IndexSize, Status));
+  FreePool (Index);
+}
+
+STATIC
+VOID
+OcKernelSaveCachelessIndex (
+  IN OUT CACHELESS_CONTEXT      *Context
+  )
+{
+  EFI_STATUS         Status;
+  VOID               *Index;
+  UINT32             IndexSize;
+
+  //
+  // Try saving once per context regardless of the result.
+  //
+  Context->BuiltInKextsIndexed = TRUE;
+
+  if (!mOcConfiguration->Kernel.Scheme.CachelessIndex
+    || mOcStorage == NULL
+    || mOcStorage->HasVault
+    || mOcStorage->FileSystem == NULL) {
+    return;
+  }
+
+  Status = CachelessContextExportIndex (Context, &Index, &IndexSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OC: Failed to export SLE index - %r\n", Status));
+    return;
+  }
+
+  Status = OcStorageWriteRootFileUnicode (mOcStorage, OPEN_CORE_SLE_INDEX_PATH, Index, IndexSize);
+
+  DEBUG ((DEBUG_INFO, "OC: Saving %u byte SLE index - %r\n", IndexSize, Status));
+  FreePool (Index);
+}
+
 STATIC
 EFI_STATUS
 OcKernelInitCacheless (
@@ -817,13 +1053,22 @@ OcKernelInitCacheless (
     return Status;
   }
 
+  OcTraceBegin ("Cacheless");
+
+  OcKernelLoadCachelessIndex (Context);
+
   OcKernelInjectKexts (Config, CacheTypeCacheless, Context, DarwinVersion, Is32Bit, 0, 0);
 
+  OcTraceBegin ("KernelPatch");
   OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypeCacheless, Context, NULL, 0);
+  OcTraceEnd ("KernelPatch");
 
   OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypeCacheless, Context);
 
-  return CachelessContextOverlayExtensionsDir (Context, File);
+  Status = CachelessContextOverlayExtensionsDir (Context, File);
+
+  OcTraceEnd ("Cacheless");
+  return Status;
 }
 
 STATIC
@@ -851,6 +1096,7 @@ OcKernelReadAppleKernel (
   UINT32             NumReservedKexts;
   UINT32             ReservedFullSize;
 
+  OcTraceBegin ("KextLoad");
   OcKernelLoadKextsAndReserve (
     RootFile,
     mOcStorage,
@@ -861,6 +1107,7 @@ OcKernelReadAppleKernel (
     &ReservedInfoSize,
     &NumReservedKexts
     );
+  OcTraceEnd ("KextLoad");
 
   *LinkedExpansion = KcGetSegmentFixupChainsSize (*ReservedExeSize);
   if (*LinkedExpansion == 0) {
@@ -881,6 +1128,7 @@ OcKernelReadAppleKernel (
   // Read last requested architecture for kernel.
   //
   DEBUG ((DEBUG_INFO, "OC: Trying %a XNU hook on %s\n", Is32Bit ? "32-bit" : "64-bit", FileName));
+  OcTraceBegin ("KernelRead");
   Status = ReadAppleKernel (
     KernelFile,
     Is32Bit,
@@ -891,6 +1139,7 @@ OcKernelReadAppleKernel (
     ReservedFullSize,
     Digest
     );
+  OcTraceEnd ("KernelRead");
   DEBUG ((
     DEBUG_INFO,
     "OC: Result of %a XNU hook on %s (%02X%02X%02X%02X) is %r\n",
@@ -926,6 +1175,16 @@ OcKernelReadAppleKernel (
     }
 
     *DarwinVersion = DarwinVersionNew;
+
+    DEBUG ((
+      DEBUG_INFO,
+      "OC: Kernel stage memory estimate %u KB - kernel %u KB, reserved %u KB, %u kexts %u KB\n",
+      (*AllocatedSize + mOcKernelStageMemory) / BASE_1KB,
+      *KernelSize / BASE_1KB,
+      ReservedFullSize / BASE_1KB,
+      NumReservedKexts,
+      mOcKernelStageMemory / BASE_1KB
+      ));
   }
 
   return Status;
@@ -1219,6 +1478,7 @@ OcKernelFileOpen (
       //
       // Apply patches to kernel itself, and then process prelinked.
       //
+      OcTraceBegin ("KernelPatch");
       OcKernelApplyPatches (
         mOcConfiguration,
         mOcCpuInfo,
@@ -1229,6 +1489,7 @@ OcKernelFileOpen (
         Kernel,
         KernelSize
         );
+      OcTraceEnd ("KernelPatch");
 
       PrelinkedStatus = OcKernelProcessPrelinked (
         mOcConfiguration,
@@ -1242,6 +1503,8 @@ OcKernelFileOpen (
         );
 
       DEBUG ((DEBUG_INFO, "OC: Prelinked status - %r\n", PrelinkedStatus));
+      OcKernelStageReportPeak (AllocatedSize);
+      OcTraceSave ();
 
       Status = GetFileModificationTime (*NewHandle, &ModificationTime);
       if (EFI_ERROR (Status)) {
@@ -1286,6 +1549,7 @@ OcKernelFileOpen (
       return EFI_NOT_FOUND;
     }
     
+    OcTraceBegin ("KextLoad");
     OcKernelLoadKextsAndReserve (
       This,
       mOcStorage,
@@ -1296,6 +1560,7 @@ OcKernelFileOpen (
       &ReservedInfoSize,
       &NumReservedKexts
       );
+    OcTraceEnd ("KextLoad");
 
     Result = OcOverflowAddU32 (
       ReservedInfoSize,
@@ -1307,6 +1572,7 @@ OcKernelFileOpen (
     }
 
     DEBUG ((DEBUG_INFO, "OC: Trying %a mkext hook on %s\n", mUse32BitKernel ? "32-bit" : "64-bit", FileName));
+    OcTraceBegin ("MkextRead");
     Status = ReadAppleMkext (
       *NewHandle,
       mUse32BitKernel,
@@ -1316,6 +1582,7 @@ OcKernelFileOpen (
       ReservedFullSize,
       NumReservedKexts
       );
+    OcTraceEnd ("MkextRead");
     DEBUG ((DEBUG_INFO, "OC: Result of mkext hook on %s is %r\n", FileName, Status));
 
     if (!EFI_ERROR (Status)) {
@@ -1331,6 +1598,8 @@ OcKernelFileOpen (
         AllocatedSize
         );
       DEBUG ((DEBUG_INFO, "OC: Mkext status - %r\n", Status));
+      OcKernelStageReportPeak (AllocatedSize);
+      OcTraceSave ();
       if (!EFI_ERROR (Status)) {
         Status = GetFileModificationTime (*NewHandle, &ModificationTime);
         if (EFI_ERROR (Status)) {
@@ -1371,6 +1640,7 @@ OcKernelFileOpen (
     }
     mOcCachelessInProgress = FALSE;
 
+    OcTraceBegin ("KextLoad");
     OcKernelLoadKextsAndReserve (
       This,
       mOcStorage,
@@ -1381,6 +1651,7 @@ OcKernelFileOpen (
       &ReservedInfoSize,
       &NumReservedKexts
       );
+    OcTraceEnd ("KextLoad");
 
     //
     // Initialize Extensions directory overlay for cacheless injection.
@@ -1396,6 +1667,7 @@ OcKernelFileOpen (
       );
     
     DEBUG ((DEBUG_INFO, "OC: Result of SLE hook on %s is %r\n", FileName, Status));
+    OcTraceSave ();
 
     if (!EFI_ERROR (Status)) {
       mOcCachelessInProgress  = TRUE;
@@ -1410,17 +1682,27 @@ OcKernelFileOpen (
   if (mOcCachelessInProgress
     && OpenMode == EFI_FILE_MODE_READ
     && StrnCmp (FileName, L"System\\Library\\Extensions\\", L_STR_LEN (L"System\\Library\\Extensions\\")) == 0) {
+      OcTraceBegin ("CachelessHook");
       Status = CachelessContextHookBuiltin (
         &mOcCachelessContext,
         FileName,
         *NewHandle,
         &VirtualFileHandle
         );
+      OcTraceEnd ("CachelessHook");
 
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_INFO, "OC: Error SLE hooking %s - %r\n", FileName, Status));
       }
 
+      //
+      // Persist built-in kext list once it is built by a full scan.
+      //
+      if (mOcCachelessContext.BuiltInKextsValid && !mOcCachelessContext.BuiltInKextsIndexed) {
+        OcKernelSaveCachelessIndex (&mOcCachelessContext);
+        OcTraceSave ();
+      }
+
       if (!EFI_ERROR (Status) && VirtualFileHandle != NULL) {
         *NewHandle = VirtualFileHandle;
         return EFI_SUCCESS;
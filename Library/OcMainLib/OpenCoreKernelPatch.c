@@ -125,6 +125,9 @@ OcKernelApplyPatches (
         Arch,
         Is32Bit ? "i386" : "x86_64"
         ));
+      if (IsKernelPatch) {
+        MachoFreeSymbolIndex (&KernelPatcher.MachContext);
+      }
       return;
     }
 
@@ -340,6 +343,8 @@ OcKernelApplyPatches (
     if (Config->Kernel.Quirks.LegacyCommpage) {
       OcKernelApplyQuirk (KernelQuirkLegacyCommpage, CacheType, DarwinVersion, NULL, &KernelPatcher);     
     }
+
+    MachoFreeSymbolIndex (&KernelPatcher.MachContext);
   }
 }
 
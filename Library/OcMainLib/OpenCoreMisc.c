@@ -28,6 +28,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcDebugLogLib.h>
 #include <Library/OcSmbiosLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/PrintLib.h>
 #include <Library/SerialPortLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -373,7 +374,6 @@ SavePanicLog (
 {
   EFI_STATUS         Status;
   VOID               *PanicLog;
-  EFI_FILE_PROTOCOL  *RootFs;
   UINT32             PanicLogSize;
   EFI_TIME           PanicLogDate;
   CHAR16             PanicLogName[32];
@@ -397,14 +397,7 @@ SavePanicLog (
       (UINT32) PanicLogDate.Second
       );
 
-    Status = Storage->FileSystem->OpenVolume (
-      Storage->FileSystem,
-      &RootFs
-      );
-    if (!EFI_ERROR (Status)) {
-      Status = SetFileData (RootFs, PanicLogName, PanicLog, PanicLogSize);
-      RootFs->Close (RootFs);
-    }
+    Status = OcStorageWriteRootFileUnicode (Storage, PanicLogName, PanicLog, PanicLogSize);
 
     DEBUG ((DEBUG_INFO, "OC: Saving %u byte panic log %s - %r\n", PanicLogSize, PanicLogName, Status));
     FreePool (PanicLog);
@@ -559,6 +552,8 @@ OcMiscEarlyInit (
     SerialPortInitialize ();
   }
 
+  OcTraceConfigure (Config->Misc.Debug.BootTrace);
+
   OcConfigureLogProtocol (
     Config->Misc.Debug.Target,
     Config->Misc.Debug.DisplayDelay,
@@ -966,6 +961,8 @@ OcMiscBoot (
   Context->PlayAudioBeep         = OcPlayAudioBeep;
   Context->PlayAudioEntry        = OcPlayAudioEntry;
   Context->ToggleVoiceOver       = OcToggleVoiceOver;
+  Context->ScanNextFileSystem    = OcScanNextFileSystem;
+  Context->RevalidateBootEntries = OcRevalidateBootEntries;
   Context->PickerMode            = PickerMode;
   Context->ConsoleAttributes     = Config->Misc.Boot.ConsoleAttributes;
   Context->PickerAttributes      = Config->Misc.Boot.PickerAttributes;
@@ -1021,6 +1018,7 @@ OcMiscBoot (
   Context->AllCustomEntryCount = EntryIndex;
   Context->PollAppleHotKeys    = Config->Misc.Boot.PollAppleHotKeys;
   Context->HideAuxiliary       = Config->Misc.Boot.HideAuxiliary;
+  Context->ScanCache           = Config->Misc.Boot.ScanCache;
   Context->PickerAudioAssist   = Config->Misc.Boot.PickerAudioAssist;
 
   DEBUG ((DEBUG_INFO, "OC: Ready for takeoff in %u us\n", (UINT32) Context->TakeoffDelay));
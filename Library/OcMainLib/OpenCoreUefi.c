@@ -47,6 +47,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcRtcLib.h>
 #include <Library/OcSmcLib.h>
 #include <Library/OcOSInfoLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcUnicodeCollationEngGenericLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -80,6 +81,36 @@ OcScheduleExitBootServices (
   ++mOcExitBootServicesIndex;
 }
 
+STATIC
+VOID
+OcPrefetchDrivers (
+  IN  OC_STORAGE_CONTEXT  *Storage,
+  IN  OC_GLOBAL_CONFIG    *Config
+  )
+{
+  UINT32       Index;
+  CONST CHAR8  *DriverName;
+  CONST CHAR8  **DriverNames;
+
+  if (!Config->Misc.Security.VaultPrefetch || !Storage->HasVault || Config->Uefi.Drivers.Count == 0) {
+    return;
+  }
+
+  DriverNames = AllocatePool (Config->Uefi.Drivers.Count * sizeof (*DriverNames));
+  if (DriverNames == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < Config->Uefi.Drivers.Count; ++Index) {
+    DriverName         = OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]);
+    DriverNames[Index] = DriverName[0] != '#' ? DriverName : NULL;
+  }
+
+  OcStoragePrefetchFilesAscii (Storage, OPEN_CORE_UEFI_DRIVER_PATH, DriverNames, NULL, Config->Uefi.Drivers.Count);
+
+  FreePool (DriverNames);
+}
+
 STATIC
 VOID
 OcLoadDrivers (
@@ -105,6 +136,8 @@ OcLoadDrivers (
 
   DEBUG ((DEBUG_INFO, "OC: Got %u drivers\n", Config->Uefi.Drivers.Count));
 
+  OcPrefetchDrivers (Storage, Config);
+
   for (Index = 0; Index < Config->Uefi.Drivers.Count; ++Index) {
     SkipDriver = OC_BLOB_GET (Config->Uefi.Drivers.Values[Index])[0] == '#';
 
@@ -139,6 +172,8 @@ OcLoadDrivers (
       continue;
     }
 
+    OcTraceBegin (OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]));
+
     Driver = OcStorageReadFileUnicode (Storage, DriverPath, &DriverSize);
     if (Driver == NULL) {
       DEBUG ((
@@ -147,6 +182,7 @@ OcLoadDrivers (
         OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]),
         Index
         ));
+      OcTraceEnd (OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]));
       //
       // TODO: This should cause security violation if configured!
       //
@@ -174,6 +210,7 @@ OcLoadDrivers (
         Status
         ));
       FreePool (Driver);
+      OcTraceEnd (OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]));
       continue;
     }
 
@@ -223,6 +260,7 @@ OcLoadDrivers (
             } else {
               DEBUG ((DEBUG_ERROR, "OC: Failed to allocate memory for drivers to connect\n"));
               FreePool (Driver);
+              OcStoragePrefetchFilesUnicode (Storage, NULL, 0);
               return;
             }
           }
@@ -241,8 +279,14 @@ OcLoadDrivers (
     }
 
     FreePool (Driver);
+    OcTraceEnd (OC_BLOB_GET (Config->Uefi.Drivers.Values[Index]));
   }
 
+  //
+  // Release prefetched files of drivers failing to load.
+  //
+  OcStoragePrefetchFilesUnicode (Storage, NULL, 0);
+
   //
   // Driver connection list should be null-terminated.
   //
@@ -780,6 +824,7 @@ OcLoadUefiSupport (
   //
   OcReserveMemory (Config);
 
+  OcTraceBegin ("Drivers");
   if (Config->Uefi.ConnectDrivers) {
     OcLoadDrivers (Storage, Config, &DriversToConnect);
     DEBUG ((DEBUG_INFO, "OC: Connecting drivers...\n"));
@@ -789,11 +834,14 @@ OcLoadUefiSupport (
       // DriversToConnect is not freed as it is owned by OcRegisterDriversToHighestPriority.
       //
     }
+    OcTraceBegin ("Connect");
     OcConnectDrivers ();
+    OcTraceEnd ("Connect");
     DEBUG ((DEBUG_INFO, "OC: Connecting drivers done...\n"));
   } else {
     OcLoadDrivers (Storage, Config, NULL);
   }
+  OcTraceEnd ("Drivers");
 
   if (Config->Uefi.Apfs.EnableJumpstart) {
     OcApfsConfigure (
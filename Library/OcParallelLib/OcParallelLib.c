@@ -0,0 +1,240 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Uefi.h>
+#include <Protocol/MpService.h>
+
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcParallelLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+/**
+  Time given to application processors to finish all jobs, in microseconds.
+  Jobs not completed by then are run on the BSP.
+**/
+#define OC_PARALLEL_TIMEOUT  10000000
+
+/**
+  Per-processor job queue covering job indices [Next, End).
+**/
+typedef struct {
+  volatile UINT32  Next;
+  UINT32           End;
+} OC_PARALLEL_QUEUE;
+
+/**
+  Job dispatch state shared by all processors.
+**/
+typedef struct {
+  OC_PARALLEL_JOB    Job;
+  VOID               *Context;
+  OC_PARALLEL_QUEUE  *Queues;
+  UINT32             QueueCount;
+  volatile UINT32    NextWorker;
+  volatile BOOLEAN   *Done;
+} OC_PARALLEL_STATE;
+
+STATIC
+UINTN
+InternalParallelGetApCount (
+  OUT EFI_MP_SERVICES_PROTOCOL  **MpServices
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+
+  Status = gBS->LocateProtocol (
+    &gEfiMpServiceProtocolGuid,
+    NULL,
+    (VOID **) MpServices
+    );
+  if (EFI_ERROR (Status)) {
+    return 0;
+  }
+
+  Status = (*MpServices)->GetNumberOfProcessors (
+    *MpServices,
+    &NumberOfProcessors,
+    &NumberOfEnabledProcessors
+    );
+  if (EFI_ERROR (Status) || NumberOfEnabledProcessors == 0) {
+    return 0;
+  }
+
+  return NumberOfEnabledProcessors - 1;
+}
+
+STATIC
+VOID
+InternalParallelRunQueue (
+  IN OUT OC_PARALLEL_STATE  *State,
+  IN OUT OC_PARALLEL_QUEUE  *Queue
+  )
+{
+  UINT32  Index;
+
+  while (Queue->Next < Queue->End) {
+    Index = InterlockedIncrement (&Queue->Next) - 1;
+    if (Index >= Queue->End) {
+      break;
+    }
+
+    State->Job (Index, State->Context);
+    State->Done[Index] = TRUE;
+  }
+}
+
+STATIC
+VOID
+EFIAPI
+InternalParallelWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  OC_PARALLEL_STATE  *State;
+  UINT32             Slot;
+  UINT32             Index;
+
+  State = Buffer;
+  Slot  = InterlockedIncrement (&State->NextWorker) - 1;
+
+  //
+  // Drain own queue first, then steal from the others.
+  //
+  for (Index = 0; Index < State->QueueCount; ++Index) {
+    InternalParallelRunQueue (
+      State,
+      &State->Queues[(Slot + Index) % State->QueueCount]
+      );
+  }
+}
+
+UINTN
+OcParallelGetWorkerCount (
+  VOID
+  )
+{
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+
+  return InternalParallelGetApCount (&MpServices) + 1;
+}
+
+VOID
+OcParallelRun (
+  IN     OC_PARALLEL_JOB  Job,
+  IN OUT VOID             *Context,
+  IN     UINTN            JobCount
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  OC_PARALLEL_STATE         State;
+  UINTN                     ApCount;
+  UINTN                     JobIndex;
+  UINT32                    Index;
+  UINT32                    Start;
+  UINT32                    PerQueue;
+  UINT32                    Extra;
+
+  ASSERT (Job != NULL);
+
+  ApCount = 0;
+  if (JobCount > 1 && JobCount <= MAX_UINT32 / 2) {
+    ApCount = InternalParallelGetApCount (&MpServices);
+  }
+
+  State.Queues = NULL;
+  State.Done   = NULL;
+  if (ApCount > 0) {
+    State.QueueCount = (UINT32) MIN (ApCount, JobCount);
+    State.Queues     = AllocatePool (State.QueueCount * sizeof (*State.Queues));
+    State.Done       = AllocateZeroPool (JobCount * sizeof (*State.Done));
+  }
+
+  if (State.Queues == NULL || State.Done == NULL) {
+    if (State.Queues != NULL) {
+      FreePool (State.Queues);
+    }
+
+    if (State.Done != NULL) {
+      FreePool ((VOID *) State.Done);
+    }
+
+    for (JobIndex = 0; JobIndex < JobCount; ++JobIndex) {
+      Job (JobIndex, Context);
+    }
+    return;
+  }
+
+  State.Job        = Job;
+  State.Context    = Context;
+  State.NextWorker = 0;
+
+  //
+  // Split jobs into contiguous ranges, one per processor, as neighbouring
+  // jobs are likely to touch neighbouring memory.
+  //
+  PerQueue = (UINT32) JobCount / State.QueueCount;
+  Extra    = (UINT32) JobCount % State.QueueCount;
+  Start    = 0;
+  for (Index = 0; Index < State.QueueCount; ++Index) {
+    State.Queues[Index].Next = Start;
+    Start                   += PerQueue + (Index < Extra ? 1 : 0);
+    State.Queues[Index].End  = Start;
+  }
+
+  //
+  // Blocking mode is used on purpose. Completion of non-blocking requests is
+  // only noticed by a periodic timer in EDK II based firmware, which adds up
+  // to 100 ms per call, far more than the BSP could contribute. StartupThisAP
+  // is not used for the same reason: it either needs non-blocking mode or
+  // serialises the APs. Bound the wait, so that a hung AP cannot stall boot.
+  // On timeout the APs are terminated as per UEFI PI specification.
+  //
+  Status = MpServices->StartupAllAPs (
+    MpServices,
+    InternalParallelWorker,
+    FALSE,
+    NULL,
+    OC_PARALLEL_TIMEOUT,
+    &State,
+    NULL
+    );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCPL: Failed to run %u APs - %r\n", (UINT32) ApCount, Status));
+  }
+
+  //
+  // Run whatever is left on the BSP, e.g. when the APs could not be started.
+  //
+  InternalParallelWorker (&State);
+
+  //
+  // Jobs taken by terminated APs may be incomplete, run them again.
+  //
+  if (Status == EFI_TIMEOUT) {
+    for (JobIndex = 0; JobIndex < JobCount; ++JobIndex) {
+      if (!State.Done[JobIndex]) {
+        Job (JobIndex, Context);
+      }
+    }
+  }
+
+  FreePool (State.Queues);
+  FreePool ((VOID *) State.Done);
+}
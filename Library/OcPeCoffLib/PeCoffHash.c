@@ -17,11 +17,14 @@
 
 /**
   Hashes the Image Section data in ascending order of raw file apprearance.
+  When Destination is not NULL, every Section is also loaded right after
+  hashing each chunk of it, so that the raw file is only swept once.
 
   @param[in]     Context      The context describing the Image. Must have been
                               initialised by PeCoffInitializeContext().
   @param[in]     HashUpdate   The data hashing function.
   @param[in,out] HashContext  The context of the current hash.
+  @param[out]    Destination  The aligned Image destination memory, optional.
 
   @returns  Whether hashing has been successful.
 **/
@@ -31,7 +34,8 @@ BOOLEAN
 InternalHashSections (
   IN     CONST PE_COFF_IMAGE_CONTEXT  *Context,
   IN     PE_COFF_HASH_UPDATE          HashUpdate,
-  IN OUT VOID                         *HashContext
+  IN OUT VOID                         *HashContext,
+  OUT    VOID                         *Destination OPTIONAL
   )
 {
   BOOLEAN                        Result;
@@ -41,6 +45,10 @@ InternalHashSections (
   UINT16                         SectIndex;
   UINT16                         SectionPos;
   UINT32                         SectionTop;
+  CONST CHAR8                    *RawData;
+  UINT32                         DataSize;
+  UINT32                         ChunkOffset;
+  UINT32                         ChunkSize;
   //
   // 9. Build a temporary table of pointers to all of the section headers in the
   //   image. The NumberOfSections field of COFF File Header indicates how big
@@ -102,15 +110,59 @@ InternalHashSections (
     //     SectionHeader structure to determine the amount of data to hash.
     //
 
-    if (SortedSections[SectIndex]->SizeOfRawData > 0) {
-      Result = HashUpdate (
-                 HashContext,
-                 (CONST CHAR8 *) Context->FileBuffer + SortedSections[SectIndex]->PointerToRawData,
-                 SortedSections[SectIndex]->SizeOfRawData
-                 );
+    RawData = (CONST CHAR8 *) Context->FileBuffer + SortedSections[SectIndex]->PointerToRawData;
+
+    if (Destination == NULL) {
+      if (SortedSections[SectIndex]->SizeOfRawData > 0) {
+        Result = HashUpdate (
+                   HashContext,
+                   RawData,
+                   SortedSections[SectIndex]->SizeOfRawData
+                   );
+        if (!Result) {
+          break;
+        }
+      }
+
+      continue;
+    }
+
+    //
+    // Only the part of the raw data within the virtual size is loaded.
+    //
+    if (SortedSections[SectIndex]->VirtualSize < SortedSections[SectIndex]->SizeOfRawData) {
+      DataSize = SortedSections[SectIndex]->VirtualSize;
+    } else {
+      DataSize = SortedSections[SectIndex]->SizeOfRawData;
+    }
+
+    //
+    // Copy every chunk while it is still cached after hashing.
+    //
+    for (ChunkOffset = 0;
+      ChunkOffset < SortedSections[SectIndex]->SizeOfRawData;
+      ChunkOffset += ChunkSize) {
+      ChunkSize = MIN (
+        SortedSections[SectIndex]->SizeOfRawData - ChunkOffset,
+        PE_COFF_LOAD_CHUNK_SIZE
+        );
+
+      Result = HashUpdate (HashContext, RawData + ChunkOffset, ChunkSize);
       if (!Result) {
         break;
       }
+
+      if (ChunkOffset < DataSize) {
+        CopyMem (
+          (CHAR8 *) Destination + SortedSections[SectIndex]->VirtualAddress + ChunkOffset,
+          RawData + ChunkOffset,
+          MIN (ChunkSize, DataSize - ChunkOffset)
+          );
+      }
+    }
+
+    if (!Result) {
+      break;
     }
   }
 
@@ -119,10 +171,11 @@ InternalHashSections (
 }
 
 BOOLEAN
-PeCoffHashImage (
+PeCoffInternalHashImage (
   IN     CONST PE_COFF_IMAGE_CONTEXT  *Context,
   IN     PE_COFF_HASH_UPDATE          HashUpdate,
-  IN OUT VOID                         *HashContext
+  IN OUT VOID                         *HashContext,
+  OUT    VOID                         *Destination OPTIONAL
   )
 {
   BOOLEAN                      Result;
@@ -239,7 +292,8 @@ PeCoffHashImage (
   return InternalHashSections (
            Context,
            HashUpdate,
-           HashContext
+           HashContext,
+           Destination
            );
 
   //
@@ -252,3 +306,18 @@ PeCoffHashImage (
   // 15. Finalize the hash algorithm context.
   //
 }
+
+BOOLEAN
+PeCoffHashImage (
+  IN     CONST PE_COFF_IMAGE_CONTEXT  *Context,
+  IN     PE_COFF_HASH_UPDATE          HashUpdate,
+  IN OUT VOID                         *HashContext
+  )
+{
+  return PeCoffInternalHashImage (
+           Context,
+           HashUpdate,
+           HashContext,
+           NULL
+           );
+}
@@ -76,6 +76,12 @@
 #define IMAGE_RELOC_SUPPORTED(Reloc) \
   IMAGE_RELOC_TYPE_SUPPORTED (IMAGE_RELOC_TYPE (Reloc))
 
+//
+// Size of the raw file chunks hashed and loaded at once by
+// PeCoffLoadRelocateImage(), chosen to stay within the L2 cache.
+//
+#define PE_COFF_LOAD_CHUNK_SIZE  SIZE_64KB
+
 //
 // 4 byte alignment has been replaced with OC_ALIGNOF (EFI_IMAGE_BASE_RELOCATION_BLOCK)
 // for proof simplicity. This obviously was the original intention of the
@@ -86,4 +92,26 @@ STATIC_ASSERT (
   "The current model violates the PE specification"
   );
 
+/**
+  Hashes the Image using the Authenticode (PE/COFF Specification 8.1 Appendix A)
+  algorithm and optionally loads the Image Sections in the same pass.
+
+  @param[in]     Context      The context describing the Image. Must have been
+                              initialised by PeCoffInitializeContext().
+  @param[in]     HashUpdate   The data hashing function.
+  @param[in,out] HashContext  The context of the current hash.
+  @param[out]    Destination  If not NULL, the aligned Image destination memory
+                              to load the Image Section data to. The remaining
+                              memory is not initialised.
+
+  @returns  Whether hashing has been successful.
+**/
+BOOLEAN
+PeCoffInternalHashImage (
+  IN     CONST PE_COFF_IMAGE_CONTEXT  *Context,
+  IN     PE_COFF_HASH_UPDATE          HashUpdate,
+  IN OUT VOID                         *HashContext,
+  OUT    VOID                         *Destination OPTIONAL
+  );
+
 #endif // PE_COFF_INTERNAL_H
@@ -19,6 +19,8 @@
   @param[in]  Context           The context describing the Image. Must have been
                                 initialised by PeCoffInitializeContext().
   @param[in]  LoadedHeaderSize  The size, in bytes, of the loaded Image Headers.
+  @param[in]  LoadData          Whether to load the Section data, or to only
+                                initialise the padding with zeros.
   @param[out] Destination       The Image destination memory.
   @param[in]  DestinationSize   The size, in bytes, of Destination.
                                 Must be at least
@@ -34,6 +36,7 @@ VOID
 InternalLoadSections (
   IN  CONST PE_COFF_IMAGE_CONTEXT  *Context,
   IN  UINT32                       LoadedHeaderSize,
+  IN  BOOLEAN                      LoadData,
   OUT VOID                         *Destination,
   IN  UINT32                       DestinationSize
   )
@@ -68,11 +71,13 @@ InternalLoadSections (
     //
     // Load the current Section into memory.
     //
-    CopyMem (
-      (CHAR8 *) Destination + Sections[Index].VirtualAddress,
-      (CONST CHAR8 *) Context->FileBuffer + (Sections[Index].PointerToRawData - Context->TeStrippedOffset),
-      DataSize
-      );
+    if (LoadData) {
+      CopyMem (
+        (CHAR8 *) Destination + Sections[Index].VirtualAddress,
+        (CONST CHAR8 *) Context->FileBuffer + (Sections[Index].PointerToRawData - Context->TeStrippedOffset),
+        DataSize
+        );
+    }
 
     PreviousTopRva = Sections[Index].VirtualAddress + DataSize;
   }
@@ -86,25 +91,37 @@ InternalLoadSections (
     );
 }
 
-RETURN_STATUS
-PeCoffLoadImage (
-  IN OUT PE_COFF_IMAGE_CONTEXT  *Context,
-  OUT    VOID                   *Destination,
-  IN     UINT32                 DestinationSize
+/**
+  Aligns the Image destination memory and loads the Image Headers if
+  configured.
+
+  @param[in]  Context           The context describing the Image. Must have been
+                                initialised by PeCoffInitializeContext().
+  @param[out] Destination       The Image destination memory.
+  @param[in]  DestinationSize   The size, in bytes, of Destination.
+  @param[out] AlignedSize       On output, the size, in bytes, of the aligned
+                                Image destination memory.
+  @param[out] LoadedHeaderSize  On output, the size, in bytes, of the loaded
+                                Image Headers.
+
+  @returns  The aligned Image destination memory.
+**/
+STATIC
+CHAR8 *
+InternalPrepareDestination (
+  IN  CONST PE_COFF_IMAGE_CONTEXT  *Context,
+  OUT VOID                         *Destination,
+  IN  UINT32                       DestinationSize,
+  OUT UINT32                       *AlignedSize,
+  OUT UINT32                       *LoadedHeaderSize
   )
 {
   CHAR8                          *AlignedDest;
   UINT32                         AlignOffset;
-  UINT32                         AlignedSize;
-  UINT32                         LoadedHeaderSize;
   CONST EFI_IMAGE_SECTION_HEADER *Sections;
   UINTN                          Address;
   UINTN                          AlignedAddress;
 
-  ASSERT (Context != NULL);
-  ASSERT (Destination != NULL);
-  ASSERT (DestinationSize >= Context->SectionAlignment);
-
   //
   // Correctly align the Image data in memory.
   //
@@ -114,20 +131,20 @@ PeCoffLoadImage (
     // The caller is required to allocate page memory, hence we have at least
     // 4 KB alignment guaranteed.
     //
-    AlignedDest = Destination;
-    AlignedSize = DestinationSize;
-    AlignOffset = 0;
+    AlignedDest  = Destination;
+    *AlignedSize = DestinationSize;
+    AlignOffset  = 0;
   } else {
     Address = PTR_TO_ADDR (Destination, DestinationSize);
     AlignedAddress = ALIGN_VALUE (Address, (UINTN) Context->SectionAlignment);
     AlignOffset = (UINT32) (AlignedAddress - Address);
-    AlignedSize = DestinationSize - AlignOffset;
-    ASSERT (Context->SizeOfImage <= AlignedSize);
+    *AlignedSize = DestinationSize - AlignOffset;
+    ASSERT (Context->SizeOfImage <= *AlignedSize);
     AlignedDest = (CHAR8 *) Destination + AlignOffset;
     ZeroMem (Destination, AlignOffset);
   }
 
-  ASSERT (AlignedSize >= Context->SizeOfImage);
+  ASSERT (*AlignedSize >= Context->SizeOfImage);
 
   Sections = (CONST EFI_IMAGE_SECTION_HEADER *) (CONST VOID *) (
                (CONST CHAR8 *) Context->FileBuffer + Context->SectionsOffset
@@ -137,15 +154,47 @@ PeCoffLoadImage (
   //
 
   if (Sections[0].VirtualAddress != 0 && PcdGetBool (PcdImageLoaderLoadHeader)) {
-    LoadedHeaderSize = (Context->SizeOfHeaders - Context->TeStrippedOffset);
-    CopyMem (AlignedDest, Context->FileBuffer, LoadedHeaderSize);
+    *LoadedHeaderSize = (Context->SizeOfHeaders - Context->TeStrippedOffset);
+    //
+    // The Image Headers are already in place when loading in place.
+    //
+    if (AlignedDest != Context->FileBuffer) {
+      CopyMem (AlignedDest, Context->FileBuffer, *LoadedHeaderSize);
+    }
   } else {
-    LoadedHeaderSize = 0;
+    *LoadedHeaderSize = 0;
   }
 
+  return AlignedDest;
+}
+
+RETURN_STATUS
+PeCoffLoadImage (
+  IN OUT PE_COFF_IMAGE_CONTEXT  *Context,
+  OUT    VOID                   *Destination,
+  IN     UINT32                 DestinationSize
+  )
+{
+  CHAR8                          *AlignedDest;
+  UINT32                         AlignedSize;
+  UINT32                         LoadedHeaderSize;
+
+  ASSERT (Context != NULL);
+  ASSERT (Destination != NULL);
+  ASSERT (DestinationSize >= Context->SectionAlignment);
+
+  AlignedDest = InternalPrepareDestination (
+    Context,
+    Destination,
+    DestinationSize,
+    &AlignedSize,
+    &LoadedHeaderSize
+    );
+
   InternalLoadSections (
     Context,
     LoadedHeaderSize,
+    TRUE,
     AlignedDest,
     AlignedSize
     );
@@ -163,6 +212,133 @@ PeCoffLoadImage (
   return RETURN_SUCCESS;
 }
 
+BOOLEAN
+PeCoffCanLoadInPlace (
+  IN CONST PE_COFF_IMAGE_CONTEXT  *Context,
+  IN UINT32                       BufferSize
+  )
+{
+  CONST EFI_IMAGE_SECTION_HEADER *Sections;
+  UINT16                         Index;
+
+  ASSERT (Context != NULL);
+
+  //
+  // The raw file must be page memory large enough to hold the loaded Image,
+  // and there must be no space needed beyond the Image for debug information.
+  //
+  if (Context->SectionAlignment > EFI_PAGE_SIZE
+    || !IS_ALIGNED ((UINTN) Context->FileBuffer, EFI_PAGE_SIZE)
+    || BufferSize < Context->SizeOfImage
+    || Context->SizeOfImageDebugAdd != 0
+    || Context->TeStrippedOffset != 0) {
+    return FALSE;
+  }
+
+  Sections = (CONST EFI_IMAGE_SECTION_HEADER *) (CONST VOID *) (
+               (CONST CHAR8 *) Context->FileBuffer + Context->SectionsOffset
+               );
+
+  //
+  // The Section Headers are referenced from the raw file after loading.
+  //
+  if (Sections[0].VirtualAddress != 0 && !PcdGetBool (PcdImageLoaderLoadHeader)) {
+    return FALSE;
+  }
+
+  //
+  // Every Section must already reside at its RVA in the raw file. As the
+  // Sections are ordered by RVA, zeroing their padding then never touches
+  // data of other Sections.
+  //
+  for (Index = 0; Index < Context->NumberOfSections; ++Index) {
+    if (Sections[Index].SizeOfRawData > 0
+      && Sections[Index].PointerToRawData != Sections[Index].VirtualAddress) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+RETURN_STATUS
+PeCoffLoadRelocateImage (
+  IN OUT PE_COFF_IMAGE_CONTEXT  *Context,
+  OUT    VOID                   *Destination,
+  IN     UINT32                 DestinationSize,
+  IN     PE_COFF_HASH_UPDATE    HashUpdate OPTIONAL,
+  IN OUT VOID                   *HashContext OPTIONAL
+  )
+{
+  BOOLEAN                        Result;
+  BOOLEAN                        InPlace;
+  CHAR8                          *AlignedDest;
+  UINT32                         AlignedSize;
+  UINT32                         LoadedHeaderSize;
+
+  ASSERT (Context != NULL);
+  ASSERT (Destination != NULL);
+  ASSERT (DestinationSize >= Context->SectionAlignment);
+
+  InPlace = Destination == Context->FileBuffer;
+
+  if (InPlace) {
+    ASSERT (PeCoffCanLoadInPlace (Context, DestinationSize));
+    //
+    // Hash the raw file before its padding is zeroed and it is relocated.
+    //
+    if (HashUpdate != NULL) {
+      Result = PeCoffInternalHashImage (Context, HashUpdate, HashContext, NULL);
+      if (!Result) {
+        return RETURN_UNSUPPORTED;
+      }
+    }
+    //
+    // Memory past the Image is not owned by the Image.
+    //
+    DestinationSize = Context->SizeOfImage;
+  }
+
+  AlignedDest = InternalPrepareDestination (
+    Context,
+    Destination,
+    DestinationSize,
+    &AlignedSize,
+    &LoadedHeaderSize
+    );
+
+  //
+  // When hashing, load the Sections within the same raw file sweep.
+  //
+  InternalLoadSections (
+    Context,
+    LoadedHeaderSize,
+    !InPlace && HashUpdate == NULL,
+    AlignedDest,
+    AlignedSize
+    );
+
+  if (!InPlace && HashUpdate != NULL) {
+    Result = PeCoffInternalHashImage (Context, HashUpdate, HashContext, AlignedDest);
+    if (!Result) {
+      return RETURN_UNSUPPORTED;
+    }
+  }
+
+  Context->ImageBuffer = AlignedDest;
+
+  if (PcdGetBool (PcdImageLoaderSupportDebug)) {
+    PeCoffLoaderLoadCodeView (Context);
+  }
+
+  return PeCoffRelocateImage (
+           Context,
+           (UINTN) AlignedDest,
+           NULL,
+           0
+           );
+}
+
 //
 // TODO: Provide a Runtime version of this API as well.
 //
@@ -155,6 +155,10 @@ static void lodepng_memset(void* LODEPNG_RESTRICT dst,
   SetMem (dst, num, (UINT8) value);
 }
 
+unsigned lodepng_crc32(const unsigned char* data, size_t length) {
+  return Crc32 (data, length);
+}
+
 #else
 
 static void* lodepng_reallocate(void* ptr, size_t old_size, size_t new_size) {
@@ -2206,6 +2210,10 @@ static unsigned deflate(unsigned char** out, size_t* outsize,
 /* ////////////////////////////////////////////////////////////////////////// */
 
 static unsigned update_adler32(unsigned adler, const unsigned char* data, unsigned len) {
+#ifdef EFIAPI
+  /* OC: Use the shared (vectorised) implementation. */
+  return Adler32Update (adler, data, len);
+#else
   unsigned s1 = adler & 0xffffu;
   unsigned s2 = (adler >> 16u) & 0xffffu;
 
@@ -2223,6 +2231,7 @@ static unsigned update_adler32(unsigned adler, const unsigned char* data, unsign
   }
 
   return (s2 << 16u) | s1;
+#endif
 }
 
 /*Return the adler32 of the bytes data[0..len-1]*/
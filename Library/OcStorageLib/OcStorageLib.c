@@ -22,6 +22,7 @@
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcDevicePathLib.h>
+#include <Library/OcParallelLib.h>
 #include <Library/OcStringLib.h>
 #include <Library/OcStorageLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -119,6 +120,106 @@ mVaultSchema = {
   .Dict = {mVaultNodesSchema, ARRAY_SIZE (mVaultNodesSchema)}
 };
 
+/**
+  Chunk size for reading and hashing files at the same time.
+**/
+#define OC_STORAGE_READ_CHUNK SIZE_1MB
+
+/**
+  Vault digest verification job entry.
+**/
+typedef struct {
+  CONST UINT8  *Buffer;
+  UINT32       Size;
+  CONST UINT8  *Digest;
+  BOOLEAN      Valid;
+} OC_STORAGE_VERIFY_ENTRY;
+
+STATIC
+UINT32
+OcStorageHashPath (
+  IN CONST VOID  *Path,
+  IN BOOLEAN     IsUnicode,
+  OUT UINT32     *Length
+  )
+{
+  UINT32  Hash;
+  UINT32  Char;
+  UINT32  Index;
+
+  //
+  // FNV-1a over character codes, so that ASCII vault keys and Unicode
+  // file paths produce the same hash.
+  //
+  Hash  = 0x811C9DC5U;
+  Index = 0;
+  while (TRUE) {
+    if (IsUnicode) {
+      Char = ((CONST CHAR16 *) Path)[Index];
+    } else {
+      Char = (UINT8) ((CONST CHAR8 *) Path)[Index];
+    }
+
+    if (Char == 0) {
+      break;
+    }
+
+    Hash = (Hash ^ Char) * 0x01000193U;
+    ++Index;
+  }
+
+  *Length = Index;
+  return Hash;
+}
+
+STATIC
+BOOLEAN
+OcStorageBuildVaultIndex (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  UINT32  Index;
+  UINT32  Slot;
+  UINT32  Size;
+  UINT32  Length;
+  UINT32  Count;
+
+  Count = Context->Vault.Files.Count;
+  if (Count > MAX_UINT32 / 4) {
+    return FALSE;
+  }
+
+  //
+  // Keep load factor at or below 50% to make probe chains short.
+  //
+  Size = 16;
+  while (Size < Count * 2) {
+    Size *= 2;
+  }
+
+  Context->VaultIndex = AllocateZeroPool (Size * sizeof (*Context->VaultIndex));
+  if (Context->VaultIndex == NULL) {
+    return FALSE;
+  }
+
+  Context->VaultIndexMask = Size - 1;
+
+  for (Index = 0; Index < Count; ++Index) {
+    Slot = OcStorageHashPath (
+      OC_BLOB_GET (Context->Vault.Files.Keys[Index]),
+      FALSE,
+      &Length
+      ) & Context->VaultIndexMask;
+
+    while (Context->VaultIndex[Slot] != 0) {
+      Slot = (Slot + 1) & Context->VaultIndexMask;
+    }
+
+    Context->VaultIndex[Slot] = Index + 1;
+  }
+
+  return TRUE;
+}
 
 STATIC
 EFI_STATUS
@@ -168,11 +269,33 @@ OcStorageInitializeVault (
     return EFI_UNSUPPORTED;
   }
 
+  if (!OcStorageBuildVaultIndex (Context)) {
+    OC_STORAGE_VAULT_DESTRUCT (&Context->Vault, sizeof (Context->Vault));
+    DEBUG ((DEBUG_ERROR, "OCST: Cannot index %u vault files\n", Context->Vault.Files.Count));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   Context->HasVault = TRUE;
 
   return EFI_SUCCESS;
 }
 
+STATIC
+VOID
+OcStorageFreeVault (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  if (Context->VaultIndex != NULL) {
+    FreePool (Context->VaultIndex);
+    Context->VaultIndex     = NULL;
+    Context->VaultIndexMask = 0;
+  }
+
+  OC_STORAGE_VAULT_DESTRUCT (&Context->Vault, sizeof (Context->Vault));
+  Context->HasVault = FALSE;
+}
+
 STATIC
 UINT8 *
 OcStorageGetDigest (
@@ -181,30 +304,34 @@ OcStorageGetDigest (
   )
 {
   UINT32             Index;
-  UINTN              StrIndex;
+  UINT32             Slot;
+  UINT32             StrIndex;
+  UINT32             FilenameLength;
   CHAR8              *VaultFilePath;
-  UINTN              FilenameSize;
 
   if (!Context->HasVault) {
     return NULL;
   }
 
-  FilenameSize = StrLen (Filename) + 1;
+  Slot = OcStorageHashPath (Filename, TRUE, &FilenameLength) & Context->VaultIndexMask;
 
-  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
-    if (Context->Vault.Files.Keys[Index]->Size != (UINT32) FilenameSize) {
+  while (Context->VaultIndex[Slot] != 0) {
+    Index = Context->VaultIndex[Slot] - 1;
+    Slot  = (Slot + 1) & Context->VaultIndexMask;
+
+    if (Context->Vault.Files.Keys[Index]->Size != FilenameLength + 1) {
       continue;
     }
 
     VaultFilePath = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
 
-    for (StrIndex = 0; StrIndex < FilenameSize; ++StrIndex) {
-      if (Filename[StrIndex] != VaultFilePath[StrIndex]) {
+    for (StrIndex = 0; StrIndex < FilenameLength; ++StrIndex) {
+      if (Filename[StrIndex] != (UINT8) VaultFilePath[StrIndex]) {
         break;
       }
     }
 
-    if (StrIndex == FilenameSize) {
+    if (StrIndex == FilenameLength) {
       return &Context->Vault.Files.Values[Index]->Hash[0];
     }
   }
@@ -212,6 +339,244 @@ OcStorageGetDigest (
   return NULL;
 }
 
+STATIC
+OC_STORAGE_CACHE_ENTRY *
+OcStorageGetCacheEntry (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath,
+  IN     BOOLEAN             Create
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  UINT32                  Hash;
+  UINT32                  Length;
+  UINT32                  Bucket;
+
+  Hash   = OcStorageHashPath (FilePath, TRUE, &Length);
+  Bucket = Hash % OC_STORAGE_CACHE_BUCKETS;
+
+  for (Entry = Context->Cache[Bucket]; Entry != NULL; Entry = Entry->Next) {
+    if (Entry->Hash == Hash && StrCmp (Entry->Path, FilePath) == 0) {
+      return Entry;
+    }
+  }
+
+  //
+  // Entries only pay off with content caching, do not waste memory otherwise.
+  //
+  if (!Create || Context->ContentCacheFileMax == 0) {
+    return NULL;
+  }
+
+  Entry = AllocateZeroPool (sizeof (*Entry) + (Length + 1) * sizeof (CHAR16));
+  if (Entry == NULL) {
+    return NULL;
+  }
+
+  Entry->Hash = Hash;
+  Entry->Path = (CHAR16 *) (Entry + 1);
+  CopyMem (Entry->Path, FilePath, (Length + 1) * sizeof (CHAR16));
+
+  Entry->Next            = Context->Cache[Bucket];
+  Context->Cache[Bucket] = Entry;
+  return Entry;
+}
+
+STATIC
+VOID
+OcStorageResetCacheEntry (
+  IN OUT OC_STORAGE_CONTEXT      *Context,
+  IN OUT OC_STORAGE_CACHE_ENTRY  *Entry
+  )
+{
+  if (Entry->File != NULL) {
+    Entry->File->Close (Entry->File);
+    Entry->File = NULL;
+  }
+
+  if (Context->OpenEntry == Entry) {
+    Context->OpenEntry = NULL;
+  }
+
+  if (Entry->Data != NULL) {
+    FreePool (Entry->Data);
+    Entry->Data                = NULL;
+    Context->ContentCacheFree += Entry->Size + 2;
+    Entry->Size                = 0;
+  }
+
+  Entry->Missing = FALSE;
+}
+
+STATIC
+VOID
+OcStorageFreeCache (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  UINT32                  Bucket;
+
+  for (Bucket = 0; Bucket < OC_STORAGE_CACHE_BUCKETS; ++Bucket) {
+    while (Context->Cache[Bucket] != NULL) {
+      Entry                  = Context->Cache[Bucket];
+      Context->Cache[Bucket] = Entry->Next;
+
+      if (Entry->File != NULL) {
+        Entry->File->Close (Entry->File);
+      }
+
+      if (Entry->Data != NULL) {
+        FreePool (Entry->Data);
+      }
+
+      FreePool (Entry);
+    }
+  }
+
+  Context->OpenEntry = NULL;
+}
+
+STATIC
+UINT8 *
+OcStorageReadFileData (
+  IN  OC_STORAGE_CONTEXT      *Context,
+  IN  CONST CHAR16            *FilePath,
+  IN  OC_STORAGE_CACHE_ENTRY  *Entry     OPTIONAL,
+  IN  UINT32                  MaxSize,
+  OUT UINT32                  *FileSize,
+  OUT UINT8                   *Digest    OPTIONAL
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *File;
+  UINT32             Size;
+  UINT32             Offset;
+  UINT32             ChunkSize;
+  UINT8              *FileBuffer;
+  SHA256_CONTEXT     HashContext;
+
+  if (Context->Storage == NULL) {
+    //
+    // TODO: expand support for other contexts.
+    //
+    return NULL;
+  }
+
+  if (Entry != NULL && Entry->Missing) {
+    ++Entry->OpensSaved;
+    return NULL;
+  }
+
+  if (Entry != NULL && Entry->File != NULL) {
+    //
+    // Reuse the file opened by the existence check.
+    //
+    File               = Entry->File;
+    Entry->File        = NULL;
+    Context->OpenEntry = NULL;
+    ++Entry->OpensSaved;
+  } else {
+    Status = SafeFileOpen (
+      Context->Storage,
+      &File,
+      (CHAR16 *) FilePath,
+      EFI_FILE_MODE_READ,
+      0
+      );
+
+    if (EFI_ERROR (Status)) {
+      if (Entry != NULL) {
+        Entry->Missing = TRUE;
+      }
+      return NULL;
+    }
+  }
+
+  Status = GetFileSize (File, &Size);
+  if (EFI_ERROR (Status) || Size >= MAX_UINT32 - 1 || Size > MaxSize) {
+    File->Close (File);
+    return NULL;
+  }
+
+  FileBuffer = AllocatePool (Size + 2);
+  if (FileBuffer == NULL) {
+    File->Close (File);
+    return NULL;
+  }
+
+  if (Digest == NULL) {
+    Status = GetFileData (File, 0, Size, FileBuffer);
+  } else {
+    //
+    // Hash every chunk right after reading it while it is still hot in cache.
+    //
+    Sha256Init (&HashContext);
+
+    Status = EFI_SUCCESS;
+    for (Offset = 0; Offset < Size && !EFI_ERROR (Status); Offset += ChunkSize) {
+      ChunkSize = MIN (Size - Offset, OC_STORAGE_READ_CHUNK);
+      Status    = GetFileData (File, Offset, ChunkSize, &FileBuffer[Offset]);
+      if (!EFI_ERROR (Status)) {
+        Sha256Update (&HashContext, &FileBuffer[Offset], ChunkSize);
+      }
+    }
+
+    Sha256Final (&HashContext, Digest);
+  }
+
+  File->Close (File);
+  if (EFI_ERROR (Status)) {
+    FreePool (FileBuffer);
+    return NULL;
+  }
+
+  FileBuffer[Size]     = 0;
+  FileBuffer[Size + 1] = 0;
+
+  *FileSize = Size;
+  return FileBuffer;
+}
+
+STATIC
+VOID
+EFIAPI
+OcStorageVerifyDigest (
+  IN     UINTN  Index,
+  IN OUT VOID   *Context
+  )
+{
+  OC_STORAGE_VERIFY_ENTRY  *Entry;
+  UINT8                    FileDigest[SHA256_DIGEST_SIZE];
+
+  Entry = &((OC_STORAGE_VERIFY_ENTRY *) Context)[Index];
+
+  Sha256 (FileDigest, Entry->Buffer, Entry->Size);
+  Entry->Valid = CompareMem (FileDigest, Entry->Digest, SHA256_DIGEST_SIZE) == 0;
+}
+
+STATIC
+VOID
+OcStorageFreePrefetched (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < Context->PrefetchedCount; ++Index) {
+    if (Context->Prefetched[Index].Buffer != NULL) {
+      FreePool (Context->Prefetched[Index].Buffer);
+    }
+  }
+
+  if (Context->Prefetched != NULL) {
+    FreePool (Context->Prefetched);
+    Context->Prefetched = NULL;
+  }
+
+  Context->PrefetchedCount = 0;
+}
+
 EFI_STATUS
 OcStorageInitFromFs (
   OUT OC_STORAGE_CONTEXT               *Context,
@@ -331,10 +696,104 @@ OcStorageFree (
     Context->Storage = NULL;
   }
 
+  OcStorageFreePrefetched (Context);
+  OcStorageFreeCache (Context);
+
   if (Context->HasVault) {
-    OC_STORAGE_VAULT_DESTRUCT (&Context->Vault, sizeof (Context->Vault));
-    Context->HasVault = FALSE;
+    OcStorageFreeVault (Context);
+  }
+}
+
+VOID
+OcStorageEnableContentCache (
+  IN OUT OC_STORAGE_CONTEXT            *Context,
+  IN     UINT32                        FileSizeMax,
+  IN     UINT32                        TotalSizeMax
+  )
+{
+  ASSERT (Context != NULL);
+
+  Context->ContentCacheFileMax = FileSizeMax;
+  Context->ContentCacheFree    = TotalSizeMax;
+}
+
+VOID
+OcStoragePreloadVaultFiles (
+  IN OUT OC_STORAGE_CONTEXT            *Context
+  )
+{
+  UINT32                  Index;
+  UINT32                  Count;
+  UINT32                  StrIndex;
+  UINT32                  Size;
+  UINT32                  MaxSize;
+  UINT8                   *FileBuffer;
+  CHAR8                   *VaultFilePath;
+  CHAR16                  FilePath[OC_STORAGE_SAFE_PATH_MAX];
+  UINT8                   FileDigest[SHA256_DIGEST_SIZE];
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+
+  ASSERT (Context != NULL);
+
+  if (!Context->HasVault || Context->ContentCacheFileMax == 0) {
+    return;
+  }
+
+  //
+  // Vault files are listed in directory order, which normally is
+  // the on-disk order as well.
+  //
+  Count = 0;
+  for (Index = 0; Index < Context->Vault.Files.Count && Context->ContentCacheFree > 2; ++Index) {
+    if (Context->Vault.Files.Keys[Index]->Size == 0
+      || Context->Vault.Files.Keys[Index]->Size > ARRAY_SIZE (FilePath)) {
+      continue;
+    }
+
+    VaultFilePath = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
+    for (StrIndex = 0; StrIndex < Context->Vault.Files.Keys[Index]->Size; ++StrIndex) {
+      FilePath[StrIndex] = (UINT8) VaultFilePath[StrIndex];
+    }
+
+    if (FilePath[0] == '\0' || FilePath[StrIndex - 1] != '\0') {
+      continue;
+    }
+
+    Entry = OcStorageGetCacheEntry (Context, FilePath, TRUE);
+    if (Entry == NULL || Entry->Data != NULL) {
+      continue;
+    }
+
+    //
+    // Larger files do not fit into the cache and are verified on read.
+    //
+    MaxSize    = MIN (Context->ContentCacheFileMax, Context->ContentCacheFree - 2);
+    FileBuffer = OcStorageReadFileData (Context, FilePath, Entry, MaxSize, &Size, FileDigest);
+    if (FileBuffer == NULL) {
+      continue;
+    }
+
+    //
+    // Drop corrupted files, so that the following read reports the error.
+    //
+    if (CompareMem (FileDigest, Context->Vault.Files.Values[Index]->Hash, SHA256_DIGEST_SIZE) != 0) {
+      FreePool (FileBuffer);
+      continue;
+    }
+
+    Entry->Data                = FileBuffer;
+    Entry->Size                = Size;
+    Context->ContentCacheFree -= Size + 2;
+    ++Count;
   }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCST: Preloaded %u of %u vault files, %u bytes cache left\n",
+    Count,
+    Context->Vault.Files.Count,
+    Context->ContentCacheFree
+    ));
 }
 
 BOOLEAN
@@ -343,9 +802,9 @@ OcStorageExistsFileUnicode (
   IN  CONST CHAR16                     *FilePath
   )
 {
-  EFI_STATUS         Status;
-  EFI_FILE_PROTOCOL  *File;
-  UINT8              *VaultDigest;
+  EFI_STATUS              Status;
+  EFI_FILE_PROTOCOL       *File;
+  OC_STORAGE_CACHE_ENTRY  *Entry;
 
   //
   // Using this API with empty filename is also not allowed.
@@ -354,16 +813,31 @@ OcStorageExistsFileUnicode (
   ASSERT (FilePath != NULL);
   ASSERT (StrLen (FilePath) > 0);
 
-  VaultDigest = OcStorageGetDigest (Context, FilePath);
-
-  if (VaultDigest != NULL) {
-    return TRUE;
+  //
+  // Files missing from the vault cannot be read, so there is no need
+  // to touch the file system.
+  //
+  if (Context->HasVault) {
+    return OcStorageGetDigest (Context, FilePath) != NULL;
   }
 
   if (Context->Storage == NULL) {
     return FALSE;
   }
 
+  Entry = OcStorageGetCacheEntry (Context, FilePath, TRUE);
+  if (Entry != NULL) {
+    if (Entry->Missing) {
+      ++Entry->OpensSaved;
+      return FALSE;
+    }
+
+    if (Entry->File != NULL || Entry->Data != NULL) {
+      ++Entry->OpensSaved;
+      return TRUE;
+    }
+  }
+
   Status = SafeFileOpen (
     Context->Storage,
     &File,
@@ -372,12 +846,206 @@ OcStorageExistsFileUnicode (
     0
     );
 
-  if (!EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status)) {
+    if (Entry != NULL) {
+      Entry->Missing = TRUE;
+    }
+    return FALSE;
+  }
+
+  if (Entry == NULL) {
     File->Close (File);
     return TRUE;
   }
 
-  return FALSE;
+  //
+  // Keep the file open, existence checks are normally followed by reads.
+  // Close the file kept by the previous check if it was never read.
+  //
+  if (Context->OpenEntry != NULL) {
+    Context->OpenEntry->File->Close (Context->OpenEntry->File);
+    Context->OpenEntry->File = NULL;
+  }
+
+  Entry->File        = File;
+  Context->OpenEntry = Entry;
+
+  return TRUE;
+}
+
+VOID
+OcStoragePrefetchFilesUnicode (
+  IN  OC_STORAGE_CONTEXT               *Context,
+  IN  CHAR16                           **FilePaths,
+  IN  UINT32                           FileCount
+  )
+{
+  OC_STORAGE_VERIFY_ENTRY  *Entries;
+  UINT8                    *VaultDigest;
+  UINT32                   Index;
+  UINT32                   Count;
+
+  ASSERT (Context != NULL);
+  ASSERT (FilePaths != NULL || FileCount == 0);
+
+  OcStorageFreePrefetched (Context);
+
+  //
+  // Without vault there is nothing to verify, and reading files in advance
+  // gives no benefit.
+  //
+  if (!Context->HasVault || FileCount == 0) {
+    return;
+  }
+
+  Entries             = AllocateZeroPool (FileCount * sizeof (*Entries));
+  Context->Prefetched = AllocateZeroPool (FileCount * sizeof (*Context->Prefetched));
+  if (Entries == NULL || Context->Prefetched == NULL) {
+    if (Entries != NULL) {
+      FreePool (Entries);
+    }
+
+    OcStorageFreePrefetched (Context);
+    return;
+  }
+
+  //
+  // File I/O has to happen on the BSP, so read everything first.
+  //
+  Count = 0;
+  for (Index = 0; Index < FileCount; ++Index) {
+    VaultDigest = OcStorageGetDigest (Context, FilePaths[Index]);
+    if (VaultDigest == NULL) {
+      continue;
+    }
+
+    Context->Prefetched[Count].Buffer = OcStorageReadFileData (
+      Context,
+      FilePaths[Index],
+      OcStorageGetCacheEntry (Context, FilePaths[Index], TRUE),
+      MAX_UINT32,
+      &Context->Prefetched[Count].Size,
+      NULL
+      );
+    if (Context->Prefetched[Count].Buffer == NULL) {
+      continue;
+    }
+
+    Context->Prefetched[Count].Digest = VaultDigest;
+    Entries[Count].Buffer             = Context->Prefetched[Count].Buffer;
+    Entries[Count].Size               = Context->Prefetched[Count].Size;
+    Entries[Count].Digest             = VaultDigest;
+    ++Count;
+  }
+
+  Context->PrefetchedCount = Count;
+
+  //
+  // Hash all files at once on every available processor.
+  //
+  OcParallelRun (OcStorageVerifyDigest, Entries, Count);
+
+  for (Index = 0; Index < Count; ++Index) {
+    //
+    // Drop the file to make the following read report the error.
+    //
+    if (!Entries[Index].Valid) {
+      FreePool (Context->Prefetched[Index].Buffer);
+      Context->Prefetched[Index].Buffer = NULL;
+    }
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCST: Prefetched %u of %u files on %u processors\n",
+    Count,
+    FileCount,
+    (UINT32) OcParallelGetWorkerCount ()
+    ));
+
+  FreePool (Entries);
+}
+
+VOID
+OcStoragePrefetchFilesAscii (
+  IN  OC_STORAGE_CONTEXT               *Context,
+  IN  CONST CHAR16                     *Directory,
+  IN  CONST CHAR8                      **FileNames,
+  IN  CONST CHAR8                      **SubPaths   OPTIONAL,
+  IN  UINT32                           FileCount
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Index;
+  UINT32      Count;
+  CHAR16      (*FullPaths)[OC_STORAGE_SAFE_PATH_MAX];
+  CHAR16      **FilePaths;
+
+  ASSERT (Context != NULL);
+  ASSERT (Directory != NULL);
+  ASSERT (FileNames != NULL || FileCount == 0);
+
+  if (!Context->HasVault || FileCount == 0) {
+    OcStoragePrefetchFilesUnicode (Context, NULL, 0);
+    return;
+  }
+
+  FullPaths = AllocatePool (FileCount * sizeof (*FullPaths));
+  FilePaths = AllocatePool (FileCount * sizeof (*FilePaths));
+  if (FullPaths == NULL || FilePaths == NULL) {
+    if (FullPaths != NULL) {
+      FreePool (FullPaths);
+    }
+    if (FilePaths != NULL) {
+      FreePool (FilePaths);
+    }
+    OcStoragePrefetchFilesUnicode (Context, NULL, 0);
+    return;
+  }
+
+  //
+  // Invalid entries are simply skipped here and reported on read.
+  //
+  Count = 0;
+  for (Index = 0; Index < FileCount; ++Index) {
+    if (FileNames[Index] == NULL || FileNames[Index][0] == '\0') {
+      continue;
+    }
+
+    if (SubPaths == NULL) {
+      Status = OcUnicodeSafeSPrint (
+        FullPaths[Count],
+        sizeof (FullPaths[Count]),
+        L"%s%a",
+        Directory,
+        FileNames[Index]
+        );
+    } else if (SubPaths[Index] != NULL && SubPaths[Index][0] != '\0') {
+      Status = OcUnicodeSafeSPrint (
+        FullPaths[Count],
+        sizeof (FullPaths[Count]),
+        L"%s%a\\%a",
+        Directory,
+        FileNames[Index],
+        SubPaths[Index]
+        );
+    } else {
+      continue;
+    }
+
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    UnicodeUefiSlashes (FullPaths[Count]);
+    FilePaths[Count] = FullPaths[Count];
+    ++Count;
+  }
+
+  OcStoragePrefetchFilesUnicode (Context, FilePaths, Count);
+
+  FreePool (FilePaths);
+  FreePool (FullPaths);
 }
 
 VOID *
@@ -387,12 +1055,12 @@ OcStorageReadFileUnicode (
   OUT UINT32                           *FileSize OPTIONAL
   )
 {
-  EFI_STATUS         Status;
-  EFI_FILE_PROTOCOL  *File;
-  UINT32             Size;
-  UINT8              *FileBuffer;
-  UINT8              *VaultDigest;
-  UINT8              FileDigest[SHA256_DIGEST_SIZE];
+  UINT32                  Index;
+  UINT32                  Size;
+  UINT8                   *FileBuffer;
+  UINT8                   *VaultDigest;
+  UINT8                   FileDigest[SHA256_DIGEST_SIZE];
+  OC_STORAGE_CACHE_ENTRY  *Entry;
 
   //
   // Using this API with empty filename is also not allowed.
@@ -408,46 +1076,55 @@ OcStorageReadFileUnicode (
     return NULL;
   }
 
-  if (Context->Storage == NULL) {
-    //
-    // TODO: expand support for other contexts.
-    //
-    return NULL;
+  //
+  // Hand over prefetched files, these are already verified.
+  // Vault digests are unique per file, so they identify the file as well.
+  //
+  for (Index = 0; Index < Context->PrefetchedCount; ++Index) {
+    if (Context->Prefetched[Index].Buffer != NULL
+      && Context->Prefetched[Index].Digest == VaultDigest) {
+      FileBuffer                        = Context->Prefetched[Index].Buffer;
+      Context->Prefetched[Index].Buffer = NULL;
+
+      if (FileSize != NULL) {
+        *FileSize = Context->Prefetched[Index].Size;
+      }
+
+      return FileBuffer;
+    }
   }
 
-  Status = SafeFileOpen (
-    Context->Storage,
-    &File,
-    (CHAR16 *) FilePath,
-    EFI_FILE_MODE_READ,
-    0
-    );
+  Entry = OcStorageGetCacheEntry (Context, FilePath, TRUE);
 
-  if (EFI_ERROR (Status)) {
-    return NULL;
-  }
+  if (Entry != NULL && Entry->Data != NULL) {
+    FileBuffer = AllocateCopyPool (Entry->Size + 2, Entry->Data);
+    if (FileBuffer == NULL) {
+      return NULL;
+    }
 
-  Status = GetFileSize (File, &Size);
-  if (EFI_ERROR (Status) || Size >= MAX_UINT32 - 1) {
-    File->Close (File);
-    return NULL;
-  }
+    ++Entry->OpensSaved;
+    Entry->BytesSaved += Entry->Size;
 
-  FileBuffer = AllocatePool (Size + 2);
-  if (FileBuffer == NULL) {
-    File->Close (File);
-    return NULL;
+    if (FileSize != NULL) {
+      *FileSize = Entry->Size;
+    }
+
+    return FileBuffer;
   }
 
-  Status = GetFileData (File, 0, Size, FileBuffer);
-  File->Close (File);
-  if (EFI_ERROR (Status)) {
-    FreePool (FileBuffer);
+  FileBuffer = OcStorageReadFileData (
+    Context,
+    FilePath,
+    Entry,
+    MAX_UINT32,
+    &Size,
+    VaultDigest != NULL ? FileDigest : NULL
+    );
+  if (FileBuffer == NULL) {
     return NULL;
   }
 
-  if (VaultDigest != 0) {
-    Sha256 (FileDigest, FileBuffer, Size);
+  if (VaultDigest != NULL) {
     if (CompareMem (FileDigest, VaultDigest, SHA256_DIGEST_SIZE) != 0) {
       DEBUG ((DEBUG_ERROR, "OCST: Aborting corrupted %s file access\n", FilePath));
       FreePool (FileBuffer);
@@ -455,8 +1132,15 @@ OcStorageReadFileUnicode (
     }
   }
 
-  FileBuffer[Size]     = 0;
-  FileBuffer[Size + 1] = 0;
+  if (Entry != NULL
+    && Size <= Context->ContentCacheFileMax
+    && Size + 2 <= Context->ContentCacheFree) {
+    Entry->Data = AllocateCopyPool (Size + 2, FileBuffer);
+    if (Entry->Data != NULL) {
+      Entry->Size                = Size;
+      Context->ContentCacheFree -= Size + 2;
+    }
+  }
 
   if (FileSize != NULL) {
     *FileSize = Size;
@@ -465,6 +1149,76 @@ OcStorageReadFileUnicode (
   return FileBuffer;
 }
 
+EFI_STATUS
+OcStorageWriteRootFileUnicode (
+  IN OUT OC_STORAGE_CONTEXT            *Context,
+  IN     CONST CHAR16                  *FilePath,
+  IN     CONST VOID                    *Buffer,
+  IN     UINT32                        Size
+  )
+{
+  EFI_STATUS              Status;
+  EFI_FILE_PROTOCOL       *RootVolume;
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  CONST CHAR16            *StorageRoot;
+  CONST CHAR16            *StoragePath;
+  UINTN                   RootLength;
+
+  ASSERT (Context != NULL);
+  ASSERT (FilePath != NULL);
+  ASSERT (Buffer != NULL || Size == 0);
+
+  if (Context->FileSystem == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Drop cached state of the file when it is within storage, as the file
+  // changes even when writing fails midway.
+  //
+  StoragePath = FilePath;
+  while (*StoragePath == L'\\') {
+    ++StoragePath;
+  }
+
+  if (Context->StorageRoot != NULL) {
+    StorageRoot = Context->StorageRoot;
+    while (*StorageRoot == L'\\') {
+      ++StorageRoot;
+    }
+
+    RootLength = StrLen (StorageRoot);
+    while (RootLength > 0 && StorageRoot[RootLength - 1] == L'\\') {
+      --RootLength;
+    }
+
+    if (RootLength > 0) {
+      if (StrnCmp (StoragePath, StorageRoot, RootLength) == 0 && StoragePath[RootLength] == L'\\') {
+        StoragePath = &StoragePath[RootLength + 1];
+      } else {
+        StoragePath = NULL;
+      }
+    }
+  }
+
+  if (StoragePath != NULL && StoragePath[0] != L'\0') {
+    Entry = OcStorageGetCacheEntry (Context, StoragePath, FALSE);
+    if (Entry != NULL) {
+      OcStorageResetCacheEntry (Context, Entry);
+    }
+  }
+
+  Status = Context->FileSystem->OpenVolume (Context->FileSystem, &RootVolume);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = SetFileData (RootVolume, FilePath, Buffer, Size);
+  RootVolume->Close (RootVolume);
+
+  return Status;
+}
+
 EFI_STATUS
 OcStorageGetInfo (
   IN  OC_STORAGE_CONTEXT               *Context,
@@ -475,9 +1229,21 @@ OcStorageGetInfo (
   IN  BOOLEAN                          RealPath
   )
 {
-  CHAR16   *FullPath;
-  UINTN    RootLength;
-  UINTN    FileSize;
+  CHAR16                  *FullPath;
+  UINTN                   RootLength;
+  UINTN                   FileSize;
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+
+  Entry = OcStorageGetCacheEntry (Context, FilePath, FALSE);
+  if (Entry != NULL) {
+    DEBUG ((
+      DEBUG_VERBOSE,
+      "OCST: Cache for %s saved %u opens and %Lu bytes\n",
+      FilePath,
+      Entry->OpensSaved,
+      Entry->BytesSaved
+      ));
+  }
 
   if (RealPath
     && Context->StorageHandle != NULL
@@ -0,0 +1,279 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Uefi.h>
+#include <Guid/OcVariable.h>
+#include <Protocol/OcTrace.h>
+
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcTraceLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+//
+// Trace state used by this image, either shared or local.
+//
+STATIC OC_TRACE_PROTOCOL  *mTrace;
+
+//
+// Local trace state recorded until tracing is configured.
+//
+STATIC OC_TRACE_PROTOCOL  mLocalTrace;
+
+//
+// Trace state is shared via protocol, and may be exported.
+//
+STATIC BOOLEAN            mTraceShared;
+
+//
+// Tracing was disabled by configuration.
+//
+STATIC BOOLEAN            mTraceDisabled;
+
+STATIC
+OC_TRACE_PROTOCOL *
+InternalGetTrace (
+  VOID
+  )
+{
+  EFI_STATUS         Status;
+  OC_TRACE_PROTOCOL  *Trace;
+
+  if (mTrace != NULL || mTraceDisabled) {
+    return mTrace;
+  }
+
+  Status = gBS->LocateProtocol (
+    &gOcTraceProtocolGuid,
+    NULL,
+    (VOID **) &Trace
+    );
+  if (!EFI_ERROR (Status)) {
+    if (Trace->Revision != OC_TRACE_PROTOCOL_REVISION) {
+      mTraceDisabled = TRUE;
+      return NULL;
+    }
+
+    mTrace       = Trace;
+    mTraceShared = TRUE;
+    return mTrace;
+  }
+
+  //
+  // Record locally until OcTraceConfigure decides whether to keep the trace.
+  //
+  mLocalTrace.Revision         = OC_TRACE_PROTOCOL_REVISION;
+  mLocalTrace.Header.Signature = OC_TRACE_SIGNATURE;
+  mLocalTrace.Header.Version   = OC_TRACE_VERSION;
+  mLocalTrace.Header.Frequency = GetPerformanceCounterProperties (NULL, NULL);
+  mLocalTrace.Header.Start     = GetPerformanceCounter ();
+
+  mTrace = &mLocalTrace;
+  return mTrace;
+}
+
+EFI_STATUS
+OcTraceConfigure (
+  IN BOOLEAN  Enable
+  )
+{
+  EFI_STATUS         Status;
+  OC_TRACE_PROTOCOL  *Trace;
+  EFI_HANDLE         Handle;
+
+  if (!Enable) {
+    mTrace         = NULL;
+    mTraceShared   = FALSE;
+    mTraceDisabled = TRUE;
+    return EFI_SUCCESS;
+  }
+
+  mTraceDisabled = FALSE;
+
+  Trace = InternalGetTrace ();
+  if (mTraceShared) {
+    return EFI_SUCCESS;
+  }
+
+  ASSERT (Trace == &mLocalTrace);
+
+  //
+  // Move the state out of this image, as other images may outlive it.
+  //
+  Trace = AllocateCopyPool (sizeof (*Trace), &mLocalTrace);
+  if (Trace == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Handle = NULL;
+  Status = gBS->InstallProtocolInterface (
+    &Handle,
+    &gOcTraceProtocolGuid,
+    EFI_NATIVE_INTERFACE,
+    Trace
+    );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCTR: Failed to install trace protocol - %r\n", Status));
+    FreePool (Trace);
+    return Status;
+  }
+
+  mTrace       = Trace;
+  mTraceShared = TRUE;
+  return EFI_SUCCESS;
+}
+
+STATIC
+BOOLEAN
+InternalNameMatches (
+  IN CONST OC_TRACE_NODE  *Node,
+  IN CONST CHAR8          *Name
+  )
+{
+  return AsciiStrnCmp (Node->Name, Name, OC_TRACE_NAME_SIZE - 1) == 0;
+}
+
+VOID
+OcTraceBegin (
+  IN CONST CHAR8  *Name
+  )
+{
+  OC_TRACE_PROTOCOL  *Trace;
+  OC_TRACE_NODE      *Node;
+  UINT16             Parent;
+  UINT16             Index;
+
+  ASSERT (Name != NULL);
+
+  Trace = InternalGetTrace ();
+  if (Trace == NULL) {
+    return;
+  }
+
+  if (Trace->Depth == OC_TRACE_MAX_DEPTH) {
+    ++Trace->Header.Dropped;
+    return;
+  }
+
+  Parent = 0;
+  if (Trace->Depth > 0) {
+    Parent = Trace->Stack[Trace->Depth - 1] + 1;
+  }
+
+  for (Index = 0; Index < Trace->Header.NodeCount; ++Index) {
+    Node = &Trace->Nodes[Index];
+    if (Node->Parent == Parent && InternalNameMatches (Node, Name)) {
+      break;
+    }
+  }
+
+  if (Index == Trace->Header.NodeCount) {
+    if (Index == OC_TRACE_MAX_NODES) {
+      ++Trace->Header.Dropped;
+      return;
+    }
+
+    Node = &Trace->Nodes[Index];
+    AsciiStrnCpyS (Node->Name, sizeof (Node->Name), Name, sizeof (Node->Name) - 1);
+    Node->Parent = Parent;
+    ++Trace->Header.NodeCount;
+  }
+
+  Trace->Stack[Trace->Depth]      = Index;
+  Trace->StackStart[Trace->Depth] = GetPerformanceCounter ();
+  ++Trace->Depth;
+
+  if (Node->First == 0) {
+    Node->First = Trace->StackStart[Trace->Depth - 1];
+  }
+}
+
+VOID
+OcTraceEnd (
+  IN CONST CHAR8  *Name
+  )
+{
+  OC_TRACE_PROTOCOL  *Trace;
+  OC_TRACE_NODE      *Node;
+  UINT64             End;
+  UINT32             Depth;
+
+  ASSERT (Name != NULL);
+
+  Trace = InternalGetTrace ();
+  if (Trace == NULL) {
+    return;
+  }
+
+  for (Depth = Trace->Depth; Depth > 0; --Depth) {
+    if (InternalNameMatches (&Trace->Nodes[Trace->Stack[Depth - 1]], Name)) {
+      break;
+    }
+  }
+
+  if (Depth == 0) {
+    return;
+  }
+
+  //
+  // Unwind phases left running by early returns within this phase.
+  //
+  End = GetPerformanceCounter ();
+  while (Trace->Depth >= Depth) {
+    --Trace->Depth;
+    Node = &Trace->Nodes[Trace->Stack[Trace->Depth]];
+    Node->Total += End - Trace->StackStart[Trace->Depth];
+    if (Node->Count < MAX_UINT16) {
+      ++Node->Count;
+    }
+  }
+}
+
+EFI_STATUS
+OcTraceSave (
+  VOID
+  )
+{
+  EFI_STATUS         Status;
+  OC_TRACE_PROTOCOL  *Trace;
+
+  //
+  // Only traces enabled by configuration are exported.
+  //
+  Trace = InternalGetTrace ();
+  if (Trace == NULL || !mTraceShared) {
+    return EFI_NOT_STARTED;
+  }
+
+  Status = gRT->SetVariable (
+    OC_TRACE_VARIABLE_NAME,
+    &gOcVendorVariableGuid,
+    EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+    sizeof (Trace->Header) + Trace->Header.NodeCount * sizeof (Trace->Nodes[0]),
+    &Trace->Header
+    );
+
+  DEBUG ((
+    EFI_ERROR (Status) ? DEBUG_INFO : DEBUG_VERBOSE,
+    "OCTR: Saved %u phases (%u dropped) - %r\n",
+    Trace->Header.NodeCount,
+    Trace->Header.Dropped,
+    Status
+    ));
+
+  return Status;
+}
@@ -47,11 +47,6 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcMiscLib.h>
 #include <Library/OcStringLib.h>
 
-//
-// Minimal extra allocation size during export.
-//
-#define XML_EXPORT_MIN_ALLOCATION_SIZE 4096
-
 #define XML_PLIST_HEADER  "<?xml version=\"1.0\" encoding=\"UTF-8\"?><!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">"
 
 struct XML_NODE_LIST_;
@@ -70,6 +65,13 @@ struct XML_NODE_ {
   CONST CHAR8    *Content;
   XML_NODE       *Real;
   XML_NODE_LIST  *Children;
+  XML_NODE       *Parent;
+  //
+  // Node location in the parsed buffer, SourceLength is 0 for new
+  // and modified nodes, as well as for all their parents.
+  //
+  UINT32         SourceOffset;
+  UINT32         SourceLength;
 };
 
 struct XML_NODE_LIST_ {
@@ -95,6 +97,7 @@ struct XML_DOCUMENT_ {
 
   XML_NODE      *Root;
   XML_REFLIST   References;
+  CONST CHAR8   *Source;
 };
 
 //
@@ -107,6 +110,17 @@ struct XML_PARSER_ {
   UINT32 Level;
 };
 
+//
+// Export context. Buffer is NULL when only measuring the output size.
+//
+typedef struct {
+  CHAR8        *Buffer;
+  UINT32       BufferSize;
+  UINT32       CurrentSize;
+  BOOLEAN      Overflow;
+  CONST CHAR8  *Source;
+} XML_EXPORT_STATE;
+
 //
 // Character offsets.
 //
@@ -194,8 +208,11 @@ XmlNodeCreate (
     Node->Name       = Name;
     Node->Attributes = Attributes;
     Node->Content    = Content;
-    Node->Real       = Real;
-    Node->Children   = Children;
+    Node->Real         = Real;
+    Node->Children     = Children;
+    Node->Parent       = NULL;
+    Node->SourceOffset = 0;
+    Node->SourceLength = 0;
   }
 
   return Node;
@@ -228,6 +245,7 @@ XmlNodeChildPush (
     if (NodeCount < XML_PARSER_NODE_COUNT && AllocCount > NodeCount) {
       Node->Children->NodeList[NodeCount] = Child;
       Node->Children->NodeCount++;
+      Child->Parent = Node;
       return TRUE;
     }
   }
@@ -268,10 +286,27 @@ XmlNodeChildPush (
 
   NewList->NodeList[NodeCount] = Child;
   Node->Children = NewList;
+  Child->Parent  = Node;
 
   return TRUE;
 }
 
+//
+// Marks node and all its parents as no longer matching the parsed buffer.
+// Parents of a modified node are always modified, so stop at the first one.
+//
+STATIC
+VOID
+XmlNodeInvalidateSource (
+  XML_NODE  *Node
+  )
+{
+  while (Node != NULL && Node->SourceLength != 0) {
+    Node->SourceLength = 0;
+    Node = Node->Parent;
+  }
+}
+
 STATIC
 BOOLEAN
 XmlPushReference (
@@ -870,101 +905,165 @@ XmlParseContent (
 }
 
 //
-// Prints to growing buffer always preserving one byte extra.
+// Appends to export buffer always preserving one byte extra.
+// Only advances the size when measuring.
 //
 STATIC
 VOID
 XmlBufferAppend (
-  CHAR8        **Buffer,
-  UINT32       *AllocSize,
-  UINT32       *CurrentSize,
-  CONST CHAR8  *Data,
-  UINT32       DataLength
+  XML_EXPORT_STATE  *State,
+  CONST CHAR8       *Data,
+  UINT32            DataLength
   )
 {
-  CHAR8   *NewBuffer;
   UINT32  NewSize;
 
-  NewSize = *AllocSize;
+  if (State->Overflow) {
+    return;
+  }
 
-  if (NewSize - *CurrentSize <= DataLength) {
-    if (DataLength + 1 <= XML_EXPORT_MIN_ALLOCATION_SIZE) {
-      NewSize += XML_EXPORT_MIN_ALLOCATION_SIZE;
-    } else {
-      NewSize += DataLength + 1;
-    }
+  if (OcOverflowAddU32 (State->CurrentSize, DataLength, &NewSize)) {
+    State->Overflow = TRUE;
+    return;
+  }
 
-    NewBuffer = AllocatePool (NewSize);
-    if (NewBuffer == NULL) {
-      XML_USAGE_ERROR("XmlBufferAppend::failed to allocate");
+  if (State->Buffer != NULL) {
+    if (NewSize >= State->BufferSize) {
+      State->Overflow = TRUE;
       return;
     }
 
-    CopyMem (NewBuffer, *Buffer, *CurrentSize);
-    FreePool (*Buffer);
-    *Buffer    = NewBuffer;
-    *AllocSize = NewSize;
+    CopyMem (&State->Buffer[State->CurrentSize], Data, DataLength);
   }
 
-  CopyMem (&(*Buffer)[*CurrentSize], Data, DataLength);
-  *CurrentSize += DataLength;
+  State->CurrentSize = NewSize;
 }
 
 //
-// Prints node to growing buffer always preserving one byte extra.
+// Prints node to export buffer always preserving one byte extra.
 //
 STATIC
 VOID
 XmlNodeExportRecursive (
-  XML_NODE  *Node,
-  CHAR8     **Buffer,
-  UINT32    *AllocSize,
-  UINT32    *CurrentSize,
-  UINT32    Skip
+  XML_NODE          *Node,
+  XML_EXPORT_STATE  *State,
+  UINT32            Skip
+  );
+
+//
+// Prints node children to export buffer. When the document has an unmodified
+// copy of the parsed buffer, consecutive unmodified children are copied from it
+// with their separating whitespace as a single span.
+//
+STATIC
+VOID
+XmlNodeExportChildren (
+  XML_NODE          *Node,
+  XML_EXPORT_STATE  *State,
+  UINT32            Skip
+  )
+{
+  XML_NODE  *Child;
+  UINT32    Index;
+  UINT32    SpanStart;
+  UINT32    SpanEnd;
+
+  for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
+    Child = Node->Children->NodeList[Index];
+
+    if (State->Source == NULL || Skip != 0 || Child->SourceLength == 0) {
+      XmlNodeExportRecursive (Child, State, Skip);
+      continue;
+    }
+
+    SpanStart = Child->SourceOffset;
+    SpanEnd   = Child->SourceOffset + Child->SourceLength;
+
+    while (Index + 1 < Node->Children->NodeCount) {
+      Child = Node->Children->NodeList[Index + 1];
+      if (Child->SourceLength == 0 || Child->SourceOffset < SpanEnd) {
+        break;
+      }
+
+      SpanEnd = Child->SourceOffset + Child->SourceLength;
+      ++Index;
+    }
+
+    XmlBufferAppend (State, &State->Source[SpanStart], SpanEnd - SpanStart);
+  }
+}
+
+STATIC
+VOID
+XmlNodeExportRecursive (
+  XML_NODE          *Node,
+  XML_EXPORT_STATE  *State,
+  UINT32            Skip
   )
 {
-  UINT32  Index;
   UINT32  NameLength;
 
   if (Skip != 0) {
     if (Node->Children != NULL) {
-      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
-        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, Skip - 1);
-      }
+      XmlNodeExportChildren (Node, State, Skip - 1);
     }
 
     return;
   }
 
+  if (State->Source != NULL && Node->SourceLength != 0) {
+    XmlBufferAppend (State, &State->Source[Node->SourceOffset], Node->SourceLength);
+    return;
+  }
+
   NameLength = (UINT32)AsciiStrLen (Node->Name);
 
-  XmlBufferAppend (Buffer, AllocSize, CurrentSize, "<", L_STR_LEN ("<"));
-  XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Name, NameLength);
+  XmlBufferAppend (State, "<", L_STR_LEN ("<"));
+  XmlBufferAppend (State, Node->Name, NameLength);
 
   if (Node->Attributes != NULL) {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, " ", L_STR_LEN (" "));
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Attributes, (UINT32)AsciiStrLen (Node->Attributes));
+    XmlBufferAppend (State, " ", L_STR_LEN (" "));
+    XmlBufferAppend (State, Node->Attributes, (UINT32)AsciiStrLen (Node->Attributes));
   }
 
   if (Node->Children != NULL || Node->Content != NULL) {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, ">", L_STR_LEN (">"));
+    XmlBufferAppend (State, ">", L_STR_LEN (">"));
 
     if (Node->Children != NULL) {
-      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
-        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, 0);
-      }
+      XmlNodeExportChildren (Node, State, 0);
     } else {
-      XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Content, (UINT32)AsciiStrLen (Node->Content));
+      XmlBufferAppend (State, Node->Content, (UINT32)AsciiStrLen (Node->Content));
     }
 
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, "</", L_STR_LEN ("</"));
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Name, NameLength);
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, ">", L_STR_LEN (">"));
+    XmlBufferAppend (State, "</", L_STR_LEN ("</"));
+    XmlBufferAppend (State, Node->Name, NameLength);
+    XmlBufferAppend (State, ">", L_STR_LEN (">"));
   } else {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, "/>", L_STR_LEN ("/>"));
+    XmlBufferAppend (State, "/>", L_STR_LEN ("/>"));
   }
 }
 
+//
+// Prints document to export buffer, or measures its size when buffer is NULL.
+//
+STATIC
+BOOLEAN
+XmlDocumentExportInternal (
+  XML_DOCUMENT      *Document,
+  XML_EXPORT_STATE  *State,
+  UINT32            Skip,
+  BOOLEAN           PrependPlistInfo
+  )
+{
+  if (PrependPlistInfo) {
+    XmlBufferAppend (State, XML_PLIST_HEADER, L_STR_LEN (XML_PLIST_HEADER));
+  }
+
+  XmlNodeExportRecursive (Document->Root, State, Skip);
+
+  return !State->Overflow;
+}
+
 //
 // Parses an XML fragment node.
 //
@@ -993,6 +1092,8 @@ XmlParseNode (
   XML_NODE     *Node;
   XML_NODE     *Child;
   UINT32       ReferenceNumber;
+  UINT32       SourceOffset;
+  UINT32       SourceEnd;
   BOOLEAN      IsReference;
   BOOLEAN      SelfClosing;
   BOOLEAN      Unprefixed;
@@ -1016,6 +1117,15 @@ XmlParseNode (
     return NULL;
   }
 
+  //
+  // Tag name directly follows `<'.
+  //
+  SourceOffset = (UINT32) (TagOpen - Parser->Buffer) - 1;
+
+  if (SelfClosing) {
+    SourceEnd = Parser->Position;
+  }
+
   XmlSkipWhitespace (Parser);
 
   Node = XmlNodeCreate (TagOpen, Attributes, NULL, XmlNodeReal (References, Attributes), NULL);
@@ -1028,6 +1138,8 @@ XmlParseNode (
   // If tag ends with `/' it's self closing, skip content lookup.
   //
   if (SelfClosing) {
+    Node->SourceOffset = SourceOffset;
+    Node->SourceLength = SourceEnd - SourceOffset;
     return Node;
   }
 
@@ -1136,6 +1248,9 @@ XmlParseNode (
     return NULL;
   }
 
+  Node->SourceOffset = SourceOffset;
+  Node->SourceLength = Parser->Position - SourceOffset;
+
   return Node;
 }
 
@@ -1191,72 +1306,113 @@ XmlDocumentParse (
   Document->Buffer.Buffer = Buffer;
   Document->Buffer.Length = Length;
   Document->Root = Root;
+  Document->Source = NULL;
   CopyMem (&Document->References, &References, sizeof (References));
 
   return Document;
 }
 
-CHAR8 *
-XmlDocumentExport (
+VOID
+XmlDocumentSetSource (
+  XML_DOCUMENT  *Document,
+  CONST CHAR8   *Source
+  )
+{
+  Document->Source = Source;
+}
+
+BOOLEAN
+XmlDocumentExportSize (
   XML_DOCUMENT  *Document,
   UINT32        *Length,
   UINT32        Skip,
   BOOLEAN       PrependPlistInfo
   )
 {
-  CHAR8   *Buffer;
-  CHAR8   *NewBuffer;
-  UINT32  AllocSize;
-  UINT32  CurrentSize;
-  UINT32  NewSize;
+  XML_EXPORT_STATE  State;
 
-  AllocSize = Document->Buffer.Length + 1;
-  Buffer = AllocatePool (AllocSize);
-  if (Buffer == NULL) {
-    XML_USAGE_ERROR ("XmlDocumentExport::failed to allocate");
-    return NULL;
+  State.Buffer      = NULL;
+  State.BufferSize  = 0;
+  State.CurrentSize = 0;
+  State.Overflow    = FALSE;
+  State.Source      = Document->Source;
+
+  if (!XmlDocumentExportInternal (Document, &State, Skip, PrependPlistInfo)) {
+    return FALSE;
   }
 
-  CurrentSize = 0;
-  XmlNodeExportRecursive (Document->Root, &Buffer, &AllocSize, &CurrentSize, Skip);
+  *Length = State.CurrentSize;
+  return TRUE;
+}
 
-  if (PrependPlistInfo) {
-    //
-    // XmlNodeExportRecursive returns a size that does not include the null terminator,
-    // but the allocated buffer does. During this reallocation, we count the null terminator
-    // of the plist header instead to ensure allocated buffer is the proper size.
-    //
-    if (OcOverflowAddU32 (CurrentSize, L_STR_SIZE (XML_PLIST_HEADER), &NewSize)) {
-      FreePool (Buffer);
-      return NULL;
-    }
+BOOLEAN
+XmlDocumentExportToBuffer (
+  XML_DOCUMENT  *Document,
+  CHAR8         *Buffer,
+  UINT32        BufferSize,
+  UINT32        *Length,
+  UINT32        Skip,
+  BOOLEAN       PrependPlistInfo
+  )
+{
+  XML_EXPORT_STATE  State;
 
-    NewBuffer = AllocatePool (NewSize);
-    if (NewBuffer == NULL) {
-      FreePool (Buffer);
-      XML_USAGE_ERROR ("XmlDocumentExport::failed to allocate");
-      return NULL;
-    }
-    CopyMem (NewBuffer, XML_PLIST_HEADER, L_STR_SIZE_NT (XML_PLIST_HEADER));
-    CopyMem (&NewBuffer[L_STR_LEN (XML_PLIST_HEADER)], Buffer, CurrentSize);
-    FreePool (Buffer);
+  if (BufferSize == 0) {
+    return FALSE;
+  }
 
-    //
-    // Null terminator is not included in size returned by XmlBufferAppend.
-    //
-    CurrentSize = NewSize - 1;
-    Buffer      = NewBuffer;
+  State.Buffer      = Buffer;
+  State.BufferSize  = BufferSize;
+  State.CurrentSize = 0;
+  State.Overflow    = FALSE;
+  State.Source      = Document->Source;
+
+  if (!XmlDocumentExportInternal (Document, &State, Skip, PrependPlistInfo)) {
+    return FALSE;
   }
 
+  //
+  // Null terminator is not included in size returned by XmlBufferAppend,
+  // but there always is room for it.
+  //
+  Buffer[State.CurrentSize] = '\0';
+
   if (Length != NULL) {
-    *Length = CurrentSize;
+    *Length = State.CurrentSize;
   }
 
+  return TRUE;
+}
+
+CHAR8 *
+XmlDocumentExport (
+  XML_DOCUMENT  *Document,
+  UINT32        *Length,
+  UINT32        Skip,
+  BOOLEAN       PrependPlistInfo
+  )
+{
+  CHAR8   *Buffer;
+  UINT32  AllocSize;
+
   //
-  // Null terminator is not included in size returned by XmlBufferAppend,
-  // but the buffer is allocated to include it.
+  // Measure the output first to allocate the buffer exactly once.
   //
-  Buffer[CurrentSize] = '\0';
+  if (!XmlDocumentExportSize (Document, &AllocSize, Skip, PrependPlistInfo)
+    || OcOverflowAddU32 (AllocSize, 1, &AllocSize)) {
+    return NULL;
+  }
+
+  Buffer = AllocatePool (AllocSize);
+  if (Buffer == NULL) {
+    XML_USAGE_ERROR ("XmlDocumentExport::failed to allocate");
+    return NULL;
+  }
+
+  if (!XmlDocumentExportToBuffer (Document, Buffer, AllocSize, Length, Skip, PrependPlistInfo)) {
+    FreePool (Buffer);
+    return NULL;
+  }
 
   return Buffer;
 }
@@ -1303,8 +1459,10 @@ XmlNodeChangeContent (
 {
   if (Node->Real != NULL) {
     Node->Real->Content = Content;
+    XmlNodeInvalidateSource (Node->Real);
   }
   Node->Content = Content;
+  XmlNodeInvalidateSource (Node);
 }
 
 UINT32
@@ -1406,6 +1564,8 @@ XmlNodeAppend (
     return NULL;
   }
 
+  XmlNodeInvalidateSource (Node);
+
   return NewNode;
 }
 
@@ -94,6 +94,9 @@ typedef struct _BOOT_PICKER_GUI_CONTEXT {
   UINT32                               CursorDefaultY;
   INT32                                AudioPlaybackTimeout;
   OC_PICKER_CONTEXT                    *PickerContext;
+  OC_BOOT_CONTEXT                      *BootContext;
+  BOOLEAN                              ScanPending;
+  BOOLEAN                              Revalidate;
 } BOOT_PICKER_GUI_CONTEXT;
 
 EFI_STATUS
@@ -111,6 +114,13 @@ BootPickerEntriesAdd (
   IN BOOLEAN                        Default
   );
 
+EFI_STATUS
+BootPickerFileSystemAdd (
+  IN OUT GUI_DRAWING_CONTEXT      *DrawContext,
+  IN     BOOT_PICKER_GUI_CONTEXT  *GuiContext,
+  IN     OC_BOOT_FILESYSTEM       *FileSystem
+  );
+
 VOID
 BootPickerViewDeinitialize (
   IN OUT GUI_DRAWING_CONTEXT      *DrawContext,
@@ -22,6 +22,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcDevicePathLib.h>
 #include <Library/OcFileLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/UefiApplicationEntryPoint.h>
@@ -93,6 +94,9 @@ OcShowMenuByOc (
   mGuiContext.HideAuxiliary = BootContext->PickerContext->HideAuxiliary;
   mGuiContext.Refresh = FALSE;
   mGuiContext.PickerContext = BootContext->PickerContext;
+  mGuiContext.BootContext = BootContext;
+  mGuiContext.ScanPending = BootContext->PendingFileSystem != NULL;
+  mGuiContext.Revalidate = BootContext->ScanCacheState != NULL;
   mGuiContext.AudioPlaybackTimeout = -1;
 
   Status = OcShowMenuByOcEnter (BootContext);
@@ -117,7 +121,7 @@ OcShowMenuByOc (
     return Status;
   }
 
-  for (Index = 0; Index < BootContext->BootEntryCount; ++Index) {
+  for (Index = 0; Index < BootContext->VisibleEntryCount; ++Index) {
     Status = BootPickerEntriesAdd (
       BootContext->PickerContext,
       &mGuiContext,
@@ -131,6 +135,7 @@ OcShowMenuByOc (
   }
 
   GuiRedrawAndFlushScreen (&mDrawContext);
+  OcTraceEnd ("PickerFrame");
 
   if (BootContext->PickerContext->PickerAudioAssist) {
     BootContext->PickerContext->PlayAudioFile (
@@ -138,7 +143,7 @@ OcShowMenuByOc (
       OcVoiceOverAudioFileChooseOS,
       FALSE
       );
-    for (Index = 0; Index < BootContext->BootEntryCount; ++Index) {
+    for (Index = 0; Index < BootContext->VisibleEntryCount; ++Index) {
       BootContext->PickerContext->PlayAudioEntry (
         BootContext->PickerContext,
         BootEntries[Index]
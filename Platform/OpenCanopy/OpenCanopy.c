@@ -985,6 +985,8 @@ GuiDrawLoop (
 {
   EFI_STATUS          Status;
   BOOLEAN             Result;
+  BOOLEAN             Changed;
+  OC_BOOT_FILESYSTEM  *FileSystem;
 
   INTN                InputKey;
   BOOLEAN             Modifier;
@@ -1160,6 +1162,36 @@ GuiDrawLoop (
       }
     }
 
+    //
+    // Append boot entries of pending filesystems one filesystem per frame.
+    // Once all of them are scanned, revalidate cached boot entries
+    // one filesystem per frame, and reload the picker once any of them changed.
+    //
+    if (DrawContext->GuiContext->ScanPending) {
+      Status = DrawContext->GuiContext->PickerContext->ScanNextFileSystem (
+        DrawContext->GuiContext->BootContext,
+        &FileSystem
+        );
+      if (EFI_ERROR (Status)) {
+        DrawContext->GuiContext->ScanPending = FALSE;
+      } else {
+        Status = BootPickerFileSystemAdd (DrawContext, DrawContext->GuiContext, FileSystem);
+        if (EFI_ERROR (Status)) {
+          DEBUG ((DEBUG_WARN, "OCUI: Failed to add scanned entries - %r\n", Status));
+        }
+      }
+    } else if (DrawContext->GuiContext->Revalidate) {
+      Status = DrawContext->GuiContext->PickerContext->RevalidateBootEntries (
+        DrawContext->GuiContext->BootContext,
+        &Changed
+        );
+      if (EFI_ERROR (Status)) {
+        DrawContext->GuiContext->Revalidate = FALSE;
+      } else if (Changed) {
+        DrawContext->GuiContext->Refresh = TRUE;
+      }
+    }
+
     //
     // Exit early if reach timer timeout and timer isn't disabled due to key event
     //
@@ -1438,6 +1438,52 @@ BootPickerEntriesAdd (
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+BootPickerFileSystemAdd (
+  IN OUT GUI_DRAWING_CONTEXT      *DrawContext,
+  IN     BOOT_PICKER_GUI_CONTEXT  *GuiContext,
+  IN     OC_BOOT_FILESYSTEM       *FileSystem
+  )
+{
+  EFI_STATUS     Status;
+  LIST_ENTRY     *EnLink;
+  OC_BOOT_ENTRY  *BootEntry;
+
+  ASSERT (DrawContext != NULL);
+  ASSERT (GuiContext != NULL);
+  ASSERT (FileSystem != NULL);
+
+  for (
+    EnLink = GetFirstNode (&FileSystem->BootEntries);
+    !IsNull (&FileSystem->BootEntries, EnLink);
+    EnLink = GetNextNode (&FileSystem->BootEntries, EnLink)) {
+    BootEntry = BASE_CR (EnLink, OC_BOOT_ENTRY, Link);
+
+    Status = BootPickerEntriesAdd (
+      GuiContext->PickerContext,
+      GuiContext,
+      BootEntry,
+      FALSE
+      );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  //
+  // Appending entries recenters the picker, so redraw the whole container.
+  //
+  GuiRequestDrawCrop (
+    DrawContext,
+    mBootPickerContainer.Obj.OffsetX,
+    mBootPickerContainer.Obj.OffsetY,
+    mBootPickerContainer.Obj.Width,
+    mBootPickerContainer.Obj.Height
+    );
+
+  return EFI_SUCCESS;
+}
+
 VOID
 InternalBootPickerEntryDestruct (
   IN GUI_VOLUME_ENTRY  *Entry
@@ -32,6 +32,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/DevicePathLib.h>
+#include <Library/OcCompressionLib.h>
 
 #include <IndustryStandard/Apm.h>
 #include <IndustryStandard/Mbr.h>
@@ -32,6 +32,15 @@ DummyLocateProtocol (
   OUT VOID      **Interface
   );
 
+EFI_STATUS
+EFIAPI
+DummyInstallProtocolInterface (
+  IN OUT EFI_HANDLE               *UserHandle,
+  IN     EFI_GUID                 *Protocol,
+  IN     EFI_INTERFACE_TYPE       InterfaceType,
+  IN     VOID                     *Interface
+  );
+
 EFI_STATUS
 EFIAPI
 DummyAllocatePages (
@@ -0,0 +1,27 @@
+/** @file
+  Copyright (c) 2026, agent. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef OC_USER_MP_SERVICES_H
+#define OC_USER_MP_SERVICES_H
+
+#include <Uefi.h>
+#include <Protocol/MpService.h>
+
+/**
+  Install EFI_MP_SERVICES_PROTOCOL implementation backed by host threads.
+  Each application processor is emulated by a thread created for the
+  duration of every StartupAllAPs or StartupThisAP call.
+  Only blocking mode is supported.
+
+  @param[in]  ProcessorCount  Number of processors including the BSP,
+                              0 to use OC_USER_MP_COUNT environment variable
+                              or the number of host processors.
+**/
+VOID
+UserMpServicesInstall (
+  IN UINTN  ProcessorCount
+  );
+
+#endif // OC_USER_MP_SERVICES_H
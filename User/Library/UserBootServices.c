@@ -10,6 +10,7 @@
 EFI_BOOT_SERVICES mBootServices = {
   .RaiseTPL                  = DummyRaiseTPL,
   .LocateProtocol            = DummyLocateProtocol,
+  .InstallProtocolInterface  = DummyInstallProtocolInterface,
   .AllocatePages             = DummyAllocatePages,
   .InstallConfigurationTable = DummyInstallConfigurationTable
 };
@@ -60,6 +61,18 @@ DummyLocateProtocol (
   return EFI_NOT_FOUND;
 }
 
+EFI_STATUS
+EFIAPI
+DummyInstallProtocolInterface (
+  IN OUT EFI_HANDLE               *UserHandle,
+  IN     EFI_GUID                 *Protocol,
+  IN     EFI_INTERFACE_TYPE       InterfaceType,
+  IN     VOID                     *Interface
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
 EFI_STATUS
 EFIAPI
 DummyAllocatePages (
@@ -57,5 +57,6 @@ EFI_GUID gOcVendorVariableGuid               = { 0x4D1FDA02, 0x38C7, 0x4A6A, { 0
 EFI_GUID gOcCustomSmbios3TableGuid           = { 0xF2FD1545, 0x9794, 0x4A2C, { 0x99, 0x2E, 0xE5, 0xBB, 0xCF, 0x20, 0xE3, 0x94 }};
 EFI_GUID gOcCustomSmbiosTableGuid            = { 0xEB9D2D35, 0x2D88, 0x11D3, { 0x9A, 0x16, 0x00, 0x90, 0x27, 0x3F, 0xC1, 0x4D }};
 EFI_GUID gOcAudioProtocolGuid                = { 0x4B228577, 0x6274, 0x4A48, { 0x82, 0xAE, 0x07, 0x13, 0xA1, 0x17, 0x19, 0x87 }};
+EFI_GUID gOcTraceProtocolGuid                = { 0x6E58CEEE, 0xDB0D, 0x45CA, { 0xBA, 0xD4, 0xA9, 0x59, 0xE2, 0x6F, 0x2F, 0x2B }};
 EFI_GUID gAppleEfiCertificateGuid            = { 0x45E7BC51, 0x913C, 0x42AC, { 0x96, 0xA2, 0x10, 0x71, 0x2F, 0xFB, 0xEB, 0xA7 }};
 EFI_GUID gEfiCertTypeRsa2048Sha256Guid       = { 0xa7717414, 0xc616, 0x4977, { 0x94, 0x20, 0x84, 0x47, 0x12, 0xa7, 0x35, 0xbf }};
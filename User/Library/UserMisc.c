@@ -181,6 +181,28 @@ AsmReadIntelMicrocodeRevision (
   return 0;
 }
 
+UINT64
+EFIAPI
+AsmReadXcr0 (
+  VOID
+  )
+{
+  #if defined(__i386__) || defined(__x86_64__)
+  UINT32  Low;
+  UINT32  High;
+
+  asm (
+    ".byte 0x0F, 0x01, 0xD0\n"
+    : "=a" (Low), "=d" (High)
+    : "c" (0)
+    );
+
+  return ((UINT64) High << 32U) | Low;
+  #else
+  return 0;
+  #endif
+}
+
 UINTN
 EFIAPI
 AsmReadCr4 (
@@ -653,3 +675,12 @@ MmioWrite8 (
 {
   return 0;
 }
+
+UINT32
+EFIAPI
+InterlockedIncrement (
+  IN      volatile UINT32           *Value
+  )
+{
+  return __atomic_add_fetch (Value, 1, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,305 @@
+/** @file
+  Copyright (c) 2026, agent. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <UserBootServices.h>
+#include <UserMpServices.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+  EFI_AP_PROCEDURE  Procedure;
+  VOID              *Argument;
+  UINTN             ProcessorNumber;
+  pthread_t         Thread;
+} USER_MP_THREAD;
+
+STATIC UINTN                       mUserProcessorCount = 1;
+STATIC EFI_LOCATE_PROTOCOL         mUserOriginalLocateProtocol;
+STATIC __thread UINTN              mUserProcessorNumber;
+
+STATIC
+VOID *
+UserMpThreadEntry (
+  IN VOID  *Argument
+  )
+{
+  USER_MP_THREAD  *Thread;
+
+  Thread               = Argument;
+  mUserProcessorNumber = Thread->ProcessorNumber;
+  Thread->Procedure (Thread->Argument);
+  return NULL;
+}
+
+STATIC
+EFI_STATUS
+UserMpRunThreads (
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN UINTN             FirstProcessor,
+  IN UINTN             ThreadCount,
+  IN BOOLEAN           SingleThread,
+  IN VOID              *Argument
+  )
+{
+  USER_MP_THREAD  *Threads;
+  UINTN           Index;
+  UINTN           Started;
+
+  Threads = AllocatePool (ThreadCount * sizeof (*Threads));
+  if (Threads == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Started = 0;
+  for (Index = 0; Index < ThreadCount; ++Index) {
+    Threads[Index].Procedure       = Procedure;
+    Threads[Index].Argument        = Argument;
+    Threads[Index].ProcessorNumber = FirstProcessor + Index;
+
+    if (pthread_create (&Threads[Index].Thread, NULL, UserMpThreadEntry, &Threads[Index]) != 0) {
+      break;
+    }
+
+    ++Started;
+
+    if (SingleThread) {
+      pthread_join (Threads[Index].Thread, NULL);
+    }
+  }
+
+  if (!SingleThread) {
+    for (Index = 0; Index < Started; ++Index) {
+      pthread_join (Threads[Index].Thread, NULL);
+    }
+  }
+
+  FreePool (Threads);
+
+  return Started > 0 ? EFI_SUCCESS : EFI_NOT_STARTED;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpGetNumberOfProcessors (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                     *NumberOfProcessors,
+  OUT UINTN                     *NumberOfEnabledProcessors
+  )
+{
+  if (NumberOfProcessors == NULL || NumberOfEnabledProcessors == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *NumberOfProcessors        = mUserProcessorCount;
+  *NumberOfEnabledProcessors = mUserProcessorCount;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpGetProcessorInfo (
+  IN  EFI_MP_SERVICES_PROTOCOL   *This,
+  IN  UINTN                      ProcessorNumber,
+  OUT EFI_PROCESSOR_INFORMATION  *ProcessorInfoBuffer
+  )
+{
+  if (ProcessorInfoBuffer == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (ProcessorNumber >= mUserProcessorCount) {
+    return EFI_NOT_FOUND;
+  }
+
+  ZeroMem (ProcessorInfoBuffer, sizeof (*ProcessorInfoBuffer));
+  ProcessorInfoBuffer->ProcessorId = ProcessorNumber;
+  ProcessorInfoBuffer->StatusFlag  = PROCESSOR_ENABLED_BIT | PROCESSOR_HEALTH_STATUS_BIT;
+  if (ProcessorNumber == 0) {
+    ProcessorInfoBuffer->StatusFlag |= PROCESSOR_AS_BSP_BIT;
+  }
+
+  ProcessorInfoBuffer->Location.Core = (UINT32) ProcessorNumber;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpStartupAllAPs (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  BOOLEAN                   SingleThread,
+  IN  EFI_EVENT                 WaitEvent               OPTIONAL,
+  IN  UINTN                     TimeoutInMicroseconds,
+  IN  VOID                      *ProcedureArgument      OPTIONAL,
+  OUT UINTN                     **FailedCpuList         OPTIONAL
+  )
+{
+  if (Procedure == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (WaitEvent != NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (FailedCpuList != NULL) {
+    *FailedCpuList = NULL;
+  }
+
+  if (mUserProcessorCount < 2) {
+    return EFI_NOT_STARTED;
+  }
+
+  return UserMpRunThreads (
+    Procedure,
+    1,
+    mUserProcessorCount - 1,
+    SingleThread,
+    ProcedureArgument
+    );
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpStartupThisAP (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  UINTN                     ProcessorNumber,
+  IN  EFI_EVENT                 WaitEvent               OPTIONAL,
+  IN  UINTN                     TimeoutInMicroseconds,
+  IN  VOID                      *ProcedureArgument      OPTIONAL,
+  OUT BOOLEAN                   *Finished               OPTIONAL
+  )
+{
+  if (Procedure == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (WaitEvent != NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (ProcessorNumber == 0 || ProcessorNumber >= mUserProcessorCount) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Finished != NULL) {
+    *Finished = TRUE;
+  }
+
+  return UserMpRunThreads (
+    Procedure,
+    ProcessorNumber,
+    1,
+    TRUE,
+    ProcedureArgument
+    );
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpSwitchBSP (
+  IN EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  UINTN                    ProcessorNumber,
+  IN  BOOLEAN                  EnableOldBSP
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpEnableDisableAP (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  UINTN                     ProcessorNumber,
+  IN  BOOLEAN                   EnableAP,
+  IN  UINT32                    *HealthFlag OPTIONAL
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpWhoAmI (
+  IN EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                    *ProcessorNumber
+  )
+{
+  if (ProcessorNumber == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *ProcessorNumber = mUserProcessorNumber;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_MP_SERVICES_PROTOCOL
+mUserMpServices = {
+  .GetNumberOfProcessors = UserMpGetNumberOfProcessors,
+  .GetProcessorInfo      = UserMpGetProcessorInfo,
+  .StartupAllAPs         = UserMpStartupAllAPs,
+  .StartupThisAP         = UserMpStartupThisAP,
+  .SwitchBSP             = UserMpSwitchBSP,
+  .EnableDisableAP       = UserMpEnableDisableAP,
+  .WhoAmI                = UserMpWhoAmI
+};
+
+STATIC
+EFI_STATUS
+EFIAPI
+UserMpLocateProtocol (
+  IN  EFI_GUID  *Protocol,
+  IN  VOID      *Registration, OPTIONAL
+  OUT VOID      **Interface
+  )
+{
+  if (CompareGuid (Protocol, &gEfiMpServiceProtocolGuid)) {
+    *Interface = &mUserMpServices;
+    return EFI_SUCCESS;
+  }
+
+  return mUserOriginalLocateProtocol (Protocol, Registration, Interface);
+}
+
+VOID
+UserMpServicesInstall (
+  IN UINTN  ProcessorCount
+  )
+{
+  long        HostCount;
+  CONST char  *Override;
+
+  if (ProcessorCount == 0) {
+    HostCount = -1;
+    Override  = getenv ("OC_USER_MP_COUNT");
+    if (Override != NULL) {
+      HostCount = strtol (Override, NULL, 10);
+    }
+#ifdef _SC_NPROCESSORS_ONLN
+    if (HostCount <= 0) {
+      HostCount = sysconf (_SC_NPROCESSORS_ONLN);
+    }
+#endif
+    ProcessorCount = HostCount > 0 ? (UINTN) HostCount : 1;
+  }
+
+  mUserProcessorCount = ProcessorCount;
+
+  if (mBootServices.LocateProtocol != UserMpLocateProtocol) {
+    mUserOriginalLocateProtocol  = mBootServices.LocateProtocol;
+    mBootServices.LocateProtocol = UserMpLocateProtocol;
+  }
+}
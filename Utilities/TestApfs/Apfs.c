@@ -0,0 +1,261 @@
+/** @file
+  Copyright (c) 2026, agent. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Base.h>
+
+#include <IndustryStandard/Apfs.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "OcApfsInternal.h"
+
+#define BENCH_ROUNDS 1000
+
+STATIC
+UINT64
+GetMicroseconds (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000ULL + Time.tv_usec;
+}
+
+/**
+  Scalar Fletcher-64 with deferred modulo reduction.
+**/
+STATIC
+UINT64
+ReferenceFletcher64 (
+  IN CONST UINT32  *Data,
+  IN UINTN         DataSize
+  )
+{
+  UINT64  Sum1;
+  UINT64  Sum2;
+  UINTN   Index;
+
+  Sum1 = 0;
+  Sum2 = 0;
+  for (Index = 0; Index < DataSize / sizeof (UINT32); ++Index) {
+    Sum1 += Data[Index];
+    Sum2 += Sum1;
+  }
+
+  Sum2 = MAX_UINT32 - (Sum1 + Sum2) % MAX_UINT32;
+  Sum1 = MAX_UINT32 - (Sum1 + Sum2) % MAX_UINT32;
+
+  return (Sum1 << 32U) | Sum2;
+}
+
+STATIC
+VOID
+FillBuffer (
+  OUT UINT8   *Buffer,
+  IN  UINTN   Size,
+  IN  UINT32  Seed
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Size; ++Index) {
+    Seed          = Seed * 1103515245U + 12345U;
+    Buffer[Index] = (UINT8) (Seed >> 16U);
+  }
+}
+
+/**
+  Check every valid APFS checksum size with random, all-ones and zero data,
+  at 8-byte and 4-byte aligned offsets.
+**/
+STATIC
+int
+VerifyFletcher64 (
+  IN UINT8  *Buffer
+  )
+{
+  UINTN   Size;
+  UINTN   Offset;
+  UINT32  Pattern;
+
+  for (Pattern = 0; Pattern < 3; ++Pattern) {
+    if (Pattern == 0) {
+      FillBuffer (Buffer, APFS_NX_MAXIMUM_BLOCK_SIZE + sizeof (UINT32), 0x12345678);
+    } else {
+      SetMem (Buffer, APFS_NX_MAXIMUM_BLOCK_SIZE + sizeof (UINT32), Pattern == 1 ? 0xFF : 0x00);
+    }
+
+    for (Size = APFS_NX_MINIMUM_BLOCK_SIZE - sizeof (UINT64);
+      Size <= APFS_NX_MAXIMUM_BLOCK_SIZE - sizeof (UINT64);
+      Size += sizeof (UINT32)) {
+      for (Offset = 0; Offset <= sizeof (UINT32); Offset += sizeof (UINT32)) {
+        if (InternalApfsFletcher64 (Buffer + Offset, Size)
+          != ReferenceFletcher64 ((UINT32 *) (Buffer + Offset), Size)) {
+          printf ("Fletcher-64 mismatch at size %u offset %u pattern %u\n", (UINT32) Size, (UINT32) Offset, Pattern);
+          return -1;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+STATIC
+int
+BenchmarkFletcher64 (
+  IN UINT32  BlockSize
+  )
+{
+  UINT8   *Buffer;
+  UINT32  Size;
+  UINT32  Round;
+  UINT32  Index;
+  UINT32  Blocks;
+  UINT64  Start;
+  UINT64  ReferenceTime;
+  UINT64  FastTime;
+  UINT64  Reference;
+  UINT64  Fast;
+
+  if (BlockSize < APFS_NX_MINIMUM_BLOCK_SIZE || BlockSize > APFS_NX_MAXIMUM_BLOCK_SIZE
+    || BlockSize % sizeof (UINT32) != 0) {
+    printf ("Invalid block size %u\n", BlockSize);
+    return -1;
+  }
+
+  //
+  // Checksum a cache-resident 1 MB area block by block, like container
+  // readers do right after reading the blocks.
+  //
+  Blocks = SIZE_1MB / BlockSize;
+  Size   = Blocks * BlockSize;
+  Buffer = AllocatePool (Size);
+  if (Buffer == NULL) {
+    printf ("Cannot allocate %u bytes\n", Size);
+    return -1;
+  }
+
+  if (VerifyFletcher64 (Buffer) != 0) {
+    FreePool (Buffer);
+    return -1;
+  }
+
+  FillBuffer (Buffer, Size, 0x87654321);
+
+  Reference     = 0;
+  Fast          = 0;
+  ReferenceTime = 0;
+  FastTime      = 0;
+
+  for (Round = 0; Round < BENCH_ROUNDS; ++Round) {
+    Start = GetMicroseconds ();
+    for (Index = 0; Index < Blocks; ++Index) {
+      Reference += ReferenceFletcher64 (
+        (UINT32 *) (Buffer + Index * BlockSize + sizeof (UINT64)),
+        BlockSize - sizeof (UINT64)
+        );
+    }
+    ReferenceTime += GetMicroseconds () - Start;
+
+    Start = GetMicroseconds ();
+    for (Index = 0; Index < Blocks; ++Index) {
+      Fast += InternalApfsFletcher64 (
+        Buffer + Index * BlockSize + sizeof (UINT64),
+        BlockSize - sizeof (UINT64)
+        );
+    }
+    FastTime += GetMicroseconds () - Start;
+  }
+
+  printf (
+    "fletcher64 %u byte blocks: reference %llu MB/s, fast %llu MB/s (%016llX %016llX)\n",
+    BlockSize,
+    (unsigned long long) (ReferenceTime > 0 ? (UINT64) Size * BENCH_ROUNDS / ReferenceTime : 0),
+    (unsigned long long) (FastTime > 0 ? (UINT64) Size * BENCH_ROUNDS / FastTime : 0),
+    (unsigned long long) Reference,
+    (unsigned long long) Fast
+    );
+
+  FreePool (Buffer);
+  return Reference == Fast ? 0 : -1;
+}
+
+int ENTRY_POINT (int argc, char *argv[]) {
+  UINT8  *Buffer;
+  int    Result;
+
+  if (argc > 1 && strcmp (argv[1], "checksum") == 0) {
+    return BenchmarkFletcher64 (argc > 2 ? (UINT32) atoi (argv[2]) : APFS_NX_MINIMUM_BLOCK_SIZE);
+  }
+
+  if (argc > 1) {
+    printf ("Usage: %s\n", argv[0]);
+    printf ("       %s checksum [block size]\n", argv[0]);
+    return -1;
+  }
+
+  Buffer = AllocatePool (APFS_NX_MAXIMUM_BLOCK_SIZE + sizeof (UINT32));
+  if (Buffer == NULL) {
+    return -1;
+  }
+
+  Result = VerifyFletcher64 (Buffer);
+  if (Result == 0) {
+    printf ("Fletcher-64 matches reference for all block sizes\n");
+  }
+
+  FreePool (Buffer);
+  return Result;
+}
+
+INT32 LLVMFuzzerTestOneInput(CONST UINT8 *Data, UINTN Size) {
+  UINT8  *Buffer;
+  UINTN  DataSize;
+  UINTN  Index;
+
+  if (Size < sizeof (UINT16)) {
+    return 0;
+  }
+
+  //
+  // Use the first two bytes to pick a valid checksum size and
+  // repeat the input to fill it.
+  //
+  DataSize = APFS_NX_MINIMUM_BLOCK_SIZE - sizeof (UINT64)
+    + (ReadUnaligned16 ((CONST UINT16 *) Data) % ((APFS_NX_MAXIMUM_BLOCK_SIZE - APFS_NX_MINIMUM_BLOCK_SIZE) / sizeof (UINT32) + 1))
+    * sizeof (UINT32);
+  Data += sizeof (UINT16);
+  Size -= sizeof (UINT16);
+
+  Buffer = AllocatePool (DataSize);
+  if (Buffer == NULL) {
+    return 0;
+  }
+
+  if (Size > 0) {
+    for (Index = 0; Index < DataSize; ++Index) {
+      Buffer[Index] = Data[Index % Size];
+    }
+  } else {
+    SetMem (Buffer, DataSize, 0xFF);
+  }
+
+  if (InternalApfsFletcher64 (Buffer, DataSize) != ReferenceFletcher64 ((UINT32 *) Buffer, DataSize)) {
+    abort ();
+  }
+
+  FreePool (Buffer);
+  return 0;
+}
@@ -0,0 +1,352 @@
+/** @file
+  Copyright (c) 2026, agent. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Base.h>
+
+#include <IndustryStandard/AppleCompressedBinaryImage.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <UserFile.h>
+
+#include "lzvn.h"
+
+#define BENCH_ROUNDS 10
+
+STATIC
+UINT64
+GetMicroseconds (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000ULL + Time.tv_usec;
+}
+
+STATIC
+MACH_COMP_HEADER *
+FindCompressedKernel (
+  IN  UINT8   *Buffer,
+  IN  UINT32  BufferSize
+  )
+{
+  MACH_COMP_HEADER  *CompHeader;
+  UINT32            Offset;
+
+  //
+  // Compressed kernels may be wrapped into a FAT binary, whose slices are
+  // at least 4-byte aligned.
+  //
+  for (Offset = 0; BufferSize - Offset >= sizeof (MACH_COMP_HEADER); Offset += sizeof (UINT32)) {
+    CompHeader = (MACH_COMP_HEADER *) (Buffer + Offset);
+    if (CompHeader->Signature == MACH_COMPRESSED_BINARY_INVERT_SIGNATURE
+      && CompHeader->Compression == MACH_COMPRESSED_BINARY_INVERT_LZVN
+      && SwapBytes32 (CompHeader->Compressed) <= BufferSize - Offset - sizeof (MACH_COMP_HEADER)) {
+      return CompHeader;
+    }
+  }
+
+  return NULL;
+}
+
+STATIC
+int
+BenchmarkLzvn (
+  IN  CONST CHAR8  *Path
+  )
+{
+  UINT8             *Buffer;
+  UINT32            BufferSize;
+  MACH_COMP_HEADER  *CompHeader;
+  UINT8             *Compressed;
+  UINT32            CompressedSize;
+  UINT32            DecompressedSize;
+  UINT8             *Fast;
+  UINT8             *Reference;
+  UINTN             FastSize;
+  UINTN             ReferenceSize;
+  UINT64            FastTime;
+  UINT64            ReferenceTime;
+  UINT64            Start;
+  UINT32            Round;
+  int               Result;
+
+  Buffer = UserReadFile (Path, &BufferSize);
+  if (Buffer == NULL) {
+    printf ("%s: read fail\n", Path);
+    return -1;
+  }
+
+  CompHeader = FindCompressedKernel (Buffer, BufferSize);
+  if (CompHeader == NULL) {
+    printf ("%s: no LZVN compressed kernel found\n", Path);
+    free (Buffer);
+    return -1;
+  }
+
+  Compressed       = (UINT8 *) (CompHeader + 1);
+  CompressedSize   = SwapBytes32 (CompHeader->Compressed);
+  DecompressedSize = SwapBytes32 (CompHeader->Decompressed);
+
+  Fast      = AllocatePool (DecompressedSize);
+  Reference = AllocatePool (DecompressedSize);
+  if (Fast == NULL || Reference == NULL) {
+    printf ("%s: cannot allocate %u bytes\n", Path, DecompressedSize);
+    free (Buffer);
+    free (Fast);
+    free (Reference);
+    return -1;
+  }
+
+  FastSize      = 0;
+  ReferenceSize = 0;
+  FastTime      = 0;
+  ReferenceTime = 0;
+
+  for (Round = 0; Round < BENCH_ROUNDS; ++Round) {
+    Start          = GetMicroseconds ();
+    ReferenceSize  = lzvn_decode_buffer_reference (Reference, DecompressedSize, Compressed, CompressedSize);
+    ReferenceTime += GetMicroseconds () - Start;
+
+    Start          = GetMicroseconds ();
+    FastSize       = DecompressLZVN (Fast, DecompressedSize, Compressed, CompressedSize);
+    FastTime      += GetMicroseconds () - Start;
+  }
+
+  Result = 0;
+  if (FastSize != DecompressedSize || ReferenceSize != DecompressedSize) {
+    printf ("%s: size mismatch %u (fast %u, reference %u)\n", Path, DecompressedSize, (UINT32) FastSize, (UINT32) ReferenceSize);
+    Result = -1;
+  } else if (CompareMem (Fast, Reference, DecompressedSize) != 0) {
+    printf ("%s: data mismatch\n", Path);
+    Result = -1;
+  } else if (Adler32 (Fast, DecompressedSize) != SwapBytes32 (CompHeader->Hash)) {
+    printf ("%s: adler32 mismatch\n", Path);
+    Result = -1;
+  } else {
+    printf (
+      "%s: %u -> %u bytes, reference %llu us (%llu MB/s), fast %llu us (%llu MB/s)\n",
+      Path,
+      CompressedSize,
+      DecompressedSize,
+      (unsigned long long) (ReferenceTime / BENCH_ROUNDS),
+      (unsigned long long) (ReferenceTime > 0 ? (UINT64) DecompressedSize * BENCH_ROUNDS / ReferenceTime : 0),
+      (unsigned long long) (FastTime / BENCH_ROUNDS),
+      (unsigned long long) (FastTime > 0 ? (UINT64) DecompressedSize * BENCH_ROUNDS / FastTime : 0)
+      );
+  }
+
+  free (Buffer);
+  FreePool (Fast);
+  FreePool (Reference);
+  return Result;
+}
+
+STATIC
+UINT32
+ReferenceAdler32 (
+  IN UINT32       Adler,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferSize
+  )
+{
+  UINT32  S1;
+  UINT32  S2;
+  UINTN   Index;
+
+  S1 = Adler & 0xFFFFU;
+  S2 = Adler >> 16U;
+  for (Index = 0; Index < BufferSize; ++Index) {
+    S1 = (S1 + Buffer[Index]) % 65521U;
+    S2 = (S2 + S1) % 65521U;
+  }
+
+  return (S2 << 16U) | S1;
+}
+
+STATIC
+UINT32
+ReferenceCrc32 (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        BufferSize
+  )
+{
+  UINTN   Index;
+  UINT32  Bit;
+
+  Crc = ~Crc;
+  for (Index = 0; Index < BufferSize; ++Index) {
+    Crc ^= Buffer[Index];
+    for (Bit = 0; Bit < 8; ++Bit) {
+      Crc = (Crc >> 1U) ^ (0xEDB88320U & (0U - (Crc & 1U)));
+    }
+  }
+
+  return ~Crc;
+}
+
+STATIC
+int
+BenchmarkChecksum (
+  IN UINT32  Megabytes
+  )
+{
+  UINT8   *Buffer;
+  UINT32  Size;
+  UINT32  Index;
+  UINT32  Seed;
+  UINT32  Round;
+  UINT32  Adler;
+  UINT32  Crc;
+  UINT64  Start;
+  UINT64  AdlerTime;
+  UINT64  CrcTime;
+
+  Size   = Megabytes * 1024 * 1024;
+  Buffer = AllocatePool (Size);
+  if (Buffer == NULL) {
+    printf ("Cannot allocate %u bytes\n", Size);
+    return -1;
+  }
+
+  Seed = 0x12345678;
+  for (Index = 0; Index < Size; ++Index) {
+    Seed          = Seed * 1103515245U + 12345U;
+    Buffer[Index] = (UINT8) (Seed >> 16U);
+  }
+
+  //
+  // Validate against the bytewise reference on a small unaligned window
+  // before measuring, so the numbers are known to be meaningful.
+  //
+  for (Index = 0; Index < 4096; Index += 7) {
+    if (Adler32 (Buffer + Index % 61, Index) != ReferenceAdler32 (1, Buffer + Index % 61, Index)
+      || Crc32 (Buffer + Index % 61, Index) != ReferenceCrc32 (0, Buffer + Index % 61, Index)) {
+      printf ("Checksum mismatch at length %u\n", Index);
+      FreePool (Buffer);
+      return -1;
+    }
+  }
+
+  Adler     = 0;
+  Crc       = 0;
+  AdlerTime = 0;
+  CrcTime   = 0;
+
+  for (Round = 0; Round < BENCH_ROUNDS; ++Round) {
+    Start      = GetMicroseconds ();
+    Adler      = Adler32 (Buffer, Size);
+    AdlerTime += GetMicroseconds () - Start;
+
+    Start      = GetMicroseconds ();
+    Crc        = Crc32 (Buffer, Size);
+    CrcTime   += GetMicroseconds () - Start;
+  }
+
+  printf (
+    "checksum %u MB: adler32 %llu MB/s, crc32 %llu MB/s (%08X %08X)\n",
+    Megabytes,
+    (unsigned long long) (AdlerTime > 0 ? (UINT64) Size * BENCH_ROUNDS / AdlerTime : 0),
+    (unsigned long long) (CrcTime > 0 ? (UINT64) Size * BENCH_ROUNDS / CrcTime : 0),
+    Adler,
+    Crc
+    );
+
+  FreePool (Buffer);
+  return 0;
+}
+
+int ENTRY_POINT (int argc, char *argv[]) {
+  int  Index;
+  int  Result;
+
+  if (argc < 2) {
+    printf ("Usage: %s kernelcache [kernelcache ...]\n", argv[0]);
+    printf ("       %s checksum [megabytes]\n", argv[0]);
+    return -1;
+  }
+
+  if (strcmp (argv[1], "checksum") == 0) {
+    return BenchmarkChecksum (argc > 2 ? (UINT32) atoi (argv[2]) : 64);
+  }
+
+  Result = 0;
+  for (Index = 1; Index < argc; ++Index) {
+    if (BenchmarkLzvn (argv[Index]) != 0) {
+      Result = -1;
+    }
+  }
+
+  return Result;
+}
+
+INT32 LLVMFuzzerTestOneInput(CONST UINT8 *Data, UINTN Size) {
+  #define MAX_INPUT  1024
+  #define MAX_OUTPUT 8192
+
+  UINT8   *Fast;
+  UINT8   *Reference;
+  UINTN   FastSize;
+  UINTN   ReferenceSize;
+  UINTN   Index;
+
+  if (Size > MAX_INPUT) {
+    return 0;
+  }
+
+  Fast      = AllocatePool (MAX_OUTPUT);
+  Reference = AllocatePool (MAX_OUTPUT);
+  if (Fast == NULL || Reference == NULL) {
+    free (Fast);
+    free (Reference);
+    return 0;
+  }
+
+  //
+  // Differential test: the fast path must produce exactly the same output
+  // as the reference decoder for every destination size, and must never
+  // write past the destination buffer.
+  //
+  for (Index = 0; Index <= MAX_OUTPUT; Index += (Index < 512 ? 1 : 61)) {
+    SetMem (Reference, MAX_OUTPUT, 0);
+    ReferenceSize = lzvn_decode_buffer_reference (Reference, Index, Data, Size);
+
+    SetMem (Fast, MAX_OUTPUT, 0);
+    ASAN_POISON_MEMORY_REGION (Fast + Index, MAX_OUTPUT - Index);
+    FastSize = DecompressLZVN (Fast, Index, Data, Size);
+    ASAN_UNPOISON_MEMORY_REGION (Fast + Index, MAX_OUTPUT - Index);
+
+    ASSERT (FastSize <= Index);
+    if (FastSize != ReferenceSize || CompareMem (Fast, Reference, FastSize) != 0) {
+      abort ();
+    }
+  }
+
+  //
+  // Vectorised checksums must match the bytewise references, including
+  // when continued from a non-initial state.
+  //
+  if (Adler32 (Data, Size) != ReferenceAdler32 (1, Data, Size)
+    || Crc32 (Data, Size) != ReferenceCrc32 (0, Data, Size)
+    || Adler32Update (0xDEADBEEFU % 65521U, Data, Size) != ReferenceAdler32 (0xDEADBEEFU % 65521U, Data, Size)
+    || Crc32Update (0xDEADBEEFU, Data, Size) != ReferenceCrc32 (0xDEADBEEFU, Data, Size)) {
+    abort ();
+  }
+
+  FreePool (Fast);
+  FreePool (Reference);
+  return 0;
+}
@@ -12,17 +12,22 @@
 #include <Library/OcCompressionLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
+#include <Library/OcParallelLib.h>
 
 #include <string.h>
 
 #include <UserFile.h>
+#include <UserMpServices.h>
+#include <time.h>
 
 int ENTRY_POINT (int argc, char *argv[]) {
   if (argc < 2) {
     printf ("Please provide a valid Disk Image path\n");
     return -1;
   }
-  
+
+  UserMpServicesInstall (0);
+
   if ((argc % 2) != 1) {
     printf ("Please provide a chunklist file for each DMG, enter \'n\' to skip\n");
   }
@@ -93,11 +98,22 @@ int ENTRY_POINT (int argc, char *argv[]) {
         goto ContinueDmgLoop;
       }
 
+      clock_t Start = clock ();
+      struct timespec WallStart, WallEnd;
+      clock_gettime (CLOCK_MONOTONIC, &WallStart);
       Result = OcAppleDiskImageVerifyData (&DmgContext, &ChunklistContext);
+      clock_gettime (CLOCK_MONOTONIC, &WallEnd);
       if (!Result) {
         printf ("Chunklist chunk verification error\n");
         goto ContinueDmgLoop;
       }
+
+      printf (
+        "Chunklist verified in %.3f ms (%.3f ms CPU) on %u processors\n",
+        (WallEnd.tv_sec - WallStart.tv_sec) * 1000.0 + (WallEnd.tv_nsec - WallStart.tv_nsec) / 1000000.0,
+        (clock () - Start) * 1000.0 / CLOCKS_PER_SEC,
+        (unsigned) OcParallelGetWorkerCount ()
+        );
     }
 
     UncompSize = (DmgContext.SectorCount * APPLE_DISK_IMAGE_SECTOR_SIZE);
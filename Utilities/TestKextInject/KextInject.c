@@ -491,6 +491,8 @@ ApplyKernelPatches (
     } else {
       DEBUG ((DEBUG_WARN, "[OK] KernelQuirkSegmentJettison patch\n"));
     }
+
+    MachoFreeSymbolIndex (&Patcher.MachContext);
   } else {
     DEBUG ((DEBUG_WARN, "Failed to find kernel - %r\n", Status));
     FailedToProcess = TRUE;
@@ -684,6 +686,7 @@ int wrap_main(int argc, char** argv) {
     }
 
     int c = 0;
+    long long InjectTime = 0;
 
     while (argc > 2) {
       UINT8  *TestData = NULL;
@@ -717,6 +720,7 @@ int wrap_main(int argc, char** argv) {
       char KextPath[64];
       snprintf(KextPath, sizeof(KextPath), "/Library/Extensions/Kex%d.kext", c);
 
+      long long InjectStart = current_timestamp();
       Status = PrelinkedInjectKext (
         &Context,
         NULL,
@@ -727,6 +731,7 @@ int wrap_main(int argc, char** argv) {
         TestData,
         TestDataSize
         );
+      InjectTime += current_timestamp() - InjectStart;
 
       if (!EFI_ERROR (Status)) {
         DEBUG ((DEBUG_WARN, "[OK] %a injected - %r\n", argv[2], Status));
@@ -745,7 +750,22 @@ int wrap_main(int argc, char** argv) {
 
     ASSERT (Context.PrelinkedSize - Context.KextsFileOffset <= ReservedExeSize);
 
+    long long CompleteStart = current_timestamp();
     Status = PrelinkedInjectComplete (&Context);
+    long long CompleteTime = current_timestamp() - CompleteStart;
+
+    //
+    // For kernel collections injection also converts kext relocations to
+    // fixup chains, pass a large kext set to benchmark it.
+    //
+    DEBUG ((
+      DEBUG_WARN,
+      "[OK] Injected %d kexts in %Lu ms, completed in %Lu ms (%a)\n",
+      c,
+      (UINT64) InjectTime,
+      (UINT64) CompleteTime,
+      Context.IsKernelCollection ? "KC" : "prelinked"
+      ));
 
     ApplyKextPatches (&Context);
 
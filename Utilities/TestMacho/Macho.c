@@ -260,6 +260,14 @@ static int FeedMacho(void *file, uint32_t size) {
     }
   }
 
+  //
+  // Exercise symbol name index lookups.
+  //
+  if (MachoGetSymbolByName (&Context, "_Assert") != NULL) {
+    MachoGetLocalDefinedSymbolByName64 (&Context, "_Assert");
+  }
+  MachoFreeSymbolIndex (&Context);
+
   for (size_t i = 0x1000000; i < MAX_UINTN; i+= 0x1000000) {
     if (MachoGetSymbolByRelocationOffset64 (&Context, i, &Symbol)) {
       if (!AsciiStrCmp (MachoGetSymbolName64 (&Context, Symbol), "__hack")) {
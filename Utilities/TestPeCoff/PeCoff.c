@@ -5,6 +5,7 @@
 
 #include "../Include/Uefi.h"
 
+#include <Library/OcCryptoLib.h>
 #include <Library/OcPeCoffLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
@@ -12,9 +13,35 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include <UserFile.h>
 
+STATIC
+BOOLEAN
+EFIAPI
+HashUpdate (
+  IN OUT VOID        *HashContext,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  Sha256Update (HashContext, Data, DataSize);
+  return TRUE;
+}
+
+STATIC
+double
+GetTimeMs (
+  VOID
+  )
+{
+  struct timespec  Time;
+
+  clock_gettime (CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec * 1000.0 + Time.tv_nsec / 1000000.0;
+}
+
 EFI_STATUS
 TestImageLoad (
   IN VOID   *SourceBuffer,
@@ -103,9 +130,179 @@ TestImageLoad (
   return EFI_SUCCESS;
 }
 
+/**
+  Compare hashing, loading, and relocating the image separately with the fused
+  single pass, both into a separate destination and in place, and time them.
+**/
+EFI_STATUS
+TestImageLoadFused (
+  IN VOID    *SourceBuffer,
+  IN UINT32  SourceSize,
+  IN UINT32  Iterations
+  )
+{
+  RETURN_STATUS          ImageStatus;
+  PE_COFF_IMAGE_CONTEXT  ImageContext;
+  UINT32                 PageCount;
+  UINT8                  *Reference;
+  UINT8                  *Destination;
+  UINT8                  *InPlaceBuffer;
+  SHA256_CONTEXT         HashContext;
+  UINT8                  ReferenceDigest[SHA256_DIGEST_SIZE];
+  UINT8                  Digest[SHA256_DIGEST_SIZE];
+  UINT32                 Index;
+  double                 Start;
+  double                 Separate;
+  double                 Fused;
+  double                 InPlace;
+  BOOLEAN                CanLoadInPlace;
+
+  ImageStatus = PeCoffInitializeContext (&ImageContext, SourceBuffer, SourceSize);
+  if (EFI_ERROR (ImageStatus)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  PageCount = EFI_SIZE_TO_PAGES (MAX (ImageContext.SizeOfImage, SourceSize));
+
+  Reference     = AllocatePages (PageCount);
+  Destination   = AllocatePages (PageCount);
+  InPlaceBuffer = AllocatePages (PageCount);
+  if (Reference == NULL || Destination == NULL || InPlaceBuffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if (Iterations == 0) {
+    Iterations = 1;
+  }
+
+  //
+  // Separate passes. Reference is relocated to the fused destination to compare them.
+  //
+  Start = GetTimeMs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    Sha256Init (&HashContext);
+    if (!PeCoffHashImage (&ImageContext, HashUpdate, &HashContext)) {
+      printf ("Separate hash failure\n");
+      return EFI_UNSUPPORTED;
+    }
+    Sha256Final (&HashContext, ReferenceDigest);
+
+    ImageStatus = PeCoffLoadImage (&ImageContext, Reference, ImageContext.SizeOfImage);
+    if (!EFI_ERROR (ImageStatus)) {
+      ImageStatus = PeCoffRelocateImage (&ImageContext, (UINTN) Destination, NULL, 0);
+    }
+    if (EFI_ERROR (ImageStatus)) {
+      printf ("Separate load failure - %d\n", (int) ImageStatus);
+      return EFI_UNSUPPORTED;
+    }
+  }
+  Separate = GetTimeMs () - Start;
+
+  //
+  // Fused pass into a separate destination.
+  //
+  Start = GetTimeMs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    Sha256Init (&HashContext);
+    ImageStatus = PeCoffLoadRelocateImage (
+      &ImageContext,
+      Destination,
+      ImageContext.SizeOfImage,
+      HashUpdate,
+      &HashContext
+      );
+    if (EFI_ERROR (ImageStatus)) {
+      printf ("Fused load failure - %d\n", (int) ImageStatus);
+      return EFI_UNSUPPORTED;
+    }
+    Sha256Final (&HashContext, Digest);
+  }
+  Fused = GetTimeMs () - Start;
+
+  if (memcmp (Digest, ReferenceDigest, sizeof (Digest)) != 0) {
+    printf ("Fused digest mismatch\n");
+    return EFI_UNSUPPORTED;
+  }
+
+  if (memcmp (Destination, Reference, ImageContext.SizeOfImage) != 0) {
+    printf ("Fused image mismatch\n");
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Fused pass in place, excluding the copy standing for the file read.
+  //
+  InPlace = 0;
+  CopyMem (InPlaceBuffer, SourceBuffer, SourceSize);
+  ImageStatus    = PeCoffInitializeContext (&ImageContext, InPlaceBuffer, SourceSize);
+  CanLoadInPlace = !EFI_ERROR (ImageStatus)
+    && PeCoffCanLoadInPlace (&ImageContext, EFI_PAGES_TO_SIZE (PageCount));
+
+  if (CanLoadInPlace) {
+    for (Index = 0; Index < Iterations; ++Index) {
+      CopyMem (InPlaceBuffer, SourceBuffer, SourceSize);
+      PeCoffInitializeContext (&ImageContext, InPlaceBuffer, SourceSize);
+
+      Start = GetTimeMs ();
+      Sha256Init (&HashContext);
+      ImageStatus = PeCoffLoadRelocateImage (
+        &ImageContext,
+        InPlaceBuffer,
+        EFI_PAGES_TO_SIZE (PageCount),
+        HashUpdate,
+        &HashContext
+        );
+      Sha256Final (&HashContext, Digest);
+      InPlace += GetTimeMs () - Start;
+
+      if (EFI_ERROR (ImageStatus)) {
+        printf ("In place load failure - %d\n", (int) ImageStatus);
+        return EFI_UNSUPPORTED;
+      }
+    }
+
+    //
+    // Relocate the reference to the in place address to compare them.
+    //
+    PeCoffInitializeContext (&ImageContext, SourceBuffer, SourceSize);
+    ImageStatus = PeCoffLoadImage (&ImageContext, Reference, ImageContext.SizeOfImage);
+    if (!EFI_ERROR (ImageStatus)) {
+      ImageStatus = PeCoffRelocateImage (&ImageContext, (UINTN) InPlaceBuffer, NULL, 0);
+    }
+
+    if (EFI_ERROR (ImageStatus)
+      || memcmp (Digest, ReferenceDigest, sizeof (Digest)) != 0
+      || memcmp (InPlaceBuffer, Reference, ImageContext.SizeOfImage) != 0) {
+      printf ("In place image mismatch\n");
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  printf (
+    "Image %u bytes, loaded %u bytes, %u iterations\n",
+    SourceSize,
+    ImageContext.SizeOfImage,
+    Iterations
+    );
+  printf ("Separate hash, load, relocate: %.3f ms\n", Separate);
+  printf ("Fused hash, load, relocate:    %.3f ms\n", Fused);
+  if (CanLoadInPlace) {
+    printf ("Fused in place:                %.3f ms\n", InPlace);
+  } else {
+    printf ("Fused in place:                unsupported by image layout\n");
+  }
+
+  FreePages (Reference, PageCount);
+  FreePages (Destination, PageCount);
+  FreePages (InPlaceBuffer, PageCount);
+
+  return EFI_SUCCESS;
+}
+
 int ENTRY_POINT (int argc, char *argv[]) {
   if (argc < 2) {
     printf ("Please provide a valid PE image path\n");
+    printf ("Usage: %s <image.efi> [benchmark iterations]\n", argv[0]);
     return -1;
   }
 
@@ -121,6 +318,9 @@ int ENTRY_POINT (int argc, char *argv[]) {
   }
 
   EFI_STATUS Status = TestImageLoad (Image, ImageSize);
+  if (!EFI_ERROR (Status) && argc > 2) {
+    Status = TestImageLoadFused (Image, ImageSize, (UINT32) strtoul (argv[2], NULL, 0));
+  }
   free(Image);
   if (EFI_ERROR (Status)) {
     return 1;
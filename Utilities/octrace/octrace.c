@@ -0,0 +1,222 @@
+/** @file
+  Decode OpenCore boot trace (opencore-trace variable) into a phase tree.
+
+  Copyright (c) 2026, agent. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Base.h>
+#include <Library/OcTraceLib.h>
+#include <UserFile.h>
+
+#define BAR_WIDTH  40
+
+STATIC OC_TRACE_HEADER  *mHeader;
+STATIC OC_TRACE_NODE    *mNodes;
+STATIC UINT16           mOrder[OC_TRACE_MAX_NODES];
+STATIC UINT64           mRootTotal;
+
+STATIC
+double
+TicksToMs (
+  IN UINT64  Ticks
+  )
+{
+  if (mHeader->Frequency == 0) {
+    return (double) Ticks;
+  }
+
+  return (double) Ticks * 1000.0 / (double) mHeader->Frequency;
+}
+
+/**
+  Decode nvram(8) output, e.g. "GUID:opencore-trace\t%4fcTr...", in place.
+**/
+STATIC
+UINT32
+DecodeNvramText (
+  IN OUT UINT8   *Buffer,
+  IN     UINT32  Size
+  )
+{
+  UINT32        Index;
+  UINT32        Length;
+  unsigned int  Value;
+
+  Index = 0;
+  while (Index < Size && Buffer[Index] != '\t') {
+    ++Index;
+  }
+
+  if (Index == Size) {
+    return 0;
+  }
+
+  ++Index;
+  Length = 0;
+  while (Index < Size && Buffer[Index] != '\n' && Buffer[Index] != '\r') {
+    if (Buffer[Index] == '%' && Index + 2 < Size
+      && sscanf ((char *) &Buffer[Index + 1], "%2x", &Value) == 1) {
+      Buffer[Length++] = (UINT8) Value;
+      Index += 3;
+    } else {
+      Buffer[Length++] = Buffer[Index++];
+    }
+  }
+
+  return Length;
+}
+
+STATIC
+VOID
+PrintNode (
+  IN UINT16  Index,
+  IN UINT32  Level
+  )
+{
+  OC_TRACE_NODE  *Node;
+  UINT64         ParentTotal;
+  UINT32         Bar;
+  UINT32         BarStart;
+  UINT16         Child;
+  char           Label[64];
+
+  Node = &mNodes[Index];
+
+  ParentTotal = Node->Parent != 0 ? mNodes[Node->Parent - 1].Total : mRootTotal;
+
+  snprintf (Label, sizeof (Label), "%*s%.*s", (int) (Level * 2), "", OC_TRACE_NAME_SIZE, Node->Name);
+
+  printf (
+    "%-36s %10.3f %10.3f %6u %6.1f%% ",
+    Label,
+    TicksToMs (Node->First - mHeader->Start),
+    TicksToMs (Node->Total),
+    Node->Count,
+    ParentTotal != 0 ? 100.0 * (double) Node->Total / (double) ParentTotal : 0.0
+    );
+
+  //
+  // Every level is indented by one column, similar to stacked flame graph rows.
+  //
+  BarStart = Level < BAR_WIDTH ? Level : BAR_WIDTH;
+  Bar      = mRootTotal != 0 ? (UINT32) ((Node->Total * BAR_WIDTH + mRootTotal / 2) / mRootTotal) : 0;
+  if (Bar == 0 && Node->Total != 0) {
+    Bar = 1;
+  }
+
+  printf ("%*s", (int) BarStart, "");
+  while (Bar-- > 0) {
+    putchar ('#');
+  }
+  putchar ('\n');
+
+  //
+  // Print children in the order they were first started.
+  //
+  for (Child = 0; Child < mHeader->NodeCount; ++Child) {
+    if (mNodes[mOrder[Child]].Parent == Index + 1) {
+      PrintNode (mOrder[Child], Level + 1);
+    }
+  }
+}
+
+STATIC
+int
+CompareNodes (
+  const void  *A,
+  const void  *B
+  )
+{
+  UINT16  IndexA;
+  UINT16  IndexB;
+
+  IndexA = *(const UINT16 *) A;
+  IndexB = *(const UINT16 *) B;
+
+  if (mNodes[IndexA].First != mNodes[IndexB].First) {
+    return mNodes[IndexA].First < mNodes[IndexB].First ? -1 : 1;
+  }
+
+  return (int) IndexA - (int) IndexB;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINT8   *Buffer;
+  UINT32  Size;
+  UINT16  Index;
+
+  if (argc != 2) {
+    printf ("Usage: %s <opencore-trace.bin>\n", argv[0]);
+    printf ("Accepts raw variable data or the output of:\n");
+    printf ("  nvram 4D1FDA02-38C7-4A6A-9CC6-4BCCA8B30102:opencore-trace\n");
+    return -1;
+  }
+
+  Buffer = UserReadFile (argv[1], &Size);
+  if (Buffer == NULL) {
+    printf ("Read fail\n");
+    return -1;
+  }
+
+  if (Size < sizeof (OC_TRACE_HEADER)
+    || ((OC_TRACE_HEADER *) Buffer)->Signature != OC_TRACE_SIGNATURE) {
+    Size = DecodeNvramText (Buffer, Size);
+  }
+
+  mHeader = (OC_TRACE_HEADER *) Buffer;
+  mNodes  = (OC_TRACE_NODE *) (mHeader + 1);
+
+  if (Size < sizeof (OC_TRACE_HEADER)
+    || mHeader->Signature != OC_TRACE_SIGNATURE
+    || mHeader->Version != OC_TRACE_VERSION
+    || mHeader->NodeCount > OC_TRACE_MAX_NODES
+    || Size < sizeof (OC_TRACE_HEADER) + mHeader->NodeCount * sizeof (OC_TRACE_NODE)) {
+    printf ("Invalid trace record\n");
+    free (Buffer);
+    return -1;
+  }
+
+  mRootTotal = 0;
+  for (Index = 0; Index < mHeader->NodeCount; ++Index) {
+    mNodes[Index].Name[OC_TRACE_NAME_SIZE - 1] = '\0';
+    if (mNodes[Index].Parent > Index) {
+      mNodes[Index].Parent = 0;
+    }
+
+    if (mNodes[Index].Parent == 0) {
+      mRootTotal += mNodes[Index].Total;
+    }
+
+    mOrder[Index] = Index;
+  }
+
+  qsort (mOrder, mHeader->NodeCount, sizeof (mOrder[0]), CompareNodes);
+
+  printf (
+    "Phases %u, dropped %u, TSC %llu Hz%s\n\n",
+    mHeader->NodeCount,
+    mHeader->Dropped,
+    (unsigned long long) mHeader->Frequency,
+    mHeader->Frequency == 0 ? " (times in ticks)" : ""
+    );
+  printf ("%-36s %10s %10s %6s %7s\n", "Phase", "Start ms", "Total ms", "Count", "Share");
+
+  for (Index = 0; Index < mHeader->NodeCount; ++Index) {
+    if (mNodes[mOrder[Index]].Parent == 0) {
+      PrintNode (mOrder[Index], 0);
+    }
+  }
+
+  free (Buffer);
+
+  return 0;
+}
@@ -16,6 +16,46 @@
 #include "ocvalidate.h"
 #include "OcValidateLib.h"
 
+/**
+  Check whether ACPI patch base is a valid absolute namespace path,
+  e.g. \_SB.PCI0.LPCB or _SB_.PCI0.
+
+  @param[in]  Path            ACPI namespace path.
+
+  @retval     TRUE            If Path is legal.
+**/
+STATIC
+BOOLEAN
+ACPIPatchBaseIsLegal (
+  IN  CONST CHAR8  *Path
+  )
+{
+  UINTN  Index;
+
+  if (*Path == '\\') {
+    ++Path;
+  }
+
+  do {
+    for (Index = 0; Path[Index] != '.' && Path[Index] != '\0'; ++Index) {
+      if (Index == 4
+        || !((Path[Index] >= 'A' && Path[Index] <= 'Z')
+          || Path[Index] == '_'
+          || (Index > 0 && Path[Index] >= '0' && Path[Index] <= '9'))) {
+        return FALSE;
+      }
+    }
+
+    if (Index == 0) {
+      return FALSE;
+    }
+
+    Path += Index;
+  } while (*Path++ == '.');
+
+  return TRUE;
+}
+
 /**
   Callback function to verify whether Path is duplicated in ACPI->Add.
 
@@ -142,6 +182,7 @@ CheckACPIPatch (
   UINT32          ErrorCount;
   UINT32          Index;
   OC_ACPI_CONFIG  *UserAcpi;
+  CONST CHAR8     *Base;
   CONST CHAR8     *Comment;
   CONST UINT8     *Find;
   UINT32          FindSize;
@@ -156,6 +197,7 @@ CheckACPIPatch (
   UserAcpi        = &Config->Acpi;
 
   for (Index = 0; Index < UserAcpi->Patch.Count; ++Index) {
+    Base            = OC_BLOB_GET (&UserAcpi->Patch.Values[Index]->Base);
     Comment         = OC_BLOB_GET (&UserAcpi->Patch.Values[Index]->Comment);
     Find            = OC_BLOB_GET (&UserAcpi->Patch.Values[Index]->Find);
     FindSize        = UserAcpi->Patch.Values[Index]->Find.Size;
@@ -174,6 +216,11 @@ CheckACPIPatch (
       ++ErrorCount;
     }
 
+    if (Base[0] != '\0' && !ACPIPatchBaseIsLegal (Base)) {
+      DEBUG ((DEBUG_WARN, "ACPI->Patch[%u]->Base is not a valid ACPI path!\n", Index));
+      ++ErrorCount;
+    }
+
     //
     // Size of OemTableId and TableSignature cannot be checked,
     // as serialisation kills it.
@@ -631,6 +631,7 @@ CheckKernelScheme (
   OC_KERNEL_CONFIG    *UserKernel;
   CONST CHAR8         *Arch;
   CONST CHAR8         *KernelCache;
+  CONST CHAR8         *Vault;
 
   ErrorCount          = 0;
   UserKernel          = &Config->Kernel;
@@ -653,6 +654,15 @@ CheckKernelScheme (
     ++ErrorCount;
   }
 
+  //
+  // CachelessIndex is ignored when the vault is in use.
+  //
+  Vault = OC_BLOB_GET (&Config->Misc.Security.Vault);
+  if (UserKernel->Scheme.CachelessIndex && AsciiStrCmp (Vault, "Optional") != 0) {
+    DEBUG ((DEBUG_WARN, "Kernel->Scheme->CachelessIndex is enabled, but Misc->Security->Vault is not set to Optional!\n"));
+    ++ErrorCount;
+  }
+
   return ErrorCount;
 }
 
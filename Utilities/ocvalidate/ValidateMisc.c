@@ -443,6 +443,11 @@ CheckMiscSecurity (
     ++ErrorCount;
   }
 
+  if (UserMisc->Security.VaultPreload && !UserMisc->Security.StorageCache) {
+    DEBUG ((DEBUG_WARN, "Misc->Security->VaultPreload is enabled, but Misc->Security->StorageCache is not!\n"));
+    ++ErrorCount;
+  }
+
   ScanPolicy        = UserMisc->Security.ScanPolicy;
   AllowedScanPolicy = OC_SCAN_FILE_SYSTEM_LOCK | OC_SCAN_DEVICE_LOCK | OC_SCAN_DEVICE_BITS | OC_SCAN_FILE_SYSTEM_BITS;
   //